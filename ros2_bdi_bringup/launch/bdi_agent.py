@@ -6,7 +6,7 @@ from launch import LaunchDescription
 from launch.actions import DeclareLaunchArgument, IncludeLaunchDescription, SetEnvironmentVariable
 from launch.launch_description_sources import PythonLaunchDescriptionSource
 from launch.substitutions import LaunchConfiguration
-from launch_ros.actions import Node
+from launch_ros.actions import Node, ComposableNodeContainer
 
 # Utilities wrapper classes
 from bdi_agent_skills import AgentAction
@@ -32,6 +32,15 @@ from bdi_agent_core import *
             ** "init_dset": string file path to YAML file to init the desire set of the agent
 
             ** "planning_mode": {"offline", "online"}, default: "offline"
+
+            ** "incremental_sync": boolean value specifying if the belief manager reconciles just the changed facts
+                                    of the PDDL problem instead of re-scanning it as a whole at every update
+                                    (default value = false)
+
+            ** "single_process": boolean value specifying if the core nodes of the agent are loaded as components within
+                                    a single (multi-threaded) container, exchanging messages through intra-process comms
+                                    instead of running as separate processes (offline planning mode only, default value = false)
+                                    n.b. the MA request handler always runs as a separate process
             
             ** "belief_ck": string array of agent groups accepts beliefs CHECK request from
             ** "belief_w": string array of agent groups accepts beliefs WRITE request from
@@ -57,6 +66,19 @@ from bdi_agent_core import *
             ** "reschedule_policy": string in {"NO_PREEMPT", "PREEMPT"}, otherwise "NO_PREEMPT"
                                     to specify the reschedule policy
 
+            ** "planning_workers": if planning_mode=="offline", integer value >= 1 specifying how many plans can be computed
+                                    concurrently (one per desire) when rescheduling (default value = 1, i.e. one desire at a time)
+
+            ** "event_driven_scheduling": boolean value specifying if the scheduler reschedules just upon relevant events
+                                    (desire set changes, alterations of beliefs referenced by desires, plan status, planner availability)
+                                    instead of every 500ms (default value = false)
+
+            ** "reschedule_debounce": if event_driven_scheduling, integer value >= 0 specifying the interval (in ms, default 50) 
+                                    within which bursts of events are coalesced into a single rescheduling
+
+            ** "max_intentions": integer value >= 1 specifying how many intentions (plans for desires of different groups
+                                    sharing no action/instance) can be executed concurrently (offline planning mode only, default value = 1)
+
 
             ** "search_interval": if planning_mode=="online", it is possible to specify the interval search (in ms, min 100, default 500)
                                     which corresponds to the lapse of time in which JavaFF needs to provide an update about its plan search
@@ -150,6 +172,13 @@ def AgentLaunchDescription(
 
     if(not run_only_psys2):
 
+        single_process = False
+        if SINGLE_PROCESS_PARAM in init_params and isinstance(init_params[SINGLE_PROCESS_PARAM], bool):
+            single_process = init_params[SINGLE_PROCESS_PARAM]
+        if single_process and planning_mode == 'online':
+            print('"{}" not available in online planning mode: core nodes will run as separate processes'.format(SINGLE_PROCESS_PARAM))
+            single_process = False
+
         # create tmp folder, delete if already there
         create_tmp_folder_agent(agent_id, True)
         if INIT_BSET_PARAM in init_params:
@@ -167,50 +196,66 @@ def AgentLaunchDescription(
         '''
             [*] PLANSYS MONITOR NODE init.
         '''
-        plansys_monitor = build_PlanSysMonitor(namespace, agent_id, init_params)
+        plansys_monitor = build_PlanSysMonitor(namespace, agent_id, init_params, single_process)
 
 
         '''
             [*] BELIEF MANAGER NODE init.
         '''
-        belief_manager = build_BeliefManager(namespace, agent_id, init_params) 
+        belief_manager = build_BeliefManager(namespace, agent_id, init_params, single_process)
         
         '''
             [*] SCHEDULER NODE init.
         '''
         #  Default init params for Scheduler Node
-        scheduler = build_Scheduler(namespace, agent_id, init_params)
+        scheduler = build_Scheduler(namespace, agent_id, init_params, single_process)
 
         '''
             [*] PLAN DIRECTOR NODE init.
         '''
-        plan_director = build_PlanDirector(namespace, agent_id, init_params)
+        plan_director = build_PlanDirector(namespace, agent_id, init_params, single_process)
         
         '''
             [*] COMMUNICATION Multi Agent MA Request Handler NODE init.
         '''
-        ma_request_handler = build_MARequestHandlerNode(namespace, agent_id, agent_group, init_params)
+        # always a separate process: its srv handlers block waiting for their write acks and need a thread pool of their own 
+        # (see main/ma_request_handler.cpp), which would be starved by the other nodes' boots within the shared container
+        ma_request_handler = build_MARequestHandlerNode(namespace, agent_id, agent_group, init_params, False)
         
         '''
             [*] EVENT LISTENER NODE init.
         '''
-        event_listener = build_EventListener(namespace, agent_id, init_params)
+        event_listener = build_EventListener(namespace, agent_id, init_params, single_process)
         
         '''
             [*] ADD ROS2_BDI CORE nodes + action(s) & sensor(s) node(s)
         '''
-        # Declare plansys2 monitor node
-        ld.add_action(plansys_monitor)
-        #Add belief manager
-        ld.add_action(belief_manager)
-        #Add BDI scheduler
-        ld.add_action(scheduler)
-        #Add plan director
-        ld.add_action(plan_director)
-        #Add communication manager node
-        ld.add_action(ma_request_handler)
-        #Add event listener node
-        ld.add_action(event_listener)
+        if single_process:
+            # All core nodes within a single container (multi-threaded, since their boot waits for PlanSys2)
+            core_container = ComposableNodeContainer(
+                name='bdi_core_container',
+                namespace=namespace,
+                package='rclcpp_components',
+                executable='component_container_mt',
+                composable_node_descriptions=[plansys_monitor, belief_manager, scheduler, plan_director, event_listener],
+                output='screen')
+            ld.add_action(core_container)
+            #Add communication manager node
+            ld.add_action(ma_request_handler)
+
+        else:
+            # Declare plansys2 monitor node
+            ld.add_action(plansys_monitor)
+            #Add belief manager
+            ld.add_action(belief_manager)
+            #Add BDI scheduler
+            ld.add_action(scheduler)
+            #Add plan director
+            ld.add_action(plan_director)
+            #Add communication manager node
+            ld.add_action(ma_request_handler)
+            #Add event listener node
+            ld.add_action(event_listener)
         
         for act in sensors:
             if isinstance(act, AgentSensor):
@@ -1,4 +1,5 @@
 from launch_ros.actions import Node
+from launch_ros.descriptions import ComposableNode
 
 # Bringup parameters
 from bringup_params import *
@@ -24,64 +25,75 @@ def is_list_of(l, type):
 
 
 
+'''
+    Core node either as a standalone process or, if @composable, as a component to be loaded within the core container
+    of the agent (see ros2_bdi_core components), exchanging messages with the other core nodes through intra-process comms
+'''
+def build_core_node(executable, plugin, name, namespace, parameters, composable):
+    if composable:
+        return ComposableNode(
+            package='ros2_bdi_core',
+            plugin=plugin,
+            name=name,
+            namespace=namespace,
+            parameters=parameters,
+            extra_arguments=[{'use_intra_process_comms': True}])
+
+    return Node(
+        package='ros2_bdi_core',
+        executable=executable,
+        name=name,
+        namespace=namespace,
+        output='screen',
+        parameters=parameters)
+
 
 '''
     PlanSys2Monitor Node builder
 '''
-def build_PlanSysMonitor(namespace, agent_id, init_params):
+def build_PlanSysMonitor(namespace, agent_id, init_params, composable=False):
     debug = (DEBUG_ACTIVE_NODES_PARAM in init_params) and ('plansys_monitor' in init_params[DEBUG_ACTIVE_NODES_PARAM])
     planning_mode = 'offline'
     if PLANNING_MODE_PARAM in init_params:
         planning_mode = init_params[PLANNING_MODE_PARAM] if init_params[PLANNING_MODE_PARAM] in ['offline', 'online'] else 'offline'
     
-    return Node(
-        package='ros2_bdi_core',
-        executable='plansys_monitor',
-        name='plansys_monitor',
-        namespace=namespace,
-        output='screen',
-        parameters=[ {AGENT_ID_PARAM: agent_id}, {DEBUG_PARAM: debug}, {PLANNING_MODE_PARAM: planning_mode}])
+    return build_core_node('plansys_monitor', 'PlanSysMonitorComponent', 'plansys_monitor', namespace,
+        [ {AGENT_ID_PARAM: agent_id}, {DEBUG_PARAM: debug}, {PLANNING_MODE_PARAM: planning_mode}], composable)
 
 '''
     BeliefManager Node builder
 '''
-def build_BeliefManager(namespace, agent_id, init_params):
+def build_BeliefManager(namespace, agent_id, init_params, composable=False):
     debug = (DEBUG_ACTIVE_NODES_PARAM in init_params) and ('belief_manager' in init_params[DEBUG_ACTIVE_NODES_PARAM])
     planning_mode = 'offline'
     if PLANNING_MODE_PARAM in init_params:
         planning_mode = init_params[PLANNING_MODE_PARAM] if init_params[PLANNING_MODE_PARAM] in ['offline', 'online'] else 'offline'
 
-    return Node(
-        package='ros2_bdi_core',
-        executable='belief_manager',
-        name='belief_manager',
-        namespace=namespace,
-        output='screen',
-        parameters= [ {AGENT_ID_PARAM: agent_id}, {DEBUG_PARAM: debug},{PLANNING_MODE_PARAM: planning_mode},  ])
+    incremental_sync = False
+    if INCREMENTAL_SYNC_PARAM in init_params and isinstance(init_params[INCREMENTAL_SYNC_PARAM], bool):
+        incremental_sync = init_params[INCREMENTAL_SYNC_PARAM]
+
+    return build_core_node('belief_manager', 'BeliefManagerComponent', 'belief_manager', namespace,
+        [ {AGENT_ID_PARAM: agent_id}, {DEBUG_PARAM: debug},{PLANNING_MODE_PARAM: planning_mode}, {INCREMENTAL_SYNC_PARAM: incremental_sync} ], composable)
     
 
 '''
     Reactive Rules Event Listener Node builder
 '''
-def build_EventListener(namespace, agent_id, init_params):
+def build_EventListener(namespace, agent_id, init_params, composable=False):
     debug = (DEBUG_ACTIVE_NODES_PARAM in init_params) and ('event_listener' in init_params[DEBUG_ACTIVE_NODES_PARAM])
     planning_mode = 'offline'
     if PLANNING_MODE_PARAM in init_params:
         planning_mode = init_params[PLANNING_MODE_PARAM] if init_params[PLANNING_MODE_PARAM] in ['offline', 'online'] else 'offline'
 
-    return Node(
-        package='ros2_bdi_core',
-        executable='event_listener',
-        name='event_listener',
-        namespace=namespace,
-        output='screen',
-        parameters= [ {AGENT_ID_PARAM: agent_id}, {DEBUG_PARAM: debug},{PLANNING_MODE_PARAM: planning_mode}, ])
+    return build_core_node('event_listener', 'EventListenerComponent', 'event_listener', namespace,
+        [ {AGENT_ID_PARAM: agent_id}, {DEBUG_PARAM: debug},{PLANNING_MODE_PARAM: planning_mode}, ], composable)
 
 
 '''
     Scheduler Node builder, pass init_params to check, eval and set init parameters for the node
 '''
-def build_Scheduler(namespace, agent_id, init_params):
+def build_Scheduler(namespace, agent_id, init_params, composable=False):
     
     debug = (DEBUG_ACTIVE_NODES_PARAM in init_params) and ('scheduler' in init_params[DEBUG_ACTIVE_NODES_PARAM])
 
@@ -91,6 +103,10 @@ def build_Scheduler(namespace, agent_id, init_params):
     exec_plan_tries = 16
     autosubmit_prec = False
     autosubmit_context = False
+    planning_workers = 1
+    event_driven_scheduling = False
+    reschedule_debounce = 50
+    max_intentions = 1
 
     # check below for passed values in init
 
@@ -120,6 +136,18 @@ def build_Scheduler(namespace, agent_id, init_params):
     else:
         log_automatic_set(AUTOSUBMIT_CONTEXT_PARAM, autosubmit_context)
 
+    if PLANNING_WORKERS_PARAM in init_params and isinstance(init_params[PLANNING_WORKERS_PARAM], int) and init_params[PLANNING_WORKERS_PARAM] >= 1:
+        planning_workers = init_params[PLANNING_WORKERS_PARAM]
+
+    if EVENT_DRIVEN_SCHEDULING_PARAM in init_params and isinstance(init_params[EVENT_DRIVEN_SCHEDULING_PARAM], bool):
+        event_driven_scheduling = init_params[EVENT_DRIVEN_SCHEDULING_PARAM]
+
+    if RESCHEDULE_DEBOUNCE_PARAM in init_params and isinstance(init_params[RESCHEDULE_DEBOUNCE_PARAM], int) and init_params[RESCHEDULE_DEBOUNCE_PARAM] >= 0:
+        reschedule_debounce = init_params[RESCHEDULE_DEBOUNCE_PARAM]
+
+    if MAX_INTENTIONS_PARAM in init_params and isinstance(init_params[MAX_INTENTIONS_PARAM], int) and init_params[MAX_INTENTIONS_PARAM] >= 1:
+        max_intentions = init_params[MAX_INTENTIONS_PARAM]
+
     planning_mode = 'offline'
     if PLANNING_MODE_PARAM in init_params:
         planning_mode = init_params[PLANNING_MODE_PARAM] if init_params[PLANNING_MODE_PARAM] in ['offline', 'online'] else 'offline'
@@ -134,30 +162,29 @@ def build_Scheduler(namespace, agent_id, init_params):
         max_empty_search_intervals = init_params[MAX_EMPTY_SEARCH_INTERVALS_PARAM]
         max_empty_search_intervals = max_empty_search_intervals if max_empty_search_intervals > 0 else 1
 
-    return Node(
-        package='ros2_bdi_core',
-        executable='scheduler_'+planning_mode,
-        name='scheduler_'+planning_mode,
-        namespace=namespace,
-        output='screen',
-        parameters=[
+    return build_core_node('scheduler_'+planning_mode, 'Scheduler'+planning_mode.capitalize()+'Component', 'scheduler_'+planning_mode, namespace,
+        [
             {AGENT_ID_PARAM: agent_id},
             {RESCHEDULE_POLICY_PARAM: reschedule_policy},
             {COMP_PLAN_TRIES_PARAM: comp_plan_tries},
             {EXEC_PLAN_TRIES_PARAM: exec_plan_tries},
             {AUTOSUBMIT_PREC_PARAM: autosubmit_prec},
             {AUTOSUBMIT_CONTEXT_PARAM: autosubmit_context}, 
+            {PLANNING_WORKERS_PARAM: planning_workers},
+            {EVENT_DRIVEN_SCHEDULING_PARAM: event_driven_scheduling},
+            {RESCHEDULE_DEBOUNCE_PARAM: reschedule_debounce},
+            {MAX_INTENTIONS_PARAM: max_intentions},
             {PLANNING_MODE_PARAM: planning_mode},
             {SEARCH_INTERVAL_MS_PARAM: interval_search_ms},
             {MAX_EMPTY_SEARCH_INTERVALS_PARAM: max_empty_search_intervals},
             {DEBUG_PARAM: debug}
-        ])
+        ], composable)
 
 
 '''
     PlanDirector Node builder, pass init_params to check, eval and set init parameters for the node
 '''
-def build_PlanDirector(namespace, agent_id, init_params):
+def build_PlanDirector(namespace, agent_id, init_params, composable=False):
 
     debug = (DEBUG_ACTIVE_NODES_PARAM in init_params) and ('plan_director' in init_params[DEBUG_ACTIVE_NODES_PARAM])
 
@@ -174,25 +201,20 @@ def build_PlanDirector(namespace, agent_id, init_params):
     if PLANNING_MODE_PARAM in init_params:
         planning_mode = init_params[PLANNING_MODE_PARAM] if init_params[PLANNING_MODE_PARAM] in ['offline', 'online'] else 'offline'
 
-    return Node(
-        package='ros2_bdi_core',
-        executable='plan_director',
-        name='plan_director',
-        namespace=namespace,
-        output='screen',
-        parameters=[
+    return build_core_node('plan_director', 'PlanDirectorComponent', 'plan_director', namespace,
+        [
             {AGENT_ID_PARAM: agent_id},
             {ABORT_SURPASS_DEADLINE_DEADLINE_PARAM: abort_surpass_deadline},
             {PLANNING_MODE_PARAM: planning_mode},
             {DEBUG_PARAM: debug}
-        ])
+        ], composable)
 
 
 '''
     Communication MA Request Handler Node builder, pass init_params to check, eval and set init parameters for the node
     Agent group id is needed too
 '''
-def build_MARequestHandlerNode(namespace, agent_id, agent_group, init_params):
+def build_MARequestHandlerNode(namespace, agent_id, agent_group, init_params, composable=False):
 
     debug = (DEBUG_ACTIVE_NODES_PARAM in init_params) and ('ma_request_handler' in init_params[DEBUG_ACTIVE_NODES_PARAM])
 
@@ -215,11 +237,5 @@ def build_MARequestHandlerNode(namespace, agent_id, agent_group, init_params):
     if PLANNING_MODE_PARAM in init_params:
         planning_mode = init_params[PLANNING_MODE_PARAM] if init_params[PLANNING_MODE_PARAM] in ['offline', 'online'] else 'offline'
 
-    return Node(
-        package='ros2_bdi_core',
-        executable='ma_request_handler',
-        name='ma_request_handler',
-        namespace=namespace,
-        output='screen',
-        parameters=communication_node_params + [{PLANNING_MODE_PARAM: planning_mode},]
-    )
\ No newline at end of file
+    return build_core_node('ma_request_handler', 'MARequestHandlerComponent', 'ma_request_handler', namespace,
+        communication_node_params + [{PLANNING_MODE_PARAM: planning_mode},], composable)
\ No newline at end of file
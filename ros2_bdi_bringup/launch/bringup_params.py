@@ -6,6 +6,10 @@ INIT_BSET_PARAM = 'init_bset'
 INIT_DSET_PARAM = 'init_dset'
 INIT_RRULESSET_PARAM = 'init_reactive_rules_set'
 
+INCREMENTAL_SYNC_PARAM = 'incremental_sync'
+
+SINGLE_PROCESS_PARAM = 'single_process'
+
 PLANNING_MODE_PARAM = 'planning_mode'
 SEARCH_INTERVAL_MS_PARAM = 'search_interval'
 MAX_EMPTY_SEARCH_INTERVALS_PARAM = 'max_null_search_intervals'
@@ -19,6 +23,7 @@ ACCEPT_DESIRES_MAX_PR_PARAM = 'desire_pr'
 ABORT_SURPASS_DEADLINE_DEADLINE_PARAM = 'rtc_deadline'
 COMP_PLAN_TRIES_PARAM = 'comp_plan_tries'
 EXEC_PLAN_TRIES_PARAM = 'exec_plan_tries'
+PLANNING_WORKERS_PARAM = 'planning_workers'
 
 AUTOSUBMIT_PREC_PARAM = 'autosub_prec'
 AUTOSUBMIT_CONTEXT_PARAM = 'autosub_context'
@@ -27,6 +32,11 @@ RESCHEDULE_POLICY_PARAM = 'reschedule_policy'
 RESCHEDULE_POLICY_VAL_NO_IF_EXEC = 'NO_PREEMPT'
 RESCHEDULE_POLICY_VAL_IF_EXEC = 'PREEMPT'
 
+EVENT_DRIVEN_SCHEDULING_PARAM = 'event_driven_scheduling'
+RESCHEDULE_DEBOUNCE_PARAM = 'reschedule_debounce'
+
+MAX_INTENTIONS_PARAM = 'max_intentions'
+
 MIN_COMMIT_STEPS_PARAM = 'min_commit_steps'
 
 DEBUG_PARAM = 'debug'
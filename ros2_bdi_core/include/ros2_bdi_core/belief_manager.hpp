@@ -5,6 +5,7 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <deque>
 #include <memory>
 #include <mutex>  
 
@@ -13,8 +14,13 @@
 #include "ros2_bdi_interfaces/msg/lifecycle_status.hpp"
 #include "ros2_bdi_interfaces/msg/belief.hpp"
 #include "ros2_bdi_interfaces/msg/belief_set.hpp"
+#include "ros2_bdi_interfaces/msg/belief_set_delta.hpp"
+#include "ros2_bdi_interfaces/msg/belief_set_write.hpp"
+#include "ros2_bdi_interfaces/msg/write_ack.hpp"
 #include "ros2_bdi_interfaces/msg/planning_system_state.hpp"
 #include "ros2_bdi_utils/ManagedBelief.hpp"
+#include "ros2_bdi_utils/BeliefStore.hpp"
+#include "ros2_bdi_utils/PDDLMetadataCache.hpp"
 
 #include "ros2_bdi_core/params/core_common_params.hpp"
 #include "ros2_bdi_core/params/belief_manager_params.hpp"
@@ -25,13 +31,21 @@
 #include "rclcpp/rclcpp.hpp"
 
 typedef enum {STARTING, SYNC, PAUSE} StateType;                
+typedef enum {SYNC_ADD, SYNC_DEL, SYNC_UPD} SyncOpType;
+
+/* Write performed by the belief manager itself to the problem expert, waiting for the corresponding update notification */
+typedef struct{
+    SyncOpType op;
+    BDIManaged::ManagedBelief belief;
+    rclcpp::Time stamp;
+}Psys2Write;
 
 class BeliefManager : public rclcpp::Node
 {
     public:
 
         /* Constructor method */
-        BeliefManager();
+        BeliefManager(const rclcpp::NodeOptions& options = rclcpp::NodeOptions());
 
         /*
             Init to call at the start, after construction method, to get the node actually started
@@ -82,9 +96,29 @@ class BeliefManager : public rclcpp::Node
 
         /*
             Publish the current belief set of the agent in agent_id_/belief_set topic
+            (pending alterations are notified through a belief set delta first)
         */
         void publishBeliefSet();
 
+        /*
+            Publish the alterations to the belief set not notified yet in agent_id_/belief_set_delta topic (if any)
+        */
+        void publishBeliefSetDelta();
+
+        /*
+            Record an alteration to the belief set to be notified with the next belief set delta
+        */
+        void recordBeliefSetChange(const BDIManaged::ManagedBelief& mb, const SyncOpType& op);
+
+        /*
+            Someone has requested a full snapshot of the belief set (e.g. its mirror has missed a delta)
+        */
+        void beliefSetRequestCallback(const std_msgs::msg::Empty::SharedPtr msg)
+        {
+            if(state_ == SYNC)
+                publishBeliefSet();
+        }
+
         /*
             Expect to find yaml file to init the belief set in "/tmp/{agent_id}/init_bset.yaml"
         */
@@ -96,6 +130,47 @@ class BeliefManager : public rclcpp::Node
         */
         void updatedPDDLProblem(const std_msgs::msg::Empty::SharedPtr msg);
 
+        /*
+            Retrieve instances, predicates and functions from the problem expert and diff them all against the belief set
+            Returns true if any modification to the belief_set occurs
+        */
+        bool fullSyncPDDLProblem();
+
+        /*
+            Apply to the belief set the facts changed in the PDDL problem since the last notification 
+            (@addedFacts new or with a new value, @removedFacts dropped, see PDDLUtils::diffPDDLProblemFacts),
+            skipping the ones already known through own writes, and align the last known pddl problem facts
+            Returns false if some changed fact cannot be interpreted (caller should fall back to a full sync),
+            modified is set to true if any modification to the belief_set occurs
+        */
+        bool reconcilePDDLProblemDelta(const std::map<std::string, std::string>& addedFacts, 
+            const std::map<std::string, std::string>& removedFacts, bool& modified);
+
+        /*
+            Record a write performed to the problem expert, so that its update notification
+            is recognized as an echo of it, and apply it to the last known pddl problem facts (incremental sync only)
+        */
+        void logPsys2Write(const BDIManaged::ManagedBelief& mb, const SyncOpType& op);
+
+        /*
+            Consume the oldest pending own write (if any) as acknowledged by an update notification, if the problem expert 
+            reflects it (own writes are logged once performed, so one which is not reflected has been undone by someone else:
+            the belief set and the last known facts are aligned with the problem expert wrt. it, setting modified to true).
+            Returns true if the notification is the echo of an own write, so there is nothing to reconcile
+        */
+        bool consumePsys2WriteAck(bool& modified);
+
+        /*
+            Check the own write @write against the problem expert (just the fact it has written):
+            if it is not reflected anymore, align the belief set and the last known facts to the actual fact and return true
+        */
+        bool alignPsys2Write(const Psys2Write& write);
+
+        /*
+            Remove from the belief set predicates and functions referring to a removed instance
+            (the problem expert drops them automatically when the instance is removed)
+        */
+        void removeDanglingBeliefs(const BDIManaged::ManagedBelief& mb_instance);
         
         bool updateBeliefSet(const std::vector<ros2_bdi_interfaces::msg::Belief>& ins_beliefs, 
             const std::vector<ros2_bdi_interfaces::msg::Belief>& pred_beliefs, const std::vector<ros2_bdi_interfaces::msg::Belief>& fun_beliefs);
@@ -145,11 +220,24 @@ class BeliefManager : public rclcpp::Node
         */
         void delBeliefSetTopicCallBack(const ros2_bdi_interfaces::msg::BeliefSet::SharedPtr msg);
 
+        /*  
+            Someone has requested a belief set write: apply it and acknowledge it 
+            with the same request id and the resulting belief set version
+        */
+        void beliefSetWriteTopicCallBack(const ros2_bdi_interfaces::msg::BeliefSetWrite::SharedPtr msg);
+
         /*
             Add Belief in the belief set, just after having appropriately sync the pddl_problem to add it there too
         */
         void addBeliefSyncPDDL(const BDIManaged::ManagedBelief& mb);
 
+        /*
+            Add a batch of beliefs in the belief set, syncing the pddl_problem to add them there too:
+            missing instances are computed once for the whole batch and added before predicates and functions,
+            the belief set delta is published once at the end
+        */
+        void addBeliefsSyncPDDL(const std::vector<BDIManaged::ManagedBelief>& mbs);
+
         /*
             Create array of boolean flags denoting missing instances' positions
             wrt. parameters in the passed ManagedBelief argument
@@ -172,6 +260,12 @@ class BeliefManager : public rclcpp::Node
         */
         void delBeliefSyncPDDL(const BDIManaged::ManagedBelief& mb);
 
+        /*
+            Remove a batch of beliefs from the belief set, syncing the pddl_problem to remove them from there too
+            (existence in the pddl_problem checked just for failed removals), the belief set delta is published once at the end
+        */
+        void delBeliefsSyncPDDL(const std::vector<BDIManaged::ManagedBelief>& mbs);
+
         /*
             add belief into belief set
         */
@@ -211,9 +305,20 @@ class BeliefManager : public rclcpp::Node
         std::shared_ptr<plansys2::ProblemExpertClient> problem_expert_;
         // domain expert instance to call the problem expert api
         std::shared_ptr<plansys2::DomainExpertClient> domain_expert_;
+        // predicate/function schemas (retrieved through domain_expert_) and instances (mirrored from the belief set)
+        BDIManaged::PDDLMetadataCache pddl_metadata_;
         // contain last pddl problem string known at the moment (goal part stripped away)
         std::string last_pddl_problem_;
         
+        // incremental sync with the problem expert (reconcile just changed facts instead of re-scanning the whole problem)
+        bool incremental_sync_;
+        // normalized facts of the last known pddl problem mapped to their values (incremental sync only)
+        std::map<std::string, std::string> last_pddl_problem_facts_;
+        // last known pddl problem facts have been recorded at least once
+        bool pddl_problem_facts_init_;
+        // change log of the writes performed to the problem expert not acknowledged by an update notification yet
+        std::deque<Psys2Write> psys2_writes_log_;
+        
         
         // flag to denote if the problem expert node seems to be up and active
         bool psys2_problem_expert_active_;
@@ -226,7 +331,12 @@ class BeliefManager : public rclcpp::Node
         bool init_bset_;
 
         // belief set of the agent <agent_id_>
-        std::set<BDIManaged::ManagedBelief> belief_set_;
+        BDIManaged::BeliefStore belief_set_;
+
+        // version of the belief set, increased by every published belief set delta
+        uint64_t belief_set_version_;
+        // alterations to the belief set not notified yet (coalesced per belief)
+        std::map<BDIManaged::ManagedBelief, SyncOpType> pending_bset_delta_;
 
         // belief set publishers/subscribers
         rclcpp::Subscription<ros2_bdi_interfaces::msg::Belief>::SharedPtr add_belief_subscriber_;//add belief notify on topic
@@ -234,6 +344,10 @@ class BeliefManager : public rclcpp::Node
         rclcpp::Subscription<ros2_bdi_interfaces::msg::Belief>::SharedPtr del_belief_subscriber_;//del belief notify on topic
         rclcpp::Publisher<ros2_bdi_interfaces::msg::BeliefSet>::SharedPtr belief_set_publisher_;//belief set publisher
         rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSet>::SharedPtr del_belief_set_subscriber_;//del belief set notify on topic
+        rclcpp::Publisher<ros2_bdi_interfaces::msg::BeliefSetDelta>::SharedPtr belief_set_delta_publisher_;//belief set delta publisher
+        rclcpp::Subscription<std_msgs::msg::Empty>::SharedPtr belief_set_request_subscriber_;//belief set snapshot requests
+        rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSetWrite>::SharedPtr belief_set_write_subscriber_;//acknowledged belief set writes
+        rclcpp::Publisher<ros2_bdi_interfaces::msg::WriteAck>::SharedPtr belief_set_write_ack_publisher_;//belief set writes acknowledgements
         
         // plansys2 problem expert notification for updates
         rclcpp::Subscription<std_msgs::msg::Empty>::SharedPtr updated_problem_subscriber_;
@@ -250,4 +364,10 @@ class BeliefManager : public rclcpp::Node
 
 }; //BeliefManager class prototype
 
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/belief_manager.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(BeliefManager& node);
+
 #endif //BELIEF_MANAGER_H_
@@ -13,6 +13,7 @@
 #include "ros2_bdi_interfaces/msg/lifecycle_status.hpp"
 #include "ros2_bdi_interfaces/msg/belief.hpp"
 #include "ros2_bdi_interfaces/msg/belief_set.hpp"
+#include "ros2_bdi_interfaces/msg/belief_set_delta.hpp"
 #include "ros2_bdi_interfaces/msg/desire.hpp"
 #include "ros2_bdi_interfaces/msg/desire_set.hpp"
 
@@ -20,14 +21,17 @@
 #include "ros2_bdi_utils/ManagedDesire.hpp"
 #include "ros2_bdi_utils/ManagedCondition.hpp"
 #include "ros2_bdi_utils/ManagedReactiveRule.hpp"
+#include "ros2_bdi_utils/ReactiveRuleMatcher.hpp"
 
 #include "ros2_bdi_utils/BDIFilter.hpp"
+#include "ros2_bdi_utils/BeliefSetMirror.hpp"
 
 #include "ros2_bdi_core/params/core_common_params.hpp"
 #include "ros2_bdi_core/params/event_listener_params.hpp"
 #include "ros2_bdi_core/support/planning_mode.hpp"
 #include "ros2_bdi_core/support/plansys_monitor_client.hpp"
 
+#include "std_msgs/msg/empty.hpp"
 #include "rclcpp/rclcpp.hpp"
 
 typedef enum {STARTING, CHECKING} StateType;   
@@ -42,7 +46,7 @@ class EventListener : public rclcpp::Node
     public:
 
         /* Constructor method */
-        EventListener();
+        EventListener(const rclcpp::NodeOptions& options = rclcpp::NodeOptions());
 
         /*
             Init to call at the start, after construction method, to get the node actually started
@@ -54,6 +58,11 @@ class EventListener : public rclcpp::Node
         */
         bool init();
 
+        /*
+            True if the node has been initialized with at least a reactive rule to apply
+        */
+        bool hasReactiveRules() const { return reactive_rules_.size() > 0; }
+
         /*
             Wait for PlanSys2 to boot at best for max_wait
         */
@@ -65,11 +74,25 @@ class EventListener : public rclcpp::Node
 
     private:
 
+        /*
+            Main loop of work called regularly through a wall timer (publish the lifecycle status)
+        */
+        void step();
+
         /*Build updated ros2_bdi_interfaces::msg::LifecycleStatus msg*/
         ros2_bdi_interfaces::msg::LifecycleStatus getLifecycleStatus();
         
         
-        void updBeliefSetCallback(const ros2_bdi_interfaces::msg::BeliefSet::SharedPtr msg);
+        /*
+            Received a full belief set snapshot: realign the mirror and check the rules if anything has changed
+        */
+        void updBeliefSetCallback(const ros2_bdi_interfaces::msg::BeliefSet::ConstSharedPtr msg);
+
+        /*
+            Received a belief set delta: apply it to the mirror and check the rules if anything has changed,
+            ask for a new snapshot if some delta has been missed
+        */
+        void updBeliefSetDeltaCallback(const ros2_bdi_interfaces::msg::BeliefSetDelta::ConstSharedPtr msg);
 
         /*
             Received notification about ROS2-BDI Lifecycle status
@@ -86,17 +109,15 @@ class EventListener : public rclcpp::Node
         // recover from expected file the rules to be applied
         std::set<BDIManaged::ManagedReactiveRule> init_reactive_rules();
 
-        /*Iterate over the rules and check if any of them applies, if yes enforces it*/
+        /*
+            Check which rule instantiations have become satisfied since the last check (as per the incremental rule matcher)
+            and enforce them
+        */
         void check_if_any_rule_apply();
         
         /*Apply reactive rule, by publishing to the right topic belief/desire set updates as defined in reactive_rule*/
         void apply_rule(const BDIManaged::ManagedReactiveRule& reactive_rule);
 
-        /*Apply satisfying rules starting from extracted possible assignments for the placeholders*/
-        void apply_satisfying_rules(const BDIManaged::ManagedReactiveRule& reactive_rule, 
-            const std::map<std::string, std::vector<BDIManaged::ManagedBelief>>& assignments, 
-            const std::set<BDIManaged::ManagedBelief>& belief_set);
-
         // internal state of the node
         StateType state_; 
                
@@ -104,18 +125,23 @@ class EventListener : public rclcpp::Node
         std::string agent_id_;
         // step counter
         uint64_t step_counter_;
+        // timer to trigger callback to perform main loop of work regularly
+        rclcpp::TimerBase::SharedPtr do_work_timer_;
 
         // Selected planning mode
         PlanningMode sel_planning_mode_;
 
         //policy rules set
         std::set<BDIManaged::ManagedReactiveRule> reactive_rules_;
+        // incremental matcher of the rules against the belief set mirror
+        BDIManaged::ReactiveRuleMatcher rule_matcher_;
 
 
         // domain expert instance to call the plansys2 domain expert api
         std::shared_ptr<plansys2::DomainExpertClient> domain_expert_;
 
-        std::set<BDIManaged::ManagedBelief> belief_set_;
+        // mirror of the agent belief set
+        BDIManaged::BeliefSetMirror belief_set_mirror_;
 
         // belief set publishers
         rclcpp::Publisher<ros2_bdi_interfaces::msg::Belief>::SharedPtr add_belief_publisher_;//add belief topic pub
@@ -126,6 +152,8 @@ class EventListener : public rclcpp::Node
         rclcpp::Publisher<ros2_bdi_interfaces::msg::Desire>::SharedPtr del_desire_publisher_;//del desire topic pub
 
         rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSet>::SharedPtr belief_set_subscription_;//belief set subscription
+        rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSetDelta>::SharedPtr belief_set_delta_subscription_;//belief set delta subscription
+        rclcpp::Publisher<std_msgs::msg::Empty>::SharedPtr belief_set_request_publisher_;//belief set snapshot request pub
 
         // current known status of the system nodes
         std::map<std::string, uint8_t> lifecycle_status_;
@@ -139,4 +167,11 @@ class EventListener : public rclcpp::Node
 
 }; //BeliefManager class prototype
 
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/event_listener.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+    (a node with no reactive rules to apply boots anyway, but just stays idle)
+*/
+bool bootCoreNode(EventListener& node);
+
 #endif //EVENT_LISTENER_H_
@@ -5,26 +5,39 @@
 #include <vector>
 #include <map>
 #include <thread>
+#include <atomic>
+#include <future>
+#include <optional>
 
 #include "ros2_bdi_interfaces/msg/lifecycle_status.hpp"
 #include "ros2_bdi_interfaces/msg/belief.hpp"
 #include "ros2_bdi_interfaces/msg/belief_set.hpp"
+#include "ros2_bdi_interfaces/msg/belief_set_delta.hpp"
 #include "ros2_bdi_interfaces/msg/desire.hpp"
 #include "ros2_bdi_interfaces/msg/desire_set.hpp"
+#include "ros2_bdi_interfaces/msg/belief_set_write.hpp"
+#include "ros2_bdi_interfaces/msg/desire_set_write.hpp"
+#include "ros2_bdi_interfaces/msg/write_ack.hpp"
 #include "ros2_bdi_interfaces/srv/is_accepted_operation.hpp"
 #include "ros2_bdi_interfaces/srv/check_belief.hpp"
 #include "ros2_bdi_interfaces/srv/upd_belief_set.hpp"
 #include "ros2_bdi_interfaces/srv/check_desire.hpp"
 #include "ros2_bdi_interfaces/srv/upd_desire_set.hpp"
+#include "ros2_bdi_interfaces/srv/check_belief_batch.hpp"
+#include "ros2_bdi_interfaces/srv/upd_belief_set_batch.hpp"
+#include "ros2_bdi_interfaces/srv/check_desire_batch.hpp"
+#include "ros2_bdi_interfaces/srv/upd_desire_set_batch.hpp"
 
 #include "ros2_bdi_utils/ManagedBelief.hpp"
 #include "ros2_bdi_utils/ManagedDesire.hpp"
+#include "ros2_bdi_utils/BeliefSetMirror.hpp"
 
 #include "ros2_bdi_core/params/core_common_params.hpp"
 #include "ros2_bdi_core/params/ma_request_handler_params.hpp"
 #include "ros2_bdi_core/support/planning_mode.hpp"
 #include "ros2_bdi_core/support/plansys_monitor_client.hpp"
 
+#include "std_msgs/msg/empty.hpp"
 #include "rclcpp/rclcpp.hpp"
 
 typedef enum {BELIEF, DESIRE} RequestObjType;  
@@ -33,7 +46,7 @@ typedef enum {CHECK, WRITE} RequestObjOp;
 class MARequestHandler : public rclcpp::Node
 {
 public:
-  MARequestHandler();
+  MARequestHandler(const rclcpp::NodeOptions& options = rclcpp::NodeOptions());
 
     /*
         Init to call at the start, after construction method, to get the node actually started
@@ -84,32 +97,46 @@ private:
     float getMaxAcceptedPriority(const std::string& requestingAgentGroup);
 
     /*
-      @updIndex to be used to know which lock has to be checked among the two in desire_set_upd_locks_
-      and which waiting counter has to be incremented and/or checked
+        The desire set has been updated
+    */
+    void updatedDesireSet(const ros2_bdi_interfaces::msg::DesireSet::ConstSharedPtr msg);
 
-      @countCheck in order to check if desire is present (ADD op) or not present (DEL op)
+    /*
+        The belief set has been updated
     */
-    void checkDesireSetWaitingUpd(const int& updIndex, const int& countCheck);
+    void updatedBeliefSet(const ros2_bdi_interfaces::msg::BeliefSet::ConstSharedPtr msg);
 
     /*
-        The desire set has been updated
+        A belief set delta has been received (ask for a new snapshot if some delta has been missed)
     */
-    void updatedDesireSet(const ros2_bdi_interfaces::msg::DesireSet::SharedPtr msg);
+    void updatedBeliefSetDelta(const ros2_bdi_interfaces::msg::BeliefSetDelta::ConstSharedPtr msg);
 
     /*
-      @updIndex to be used to know which lock has to be checked among the two in belief_set_upd_locks_
-      and which waiting counter has to be incremented and/or checked
+      Submit the write of @beliefs (@updIndex = ADD_I/DEL_I) to the belief manager and wait for its acknowledgement
+      (at most WRITE_ACK_TIMEOUT ms): return it, if it has come in time
+    */
+    std::optional<ros2_bdi_interfaces::msg::WriteAck> writeBeliefSet(const std::vector<ros2_bdi_interfaces::msg::Belief>& beliefs, 
+        const int& updIndex);
 
-      @countCheck in order to check if belief is present (ADD op) or not present (DEL op)
+    /*
+      Submit the write of @desires (@updIndex = ADD_I/DEL_I) to the scheduler and wait for its acknowledgement
+      (at most WRITE_ACK_TIMEOUT ms): return it, if it has come in time
     */
-    void checkBeliefSetWaitingUpd(const int& updIndex, const int& countCheck);
-    
+    std::optional<ros2_bdi_interfaces::msg::WriteAck> writeDesireSet(const std::vector<ros2_bdi_interfaces::msg::Desire>& desires, 
+        const int& updIndex);
+
     /*
-        The belief set has been updated
+      Wait for the acknowledgement of the write @requestId among @pendingWrites (at most WRITE_ACK_TIMEOUT ms)
     */
-    void updatedBeliefSet(const ros2_bdi_interfaces::msg::BeliefSet::SharedPtr msg);
+    std::optional<ros2_bdi_interfaces::msg::WriteAck> waitWriteAck(
+        std::map<uint64_t, std::shared_ptr<std::promise<ros2_bdi_interfaces::msg::WriteAck>>>& pendingWrites,
+        const uint64_t& requestId, std::future<ros2_bdi_interfaces::msg::WriteAck>& ackFuture);
 
-    
+    /*
+      A write has been acknowledged: wake up the handler waiting for it among @pendingWrites (if still there)
+    */
+    void writeAcknowledged(std::map<uint64_t, std::shared_ptr<std::promise<ros2_bdi_interfaces::msg::WriteAck>>>& pendingWrites,
+        const ros2_bdi_interfaces::msg::WriteAck& ack);
 
     /*  
         Read Belief Request service handler        
@@ -148,6 +175,32 @@ private:
     */
     void handleDelDesireRequest(const ros2_bdi_interfaces::srv::UpdDesireSet::Request::SharedPtr request,
         const ros2_bdi_interfaces::srv::UpdDesireSet::Response::SharedPtr response);
+
+    /*  
+        Read Belief Batch Request service handler        
+    */
+    void handleCheckBeliefBatchRequest(const ros2_bdi_interfaces::srv::CheckBeliefBatch::Request::SharedPtr request,
+        const ros2_bdi_interfaces::srv::CheckBeliefBatch::Response::SharedPtr response);
+
+    /*  
+        Add (@updIndex = ADD_I) / Del (@updIndex = DEL_I) Belief Batch Request service handler:
+        the whole batch goes within a single add/del belief set msg and a single wait for the belief set covering all of it
+    */
+    void handleUpdBeliefBatchRequest(const ros2_bdi_interfaces::srv::UpdBeliefSetBatch::Request::SharedPtr request,
+        const ros2_bdi_interfaces::srv::UpdBeliefSetBatch::Response::SharedPtr response, const int& updIndex);
+
+    /*  
+        Read Desire Batch Request service handler        
+    */
+    void handleCheckDesireBatchRequest(const ros2_bdi_interfaces::srv::CheckDesireBatch::Request::SharedPtr request,
+        const ros2_bdi_interfaces::srv::CheckDesireBatch::Response::SharedPtr response);
+
+    /*  
+        Add (@updIndex = ADD_I) / Del (@updIndex = DEL_I) Desire Batch Request service handler:
+        a single wait for the desire set covering the whole batch
+    */
+    void handleUpdDesireBatchRequest(const ros2_bdi_interfaces::srv::UpdDesireSetBatch::Request::SharedPtr request,
+        const ros2_bdi_interfaces::srv::UpdDesireSetBatch::Response::SharedPtr response, const int& updIndex);
     
     // agent id that defines the namespace in which the node operates
     std::string agent_id_;
@@ -164,14 +217,22 @@ private:
     rclcpp::Service<ros2_bdi_interfaces::srv::IsAcceptedOperation>::SharedPtr accepted_server_;
 
     // mirroring of the current state of the belief set
-    std::set<BDIManaged::ManagedBelief> belief_set_;
+    BDIManaged::BeliefSetMirror belief_set_mirror_;
     // belief set update subscription
     rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSet>::SharedPtr belief_set_subscriber_;
+    // belief set delta subscription
+    rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSetDelta>::SharedPtr belief_set_delta_subscriber_;
+    // belief set snapshot request publisher (to resync the mirror)
+    rclcpp::Publisher<std_msgs::msg::Empty>::SharedPtr belief_set_request_publisher_;
+    // lock to process belief set updates (and read the mirror meanwhile)
+    std::mutex process_belief_set_upd_lock_;
     
     rclcpp::callback_group::CallbackGroup::SharedPtr callback_group_upd_subscribers_;
 
     // mirroring of the current state of the desire set
     std::set<BDIManaged::ManagedDesire> desire_set_;
+    // lock to process desire set updates (and read the mirror meanwhile)
+    std::mutex process_desire_set_upd_lock_;
     // desire set update subscription
     rclcpp::Subscription<ros2_bdi_interfaces::msg::DesireSet>::SharedPtr desire_set_subscriber_;
 
@@ -182,18 +243,16 @@ private:
     // handle del belief requests from other agents
     rclcpp::Service<ros2_bdi_interfaces::srv::UpdBeliefSet>::SharedPtr del_belief_server_;
     
-    // lock to put waiting for next belief set addition/deletion
-    std::mutex process_belief_set_upd_lock_;
-    std::vector<std::mutex> belief_set_upd_locks_;
-    // managed belief you're waiting for (to be added or deleted)
-    std::vector<BDIManaged::ManagedBelief> belief_waiting_for_;
-    // belief operation in waiting and not performed in last belief set upd counter
-    std::vector<int> belief_waiting_for_counter_;
-    
-    //add_belief publisher
-    rclcpp::Publisher<ros2_bdi_interfaces::msg::Belief>::SharedPtr add_belief_publisher_;
-    //del_belief publisher
-    rclcpp::Publisher<ros2_bdi_interfaces::msg::Belief>::SharedPtr del_belief_publisher_;
+    // handle check belief batch requests from other agents
+    rclcpp::Service<ros2_bdi_interfaces::srv::CheckBeliefBatch>::SharedPtr chk_belief_batch_server_;
+    // handle add belief batch requests from other agents
+    rclcpp::Service<ros2_bdi_interfaces::srv::UpdBeliefSetBatch>::SharedPtr add_belief_batch_server_;
+    // handle del belief batch requests from other agents
+    rclcpp::Service<ros2_bdi_interfaces::srv::UpdBeliefSetBatch>::SharedPtr del_belief_batch_server_;
+
+    // belief set write requests (to the belief manager) and their acknowledgements
+    rclcpp::Publisher<ros2_bdi_interfaces::msg::BeliefSetWrite>::SharedPtr belief_set_write_publisher_;
+    rclcpp::Subscription<ros2_bdi_interfaces::msg::WriteAck>::SharedPtr belief_set_write_ack_subscriber_;
 
     // handle check desire requests from other agents
     rclcpp::Service<ros2_bdi_interfaces::srv::CheckDesire>::SharedPtr chk_desire_server_;
@@ -202,18 +261,25 @@ private:
     // handle del desire requests from other agents
     rclcpp::Service<ros2_bdi_interfaces::srv::UpdDesireSet>::SharedPtr del_desire_server_;
     
-    // lock to put waiting for next desire set addition/deletion
-    std::mutex process_desire_set_upd_lock_;
-    std::vector<std::mutex> desire_set_upd_locks_;
-    // managed desire you're waiting for (to be added or deleted)
-    std::vector<BDIManaged::ManagedDesire> desire_waiting_for_;
-    // desire operation in waiting and not performed in last desire set upd counter
-    std::vector<int> desire_waiting_for_counter_;
-    
-    //add_desire publisher
-    rclcpp::Publisher<ros2_bdi_interfaces::msg::Desire>::SharedPtr add_desire_publisher_;
-    //del_desire publisher
-    rclcpp::Publisher<ros2_bdi_interfaces::msg::Desire>::SharedPtr del_desire_publisher_;
+    // handle check desire batch requests from other agents
+    rclcpp::Service<ros2_bdi_interfaces::srv::CheckDesireBatch>::SharedPtr chk_desire_batch_server_;
+    // handle add desire batch requests from other agents
+    rclcpp::Service<ros2_bdi_interfaces::srv::UpdDesireSetBatch>::SharedPtr add_desire_batch_server_;
+    // handle del desire batch requests from other agents
+    rclcpp::Service<ros2_bdi_interfaces::srv::UpdDesireSetBatch>::SharedPtr del_desire_batch_server_;
+
+    // desire set write requests (to the scheduler) and their acknowledgements
+    rclcpp::Publisher<ros2_bdi_interfaces::msg::DesireSetWrite>::SharedPtr desire_set_write_publisher_;
+    rclcpp::Subscription<ros2_bdi_interfaces::msg::WriteAck>::SharedPtr desire_set_write_ack_subscriber_;
+
+    // service handlers run here: they can wait for their write acknowledgement at the same time
+    rclcpp::callback_group::CallbackGroup::SharedPtr callback_group_srv_;
+    // writes waiting for their acknowledgement (request id -> ack to be delivered to the waiting handler)
+    std::map<uint64_t, std::shared_ptr<std::promise<ros2_bdi_interfaces::msg::WriteAck>>> pending_belief_writes_;
+    std::map<uint64_t, std::shared_ptr<std::promise<ros2_bdi_interfaces::msg::WriteAck>>> pending_desire_writes_;
+    std::mutex mtx_pending_writes_;
+    // id for the next write request
+    std::atomic<uint64_t> next_write_id_;
 
     // current known status of the system nodes
     std::map<std::string, uint8_t> lifecycle_status_;
@@ -227,4 +293,10 @@ private:
 
 };
 
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/ma_request_handler.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(MARequestHandler& node);
+
 #endif // MA_REQUEST_HANDLER_H_
\ No newline at end of file
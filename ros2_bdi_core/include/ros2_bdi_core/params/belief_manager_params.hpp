@@ -3,10 +3,30 @@
 
 /* Parameters affecting internal logic (recompiling required) */
 #define BELIEF_SET_TOPIC "belief_set"
+#define BELIEF_SET_DELTA_TOPIC "belief_set_delta"
+#define BELIEF_SET_REQUEST_TOPIC "belief_set_request"
 #define ADD_BELIEF_TOPIC "add_belief"
 #define ADD_BELIEF_SET_TOPIC "add_belief_set"
 #define DEL_BELIEF_SET_TOPIC "del_belief_set"
 #define DEL_BELIEF_TOPIC "del_belief"
+#define BELIEF_SET_WRITE_TOPIC "belief_set_write"
+#define BELIEF_SET_WRITE_ACK_TOPIC "belief_set_write_ack"
 #define INIT_BELIEF_SET_FILENAME "init_bset.yaml"
 
+// steps of the work loop between two full belief set snapshots (alterations are notified through belief set deltas)
+#define BELIEF_SET_KEYFRAME_STEPS 10
+
+/*  When incremental sync is active, steps of the work loop between two full re-scans of the PDDL problem
+    (safety net for external changes whose update notification has been mistaken for the echo of an own write)
+*/
+#define FULL_RESYNC_STEPS 120
+
+// ms after which an own write to the problem expert is dropped from the change log if its update notification has not arrived yet
+#define PSYS2_WRITE_ACK_TIMEOUT 2000
+
+/* ROS2 Parameter names for Belief Manager node */
+#define PARAM_INCREMENTAL_SYNC "incremental_sync"
+
+#define DEFAULT_VAL_INCREMENTAL_SYNC false
+
 #endif
\ No newline at end of file
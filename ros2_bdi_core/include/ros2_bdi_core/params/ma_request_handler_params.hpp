@@ -13,9 +13,19 @@
 #define ADD_DESIRE_SRV "add_desire_srv"
 #define DEL_DESIRE_SRV "del_desire_srv"
 
+// batch versions (several beliefs/desires within the same request)
+#define CK_BELIEF_BATCH_SRV "check_belief_batch_srv"
+#define ADD_BELIEF_BATCH_SRV "add_belief_batch_srv"
+#define DEL_BELIEF_BATCH_SRV "del_belief_batch_srv"
+
+#define CK_DESIRE_BATCH_SRV "check_desire_batch_srv"
+#define ADD_DESIRE_BATCH_SRV "add_desire_batch_srv"
+#define DEL_DESIRE_BATCH_SRV "del_desire_batch_srv"
+
 #define ADD_I 1
 #define DEL_I 0
-#define MAX_WAIT_UPD 4 // indicates number of belief/desire set notification to wait before considering a submitted upd request failed 
+#define WRITE_ACK_TIMEOUT 2000 // ms to wait for the acknowledgement of a submitted belief/desire set write before considering it failed
+#define MAX_CONCURRENT_WRITES 8 // writes waiting for their acknowledgement at the same time (one executor thread each)
 
 /* ROS2 Parameter names for PlanSys2Monitor node */
 #define PARAM_BELIEF_CHECK "belief_ck"
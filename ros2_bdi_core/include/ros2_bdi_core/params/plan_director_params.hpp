@@ -3,9 +3,9 @@
 
 /* Parameters affecting internal logic for Plan Director node (recompiling required) */
 #define NO_PLAN_INTERVAL 1000
-#define PLAN_INTERVAL 200
 
 #define PLAN_EXECUTION_SRV "plan_execution"
+#define PSYS2_EXECUTE_PLAN_ACTION "execute_plan"
 #define PLAN_EXECUTION_TOPIC "plan_execution_info"
 
 /* ROS2 Parameter names for Plan Director node */
@@ -9,6 +9,8 @@
 #define ADD_DESIRE_TOPIC "add_desire"
 #define BOOST_DESIRE_TOPIC "boost_desire"
 #define DEL_DESIRE_TOPIC "del_desire"
+#define DESIRE_SET_WRITE_TOPIC "desire_set_write"
+#define DESIRE_SET_WRITE_ACK_TOPIC "desire_set_write_ack"
 
 #define INIT_DESIRE_SET_FILENAME "init_dset.yaml"
 
@@ -18,18 +20,30 @@
 */
 #define COMPLETED_THRESHOLD 0.75 //TODO check in the future for a better value
 
+/*  In event driven scheduling, steps (500ms each) between two reschedulings not triggered by any event
+    (so that desires for which a plan could not be computed are retried anyway)
+*/
+#define EVENT_DRIVEN_FALLBACK_STEPS 10
+
 //seconds to wait before giving up on performing a request (service does not appear to be up)
 #define WAIT_SRV_UP 1   
 
 //seconds to wait before giving up on waiting for the response
 #define WAIT_RESPONSE_TIMEOUT 2
 
+//seconds to wait before giving up on waiting for a plan computed by the PlanSys2 planner
+#define WAIT_GET_PLAN_TIMEOUT 15
+
 /* ROS2 Parameter names for PlanSys2Monitor node */
 #define PARAM_MAX_TRIES_COMP_PLAN "comp_plan_tries"
 #define PARAM_MAX_TRIES_EXEC_PLAN "exec_plan_tries"
 #define PARAM_RESCHEDULE_POLICY "reschedule_policy"
 #define PARAM_AUTOSUBMIT_PREC "autosub_prec"
 #define PARAM_AUTOSUBMIT_CONTEXT "autosub_context"
+#define PARAM_PLANNING_WORKERS "planning_workers"
+#define PARAM_MAX_INTENTIONS "max_intentions"
+#define PARAM_EVENT_DRIVEN "event_driven_scheduling"
+#define PARAM_RESCHEDULE_DEBOUNCE "reschedule_debounce"
 
 
 #define CURR_INTENTIONS_TOPIC "current_intentions"
@@ -45,6 +59,9 @@
 #define JAVAFF_SEARCH_INTERVAL_PARAM_DEFAULT 500
 #define JAVAFF_SEARCH_MAX_EMPTY_SEARCH_INTERVALS_PARAM_DEFAULT 16
 
+#define PSYS2_GET_PLAN_SRV "planner/get_plan"
+#define PLANNER_WORKER_NODE_BASENAME "planner_worker_client_"
+
 #define PLAN_LIBRARY_NAME "plan_lib.db"
 
 #endif
\ No newline at end of file
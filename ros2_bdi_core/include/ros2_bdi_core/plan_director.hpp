@@ -13,10 +13,12 @@
 #include "plansys2_domain_expert/DomainExpertClient.hpp"
 #include "plansys2_problem_expert/ProblemExpertClient.hpp"
 #include "plansys2_executor/ExecutorClient.hpp"
+#include "plansys2_msgs/action/execute_plan.hpp"
 
 #include "ros2_bdi_interfaces/msg/lifecycle_status.hpp"
 #include "ros2_bdi_interfaces/msg/belief.hpp"
 #include "ros2_bdi_interfaces/msg/belief_set.hpp"
+#include "ros2_bdi_interfaces/msg/belief_set_delta.hpp"
 #include "ros2_bdi_interfaces/msg/desire.hpp"
 #include "ros2_bdi_interfaces/msg/planning_system_state.hpp"
 #include "ros2_bdi_interfaces/msg/bdi_action_execution_info.hpp"
@@ -25,22 +27,36 @@
 #include "ros2_bdi_interfaces/srv/bdi_plan_execution.hpp"
 #include "ros2_bdi_utils/ManagedBelief.hpp"
 #include "ros2_bdi_utils/ManagedPlan.hpp"
+#include "ros2_bdi_utils/BeliefSetMirror.hpp"
+#include "ros2_bdi_utils/PDDLMetadataCache.hpp"
 
 #include "ros2_bdi_core/params/core_common_params.hpp"
 #include "ros2_bdi_core/params/plan_director_params.hpp"
 #include "ros2_bdi_core/support/plansys_monitor_client.hpp"
 #include "ros2_bdi_core/support/planning_mode.hpp"
 
+#include "std_msgs/msg/empty.hpp"
 #include "rclcpp/rclcpp.hpp"
+#include "rclcpp_action/rclcpp_action.hpp"
 
 typedef enum {STARTING, READY, EXECUTING, PAUSE} StateType;      
 
+// last executor feedback applied to an action of the plan in execution
+typedef struct{
+    int8_t status;
+    int32_t status_sec;
+    uint32_t status_nanosec;
+    float completion;
+}ActionFeedbackStamp;
+
 class PlanDirector : public rclcpp::Node
 {
 public:
+    using ExecutePlan = plansys2_msgs::action::ExecutePlan;
+    using GoalHandleExecutePlan = rclcpp_action::ClientGoalHandle<ExecutePlan>;
   
     /* Constructor method */
-    PlanDirector();
+    PlanDirector(const rclcpp::NodeOptions& options = rclcpp::NodeOptions());
 
     /*
         Init to call at the start, after construction method, to get the node actually started
@@ -71,12 +87,7 @@ private:
     void setState(StateType state){ state_ = state;  }
 
     // clear info about current plan execution
-    void setNoPlanMsg(){ current_plan_ = BDIManaged::ManagedPlan{}; }
-
-    /*
-        Check planExecution feedback from plansys2 executor + check for context conditions
-    */
-    void executingPlan();
+    void setNoPlanMsg(){ current_plan_ = BDIManaged::ManagedPlan{}; intentions_.clear(); }
 
     /*
         When in READY state, msg to publish in plan_execution_info to notify it 
@@ -111,16 +122,19 @@ private:
     */
     void cancelCurrentPlanExecution();
 
-
     /*
-        Start new plan execution -> true if correctly started
+        Plan currently in execution, abort it if the executor appears down or has not streamed any feedback 
+        for more than N times the plan deadline (N ros2 parameter && >= 1.0)
     */
-    bool startPlanExecution(const BDIManaged::ManagedPlan& mp);
+    void checkExecutorAlive();
 
 
+    /*
+        Start new plan execution -> true if correctly started
+        (@concurrentPlans executed alongside @mp: all of them are merged into a single plan for the PlanSys2 executor)
+    */
+    bool startPlanExecution(const BDIManaged::ManagedPlan& mp, const std::vector<BDIManaged::ManagedPlan>& concurrentPlans);
 
-    // redefine workint timer interval
-    void resetWorkTimer(const int& ms);
 
     /*
         Return true if plan exec request is well formed 
@@ -139,9 +153,31 @@ private:
         const ros2_bdi_interfaces::srv::BDIPlanExecution::Response::SharedPtr response);
 
     /*
-        Plan currently in execution, monitor and publish the feedback of its development
+        Executor has accepted (@goalHandle) or rejected (nullptr) the execution of the plan identified by @planExecId
     */
-    void checkContextConditions();
+    void planGoalResponse(const uint64_t& planExecId, const GoalHandleExecutePlan::SharedPtr& goalHandle);
+
+    /*
+        Executor has streamed a feedback about the execution of the plan identified by @planExecId
+    */
+    void planFeedback(const uint64_t& planExecId, const ExecutePlan::Feedback& feedback);
+
+    /*
+        Executor has terminated the execution of the plan identified by @planExecId
+    */
+    void planResult(const uint64_t& planExecId, const GoalHandleExecutePlan::WrappedResult& result);
+
+    /*
+        Index the context condition clauses of the intentions in execution by the names of the beliefs they check
+        and evaluate all of them against the current belief set
+    */
+    void initContextMonitor();
+
+    /*
+        Plan currently in execution, re-evaluate the context condition clauses checking any of the altered beliefs
+        (all of them if @alteredBeliefs is empty) and abort the plan execution if they're not satisfied anymore
+    */
+    void checkContextConditions(const std::set<std::string>& alteredBeliefs = std::set<std::string>());
 
     /* 
         publish beliefs to be added and beliefs to be deleted as a consequence of plan abortion (rollback)
@@ -155,23 +191,47 @@ private:
     */
     void checkPlanExecution();
 
+    /*
+        Prepare the BDIPlanExecutionInfo of the plan just started (@planBody sent to the executor) and the index of its actions, 
+        so that executor feedback can then be applied to it in place
+    */
+    void initPlanExecutionInfo(const std::vector<plansys2_msgs::msg::PlanItem>& planBody);
+
+    /*
+        Map each action of the plan in execution to the index of its status within the executor feedback
+    */
+    void resolveFeedbackIndexes(const std::vector<plansys2_msgs::msg::ActionExecutionInfo>& actionsFeedback);
+
     /* 
-        Use PlanSys2 feedback received from the executor to build the BDIPlanExecutionInfo to be published to the respecive topic
+        Use PlanSys2 feedback received from the executor to update the BDIPlanExecutionInfo to be published to the respecive topic
         Call NECESSARY to update the properties regarding the status of the current monitored/managed plan exec.
     */
-    ros2_bdi_interfaces::msg::BDIPlanExecutionInfo getPlanExecutionInfo(const plansys2::ExecutorClient::ExecutePlan::Feedback& feedback);
+    const ros2_bdi_interfaces::msg::BDIPlanExecutionInfo& getPlanExecutionInfo(const ExecutePlan::Feedback& feedback);
+
+    /*
+        Split the execution info of the plan in execution into the ones of the intentions merged into it 
+        (just the ones not already notified as terminated)
+        Intentions aborted just because another one failed or had its context violated are marked as sibling aborts
+    */
+    std::vector<ros2_bdi_interfaces::msg::BDIPlanExecutionInfo> splitPlanExecutionInfo(
+        const ros2_bdi_interfaces::msg::BDIPlanExecutionInfo& planExecutionInfo);
 
 
     /*
     Retrieve from PlanSys2 Executor status info about current plan execution: RUNNING, SUCCESSFUL, ABORT
     */
-    int16_t getPlanExecutionStatus();
+    int16_t getPlanExecutionStatus(){ return plan_exec_status_; }
 
 
     /*
-        The belief set has been updated
+        The belief set has been updated (full snapshot)
     */
-    void updatedBeliefSet(const ros2_bdi_interfaces::msg::BeliefSet::SharedPtr msg);
+    void updatedBeliefSet(const ros2_bdi_interfaces::msg::BeliefSet::ConstSharedPtr msg);
+
+    /*
+        The belief set has been updated (delta wrt. previous version)
+    */
+    void updatedBeliefSetDelta(const ros2_bdi_interfaces::msg::BeliefSetDelta::ConstSharedPtr msg);
 
     // internal state of the node
     StateType state_;
@@ -191,10 +251,20 @@ private:
     int psys2_comm_errors_;
     // domain expert client contacting psys2 for checking validity of a plan
     std::shared_ptr<plansys2::DomainExpertClient> domain_expert_client_;
-    // problem expert client contacting psys2 for checking validity of a plan
-    std::shared_ptr<plansys2::ProblemExpertClient> problem_expert_client_;
-    // executor client contacting psys2 for the execution of a plan, then receiving feedback for it 
+    // durative action schemas (retrieved through domain_expert_client_) and instances (mirrored from the belief set) for checking validity of a plan
+    BDIManaged::PDDLMetadataCache pddl_metadata_;
+    // executor client contacting psys2 for early arrest requests
     std::shared_ptr<plansys2::ExecutorClient> executor_client_;
+    // action client contacting psys2 executor for the execution of a plan, then receiving the stream of feedback for it
+    rclcpp_action::Client<ExecutePlan>::SharedPtr execute_plan_client_;
+    // goal handle of the plan in execution (nullptr until the executor accepts it)
+    GoalHandleExecutePlan::SharedPtr plan_goal_handle_;
+    // id of the last plan execution started (responses, feedback and results of previous ones are ignored)
+    uint64_t plan_exec_id_;
+    // last feedback received from the executor for the plan in execution
+    ExecutePlan::Feedback plan_feedback_;
+    // status of the plan in execution: RUNNING until the executor rejects it or notifies its result
+    int16_t plan_exec_status_;
 
     // flag to denote if plansys2 domain expert appears to be active
     bool psys2_domain_expert_active_;
@@ -207,17 +277,46 @@ private:
 
     // current_plan_ in execution (could be none if the agent isn't doing anything)
     BDIManaged::ManagedPlan current_plan_;
+    // intentions executed through current_plan_ (just current_plan_ itself, unless several plans are executed concurrently)
+    std::vector<BDIManaged::ManagedPlan> intentions_;
+    // intentions already notified as terminated
+    std::vector<bool> intention_terminated_;
+    // intention whose context conditions are not satisfied anymore, causing the abortion of current_plan_ (-1 if none)
+    int context_violated_intention_;
+    // for each action in current_plan_, index of the intention it belongs to and its index within that intention
+    std::vector<int> action_intention_;
+    std::vector<int> action_intention_index_;
     // # checks performed during the current plan exec
     int counter_check_;
+    // execution info of current_plan_, updated in place upon executor feedback
+    ros2_bdi_interfaces::msg::BDIPlanExecutionInfo plan_exec_info_;
+    // for each action in current_plan_ (in order), its full name as reported by the executor, i.e. "(a1 p1 p2 p3):timex1000"
+    std::vector<std::string> action_full_names_;
+    // index within current_plan_ of each action by full name
+    std::map<std::string, int> action_plan_index_;
+    // for each action in current_plan_, index of its status within the executor feedback (-1 if not reported)
+    std::vector<int> action_feedback_index_;
+    // # action statuses within the executor feedback for which action_feedback_index_ has been resolved
+    int feedback_size_;
+    // for each action in current_plan_, last executor feedback applied to it
+    std::vector<ActionFeedbackStamp> action_feedback_stamp_;
+    // for each intention, satisfaction of its context condition clauses against the belief set mirror
+    std::vector<std::vector<bool>> context_clauses_satisfied_;
+    // for each intention, indexes of its context condition clauses checking a belief (by name; "" for instances named by a placeholder
+    // and names with wild chars, i.e. clauses checked upon any alteration)
+    std::vector<std::map<std::string, std::vector<int>>> context_clauses_by_belief_;
     // time at which plan started (NOT DOING this anymore -> using first start_ts from first action executed in plan)
     //high_resolution_clock::time_point current_plan_start_;
     // msg to notify the idle-ready state, i.e. no current plan execution, but ready to do it
     ros2_bdi_interfaces::msg::BDIPlanExecutionInfo no_plan_msg_;
 
-    // current belief set (in order to check precondition && context condition)
-    std::set<BDIManaged::ManagedBelief> belief_set_;
-    // belief set subscriber
+    // current belief set mirror (in order to check precondition && context condition)
+    BDIManaged::BeliefSetMirror belief_set_mirror_;
+    // belief set subscribers
     rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSet>::SharedPtr belief_set_subscriber_;//belief set sub.
+    rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSetDelta>::SharedPtr belief_set_delta_subscriber_;//belief set delta sub.
+    // request belief set snapshot (mirror out of sync)
+    rclcpp::Publisher<std_msgs::msg::Empty>::SharedPtr belief_set_request_publisher_;
     // belief add publisher
     rclcpp::Publisher<ros2_bdi_interfaces::msg::Belief>::SharedPtr belief_add_publisher_;
     // belief del publisher
@@ -226,8 +325,11 @@ private:
     // record first timestamp in sec of the current plan execution (to subtract from it)
     int first_ts_plan_sec_;
     unsigned int first_ts_plan_nanosec_;
-    // last recorded timestamp during plan execution
+    // last recorded timestamp during plan execution and wall time at which it has been recorded
     float last_ts_plan_exec_;
+    std::chrono::high_resolution_clock::time_point last_ts_plan_exec_check_;
+    // wall time at which the last executor feedback for the current plan execution has been received (or it has been started)
+    std::chrono::high_resolution_clock::time_point last_plan_feedback_;
 
     // notification about the current plan execution -> plan execution info publisher
     rclcpp::Publisher<ros2_bdi_interfaces::msg::BDIPlanExecutionInfo>::SharedPtr plan_exec_publisher_;
@@ -247,4 +349,10 @@ private:
 
 }; // PlanDirector class prototype
 
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/plan_director.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(PlanDirector& node);
+
 #endif // PLAN_DIRECTOR
\ No newline at end of file
@@ -18,7 +18,7 @@ class PlanSysMonitor : public rclcpp::Node
     public:
 
         /* Constructor method */
-        PlanSysMonitor();
+        PlanSysMonitor(const rclcpp::NodeOptions& options = rclcpp::NodeOptions());
 
         /*
             Init to call at the start, after construction method, to get the node actually started
@@ -92,4 +92,10 @@ class PlanSysMonitor : public rclcpp::Node
 
 }; // PlanSys2Monitor class prototype
 
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/plansys_monitor.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(PlanSysMonitor& node);
+
 #endif // PLANSYS_MONITOR_H_
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <optional>
 #include <mutex>
 #include <vector>
+#include <functional>
 #include <set>   
 #include <map>   
 
@@ -14,7 +15,10 @@
 #include "ros2_bdi_interfaces/msg/belief.hpp"
 #include "ros2_bdi_interfaces/msg/desire.hpp"
 #include "ros2_bdi_interfaces/msg/belief_set.hpp"
+#include "ros2_bdi_interfaces/msg/belief_set_delta.hpp"
 #include "ros2_bdi_interfaces/msg/desire_set.hpp"
+#include "ros2_bdi_interfaces/msg/desire_set_write.hpp"
+#include "ros2_bdi_interfaces/msg/write_ack.hpp"
 #include "ros2_bdi_interfaces/msg/condition.hpp"
 #include "ros2_bdi_interfaces/msg/conditions_conjunction.hpp"
 #include "ros2_bdi_interfaces/msg/conditions_dnf.hpp"
@@ -27,7 +31,11 @@
 
 #include "ros2_bdi_utils/ManagedBelief.hpp"
 #include "ros2_bdi_utils/ManagedDesire.hpp"
+#include "ros2_bdi_utils/WildPattern.hpp"
 #include "ros2_bdi_utils/ManagedPlan.hpp"
+#include "ros2_bdi_utils/BeliefSetMirror.hpp"
+#include "ros2_bdi_utils/BDIPlanLibrary.hpp"
+#include "ros2_bdi_utils/PDDLMetadataCache.hpp"
 
 #include "ros2_bdi_core/params/core_common_params.hpp"
 #include "ros2_bdi_core/params/scheduler_params.hpp"
@@ -37,6 +45,7 @@
 #include "ros2_bdi_core/support/planning_mode.hpp"
 #include "ros2_bdi_core/support/trigger_plan_client.hpp"
 
+#include "std_msgs/msg/empty.hpp"
 #include "rclcpp/rclcpp.hpp"
 
 typedef enum {STARTING, SCHEDULING, PAUSE} StateType;          
@@ -47,7 +56,7 @@ typedef enum {ADD_GOAL_BELIEFS, DEL_GOAL_BELIEFS} GoalBeliefOp;
 class Scheduler : public rclcpp::Node
 {
 public:
-    Scheduler();
+    Scheduler(const rclcpp::NodeOptions& options = rclcpp::NodeOptions());
 
     /*
         Init to call at the start, after construction method, to get the node actually started
@@ -93,6 +102,23 @@ protected:
     */
     virtual void reschedule() = 0;
 
+    /*
+        Something relevant for the scheduling has happened: reschedule right away in polling mode,
+        otherwise within PARAM_RESCHEDULE_DEBOUNCE ms, coalescing further requests in between into a single rescheduling
+    */
+    void requestReschedule();
+
+    /*
+        Debounce interval elapsed after a reschedule request: perform the rescheduling
+    */
+    void debouncedReschedule();
+
+    /*
+        Return true if some of @beliefs is referenced by a desire in the desire set (in its value, precondition or context),
+        either by name or by a name with wild chars/placeholder matching it
+    */
+    bool referencedByDesires(const std::vector<ros2_bdi_interfaces::msg::Belief>& beliefs);
+
     /*  Use the updated belief set for deciding if some desires are pointless to pursue given the current 
         beliefs which shows they're already fulfilled
     */
@@ -103,6 +129,12 @@ protected:
     */
     virtual void updatePlanExecution(const ros2_bdi_interfaces::msg::BDIPlanExecutionInfo::SharedPtr msg) = 0;
 
+    /*
+        PlanSys2 domain expert gone down: drop whatever has been derived from the domain, 
+        so that it is retrieved again once the domain expert is back
+    */
+    virtual void invalidateDomain();
+
 
     /*  
         Change internal state of the node
@@ -118,20 +150,33 @@ protected:
     /*
         If selected plan fit the minimal requirements for a plan (i.e. not empty body and a desire which is in the desire_set)
         try triggering its execution by srv request to PlanDirector (/{agent}/plan_execution)
+        (aborting first the plan in execution, if the reschedule policy allows it);
+        @onTriggered is called with the outcome without blocking the caller
     */
-    bool tryTriggerPlanExecution(const BDIManaged::ManagedPlan& selectedPlan);
+    void tryTriggerPlanExecution(const BDIManaged::ManagedPlan& selectedPlan, const std::function<void(bool)>& onTriggered,
+        const std::vector<BDIManaged::ManagedPlan>& concurrentPlans = std::vector<BDIManaged::ManagedPlan>());
 
     /*
-        Launch execution of selectedPlan; if successful waiting_plans_.access() gets value of selectedPlan
-        return true if successful
+        Launch execution of selectedPlan (alongside concurrentPlans, if any); if successful current_plan_ gets value of selectedPlan
+        and concurrent_plans_ the value of concurrentPlans
+        The request is served without blocking: @onTriggered is called with the outcome once the plan director answers
+        (reschedulings are held in the meantime)
     */
-    bool launchPlanExecution(const BDIManaged::ManagedPlan& selectedPlan);
+    void launchPlanExecution(const BDIManaged::ManagedPlan& selectedPlan, 
+        const std::vector<BDIManaged::ManagedPlan>& concurrentPlans, const std::function<void(bool)>& onTriggered);
     
     /*
-        Abort execution of first waiting_plans_; if successful waiting_plans_ first element is popped
-        return true if successful
+        Abort execution of current plan; if successful current plan (and the ones executed concurrently with it) are dropped
+        The request is served without blocking: @onAborted is called with the outcome once the plan director answers
+        (reschedulings are held in the meantime)
     */
-    bool abortCurrentPlanExecution();
+    void abortCurrentPlanExecution(const std::function<void(bool)>& onAborted = [](bool){});
+
+    /*
+        A trigger/abort request toward the plan director (or a search request toward JavaFF) has been answered: 
+        perform the reschedulings held in the meantime
+    */
+    void planExecRequestDone();
 
     /*
         Check if there is a current valid plan selected
@@ -142,6 +187,17 @@ protected:
     }
 
 
+    /*
+        Desire @md is the target of a plan executed concurrently with current_plan_
+    */
+    bool pursuedConcurrently(const BDIManaged::ManagedDesire& md)
+    {
+        for(const BDIManaged::ManagedPlan& mp : concurrent_plans_)
+            if(mp.getFinalTarget() == md)
+                return true;
+        return false;
+    }
+
     /*Build updated ros2_bdi_interfaces::msg::LifecycleStatus msg*/
     ros2_bdi_interfaces::msg::LifecycleStatus getLifecycleStatus();
 
@@ -180,9 +236,17 @@ protected:
     TargetBeliefAcceptance desireAcceptanceCheck(const BDIManaged::ManagedDesire& md);
 
     /*
-        Publish target goal info to belief set
+        Publish target goal info of @mp to belief set
+    */
+    void publishTargetGoalInfo(const GoalBeliefOp& op, const BDIManaged::ManagedPlan& mp);
+
+    /*
+        Publish target goal info of current plan to belief set
     */
-    void publishTargetGoalInfo(const GoalBeliefOp& op);
+    void publishTargetGoalInfo(const GoalBeliefOp& op)
+    {
+        publishTargetGoalInfo(op, current_plan_);
+    }
 
     /*
         Given the current knowledge of the belief set, decide if a given desire
@@ -191,9 +255,46 @@ protected:
     bool isDesireSatisfied(BDIManaged::ManagedDesire& md);
 
     /*
-        The belief set has been updated
+        Store in the plan library a plan which has been executed successfully (plan lib id of @mp set accordingly)
+    */
+    void storeExecutedPlan(BDIManaged::ManagedPlan& mp);
+
+    /*
+        Retrieve from the plan library the stored plan (earliest deadline first) for the same target and preconditions of @md
+        which is applicable given the current belief set and has not been discarded after an aborted execution
+    */
+    std::optional<BDIManaged::ManagedPlan> retrieveStoredPlan(const BDIManaged::ManagedDesire& md);
+
+    /*
+        Fast applicability check of a stored plan wrt. the current belief set:
+        preconditions of its target hold, every arg of its actions is a known instance
+        and the at start/over all requirements of its first actions (i.e. the ones starting right away) are not violated
+        (requirements of the following actions are still checked by the executor at runtime)
+    */
+    bool storedPlanApplicable(const BDIManaged::ManagedPlan& mp);
+
+    /*
+        False if an at start or over all requirement of the durative action @actionName grounded with @args is violated 
+        by the current belief set: just (negated) predicates within conjunctions are checked, 
+        anything else (disjunctions, numeric expressions) is deemed satisfiable
+    */
+    bool actionRequirementsSatisfiable(const std::string& actionName, const std::vector<std::string>& args);
+
+    /*
+        The belief set has been updated (full snapshot)
+    */
+    void updatedBeliefSet(const ros2_bdi_interfaces::msg::BeliefSet::ConstSharedPtr msg);
+
+    /*
+        The belief set has been updated (delta wrt. previous version)
+    */
+    void updatedBeliefSetDelta(const ros2_bdi_interfaces::msg::BeliefSetDelta::ConstSharedPtr msg);
+
+    /*
+        The mirrored belief set has been altered: check for satisfied desires and reschedule 
+        (just if @relevantForDesires in event driven mode)
     */
-    void updatedBeliefSet(const ros2_bdi_interfaces::msg::BeliefSet::SharedPtr msg);
+    void alteredBeliefSet(const bool& relevantForDesires);
 
     /*  
         Someone has publish a new desire to be fulfilled in the respective topic
@@ -206,6 +307,12 @@ protected:
     */
     void delDesireTopicCallBack(const ros2_bdi_interfaces::msg::Desire::SharedPtr msg);
 
+    /*  
+        Someone has requested a desire set write: apply it and acknowledge it 
+        with the same request id and the resulting desire set version
+    */
+    void desireSetWriteTopicCallBack(const ros2_bdi_interfaces::msg::DesireSetWrite::SharedPtr msg);
+
     /*
         Wrapper for calling addDesire with just desire to added (where not linked to any other desires)
         N.B see addDesire(const ManagedDesire mdAdd, const optional<ManagedDesire> necessaryForMd)
@@ -253,6 +360,7 @@ protected:
             {
                 desire_set_.erase(mdOriginal);
                 desire_set_.insert(mdNew);
+                desire_set_version_++;
             }
         }
         mtx_add_del_.unlock();
@@ -318,12 +426,30 @@ protected:
 
     // current_plan in execution
     BDIManaged::ManagedPlan current_plan_;
+    // plans in execution concurrently with current_plan_ (multi-intention execution)
+    std::vector<BDIManaged::ManagedPlan> concurrent_plans_;
     
     // agent id that defines the namespace in which the node operates
     std::string agent_id_;
     // callback to perform main loop of work regularly
     rclcpp::TimerBase::SharedPtr do_work_timer_;
 
+    // reschedule upon relevant events (desire set, referenced beliefs, plan status, planner availability) instead of at every step
+    bool event_driven_;
+    // a rescheduling has been requested and is waiting for the debounce interval to elapse
+    bool reschedule_pending_;
+    // a trigger/abort request toward the plan director (or a search request toward JavaFF) is waiting for its answer
+    bool plan_exec_request_pending_;
+    // a rescheduling has been requested meanwhile: performed as the answer comes
+    bool reschedule_held_;
+    // one-shot timer firing the debounced rescheduling (event driven mode)
+    rclcpp::TimerBase::SharedPtr reschedule_timer_;
+    // names of the beliefs referenced by the desire set at version referenced_beliefs_version_
+    std::set<std::string> referenced_beliefs_;
+    // patterns of the names with wild chars (or placeholders) referenced by the desire set at version referenced_beliefs_version_
+    std::vector<BDIManaged::WildPattern> referenced_patterns_;
+    uint64_t referenced_beliefs_version_;
+
     // counter of communication errors with plansys2
     int psys2_comm_errors_;
     // problem expert instance to call the plansys2 problem expert api
@@ -347,9 +473,19 @@ protected:
     
     // desire set has been init. (or at least the process to do so has been tried)
     bool init_dset_;
+    // version of the desire set, increased by every alteration of it
+    uint64_t desire_set_version_;
+
+    // mirror of the belief set of the agent <agent_id_>
+    BDIManaged::BeliefSetMirror belief_set_mirror_;
+    // domain schemas and instances (mirrored from the belief set) to check desires without querying plansys2
+    BDIManaged::PDDLMetadataCache pddl_metadata_;
 
-    // belief set of the agent <agent_id_>
-    std::set<BDIManaged::ManagedBelief> belief_set_;
+    //Plan library db utility (long-lived connection, closed when the node is destroyed)
+    std::shared_ptr<PlanLibrary::BDIPlanLibrary> planlib_db_;
+    bool planlib_conn_ok_;
+    // stored plans (by plan lib id) whose execution has been aborted: not retrieved anymore
+    std::set<int> discarded_stored_plans_;
 
     // desire set of the agent <agent_id_>
     std::set<BDIManaged::ManagedDesire> desire_set_;
@@ -383,13 +519,17 @@ protected:
     rclcpp::Subscription<ros2_bdi_interfaces::msg::Desire>::SharedPtr add_desire_subscriber_;//add desire notify on topic
     rclcpp::Subscription<ros2_bdi_interfaces::msg::Desire>::SharedPtr del_desire_subscriber_;//del desire notify on topic
     rclcpp::Publisher<ros2_bdi_interfaces::msg::DesireSet>::SharedPtr desire_set_publisher_;//desire set publisher
+    rclcpp::Subscription<ros2_bdi_interfaces::msg::DesireSetWrite>::SharedPtr desire_set_write_subscriber_;//acknowledged desire set writes
+    rclcpp::Publisher<ros2_bdi_interfaces::msg::WriteAck>::SharedPtr desire_set_write_ack_publisher_;//desire set writes acknowledgements
 
     // belief set publisher (to publish info wrt. currently active desire)
     rclcpp::Publisher<ros2_bdi_interfaces::msg::Belief>::SharedPtr add_belief_publisher_;//add belief publisher
     rclcpp::Publisher<ros2_bdi_interfaces::msg::Belief>::SharedPtr del_belief_publisher_;//del belief publisher
 
-    // belief set subscriber
+    // belief set subscribers
     rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSet>::SharedPtr belief_set_subscriber_;//belief set sub.
+    rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSetDelta>::SharedPtr belief_set_delta_subscriber_;//belief set delta sub.
+    rclcpp::Publisher<std_msgs::msg::Empty>::SharedPtr belief_set_request_publisher_;//request belief set snapshot (mirror out of sync)
 
     // plan executioninfo subscriber
     rclcpp::Subscription<ros2_bdi_interfaces::msg::BDIPlanExecutionInfo>::SharedPtr plan_exec_info_subscriber_;//plan execution info publisher
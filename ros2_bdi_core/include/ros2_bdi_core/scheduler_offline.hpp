@@ -1,15 +1,30 @@
 #ifndef SCHEDULER_OFFLINE_H_
 #define SCHEDULER_OFFLINE_H_
 
+#include <map>
+#include <vector>
+#include <memory>
+
 #include "ros2_bdi_core/scheduler.hpp"
+#include "ros2_bdi_core/support/planner_worker_client.hpp"
+
+#include "ros2_bdi_utils/PDDLUtils.hpp"
 
 #include "rclcpp/rclcpp.hpp"
 
+/* plan (or its absence) computed for a goal, given the fingerprint of the beliefs relevant for it at that time 
+   (plan lib id of the plan, if retrieved from the plan library, -1 otherwise) */
+typedef struct{
+    uint64_t fingerprint;
+    std::optional<plansys2_msgs::msg::Plan> plan;
+    int planlib_id;
+}PlanCacheEntry;
+
 
 class SchedulerOffline : public Scheduler
 {
 public:
-    SchedulerOffline() : Scheduler() {};
+    SchedulerOffline(const rclcpp::NodeOptions& options = rclcpp::NodeOptions()) : Scheduler(options) {};
 
     void init() override;
 
@@ -29,20 +44,59 @@ protected:
     */
     void checkForSatisfiedDesires();
 
+    /*
+        PlanSys2 domain expert gone down: drop the domain actions dependencies and the plans computed against the domain too
+    */
+    void invalidateDomain() override;
+
 
 private:
 
     /*
         Compute plan from managed desire, setting its belief array representing the desirable state to reach
         as the goal of the PDDL problem 
+        (served from the plan cache if nothing relevant for the goal has changed since it was last computed,
+        otherwise from the plan library if an applicable plan has been stored for it)
     */
     std::optional<plansys2_msgs::msg::Plan> computePlan(const BDIManaged::ManagedDesire& md);
 
+    /*
+        Compute plans for all the given desires concurrently through the planner workers:
+        domain and problem are retrieved once and each desire gets its own goal specific copy of the problem
+        (the goal of the problem expert is left untouched)
+        (plans still valid in the plan cache or applicable ones stored in the plan library are not computed again)
+        n.b. still blocking: the caller waits for all the workers to be done (each get_plan request up to WAIT_GET_PLAN_TIMEOUT s)
+    */
+    std::map<BDIManaged::ManagedDesire, std::optional<plansys2_msgs::msg::Plan>> computePlans(const std::vector<BDIManaged::ManagedDesire>& candidates);
+
+    /*
+        Fingerprint of the beliefs which can affect planning for the desire: all the instances plus the predicates/functions
+        within the relevance cone of its goal (i.e. the ones read by the domain actions which might lead to it)
+    */
+    uint64_t relevantBeliefsFingerprint(const BDIManaged::ManagedDesire& md);
+
+    /*
+        Plan lib id of the plan currently cached for the goal of @md (-1 if not retrieved from the plan library)
+    */
+    int cachedPlanLibID(const BDIManaged::ManagedDesire& md);
+
+    /*
+        Drop the cached plans for goals not pursued by any desire anymore
+    */
+    void prunePlanCache();
+
     /*
         Select plan execution based on precondition, deadline
     */
     void reschedule();
 
+    /*
+        Among @feasiblePlans, select (by priority, then deadline) up to @maxPlans plans to be executed concurrently with @selectedPlan:
+        each of them targets a desire of another group and shares no action/instance with @selectedPlan and with the other ones
+    */
+    std::vector<BDIManaged::ManagedPlan> selectConcurrentPlans(const BDIManaged::ManagedPlan& selectedPlan, 
+        std::vector<BDIManaged::ManagedPlan> feasiblePlans, const int& maxPlans);
+
     void publishCurrentIntention();
     
     /*
@@ -50,11 +104,32 @@ private:
     */
     void updatePlanExecution(const ros2_bdi_interfaces::msg::BDIPlanExecutionInfo::SharedPtr msg);
 
+    /*
+        Execution of @mp (current plan or one executed concurrently with it) has terminated as reported by @planExecInfo:
+        remove its target desire if achieved, otherwise count the abortion (and possibly auto-submit its context conditions)
+    */
+    void intentionTerminated(const ros2_bdi_interfaces::msg::BDIPlanExecutionInfo& planExecInfo, const BDIManaged::ManagedPlan& mp);
+
     /*
         wrt the current plan execution...
         return sum of progress status of all actions within a plan divided by the number of actions
     */
     float computePlanProgressStatus();
+
+    // planner clients used by computePlans, one per concurrent planning request (each one spinning its own uniquely named node)
+    std::vector<std::shared_ptr<PlannerWorkerClient>> planner_workers_;
+
+    // predicates/functions read and written by the domain actions (retrieved at first use)
+    std::optional<std::vector<PDDLUtils::PDDLActionDependencies>> domain_actions_;
+    // plans computed so far by goal, valid as long as the fingerprint of the relevant beliefs is the same
+    // (failed computations are not cached: the planner client cannot tell a timeout/error apart from an unfeasible goal)
+    std::map<std::string, PlanCacheEntry> plan_cache_;
 };
 
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/scheduler_offline.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(SchedulerOffline& node);
+
 #endif // SCHEDULER_OFFLINE_H_
\ No newline at end of file
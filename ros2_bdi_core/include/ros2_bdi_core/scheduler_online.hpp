@@ -8,8 +8,6 @@
 #include "javaff_interfaces/msg/search_result.hpp"
 #include "javaff_interfaces/msg/execution_status.hpp"
 
-#include "ros2_bdi_utils/BDIPlanLibrary.hpp"
-
 #include "rclcpp/rclcpp.hpp"
 
 #include "plansys2_executor/ExecutorClient.hpp"
@@ -18,8 +16,7 @@
 class SchedulerOnline : public Scheduler
 {
 public:
-    SchedulerOnline() : Scheduler(), 
-        planlib_db_(PlanLibrary::BDIPlanLibrary{"/tmp/"+agent_id_+"/"+PLAN_LIBRARY_NAME}){};
+    SchedulerOnline(const rclcpp::NodeOptions& options = rclcpp::NodeOptions()) : Scheduler(options) {};
 
     void init() override;
 
@@ -105,7 +102,10 @@ private:
 
     void publishCurrentIntention();
 
-    /* Launch first partial plan execution of a queue of plans which are going to be stored in the waiting list, waiting for their turn */
+    /* 
+        Launch first partial plan execution of a queue of plans which are going to be stored in the waiting list, waiting for their turn
+        (return true if the execution has been requested, its failure is handled once the plan director answers by rescheduling from scratch)
+    */
     bool launchFirstPPlanExecution(const javaff_interfaces::msg::PartialPlan& firstpplan);
 
     /*
@@ -144,6 +144,19 @@ private:
         Init all info related to current desire in pursuit & plan to fulfill it
     */
     void resetSearchInfo();
+
+    /*
+        Continuation for the abortion of the current plan: if aborted, init all info related to current desire in pursuit
+        (unless a new one has been picked in the meantime)
+    */
+    std::function<void(bool)> resetSearchInfoOnAbort();
+
+    /*
+        Current plan could not go on: drop it along with the waiting ones and ask JavaFF to search again from the current state
+        (reschedule from scratch if the unexpected state srv call fails)
+        The request is served without blocking: reschedulings are held until JavaFF answers
+    */
+    void handleUnexpectedState();
     
     /*
         wrt the current plan execution...
@@ -178,10 +191,11 @@ private:
     void processIncrementalSearchResult(const javaff_interfaces::msg::SearchResult::SharedPtr msg);
 
     /*
-        Process updated search result presenting a new search baseline compared to previous msgs of the same type
-        returns true if new baseline and search results are accepted (i.e. not too late)
+        Process updated search result presenting a new search baseline compared to previous msgs of the same type:
+        new baseline and search results are taken (i.e. waiting queue and search baseline replaced) just if accepted,
+        i.e. not too late (the early arrest request for the current plan is answered without blocking)
     */
-    bool processSearchResultWithNewBaseline(const javaff_interfaces::msg::SearchResult::SharedPtr msg);
+    void processSearchResultWithNewBaseline(const javaff_interfaces::msg::SearchResult::SharedPtr msg);
 
     /*
         Process desire boost request for active goal augmentation
@@ -190,8 +204,10 @@ private:
 
     /*
         Call JavaFF for triggering the search for a plan fulfilling @selDesire
+        The request is served without blocking: @onLaunched is called with the outcome once JavaFF answers
+        (reschedulings are held in the meantime)
     */
-    bool launchPlanSearch(const BDIManaged::ManagedDesire& selDesire);
+    void launchPlanSearch(const BDIManaged::ManagedDesire& selDesire, const std::function<void(bool)>& onLaunched);
 
     /* build empty search baseline method */
     javaff_interfaces::msg::CommittedStatus emptySearchBaseline()
@@ -237,12 +253,14 @@ private:
     // Client to wrap srv call to JavaFFServer
     std::shared_ptr<JavaFFClient> javaff_client_;
 
-    //Plan library db utility (just used in online for now: put it here, so we can close connection in bringdown)
-    PlanLibrary::BDIPlanLibrary planlib_db_;
-    bool planlib_conn_ok_;
-
     // Index of executing partial plan in the queue of executions for current global target in fulfillment 
     int executing_pplan_index_;
 };
 
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/scheduler_online.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(SchedulerOnline& node);
+
 #endif // SCHEDULER_ONLINE_H_
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef ASYNC_SRV_REQUEST_H_
+#define ASYNC_SRV_REQUEST_H_
+
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <functional>
+
+#include "rclcpp/rclcpp.hpp"
+
+// period (ms) of the readiness checks for requests held until their service is available
+#define ASYNC_SRV_READY_POLL_MS 50
+
+/*
+    Interfaces of the node whose executor serves asynchronous service requests
+    (clients are created on it, responses and timeouts are delivered by the executor spinning it)
+*/
+typedef struct{
+    rclcpp::node_interfaces::NodeBaseInterface::SharedPtr base;
+    rclcpp::node_interfaces::NodeGraphInterface::SharedPtr graph;
+    rclcpp::node_interfaces::NodeServicesInterface::SharedPtr services;
+    rclcpp::node_interfaces::NodeTimersInterface::SharedPtr timers;
+}AsyncSrvHost;
+
+/*
+    Build the AsyncSrvHost for @node (either a rclcpp::Node or a rclcpp_lifecycle::LifecycleNode)
+*/
+template<typename NodeT>
+AsyncSrvHost asyncSrvHost(NodeT* node)
+{
+    return AsyncSrvHost{node->get_node_base_interface(), node->get_node_graph_interface(),
+        node->get_node_services_interface(), node->get_node_timers_interface()};
+}
+
+/*
+    Create a client for @serviceName on the host node
+*/
+template<typename ServiceT>
+typename rclcpp::Client<ServiceT>::SharedPtr createAsyncSrvClient(const AsyncSrvHost& host, const std::string& serviceName)
+{
+    return rclcpp::create_client<ServiceT>(host.base, host.graph, host.services, serviceName, rmw_qos_profile_services_default, nullptr);
+}
+
+/*
+    Create a wall timer calling @callback every @period within the host node executor
+*/
+inline rclcpp::TimerBase::SharedPtr createAsyncSrvTimer(const AsyncSrvHost& host, const std::chrono::milliseconds& period,
+    std::function<void()> callback)
+{
+    auto timer = rclcpp::WallTimer<std::function<void()>>::make_shared(period, std::move(callback), host.base->get_context());
+    host.timers->add_timer(timer, nullptr);
+    return timer;
+}
+
+/*
+    Send @request through @client without blocking the caller:
+    @onResponse is called within the host node executor with the response,
+    or with nullptr if no response comes within @timeout.
+    If the service is not available yet (e.g. client just created, discovery still in progress),
+    the request is held and sent as soon as it is, within the same @timeout
+*/
+template<typename ServiceT>
+void asyncSrvRequest(const AsyncSrvHost& host, const typename rclcpp::Client<ServiceT>::SharedPtr& client,
+    const typename ServiceT::Request::SharedPtr& request,
+    const std::function<void(typename ServiceT::Response::SharedPtr)>& onResponse, const std::chrono::milliseconds& timeout)
+{
+    // shared between response, readiness poll and timeout callbacks: whichever comes first answers and releases the others
+    // (the client is kept alive until then, so that one created just for this request can be dropped by the caller)
+    typedef struct{
+        std::mutex mtx;
+        bool done;
+        bool sent;
+        rclcpp::TimerBase::SharedPtr timer;
+        rclcpp::TimerBase::SharedPtr poll_timer;
+        typename rclcpp::Client<ServiceT>::SharedPtr client;
+    }PendingRequest;
+
+    auto pending = std::make_shared<PendingRequest>();
+    pending->done = false;
+    pending->sent = false;
+    pending->client = client;
+
+    // returns true just for the first caller
+    auto complete = [pending]()
+    {
+        std::lock_guard<std::mutex> lock(pending->mtx);
+        if(pending->done)
+            return false;
+        pending->done = true;
+        if(pending->timer)
+            pending->timer->cancel();
+        if(pending->poll_timer)
+            pending->poll_timer->cancel();
+        pending->timer.reset();
+        pending->poll_timer.reset();
+        pending->client.reset();
+        return true;
+    };
+
+    // send the request once (false if already answered or sent)
+    auto send = [pending, request, complete, onResponse]()
+    {
+        typename rclcpp::Client<ServiceT>::SharedPtr sending_client;
+        {
+            std::lock_guard<std::mutex> lock(pending->mtx);
+            if(pending->done || pending->sent)
+                return;
+            pending->sent = true;
+            if(pending->poll_timer)
+                pending->poll_timer->cancel();
+            pending->poll_timer.reset();
+            sending_client = pending->client;
+        }
+
+        sending_client->async_send_request(request, [complete, onResponse](typename rclcpp::Client<ServiceT>::SharedFuture future)
+        {
+            if(complete())
+                onResponse(future.get());
+        });
+    };
+
+    std::function<void()> onTimeout = [complete, onResponse]()
+    {
+        if(complete())
+            onResponse(nullptr);
+    };
+    {
+        std::lock_guard<std::mutex> lock(pending->mtx);
+        pending->timer = createAsyncSrvTimer(host, timeout, std::move(onTimeout));
+    }
+
+    if(client->service_is_ready())
+    {
+        send();
+        return;
+    }
+
+    // service not discovered yet: poll for it within the host executor until it shows up or the timeout fires
+    std::function<void()> onPoll = [pending, send]()
+    {
+        bool ready = false;
+        {
+            std::lock_guard<std::mutex> lock(pending->mtx);
+            ready = !pending->done && pending->client && pending->client->service_is_ready();
+        }
+        if(ready)
+            send();
+    };
+    {
+        std::lock_guard<std::mutex> lock(pending->mtx);
+        if(!pending->done)
+            pending->poll_timer = createAsyncSrvTimer(host, std::chrono::milliseconds(ASYNC_SRV_READY_POLL_MS), std::move(onPoll));
+    }
+}
+
+#endif //ASYNC_SRV_REQUEST_H_
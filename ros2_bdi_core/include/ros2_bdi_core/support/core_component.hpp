@@ -0,0 +1,44 @@
+#ifndef CORE_COMPONENT_H_
+#define CORE_COMPONENT_H_
+
+#include <chrono>
+#include <memory>
+
+#include "rclcpp/rclcpp.hpp"
+
+/*
+    Core node loadable as a rclcpp component (e.g. all the core nodes of an agent within a single container,
+    exchanging messages through intra-process comms)
+
+    Nobody calls the init of a node loaded within a container, as the main of the standalone executable does:
+    the component boots itself as soon as the container's executor spins it, through the boot sequence
+        bool bootCoreNode(CoreNode& node)
+    defined along with the core node (returns false if the node could not be started, e.g. PlanSys2 not booted in time)
+
+    n.b. boot sequences wait for PlanSys2, so load the components within a multi-threaded container
+    n.b. the MA request handler srv handlers block waiting for their write acks and need MAX_CONCURRENT_WRITES+2 threads
+    of their own (see main/ma_request_handler.cpp): the bringup never loads it within the shared container
+*/
+template<class CoreNode>
+class CoreComponent : public CoreNode
+{
+    public:
+
+        /* Constructor method (as expected by the component container) */
+        explicit CoreComponent(const rclcpp::NodeOptions& options)
+            : CoreNode(options)
+        {
+            boot_timer_ = this->create_wall_timer(std::chrono::milliseconds(0), [this]()
+            {
+                boot_timer_->cancel();//boot just once
+                if(!bootCoreNode(static_cast<CoreNode&>(*this)))
+                    RCLCPP_ERROR(this->get_logger(), "Boot failed: node loaded within the container, but it will not work");
+            });
+        }
+
+    private:
+        // one shot timer to boot the node once it is spun
+        rclcpp::TimerBase::SharedPtr boot_timer_;
+};
+
+#endif // CORE_COMPONENT_H_
@@ -3,37 +3,43 @@
 
 #include <string>
 #include <memory>
+#include <optional>
+#include <functional>
 
 #include "ros2_bdi_interfaces/msg/desire.hpp"
 #include "ros2_bdi_utils/ManagedDesire.hpp"
 #include "javaff_interfaces/srv/java_ff_plan.hpp"
 #include "javaff_interfaces/srv/unexpected_state.hpp"
 
+#include "ros2_bdi_core/support/async_srv_request.hpp"
+
 #include "rclcpp/rclcpp.hpp"
 
 class JavaFFClient
 {
     public:
-        /* Constructor for the supporting node for calling javaff services */
-        JavaFFClient(const std::string& nodeBasename);
-
-        bool launchPlanSearch(const ros2_bdi_interfaces::msg::Desire& fulfilling_desire, const std::string& problem, const int& interval, const int& max_empty_search_intervals);
-        bool callUnexpectedStateSrv(const std::string& pddl_problem);
+        /* 
+            Constructor for the supporting node for calling javaff services
+            (@asyncHost, if given, is the node whose executor serves the non blocking requests)
+        */
+        JavaFFClient(const std::string& nodeBasename, const std::optional<AsyncSrvHost>& asyncHost = std::nullopt);
+
+        /* 
+            Non blocking requests to the javaff srvs: @onResult is called with the outcome of the request
+            within the executor of the async host node (false on timeout or if no async host has been given)
+        */
+        void launchPlanSearchAsync(const ros2_bdi_interfaces::msg::Desire& fulfilling_desire, const std::string& problem, const int& interval, const int& max_empty_search_intervals,
+            const std::function<void(bool)>& onResult);
+        void callUnexpectedStateSrvAsync(const std::string& pddl_problem, const std::function<void(bool)>& onResult);
 
     private:
-        bool makePlanSearchRequest(const javaff_interfaces::srv::JavaFFPlan::Request::SharedPtr& request);
-
-        bool makeUnexpectedStateRequest(const javaff_interfaces::srv::UnexpectedState::Request::SharedPtr& request);
-
-
-        // node to be spinned while making request to javaff srvs 
+        // node used for logging
         rclcpp::Node::SharedPtr caller_node_;
 
-        // client instance to make the request to the javaff_server/start_plan srv
-        rclcpp::Client<javaff_interfaces::srv::JavaFFPlan>::SharedPtr start_plan_client_;
-
-        // client instance to make the request to the javaff_server/unexpected_state srv
-        rclcpp::Client<javaff_interfaces::srv::UnexpectedState>::SharedPtr unexpected_state_client_;
+        // node serving non blocking requests and client instances created on it
+        std::optional<AsyncSrvHost> async_host_;
+        rclcpp::Client<javaff_interfaces::srv::JavaFFPlan>::SharedPtr async_start_plan_client_;
+        rclcpp::Client<javaff_interfaces::srv::UnexpectedState>::SharedPtr async_unexpected_state_client_;
 
 };
 
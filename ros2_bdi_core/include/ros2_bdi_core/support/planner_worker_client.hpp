@@ -0,0 +1,34 @@
+#ifndef PLANNER_WORKER_CLIENT_H_
+#define PLANNER_WORKER_CLIENT_H_
+
+#include <string>
+#include <memory>
+#include <optional>
+
+#include "plansys2_msgs/msg/plan.hpp"
+#include "plansys2_msgs/srv/get_plan.hpp"
+
+#include "rclcpp/rclcpp.hpp"
+
+/*
+    Client of the PlanSys2 planner get_plan service, as plansys2::PlannerClient, but spinning its own uniquely named node
+    (plansys2::PlannerClient nodes are all named "planner_client", so several of them cannot live within the same agent)
+*/
+class PlannerWorkerClient
+{
+    public:
+        /* Constructor for the supporting node (named @nodeName) for calling the planner get_plan service */
+        PlannerWorkerClient(const std::string& nodeName);
+
+        /* Compute plan for @problem within @domain (std::nullopt if the planner has not found any or it cannot be reached) */
+        std::optional<plansys2_msgs::msg::Plan> getPlan(const std::string& domain, const std::string& problem);
+
+    private:
+        // node to be spinned while making request to the get_plan srv
+        rclcpp::Node::SharedPtr caller_node_;
+
+        // client instance to make the request to the planner/get_plan srv
+        rclcpp::Client<plansys2_msgs::srv::GetPlan>::SharedPtr get_plan_client_;
+};
+
+#endif //PLANNER_WORKER_CLIENT_H_
@@ -2,21 +2,30 @@
 #define TRIGGER_PLAN_CLIENT_H_
 
 #include <string>
+#include <vector>
 #include <memory>
+#include <optional>
+#include <functional>
 
 #include "ros2_bdi_interfaces/msg/bdi_plan.hpp"
 #include "ros2_bdi_interfaces/srv/bdi_plan_execution.hpp"
 
+#include "ros2_bdi_core/support/async_srv_request.hpp"
+
 #include "rclcpp/rclcpp.hpp"
 
 class TriggerPlanClient
 {
     public:
-        /* Constructor for the supporting node for calling the plan_execution service */
-        TriggerPlanClient(const std::string& nodeBasename);
+        /* 
+            Constructor for the supporting node for calling the plan_execution service
+            (@asyncHost, if given, is the node whose executor serves the non blocking requests)
+        */
+        TriggerPlanClient(const std::string& nodeBasename, const std::optional<AsyncSrvHost>& asyncHost = std::nullopt);
         
-        /* Return true if operation is successful */
-        bool triggerPlanExecution(const ros2_bdi_interfaces::msg::BDIPlan& bdiPlan);
+        /* Return true if operation is successful (@concurrentPlans to be executed alongside @bdiPlan) */
+        bool triggerPlanExecution(const ros2_bdi_interfaces::msg::BDIPlan& bdiPlan, 
+            const std::vector<ros2_bdi_interfaces::msg::BDIPlan>& concurrentPlans = std::vector<ros2_bdi_interfaces::msg::BDIPlan>());
 
         /* Return true if operation is successful */
         bool abortPlanExecution(const ros2_bdi_interfaces::msg::BDIPlan& bdiPlan);
@@ -24,6 +33,15 @@ class TriggerPlanClient
         /* Return true if operation is successful */
         bool earlyArrestRequest(const ros2_bdi_interfaces::msg::BDIPlan& bdiPlan);
 
+        /* 
+            Non blocking versions of the above: @onResult is called with the outcome of the operation
+            within the executor of the async host node (false on timeout or if no async host has been given)
+        */
+        void triggerPlanExecutionAsync(const ros2_bdi_interfaces::msg::BDIPlan& bdiPlan, 
+            const std::vector<ros2_bdi_interfaces::msg::BDIPlan>& concurrentPlans, const std::function<void(bool)>& onResult);
+        void abortPlanExecutionAsync(const ros2_bdi_interfaces::msg::BDIPlan& bdiPlan, const std::function<void(bool)>& onResult);
+        void earlyArrestRequestAsync(const ros2_bdi_interfaces::msg::BDIPlan& bdiPlan, const std::function<void(bool)>& onResult);
+
     private:
 
         /* 
@@ -32,11 +50,19 @@ class TriggerPlanClient
         */
         bool makePlanExecutionRequest(const ros2_bdi_interfaces::srv::BDIPlanExecution::Request::SharedPtr& request);
 
+        /* Non blocking version of makePlanExecutionRequest */
+        void makePlanExecutionRequestAsync(const ros2_bdi_interfaces::srv::BDIPlanExecution::Request::SharedPtr& request, 
+            const std::function<void(bool)>& onResult);
+
         // node to be spinned while making request to the plan_execution srv 
         rclcpp::Node::SharedPtr caller_node_;
 
         // client instance to make the request to the plan_execution srv
         rclcpp::Client<ros2_bdi_interfaces::srv::BDIPlanExecution>::SharedPtr caller_client_;
+
+        // node serving non blocking requests and client instance created on it
+        std::optional<AsyncSrvHost> async_host_;
+        rclcpp::Client<ros2_bdi_interfaces::srv::BDIPlanExecution>::SharedPtr async_client_;
 };
 
 #endif //TRIGGER_PLAN_CLIENT_H_
\ No newline at end of file
@@ -10,13 +10,18 @@
 #include <yaml-cpp/exceptions.h>
 
 #include "plansys2_msgs/srv/get_problem_instances.hpp"
+#include "plansys2_msgs/msg/param.hpp"
 #include "ros2_bdi_utils/BDIPDDLConverter.hpp"
 #include "ros2_bdi_utils/PDDLBDIConverter.hpp"
 #include "ros2_bdi_utils/BDIFilter.hpp"
 #include "ros2_bdi_utils/BDIYAMLParser.hpp"
+#include "ros2_bdi_utils/PDDLUtils.hpp"
 
 #include <iostream>
-#include <fstream>
+
+// boot as rclcpp component
+#include "ros2_bdi_core/support/core_component.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
 
 using std::string;
 using std::vector;
@@ -33,27 +38,33 @@ using plansys2::DomainExpertClient;
 using plansys2::Instance;
 using plansys2::Predicate;
 using plansys2::Function;
+using plansys2_msgs::msg::Param;
 using plansys2_msgs::srv::GetProblemInstances;
 using std_msgs::msg::Empty;
 
 using ros2_bdi_interfaces::msg::Belief;
 using ros2_bdi_interfaces::msg::BeliefSet;
+using ros2_bdi_interfaces::msg::BeliefSetDelta;
+using ros2_bdi_interfaces::msg::BeliefSetWrite;
+using ros2_bdi_interfaces::msg::WriteAck;
 using ros2_bdi_interfaces::msg::LifecycleStatus;
 using ros2_bdi_interfaces::msg::PlanningSystemState;
 
 using BDIManaged::ManagedType;
 using BDIManaged::ManagedParam;
 using BDIManaged::ManagedBelief;
+using BDIManaged::BeliefStore;
 
 
 /*  Constructor method */
-BeliefManager::BeliefManager()
-  : rclcpp::Node(BELIEF_MANAGER_NODE_NAME), state_(STARTING)
+BeliefManager::BeliefManager(const rclcpp::NodeOptions& options)
+  : rclcpp::Node(BELIEF_MANAGER_NODE_NAME, options), state_(STARTING)
 {
     psys2_comm_errors_ = 0;
     this->declare_parameter(PARAM_AGENT_ID, "agent0");
     this->declare_parameter(PARAM_DEBUG, true);
     this->declare_parameter(PARAM_PLANNING_MODE, PLANNING_MODE_OFFLINE);
+    this->declare_parameter(PARAM_INCREMENTAL_SYNC, DEFAULT_VAL_INCREMENTAL_SYNC);
 
     sel_planning_mode_ = this->get_parameter(PARAM_PLANNING_MODE).as_string() == PLANNING_MODE_OFFLINE? OFFLINE : ONLINE;
     this->undeclare_parameter(PARAM_PLANNING_MODE);
@@ -75,6 +86,8 @@ void BeliefManager::init()
 
     //domain expert client to communicate with domain expert node of plansys2
     domain_expert_ = std::make_shared<DomainExpertClient>();
+    // predicate/function schemas retrieved through it at first use
+    pddl_metadata_ = BDIManaged::PDDLMetadataCache{domain_expert_};
 
     //problem expert client to communicate with problem expert node of plansys2
     problem_expert_ = std::make_shared<ProblemExpertClient>();
@@ -82,13 +95,23 @@ void BeliefManager::init()
     // last pddl problem known at the moment init (just empty string)
     last_pddl_problem_ = "";
 
+    // incremental sync: no pddl problem facts known, no own writes pending yet
+    incremental_sync_ = this->get_parameter(PARAM_INCREMENTAL_SYNC).as_bool();
+    last_pddl_problem_facts_ = map<string, string>();
+    pddl_problem_facts_init_ = false;
+    psys2_writes_log_ = std::deque<Psys2Write>();
+
     //Declare empty belief set
-    belief_set_ = set<ManagedBelief>();
+    belief_set_ = BeliefStore();
+    belief_set_version_ = 0;
+    pending_bset_delta_ = map<ManagedBelief, SyncOpType>();
     //wait for it to be init
     init_bset_ = false;
 
     //Belief set publisher
     belief_set_publisher_ = this->create_publisher<BeliefSet>(BELIEF_SET_TOPIC, 10);
+    //Belief set delta publisher
+    belief_set_delta_publisher_ = this->create_publisher<BeliefSetDelta>(BELIEF_SET_DELTA_TOPIC, 10);
     
     rclcpp::QoS qos_reliable = rclcpp::QoS(10);
     qos_reliable.reliable();
@@ -143,6 +166,17 @@ void BeliefManager::init()
                 DEL_BELIEF_TOPIC, qos_reliable,
                 bind(&BeliefManager::delBeliefTopicCallBack, this, _1));
 
+    //Belief set write requests (acknowledged once processed)
+    belief_set_write_subscriber_ = this->create_subscription<BeliefSetWrite>(
+                BELIEF_SET_WRITE_TOPIC, qos_reliable,
+                bind(&BeliefManager::beliefSetWriteTopicCallBack, this, _1));
+    belief_set_write_ack_publisher_ = this->create_publisher<WriteAck>(BELIEF_SET_WRITE_ACK_TOPIC, qos_reliable);
+
+    //Belief set snapshot requested notification
+    belief_set_request_subscriber_ = this->create_subscription<Empty>(
+                BELIEF_SET_REQUEST_TOPIC, qos_reliable,
+                bind(&BeliefManager::beliefSetRequestCallback, this, _1));
+
     //problem_expert update subscriber
     updated_problem_subscriber_ = this->create_subscription<Empty>(
                 "problem_expert/update_notify", 10,
@@ -198,7 +232,15 @@ void BeliefManager::step()
 
         case SYNC:
         {    
-            publishBeliefSet();
+            //safety net for external changes which might have been missed by the incremental sync
+            if(incremental_sync_ && step_counter_ % FULL_RESYNC_STEPS == 0 && fullSyncPDDLProblem() && 
+                    this->get_parameter(PARAM_DEBUG).as_bool())
+                RCLCPP_INFO(this->get_logger(), "Periodic full sync with the PDDL problem has altered the belief set");
+            
+            if(step_counter_ % BELIEF_SET_KEYFRAME_STEPS == 0)
+                publishBeliefSet();
+            else
+                publishBeliefSetDelta();
         }
 
         case PAUSE:
@@ -230,16 +272,87 @@ void BeliefManager::callbackPsys2State(const PlanningSystemState::SharedPtr msg)
 {
     psys2_problem_expert_active_ = msg->problem_expert_active;
     psys2_domain_expert_active_ = msg->domain_expert_active;
+    if(!psys2_domain_expert_active_)
+        pddl_metadata_.invalidateDomain();//domain retrieved again once the domain expert is back
 }
 
 /*
     Publish the current belief set of the agent in agent_id_/belief_set topic
+    (pending alterations are notified through a belief set delta first)
 */
 void BeliefManager::publishBeliefSet()
 {
-    BeliefSet bset_msg = BDIFilter::extractBeliefSetMsg(belief_set_);
-    bset_msg.agent_id = agent_id_;
-    belief_set_publisher_->publish(bset_msg);
+    publishBeliefSetDelta();
+
+    // handed over as unique_ptr: moved to the subscribers within the same process (intra-process comms) without copies
+    mtx_sync.lock();
+        auto bset_msg = std::make_unique<BeliefSet>(BDIFilter::extractBeliefSetMsg(belief_set_));
+        bset_msg->agent_id = agent_id_;
+        bset_msg->version = belief_set_version_;//snapshot and version taken together
+    mtx_sync.unlock();
+    belief_set_publisher_->publish(std::move(bset_msg));
+}
+
+/*
+    Publish the alterations to the belief set not notified yet in agent_id_/belief_set_delta topic (if any)
+*/
+void BeliefManager::publishBeliefSetDelta()
+{
+    // pending alterations are recorded under mtx_sync: take them over (and version them) under it as well,
+    // so that nothing recorded meanwhile gets lost and versions follow the order in which alterations are taken
+    map<ManagedBelief, SyncOpType> pending_delta;
+    mtx_sync.lock();
+        pending_delta.swap(pending_bset_delta_);
+        uint64_t version = (pending_delta.size() > 0)? ++belief_set_version_ : belief_set_version_;
+    mtx_sync.unlock();
+
+    if(pending_delta.size() == 0)
+        return;
+
+    auto delta_msg = std::make_unique<BeliefSetDelta>();
+    for(auto change : pending_delta)
+    {
+        if(change.second == SYNC_ADD)
+            delta_msg->added.push_back(change.first.toBelief());
+        else if(change.second == SYNC_DEL)
+            delta_msg->removed.push_back(change.first.toBelief());
+        else
+            delta_msg->modified.push_back(change.first.toBelief());
+    }
+
+    delta_msg->version = version;
+    delta_msg->agent_id = agent_id_;
+    belief_set_delta_publisher_->publish(std::move(delta_msg));
+}
+
+/*
+    Record an alteration to the belief set to be notified with the next belief set delta
+*/
+void BeliefManager::recordBeliefSetChange(const ManagedBelief& mb, const SyncOpType& op)
+{
+    //instances mirrored in the pddl metadata cache
+    if(op == SYNC_ADD)
+        pddl_metadata_.addInstance(mb);
+    else if(op == SYNC_DEL)
+        pddl_metadata_.removeInstance(mb);
+
+    SyncOpType pending_op = op;
+    auto pending = pending_bset_delta_.find(mb);
+    if(pending != pending_bset_delta_.end())
+    {
+        if(pending->second == SYNC_ADD && op == SYNC_DEL)
+        {
+            pending_bset_delta_.erase(pending);//never notified, nothing to notify
+            return;
+        }
+        else if(pending->second == SYNC_ADD)
+            pending_op = SYNC_ADD;//still a new belief for the subscribers (with its last value)
+        else if(pending->second == SYNC_DEL && op == SYNC_ADD)
+            pending_op = SYNC_UPD;//removed and added back, subscribers just need its last value
+        
+        pending_bset_delta_.erase(pending);//erase + insert to keep the last value for functions
+    }
+    pending_bset_delta_.insert(std::make_pair(mb, pending_op));
 }
 
 /*
@@ -251,8 +364,7 @@ void BeliefManager::tryInitBeliefSet()
     
     try{
         vector<ManagedBelief> init_mgbeliefs = BDIYAMLParser::extractMGBeliefs(init_bset_filepath, domain_expert_);
-        for(ManagedBelief initMGBelief : init_mgbeliefs)
-            addBeliefSyncPDDL(initMGBelief);
+        addBeliefsSyncPDDL(init_mgbeliefs);
         if(this->get_parameter(PARAM_DEBUG).as_bool())
             RCLCPP_INFO(this->get_logger(), "Belief set initialization performed through " + init_bset_filepath);
     
@@ -273,42 +385,253 @@ void BeliefManager::tryInitBeliefSet()
 */
 void BeliefManager::updatedPDDLProblem(const Empty::SharedPtr msg)
 {   
+    bool notify = false;//if anything changes, put it to true
+    if(incremental_sync_ && consumePsys2WriteAck(notify))
+        return;//echo of a write of ours, already applied to the belief set
+
     string pddlProblemNow = problem_expert_->getProblem();
     //strip off goal part (the belief regards just instances, predicates, fluents)
     pddlProblemNow = pddlProblemNow.substr(0,pddlProblemNow.find(":goal")-1);
     if(pddlProblemNow == last_pddl_problem_)//nothing has changed (maybe goal has been set)
+    {
+        if(notify)
+            publishBeliefSetDelta();//own write found undone
         return;
+    }
 
+    string pddlProblemBefore = last_pddl_problem_;
     last_pddl_problem_ = pddlProblemNow;
-    bool notify;//if anything changes, put it to true
     
-    std::istringstream ss(pddlProblemNow);
-    string line, out;
-    std::cout << "";
-    while(getline(ss, line)){
-        // if((line.find("near") != string::npos) || (line.find("free") != string::npos))
-        //     out += "";
-        // else 
-            out += line + "\n";
-    }
-    RCLCPP_INFO(this->get_logger(), "Update pddl problem notification:\n");
-    RCLCPP_INFO(this->get_logger(), out);
-    std::ofstream file;
-    file.open("/home/devis/alexis.txt");
-    file << pddlProblemNow;
-    file.close();
-    if(this->get_parameter(PARAM_DEBUG).as_bool()){
-        // RCLCPP_INFO(this->get_logger(), "Update pddl problem notification:\n"+pddlProblemNow);
+    if(this->get_parameter(PARAM_DEBUG).as_bool())
+        RCLCPP_INFO(this->get_logger(), "Update pddl problem notification:\n"+pddlProblemNow);
 
+    if(incremental_sync_)
+    {
+        //just the facts around the changed part of the problem are parsed and reconciled
+        map<string, string> addedFacts, removedFacts;
+        bool reconciled = pddl_problem_facts_init_ && 
+            PDDLUtils::diffPDDLProblemFacts(pddlProblemBefore, pddlProblemNow, addedFacts, removedFacts) &&
+            reconcilePDDLProblemDelta(addedFacts, removedFacts, notify);
+        
+        if(!reconciled)
+        {
+            //first notification or unexpected problem format: fall back to full sync
+            notify = fullSyncPDDLProblem() || notify;
+            last_pddl_problem_facts_ = PDDLUtils::extractPDDLProblemFacts(pddlProblemNow);
+            pddl_problem_facts_init_ = true;
+        }
     }
+    else
+        notify = fullSyncPDDLProblem();
+    
+    if(notify)
+        publishBeliefSetDelta();//there has been some modifications, notify them
+}
 
+/*
+    Retrieve instances, predicates and functions from the problem expert and diff them all against the belief set
+    Returns true if any modification to the belief_set occurs
+*/
+bool BeliefManager::fullSyncPDDLProblem()
+{
     vector<Belief> instances = PDDLBDIConverter::convertPDDLInstances(problem_expert_->getInstances());
     vector<Belief> predicates = PDDLBDIConverter::convertPDDLPredicates(problem_expert_->getPredicates());
     vector<Belief> functions = PDDLBDIConverter::convertPDDLFunctions(problem_expert_->getFunctions());
-    notify = updateBeliefSet(instances, predicates, functions);
+    return updateBeliefSet(instances, predicates, functions);
+}
+
+/*
+    Apply to the belief set the facts changed in the PDDL problem since the last notification 
+    (@addedFacts new or with a new value, @removedFacts dropped, see PDDLUtils::diffPDDLProblemFacts),
+    skipping the ones already known through own writes, and align the last known pddl problem facts
+    Returns false if some changed fact cannot be interpreted (caller should fall back to a full sync),
+    modified is set to true if any modification to the belief_set occurs
+*/
+bool BeliefManager::reconcilePDDLProblemDelta(const map<string, string>& addedFacts, const map<string, string>& removedFacts, bool& modified)
+{
+    vector<Belief> added, removed;
+    for(auto fact : addedFacts)
+    {
+        auto last_fact = last_pddl_problem_facts_.find(fact.first);
+        bool changed = last_fact == last_pddl_problem_facts_.end();
+        if(!changed && last_fact->second != fact.second)//function value may just be formatted differently
+        {
+            try{
+                changed = std::stof(last_fact->second) != std::stof(fact.second);
+            }catch(const std::exception& e){
+                changed = true;
+            }
+        }
+
+        if(changed)
+        {
+            std::optional<Belief> b = PDDLBDIConverter::convertPDDLProblemFact(fact.first, fact.second);
+            if(!b.has_value())
+                return false;
+            added.push_back(b.value());
+        }
+    }
     
-    if(notify)
-        publishBeliefSet();//there has been some modifications, publish new belief set
+    for(auto fact : removedFacts)
+        if(addedFacts.count(fact.first) == 0 && last_pddl_problem_facts_.count(fact.first) > 0)
+        {
+            auto last_fact = last_pddl_problem_facts_.find(fact.first);
+            std::optional<Belief> b = PDDLBDIConverter::convertPDDLProblemFact(last_fact->first, last_fact->second);
+            if(!b.has_value())
+                return false;
+            removed.push_back(b.value());
+        }
+
+    if(this->get_parameter(PARAM_DEBUG).as_bool())
+        RCLCPP_INFO(this->get_logger(), "update problem: reconcile changed facts (b_set %zu, added %zu, removed %zu)", 
+            belief_set_.size(), added.size(), removed.size());
+
+    mtx_sync.lock();
+        //new facts or functions with a new value
+        modified = (added.size() > 0 && addOrModifyBeliefs(added, true)) || modified;
+
+        for(Belief b : removed)
+        {
+            ManagedBelief mb = ManagedBelief{b};
+            if(belief_set_.count(mb) > 0)
+            {
+                delBelief(mb);
+                modified = true;
+            }
+        }
+
+        for(auto fact : addedFacts)
+            last_pddl_problem_facts_[fact.first] = fact.second;
+        for(auto fact : removedFacts)
+            if(addedFacts.count(fact.first) == 0)
+                last_pddl_problem_facts_.erase(fact.first);
+    mtx_sync.unlock();
+
+    return true;
+}
+
+/*
+    Record a write performed to the problem expert, so that its update notification
+    is recognized as an echo of it, and apply it to the last known pddl problem facts (incremental sync only)
+*/
+void BeliefManager::logPsys2Write(const ManagedBelief& mb, const SyncOpType& op)
+{
+    if(!incremental_sync_)
+        return;
+    
+    psys2_writes_log_.push_back(Psys2Write{op, mb, this->now()});
+
+    // keep last known facts aligned, otherwise a later external change undoing this write would go unnoticed
+    string fact = BDIPDDLConverter::buildPDDLProblemFact(mb);
+    if(op == SYNC_DEL)
+        last_pddl_problem_facts_.erase(fact);
+    else
+        last_pddl_problem_facts_[fact] = (mb.pddlType() == Belief().FUNCTION_TYPE)? std::to_string(mb.getValue()) : "";
+}
+
+/*
+    Consume the oldest pending own write (if any) as acknowledged by an update notification, if the problem expert 
+    reflects it (own writes are logged once performed, so one which is not reflected has been undone by someone else:
+    the belief set and the last known facts are aligned with the problem expert wrt. it, setting modified to true).
+    Returns true if the notification is the echo of an own write, so there is nothing to reconcile
+*/
+bool BeliefManager::consumePsys2WriteAck(bool& modified)
+{
+    rclcpp::Time now = this->now();
+    bool echo = false;
+
+    mtx_sync.lock();
+        //writes whose notification has been lost: check them anyway, so that they do not hide external changes
+        while(psys2_writes_log_.size() > 0 && (now - psys2_writes_log_.front().stamp).nanoseconds() > PSYS2_WRITE_ACK_TIMEOUT * 1000000L)
+        {
+            modified = alignPsys2Write(psys2_writes_log_.front()) || modified;
+            psys2_writes_log_.pop_front();
+        }
+
+        if(psys2_writes_log_.size() > 0)
+        {
+            bool undone = alignPsys2Write(psys2_writes_log_.front());
+            modified = undone || modified;
+            echo = !undone;
+            psys2_writes_log_.pop_front();
+        }
+    mtx_sync.unlock();
+
+    return echo;
+}
+
+/*
+    Check the own write @write against the problem expert (just the fact it has written):
+    if it is not reflected anymore, align the belief set and the last known facts to the actual fact and return true
+*/
+bool BeliefManager::alignPsys2Write(const Psys2Write& write)
+{
+    const ManagedBelief& mb = write.belief;
+    string fact = BDIPDDLConverter::buildPDDLProblemFact(mb);
+
+    bool present = false;
+    float value = mb.getValue();
+    if(mb.pddlType() == Belief().INSTANCE_TYPE)
+        present = problem_expert_->getInstance(mb.getName()).has_value();
+    else if(mb.pddlType() == Belief().PREDICATE_TYPE)
+        present = problem_expert_->existPredicate(BDIPDDLConverter::buildPredicate(mb));
+    else
+    {
+        auto function = problem_expert_->getFunction(fact);
+        present = function.has_value();
+        if(present)
+            value = function.value().value;
+    }
+
+    bool reflected = (write.op == SYNC_DEL)? !present : present && value == mb.getValue();
+    if(reflected)
+        return false;
+
+    if(this->get_parameter(PARAM_DEBUG).as_bool())
+        RCLCPP_INFO(this->get_logger(), "Own write of " + fact + " has been undone in the meantime: realigning belief set");
+
+    ManagedBelief actual = (mb.pddlType() == Belief().FUNCTION_TYPE)? 
+        ManagedBelief::buildMBFunction(mb.getName(), mb.getParams(), value) : mb;
+    if(present)
+    {
+        last_pddl_problem_facts_[fact] = (mb.pddlType() == Belief().FUNCTION_TYPE)? std::to_string(value) : "";
+        if(belief_set_.count(actual) == 0)
+            addBelief(actual);
+        else
+            modifyBelief(actual);
+    }
+    else
+    {
+        last_pddl_problem_facts_.erase(fact);
+        delBelief(mb);
+        if(mb.pddlType() == Belief().INSTANCE_TYPE)
+            removeDanglingBeliefs(mb);
+    }
+    return true;
+}
+
+/*
+    Remove from the belief set predicates and functions referring to a removed instance
+    (the problem expert drops them automatically when the instance is removed)
+*/
+void BeliefManager::removeDanglingBeliefs(const ManagedBelief& mb_instance)
+{
+    vector<ManagedBelief> dangling;
+    for(ManagedBelief mb : belief_set_)
+        if(mb.pddlType() != Belief().INSTANCE_TYPE)
+            for(ManagedParam mp : mb.getParams())
+                if(mp.name == mb_instance.getName())
+                {
+                    dangling.push_back(mb);
+                    break;
+                }
+    
+    for(ManagedBelief mb : dangling)
+    {
+        delBelief(mb);
+        if(incremental_sync_)
+            last_pddl_problem_facts_.erase(BDIPDDLConverter::buildPDDLProblemFact(mb));
+    }
 }
 
 
@@ -316,7 +639,7 @@ bool BeliefManager::updateBeliefSet(const vector<Belief>& ins_beliefs, const vec
 {
     bool notify;//if anything changes, put it to true
     if(this->get_parameter(PARAM_DEBUG).as_bool())
-        RCLCPP_INFO(this->get_logger(), "update problem: verify if needed to sync (b_set %d, prob_ins %d, prob_pred %d, prob_fun %d)", 
+        RCLCPP_INFO(this->get_logger(), "update problem: verify if needed to sync (b_set %zu, prob_ins %zu, prob_pred %zu, prob_fun %zu)", 
             belief_set_.size(), ins_beliefs.size(), pred_beliefs.size(), fun_beliefs.size());
 
     mtx_sync.lock();
@@ -464,14 +787,12 @@ void BeliefManager::addBeliefTopicCallBack(const Belief::SharedPtr msg)
 */
 void BeliefManager::addBeliefSetTopicCallBack(const BeliefSet::SharedPtr msg)
 {
-    if(msg->agent_id == agent_id_)
+    if(msg->agent_id == agent_id_ && psys2_domain_expert_active_ && psys2_problem_expert_active_)
     {
-        for(Belief b : msg->value)
-        {
-            ManagedBelief mb = ManagedBelief{b};
-            if(psys2_domain_expert_active_ && psys2_problem_expert_active_)
-                addBeliefSyncPDDL(mb);
-        }
+        vector<ManagedBelief> mbs;
+        for(const Belief& b : msg->value)
+            mbs.push_back(ManagedBelief{b});
+        addBeliefsSyncPDDL(mbs);
     }
 }
 
@@ -480,15 +801,42 @@ void BeliefManager::addBeliefSetTopicCallBack(const BeliefSet::SharedPtr msg)
 */
 void BeliefManager::delBeliefSetTopicCallBack(const BeliefSet::SharedPtr msg)
 {
-    if(msg->agent_id == agent_id_)
+    if(msg->agent_id == agent_id_ && psys2_domain_expert_active_ && psys2_problem_expert_active_)
     {
-        for(Belief b : msg->value)
-        {
-            ManagedBelief mb = ManagedBelief{b};
-            if(psys2_domain_expert_active_ && psys2_problem_expert_active_)
-                delBeliefSyncPDDL(mb);
-        }
+        vector<ManagedBelief> mbs;
+        for(const Belief& b : msg->value)
+            mbs.push_back(ManagedBelief{b});
+        delBeliefsSyncPDDL(mbs);
+    }
+}
+
+/*  
+    Someone has requested a belief set write: apply it and acknowledge it 
+    with the same request id and the resulting belief set version
+*/
+void BeliefManager::beliefSetWriteTopicCallBack(const BeliefSetWrite::SharedPtr msg)
+{
+    vector<ManagedBelief> mbs;
+    for(const Belief& b : msg->value)
+        mbs.push_back(ManagedBelief{b});
+
+    if(psys2_domain_expert_active_ && psys2_problem_expert_active_)
+    {
+        if(msg->operation == msg->ADD)
+            addBeliefsSyncPDDL(mbs);
+        else
+            delBeliefsSyncPDDL(mbs);
     }
+
+    //acknowledge anyway (not performed if plansys2 is not up), so that the requester does not wait in vain
+    WriteAck ack = WriteAck();
+    ack.request_id = msg->request_id;
+    mtx_sync.lock();
+        for(const ManagedBelief& mb : mbs)
+            ack.performed.push_back(belief_set_.count(mb) == ((msg->operation == msg->ADD)? 1 : 0));
+        ack.version = belief_set_version_;
+    mtx_sync.unlock();
+    belief_set_write_ack_publisher_->publish(ack);
 }
 
 /*
@@ -496,18 +844,18 @@ void BeliefManager::delBeliefSetTopicCallBack(const BeliefSet::SharedPtr msg)
 */
 void BeliefManager::addBeliefSyncPDDL(const ManagedBelief& mb)
 {   
-    bool alreadyThere = true;//belief already in belief set (check later)
     mtx_sync.lock();
         if(belief_set_.count(mb)==0)
         {
-            alreadyThere = false;//belief NOT already in belief set (check later)
-
             if(mb.pddlType() == Belief().INSTANCE_TYPE)
             {   
                 //try to add new instance; if fails (word conflicts, wrong/missing type), no biggie!
                 Instance ins = BDIPDDLConverter::buildInstance(mb);
                 if(problem_expert_->addInstance(ins))
+                {
+                    logPsys2Write(mb, SYNC_ADD);
                     addBelief(mb);
+                }
             } 
 
             if(mb.pddlType() == Belief().PREDICATE_TYPE)
@@ -516,7 +864,10 @@ void BeliefManager::addBeliefSyncPDDL(const ManagedBelief& mb)
                 Predicate p_add = BDIPDDLConverter::buildPredicate(mb);
                 if(problem_expert_->addPredicate(p_add) || 
                     tryAddMissingInstances(mb) && problem_expert_->addPredicate(p_add))
+                {
+                    logPsys2Write(mb, SYNC_ADD);
                     addBelief(mb);
+                }
             } 
             
             if(mb.pddlType() == Belief().FUNCTION_TYPE)
@@ -525,7 +876,10 @@ void BeliefManager::addBeliefSyncPDDL(const ManagedBelief& mb)
                 Function f_add =  BDIPDDLConverter::buildFunction(mb);
                 if(problem_expert_->addFunction(f_add) || 
                     tryAddMissingInstances(mb) && problem_expert_->addFunction(f_add))
+                {
+                    logPsys2Write(mb, SYNC_ADD);
                     addBelief(mb);
+                }
             }
 
         }
@@ -534,37 +888,123 @@ void BeliefManager::addBeliefSyncPDDL(const ManagedBelief& mb)
             //function present in the belief set with diff. value
             Function f_upd = BDIPDDLConverter::buildFunction(mb);
             if(problem_expert_->updateFunction(f_upd))//instances have to be already present
+            {
+                logPsys2Write(mb, SYNC_UPD);
                 modifyBelief(mb);
+            }
         }
     mtx_sync.unlock();
     
-    if(!alreadyThere && belief_set_.count(mb) > 0)//modification to belief set
-        publishBeliefSet();
+    publishBeliefSetDelta();//notify modifications to belief set (if any)
 }
 
 /*
-    Create array of boolean flags denoting missing instances' positions
-    wrt. parameters in the passed ManagedBelief argument
+    Add a batch of beliefs in the belief set, syncing the pddl_problem to add them there too:
+    missing instances are computed once for the whole batch and added before predicates and functions,
+    the belief set delta is published once at the end
 */
-vector<bool> BeliefManager::computeMissingInstancesPos(const ManagedBelief& mb)
+void BeliefManager::addBeliefsSyncPDDL(const vector<ManagedBelief>& mbs)
 {
-    vector<bool> missing_pos = vector<bool>();
-    vector<Instance> instances = problem_expert_->getInstances();
-    for(ManagedParam mb_par : mb.getParams())
-    {    
-        bool found = false;
+    mtx_sync.lock();
+        //explicit instances first, so that predicates and functions of the batch can refer to them
+        vector<ManagedBelief> facts;
+        for(const ManagedBelief& mb : mbs)
+        {
+            if(mb.pddlType() != Belief().INSTANCE_TYPE)
+                facts.push_back(mb);
+            
+            else if(belief_set_.count(mb)==0)
+            {
+                //try to add new instance; if fails (word conflicts, wrong/missing type), no biggie!
+                if(problem_expert_->addInstance(BDIPDDLConverter::buildInstance(mb)))
+                {
+                    logPsys2Write(mb, SYNC_ADD);
+                    addBelief(mb);
+                }
+            }
+        }
+
+        //then the missing instances referred by new predicates and functions, typed wrt. their domain definition
+        for(const ManagedBelief& mb : facts)
+        {
+            if(belief_set_.count(mb) == 1)
+                continue;
+            
+            for(int i = 0; i < mb.getParams().size(); i++)
+            {
+                const string& ins_name = mb.getParams()[i].name;
+                if(pddl_metadata_.hasInstance(ins_name))
+                    continue;
+
+                //retrieve domain definition of this predicate/function
+                std::optional<vector<Param>> params = std::nullopt;
+                if(mb.pddlType() == Belief().PREDICATE_TYPE)
+                {
+                    auto pred = pddl_metadata_.getPredicate(mb.getName());
+                    params = pred.has_value()? std::make_optional(pred.value().parameters) : std::nullopt;
+                }
+                else
+                {
+                    auto function = pddl_metadata_.getFunction(mb.getName());
+                    params = function.has_value()? std::make_optional(function.value().parameters) : std::nullopt;
+                }
 
-        for(Instance ins : instances)
+                if(!params.has_value() || i >= params.value().size())
+                    break;//unknown predicate/function: adding it will fail anyway
+                
+                auto mp_type = ManagedType{params.value()[i].type, params.value()[i].sub_types};
+                ManagedBelief mb_ins = ManagedBelief::buildMBInstance(ins_name, mp_type);
+
+                if(this->get_parameter(PARAM_DEBUG).as_bool())
+                    RCLCPP_INFO(this->get_logger(), "Trying to add instance: " + mb_ins.getName() + " - " + mb_ins.type().name);
+                
+                if(problem_expert_->addInstance(BDIPDDLConverter::buildInstance(mb_ins)))//add instance (type found from domain expert)
+                {
+                    logPsys2Write(mb_ins, SYNC_ADD);
+                    addBelief(mb_ins);
+                }
+            }
+        }
+
+        //finally predicates and functions (all instances they need should be there by now)
+        for(const ManagedBelief& mb : facts)
         {
-            if(mb_par.name == ins.name)
+            auto present = belief_set_.find(mb);
+            if(present == belief_set_.end())
             {
-                found = true;//instance already defined
-                break;
+                bool added = (mb.pddlType() == Belief().PREDICATE_TYPE)? 
+                    problem_expert_->addPredicate(BDIPDDLConverter::buildPredicate(mb)) :
+                    problem_expert_->addFunction(BDIPDDLConverter::buildFunction(mb));
+                if(added)
+                {
+                    logPsys2Write(mb, SYNC_ADD);
+                    addBelief(mb);
+                }
+            }
+            else if(mb.pddlType() == Belief().FUNCTION_TYPE && mb.getValue() != (*present).getValue())
+            {
+                //function present in the belief set with diff. value
+                if(problem_expert_->updateFunction(BDIPDDLConverter::buildFunction(mb)))//instances have to be already present
+                {
+                    logPsys2Write(mb, SYNC_UPD);
+                    modifyBelief(mb);
+                }
             }
         }
+    mtx_sync.unlock();
 
-        missing_pos.push_back(!found);//flag denote missing instance
-    }
+    publishBeliefSetDelta();//notify all the modifications to belief set at once (if any)
+}
+
+/*
+    Create array of boolean flags denoting missing instances' positions
+    wrt. parameters in the passed ManagedBelief argument
+*/
+vector<bool> BeliefManager::computeMissingInstancesPos(const ManagedBelief& mb)
+{
+    vector<bool> missing_pos = vector<bool>();
+    for(ManagedParam mb_par : mb.getParams())
+        missing_pos.push_back(!pddl_metadata_.hasInstance(mb_par.name));//flag denote missing instance
     return missing_pos;
 }
 
@@ -588,7 +1028,7 @@ bool BeliefManager::tryAddMissingInstances(const ManagedBelief& mb)
     {   
         try {
             //retrieve from domain expert definition information about this predicate
-            Predicate pred = domain_expert_->getPredicate(mb.getName()).value();
+            Predicate pred = pddl_metadata_.getPredicate(mb.getName()).value();
             for(int i = 0; i<pred.parameters.size(); i++)
             {
                 if(missing_pos[i])//missing instance
@@ -600,8 +1040,11 @@ bool BeliefManager::tryAddMissingInstances(const ManagedBelief& mb)
                         RCLCPP_INFO(this->get_logger(), "Trying to add instance: " + mb_ins.getName() + " - " + mb_ins.type().name);
                     
                     if(problem_expert_->addInstance(BDIPDDLConverter::buildInstance(mb_ins)))//add instance (type found from domain expert)
+                    {
+                        logPsys2Write(mb_ins, SYNC_ADD);
                         addBelief(mb_ins);
-                    else
+                    }
+                    else if(!problem_expert_->getInstance(mb_ins.getName()).has_value())//unless already defined in the pddl_problem, just not mirrored yet
                         return false;//add instance failed
                 }
             }
@@ -613,7 +1056,7 @@ bool BeliefManager::tryAddMissingInstances(const ManagedBelief& mb)
     {   
         try {
             //retrieve from domain expert definition information about this function
-            Function function = domain_expert_->getFunction(mb.getName()).value();
+            Function function = pddl_metadata_.getFunction(mb.getName()).value();
             
             for(int i = 0; i<function.parameters.size(); i++)
             {
@@ -626,8 +1069,11 @@ bool BeliefManager::tryAddMissingInstances(const ManagedBelief& mb)
                         RCLCPP_INFO(this->get_logger(), "Trying to add instance: " + mb_ins.getName() + " - " + mb_ins.type().name);
                     
                     if(problem_expert_->addInstance(BDIPDDLConverter::buildInstance(mb_ins)))//add instance (type found from domain expert)
+                    {
+                        logPsys2Write(mb_ins, SYNC_ADD);
                         addBelief(mb_ins);
-                    else
+                    }
+                    else if(!problem_expert_->getInstance(mb_ins.getName()).has_value())//unless already defined in the pddl_problem, just not mirrored yet
                         return false;//add instance failed
                 }
 
@@ -666,30 +1112,92 @@ void BeliefManager::delBeliefSyncPDDL(const ManagedBelief& mb)
             if(mb.pddlType() == Belief().INSTANCE_TYPE)
             {
                 //relative predicates/functions will be automatically removed in the pddl_problem, 
-                // hence in the consequent update notification removed in the belief_set as well
+                // hence remove them from the belief_set as well
                 Instance ins = BDIPDDLConverter::buildInstance(mb);
-                done = !problem_expert_->getInstance(ins.name).has_value() || problem_expert_->removeInstance(ins);
+                done = !problem_expert_->getInstance(ins.name).has_value();
+                if(!done && problem_expert_->removeInstance(ins))
+                {
+                    done = true;
+                    logPsys2Write(mb, SYNC_DEL);
+                }
+                if(done)
+                    removeDanglingBeliefs(mb);
             }
 
             if(mb.pddlType() == Belief().PREDICATE_TYPE)
             {
                 Predicate pred = BDIPDDLConverter::buildPredicate(mb);
-                done = !problem_expert_->existPredicate(pred) || problem_expert_->removePredicate(pred);
+                done = !problem_expert_->existPredicate(pred);
+                if(!done && problem_expert_->removePredicate(pred))
+                {
+                    done = true;
+                    logPsys2Write(mb, SYNC_DEL);
+                }
             }
 
             if(mb.pddlType() == Belief().FUNCTION_TYPE)
             {
                 Function fun = BDIPDDLConverter::buildFunction(mb);
-                done = !problem_expert_->existFunction(fun) || problem_expert_->removeFunction(fun);
+                done = !problem_expert_->existFunction(fun);
+                if(!done && problem_expert_->removeFunction(fun))
+                {
+                    done = true;
+                    logPsys2Write(mb, SYNC_DEL);
+                }
             }
             
-            if(done)
-                belief_set_.erase(mb);
+            if(done && belief_set_.erase(mb) > 0)
+                recordBeliefSetChange(mb, SYNC_DEL);
         }
     mtx_sync.unlock();
 
     if(done)//modification has happened, publish new belief set
-        publishBeliefSet();
+        publishBeliefSetDelta();
+}
+
+/*
+    Remove a batch of beliefs from the belief set, syncing the pddl_problem to remove them from there too
+    (existence in the pddl_problem checked just for failed removals), the belief set delta is published once at the end
+*/
+void BeliefManager::delBeliefsSyncPDDL(const vector<ManagedBelief>& mbs)
+{
+    mtx_sync.lock();
+        for(const ManagedBelief& mb : mbs)
+        {
+            if(belief_set_.count(mb)==0)
+                continue;
+            
+            //try removal straight away, checking for existence just if it fails (i.e. already removed)
+            bool removed = false, done = false;
+            if(mb.pddlType() == Belief().INSTANCE_TYPE)
+            {
+                Instance ins = BDIPDDLConverter::buildInstance(mb);
+                removed = problem_expert_->removeInstance(ins);
+                done = removed || !problem_expert_->getInstance(ins.name).has_value();
+            }
+            else if(mb.pddlType() == Belief().PREDICATE_TYPE)
+            {
+                Predicate pred = BDIPDDLConverter::buildPredicate(mb);
+                removed = problem_expert_->removePredicate(pred);
+                done = removed || !problem_expert_->existPredicate(pred);
+            }
+            else if(mb.pddlType() == Belief().FUNCTION_TYPE)
+            {
+                Function fun = BDIPDDLConverter::buildFunction(mb);
+                removed = problem_expert_->removeFunction(fun);
+                done = removed || !problem_expert_->existFunction(fun);
+            }
+
+            if(removed)
+                logPsys2Write(mb, SYNC_DEL);
+            if(done && mb.pddlType() == Belief().INSTANCE_TYPE)
+                removeDanglingBeliefs(mb);//relative predicates/functions are automatically removed in the pddl_problem
+            if(done && belief_set_.erase(mb) > 0)
+                recordBeliefSetChange(mb, SYNC_DEL);
+        }
+    mtx_sync.unlock();
+
+    publishBeliefSetDelta();//notify all the modifications to belief set at once (if any)
 }
 
 /*
@@ -697,7 +1205,8 @@ void BeliefManager::delBeliefSyncPDDL(const ManagedBelief& mb)
 */
 void BeliefManager::addBelief(const ManagedBelief& mb)
 {
-    belief_set_.insert(mb);
+    if(belief_set_.insert(mb).second)
+        recordBeliefSetChange(mb, SYNC_ADD);
     if(this->get_parameter(PARAM_DEBUG).as_bool())
         RCLCPP_INFO(this->get_logger(), "Added belief ("+mb.pddlTypeString()+"): " + 
             mb.getName() + " " + (mb.pddlType() == Belief().INSTANCE_TYPE? mb.type().name : mb.getParamsJoined()) + 
@@ -716,6 +1225,7 @@ void BeliefManager::modifyBelief(const ManagedBelief& mb)
     if(belief_set_.count(mb) == 1){
         belief_set_.erase(mb);
         belief_set_.insert(mb);
+        recordBeliefSetChange(mb, SYNC_UPD);
         if(this->get_parameter(PARAM_DEBUG).as_bool())
             RCLCPP_INFO(this->get_logger(), "Modified belief ("+mb.pddlTypeString()+"): " + 
                 mb.getName() + " " + (mb.pddlType() == Belief().INSTANCE_TYPE? mb.type().name : mb.getParamsJoined()) + 
@@ -730,7 +1240,8 @@ void BeliefManager::modifyBelief(const ManagedBelief& mb)
 */
 void BeliefManager::delBelief(const ManagedBelief& mb)
 {
-    belief_set_.erase(mb);
+    if(belief_set_.erase(mb) > 0)
+        recordBeliefSetChange(mb, SYNC_DEL);
     if(this->get_parameter(PARAM_DEBUG).as_bool())
         RCLCPP_INFO(this->get_logger(), "Removed belief ("+mb.pddlTypeString()+"): " + 
             mb.getName() + " " + (mb.pddlType() == Belief().INSTANCE_TYPE? mb.type().name : mb.getParamsJoined()) + 
@@ -739,23 +1250,18 @@ void BeliefManager::delBelief(const ManagedBelief& mb)
             );
 }
 
-int main(int argc, char ** argv)
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/belief_manager.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(BeliefManager& node)
 {
-  rclcpp::init(argc, argv);
-  auto node = std::make_shared<BeliefManager>();
-  bool psys2_booted = node->wait_psys2_boot(std::chrono::seconds(8));//Wait max 8 seconds for plansys2 to boot
-  
-  if(psys2_booted)
-  {
-    node->init();
-    rclcpp::spin(node);
-  }
-  else
-  {
-    std::cerr << "PlanSys2 failed to boot: node will not spin and process will terminate" << std::endl;
-  }
-  
-  rclcpp::shutdown();
+    if(!node.wait_psys2_boot(std::chrono::seconds(8)))//Wait max 8 seconds for plansys2 to boot
+        return false;
 
-  return 0;
+    node.init();
+    return true;
 }
+
+typedef CoreComponent<BeliefManager> BeliefManagerComponent;
+RCLCPP_COMPONENTS_REGISTER_NODE(BeliefManagerComponent)
@@ -12,23 +12,32 @@
 
 #include "ros2_bdi_utils/BDIYAMLParser.hpp"
 
+// boot as rclcpp component
+#include "ros2_bdi_core/support/core_component.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
+
 using ros2_bdi_interfaces::msg::Belief;
 using ros2_bdi_interfaces::msg::BeliefSet;
+using ros2_bdi_interfaces::msg::BeliefSetDelta;
 using ros2_bdi_interfaces::msg::Desire;
 using ros2_bdi_interfaces::msg::LifecycleStatus;
 
 using BDIManaged::ManagedBelief;
 using BDIManaged::ManagedReactiveRule;
+using BDIManaged::BeliefSetMirror;
+using BDIManaged::BeliefStore;
+using BDIManaged::ReactiveRuleMatcher;
 using std::string;
 using std::vector;
 using std::set;
 using std::map;
 using std::bind;
+using std::chrono::milliseconds;
 using std::placeholders::_1;
 
 
-EventListener::EventListener()
-    : rclcpp::Node(EVENT_LISTENER_NODE_NAME)//, state_(STARTING)
+EventListener::EventListener(const rclcpp::NodeOptions& options)
+    : rclcpp::Node(EVENT_LISTENER_NODE_NAME, options)//, state_(STARTING)
 {
     this->declare_parameter(PARAM_AGENT_ID, "agent0");
     this->declare_parameter(PARAM_DEBUG, true);
@@ -53,10 +62,8 @@ bool EventListener::init()
     // init rules set
     reactive_rules_ = init_reactive_rules();
     if(reactive_rules_.size() == 0)
-    {   
-        rclcpp::shutdown();
-        return false;
-    }
+        return false;//nothing to do (standalone executable terminates, within a container the node just stays idle)
+    rule_matcher_ = ReactiveRuleMatcher{reactive_rules_};
 
     //lifecycle status init
     auto lifecycle_status = LifecycleStatus{};
@@ -83,6 +90,11 @@ bool EventListener::init()
     belief_set_subscription_ = this->create_subscription<BeliefSet>(
                 BELIEF_SET_TOPIC, qos_reliable,
                 bind(&EventListener::updBeliefSetCallback, this, _1));
+    belief_set_delta_subscription_ = this->create_subscription<BeliefSetDelta>(
+                BELIEF_SET_DELTA_TOPIC, qos_reliable,
+                bind(&EventListener::updBeliefSetDeltaCallback, this, _1));
+    // ask for a full snapshot when the mirror gets out of sync
+    belief_set_request_publisher_ = this->create_publisher<std_msgs::msg::Empty>(BELIEF_SET_REQUEST_TOPIC, qos_reliable);
 
     // add/del belief publishers init.
     add_belief_publisher_ = this->create_publisher<Belief>(ADD_BELIEF_TOPIC, qos_reliable);
@@ -92,9 +104,25 @@ bool EventListener::init()
     add_desire_publisher_ = this->create_publisher<Desire>(ADD_DESIRE_TOPIC, qos_reliable);
     del_desire_publisher_ = this->create_publisher<Desire>(DEL_DESIRE_TOPIC, qos_reliable);
 
+    //loop to be called regularly to perform work (publish lifecycle status)
+    do_work_timer_ = this->create_wall_timer(
+        milliseconds(500),
+        bind(&EventListener::step, this));
+
     return true;
 }
 
+/*
+    Main loop of work called regularly through a wall timer (publish the lifecycle status)
+*/
+void EventListener::step()
+{
+    if(step_counter_ % 4 == 0)
+        lifecycle_status_publisher_->publish(getLifecycleStatus());
+    
+    step_counter_++;
+}
+
 /*Build updated LifecycleStatus msg*/
 LifecycleStatus EventListener::getLifecycleStatus()
 {
@@ -131,137 +159,51 @@ set<ManagedReactiveRule> EventListener::init_reactive_rules()
     return rules;
 }
 
-void EventListener::updBeliefSetCallback(const BeliefSet::SharedPtr msg)
+/*
+    Received a full belief set snapshot: realign the mirror (and the rule matcher) and check the rules if anything has changed
+*/
+void EventListener::updBeliefSetCallback(const BeliefSet::ConstSharedPtr msg)
 {
-    std::set<BDIManaged::ManagedBelief> new_belief_set = BDIFilter::extractMGBeliefs(msg->value);
-    bool belief_set_upd = false;
-    if(new_belief_set.size() != belief_set_.size())
-        belief_set_upd = true;
-    else
+    if(belief_set_mirror_.applySnapshot(*msg) == BeliefSetMirror::UPDATED)
     {
-        for(BDIManaged::ManagedBelief mb : new_belief_set)
-        {
-            if(belief_set_.count(mb) == 0)
-            {
-                belief_set_upd = true;
-                break;
-            }
-        }
-    }       
-
-    if(belief_set_upd)
-    {
-        //there has been an update //TODO improve the check above and the assignment below :-(
-        belief_set_ = new_belief_set;
+        rule_matcher_.reset(belief_set_mirror_.getBeliefSet());
         if(state_ == CHECKING)
             check_if_any_rule_apply();
     }
-    
-    if(step_counter_ % 4 == 0)
-        lifecycle_status_publisher_->publish(getLifecycleStatus());
-    
-    step_counter_++;
 }
 
-/*Apply satisfying rules starting from extracted possible assignments for the placeholders*/
-void EventListener::apply_satisfying_rules(const ManagedReactiveRule& reactive_rule, const map<string, vector<ManagedBelief>>& assignments, const set<ManagedBelief>& belief_set)
+/*
+    Received a belief set delta: apply it to the mirror (and the rule matcher) and check the rules if anything has changed,
+    ask for a new snapshot if some delta has been missed
+*/
+void EventListener::updBeliefSetDeltaCallback(const BeliefSetDelta::ConstSharedPtr msg)
 {
-    vector<int> current_choices = vector<int>(assignments.size(),0); // init current_choices as {0,0,0,...} with length == num of placeholders
-    
-    vector<int> limit_choices = vector<int>(assignments.size(),0); // init limit_choices with max value per each digit, e.g. {3, 4, 6}
-    
-    bool reached_end = false;
-    int i = 0;
-    for(auto it = assignments.begin(); !reached_end && it != assignments.end(); ++it)
-    {
-        limit_choices[i] = it->second.size();
-        if(limit_choices[i] > 0)//there seems to be at least a combination to evaluate
-            reached_end = false;
-        else
-            reached_end = true;//stop immediately, a placeholder has no possible actual replacement with an instance
-        i++;
-    }
+    BeliefSetMirror::UpdateResult res = belief_set_mirror_.applyDelta(*msg);
+    if(res == BeliefSetMirror::GAP)
+        belief_set_request_publisher_->publish(std_msgs::msg::Empty());
 
-    while(!reached_end) // keep iterating while there is a combination to evaluate
+    else if(res == BeliefSetMirror::UPDATED)
     {
-        // use current choice and apply them to replace placeholder in reactive_rule with actual values from possible assignments
-        map<string, string> actual_assignments;
-        i = 0;
-        for(auto it = assignments.begin(); it != assignments.end(); ++it)
-        {
-            actual_assignments[it->first] = it->second[current_choices[i]].getName();
-            i++;
-        }
-
-        ManagedReactiveRule reactive_rule_subs = ManagedReactiveRule::applySubstitution(reactive_rule, actual_assignments);
-        if(reactive_rule_subs.getMGCondition().isSatisfied(belief_set_))
-            apply_rule(reactive_rule_subs);
-        else
-        {
-            // std::cout << "reactive rule " << std::to_string(reactive_rule.getId()) << " not sat with assignments:" << std::flush << std::endl;
-            // for(auto it=actual_assignments.begin(); it != actual_assignments.end(); it++)
-            //     std::cout << it->first << ": " << it->second << std::flush << std::endl;
-        }
+        for(const Belief& b : msg->removed)
+            rule_matcher_.removeBelief(ManagedBelief{b});
+        for(const Belief& b : msg->added)
+            rule_matcher_.addBelief(ManagedBelief{b});
+        for(const Belief& b : msg->modified)
+            rule_matcher_.addBelief(ManagedBelief{b});//replaces the previous one
 
-        // try to update current choice
-        bool upd = false;
-        // increment one
-        for(int i = 0; i<current_choices.size(); i++)
-        {
-            if(current_choices[i] < limit_choices[i] - 1)
-            {
-                current_choices[i]++;
-                if(i>0)
-                {
-                    int j = 0;
-                    while(j<i)
-                    {
-                        current_choices[j] = 0;
-                        j++;
-                    }
-                }
-                upd = true;
-                i = current_choices.size(); //exit immediately
-            }
-        }
-        reached_end = !upd;//if upd made -> not reached end yet
+        if(state_ == CHECKING)
+            check_if_any_rule_apply();
     }
 }
 
-
-/*Iterate over the rules and check if any of them applies, if yes enforces it*/
+/*
+    Check which rule instantiations have become satisfied since the last check (as per the incremental rule matcher)
+    and enforce them
+*/
 void EventListener::check_if_any_rule_apply()
 {
-    for(auto reactive_rule : reactive_rules_)
-    {  
-        map <string, vector<ManagedBelief>> assignments;//contains variable assigments
-        if(reactive_rule.getMGCondition().containsPlaceholders())
-        {
-            // std::cout << "reactive rule " << std::to_string(reactive_rule.getId()) << " assignments:" << std::flush << std::endl;
-            assignments = reactive_rule.getMGCondition().extractAssignmentsMap(belief_set_);
-            // for(auto key_it = assignments.begin(); key_it != assignments.end(); key_it++)
-            // {
-            //     std::cout << key_it->first << ":" << std::flush << std::endl;
-            //     for(auto mb : key_it->second)
-            //         std::cout << mb.getName() << ", ";
-            //     std::cout << std::flush << std::endl;
-            // }
-            apply_satisfying_rules(reactive_rule, assignments, belief_set_);
-        }
-
-        else if(reactive_rule.getMGCondition().isSatisfied(belief_set_))//rule with no placeholders sat -> apply rune as is
-        {
-            //std::cout << "reactive rule " << std::to_string(reactive_rule.getId()) << " SAT" << std::flush << std::endl;
-            //rule is satisfied! apply effects
-            apply_rule(reactive_rule);
-        }
-        // else
-        // {
-        //     bool res = reactive_rule.getMGCondition().isSatisfied(belief_set_);
-        //     std::cout << "reactive rule " << std::to_string(reactive_rule.getId()) << " sat = " << res
-        //         << std::flush << std::endl;
-        // }
-    }
+    for(const ManagedReactiveRule& activated_rule : rule_matcher_.newActivations())
+        apply_rule(activated_rule);
 }
 
 /*Apply reactive rule, by publishing to the right topic belief/desire set updates as defined in reactive_rule*/
@@ -274,7 +216,7 @@ void EventListener::apply_rule(const BDIManaged::ManagedReactiveRule& reactive_r
             + " value = " + std::to_string (bset_upd.second.getValue()) ;
         if(bset_upd.first == ReactiveOp::ADD)
         {
-            if(belief_set_.count(bset_upd.second) == 0)
+            if(belief_set_mirror_.getBeliefSet().count(bset_upd.second) == 0)
             {
                 if(this->get_parameter(PARAM_DEBUG).as_bool())
                     RCLCPP_INFO(this->get_logger(), "Adding belief " + bel_to_string);
@@ -283,7 +225,7 @@ void EventListener::apply_rule(const BDIManaged::ManagedReactiveRule& reactive_r
         }
         else
         {
-            if(belief_set_.count(bset_upd.second) > 0)
+            if(belief_set_mirror_.getBeliefSet().count(bset_upd.second) > 0)
             {
                 if(this->get_parameter(PARAM_DEBUG).as_bool())
                     RCLCPP_INFO(this->get_logger(), "Deleting belief " + bel_to_string);
@@ -312,27 +254,20 @@ void EventListener::apply_rule(const BDIManaged::ManagedReactiveRule& reactive_r
     }
 }
 
-
-
-int main(int argc, char ** argv)
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/event_listener.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+    (a node with no reactive rules to apply boots anyway, but just stays idle)
+*/
+bool bootCoreNode(EventListener& node)
 {
-  rclcpp::init(argc, argv);
-  auto node = std::make_shared<EventListener>();
-  bool psys2_booted = node->wait_psys2_boot(std::chrono::seconds(8));//Wait max 8 seconds for plansys2 to boot
-  
-  if(psys2_booted)
-  {
-    if(node->init())//if False, no proper reactive rules defined -> hence no point in having the node booted up 
-        rclcpp::spin(node);
-    else
-        std::cout << "Event Listener has provided with any rule to implement Belief Revision Function or Desire Generation Function, thus will be directly terminated" << std::endl;
-  }
-  else
-  {
-    std::cerr << "PlanSys2 failed to boot: node will not spin and process will terminate" << std::endl;
-  }
-    
-  rclcpp::shutdown();
+    if(!node.wait_psys2_boot(std::chrono::seconds(8)))//Wait max 8 seconds for plansys2 to boot
+        return false;
 
-  return 0;
+    if(!node.init())//no proper reactive rules defined
+        RCLCPP_INFO(node.get_logger(), "No reactive rules implementing Belief Revision Function or Desire Generation Function: Event Listener idle");
+    return true;
 }
+
+typedef CoreComponent<EventListener> EventListenerComponent;
+RCLCPP_COMPONENTS_REGISTER_NODE(EventListenerComponent)
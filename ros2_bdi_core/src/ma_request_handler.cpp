@@ -11,6 +11,10 @@
 
 #include "ros2_bdi_utils/BDIFilter.hpp"
 
+// boot as rclcpp component
+#include "ros2_bdi_core/support/core_component.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
+
 using std::string;
 using std::vector;
 using std::set;
@@ -21,24 +25,35 @@ using std::chrono::milliseconds;
 using std::bind;
 using std::placeholders::_1;
 using std::placeholders::_2;
+using std::placeholders::_3;
+using std::optional;
 
 using ros2_bdi_interfaces::msg::LifecycleStatus;
 using ros2_bdi_interfaces::msg::Belief;
 using ros2_bdi_interfaces::msg::BeliefSet;
+using ros2_bdi_interfaces::msg::BeliefSetDelta;
 using ros2_bdi_interfaces::msg::Desire;
 using ros2_bdi_interfaces::msg::DesireSet;
+using ros2_bdi_interfaces::msg::BeliefSetWrite;
+using ros2_bdi_interfaces::msg::DesireSetWrite;
+using ros2_bdi_interfaces::msg::WriteAck;
 using ros2_bdi_interfaces::srv::IsAcceptedOperation;
 using ros2_bdi_interfaces::srv::CheckBelief;
 using ros2_bdi_interfaces::srv::UpdBeliefSet;
 using ros2_bdi_interfaces::srv::CheckDesire;
 using ros2_bdi_interfaces::srv::UpdDesireSet;
+using ros2_bdi_interfaces::srv::CheckBeliefBatch;
+using ros2_bdi_interfaces::srv::UpdBeliefSetBatch;
+using ros2_bdi_interfaces::srv::CheckDesireBatch;
+using ros2_bdi_interfaces::srv::UpdDesireSetBatch;
 
 using BDIManaged::ManagedBelief;
 using BDIManaged::ManagedDesire;
+using BDIManaged::BeliefSetMirror;
 
 
-MARequestHandler::MARequestHandler()
-  : rclcpp::Node(MA_REQUEST_HANDLER_NODE_NAME)
+MARequestHandler::MARequestHandler(const rclcpp::NodeOptions& options)
+  : rclcpp::Node(MA_REQUEST_HANDLER_NODE_NAME, options)
 {
   this->declare_parameter(PARAM_AGENT_ID, "agent0");
   this->declare_parameter(PARAM_AGENT_GROUP_ID, "agent0_group");
@@ -100,59 +115,69 @@ void MARequestHandler::init()
   belief_set_subscriber_ = this->create_subscription<BeliefSet>(
               BELIEF_SET_TOPIC, qos_reliable,
               bind(&MARequestHandler::updatedBeliefSet, this, _1), sub_opt);
-  
+  belief_set_delta_subscriber_ = this->create_subscription<BeliefSetDelta>(
+              BELIEF_SET_DELTA_TOPIC, qos_reliable,
+              bind(&MARequestHandler::updatedBeliefSetDelta, this, _1), sub_opt);
+  belief_set_request_publisher_ = this->create_publisher<std_msgs::msg::Empty>(BELIEF_SET_REQUEST_TOPIC, qos_reliable);
+
   //register to desire set updates to have the mirroring of the last published version of it
   desire_set_subscriber_ = this->create_subscription<DesireSet>(
               DESIRE_SET_TOPIC, qos_reliable,
               bind(&MARequestHandler::updatedDesireSet, this, _1), sub_opt);
 
+  // belief/desire set write requests: each one is acknowledged by the belief manager/scheduler with the same request id
+  next_write_id_ = 0;
+  belief_set_write_publisher_ = this->create_publisher<BeliefSetWrite>(BELIEF_SET_WRITE_TOPIC, qos_reliable);
+  belief_set_write_ack_subscriber_ = this->create_subscription<WriteAck>(
+              BELIEF_SET_WRITE_ACK_TOPIC, qos_reliable,
+              [&](const WriteAck::SharedPtr msg){writeAcknowledged(pending_belief_writes_, *msg);}, sub_opt);
+  desire_set_write_publisher_ = this->create_publisher<DesireSetWrite>(DESIRE_SET_WRITE_TOPIC, qos_reliable);
+  desire_set_write_ack_subscriber_ = this->create_subscription<WriteAck>(
+              DESIRE_SET_WRITE_ACK_TOPIC, qos_reliable,
+              [&](const WriteAck::SharedPtr msg){writeAcknowledged(pending_desire_writes_, *msg);}, sub_opt);
+
+  // srv handlers wait for their write acknowledgement: let them run concurrently
+  callback_group_srv_ = this->create_callback_group(rclcpp::callback_group::CallbackGroupType::Reentrant);
+
   // init server for handling check belief requests from other agents
   chk_belief_server_ = this->create_service<CheckBelief>(CK_BELIEF_SRV, 
-      bind(&MARequestHandler::handleCheckBeliefRequest, this, _1, _2));
+      bind(&MARequestHandler::handleCheckBeliefRequest, this, _1, _2), rmw_qos_profile_services_default, callback_group_srv_);
   
   // init server for handling add belief requests from other agents
   add_belief_server_ = this->create_service<UpdBeliefSet>(ADD_BELIEF_SRV, 
-      bind(&MARequestHandler::handleAddBeliefRequest, this, _1, _2));
+      bind(&MARequestHandler::handleAddBeliefRequest, this, _1, _2), rmw_qos_profile_services_default, callback_group_srv_);
     
   // init server for handling del belief requests from other agents
   del_belief_server_ = this->create_service<UpdBeliefSet>(DEL_BELIEF_SRV, 
-      bind(&MARequestHandler::handleDelBeliefRequest, this, _1, _2));
-  
-  // add belief publisher -> to publish on the topic and alter the belief set when the request can go through
-  add_belief_publisher_ = this->create_publisher<Belief>(ADD_BELIEF_TOPIC, 10);
-  // del belief publisher -> to publish on the topic and alter the belief set when the request can go through
-  del_belief_publisher_ = this->create_publisher<Belief>(DEL_BELIEF_TOPIC, 10);
-
-  // init two locks for waiting belief upd
-  belief_set_upd_locks_ = vector<mutex>(2);
-  // init two counter for waiting belief upd
-  belief_waiting_for_counter_ = vector<int>(2);
-  // init two empty managed beliefs where to store the two you're waiting for an update
-  belief_waiting_for_ = vector<ManagedBelief>(2);
+      bind(&MARequestHandler::handleDelBeliefRequest, this, _1, _2), rmw_qos_profile_services_default, callback_group_srv_);
+
+  // init servers for handling check/add/del belief batch requests from other agents
+  chk_belief_batch_server_ = this->create_service<CheckBeliefBatch>(CK_BELIEF_BATCH_SRV, 
+      bind(&MARequestHandler::handleCheckBeliefBatchRequest, this, _1, _2), rmw_qos_profile_services_default, callback_group_srv_);
+  add_belief_batch_server_ = this->create_service<UpdBeliefSetBatch>(ADD_BELIEF_BATCH_SRV, 
+      bind(&MARequestHandler::handleUpdBeliefBatchRequest, this, _1, _2, ADD_I), rmw_qos_profile_services_default, callback_group_srv_);
+  del_belief_batch_server_ = this->create_service<UpdBeliefSetBatch>(DEL_BELIEF_BATCH_SRV, 
+      bind(&MARequestHandler::handleUpdBeliefBatchRequest, this, _1, _2, DEL_I), rmw_qos_profile_services_default, callback_group_srv_);
 
   // init server for handling check desire requests from other agents
   chk_desire_server_ = this->create_service<CheckDesire>(CK_DESIRE_SRV, 
-      bind(&MARequestHandler::handleCheckDesireRequest, this, _1, _2));
+      bind(&MARequestHandler::handleCheckDesireRequest, this, _1, _2), rmw_qos_profile_services_default, callback_group_srv_);
 
   // init server for handling add belief requests from other agents
   add_desire_server_ = this->create_service<UpdDesireSet>(ADD_DESIRE_SRV, 
-      bind(&MARequestHandler::handleAddDesireRequest, this, _1, _2));
+      bind(&MARequestHandler::handleAddDesireRequest, this, _1, _2), rmw_qos_profile_services_default, callback_group_srv_);
     
     // init server for handling del belief requests from other agents
   del_desire_server_ = this->create_service<UpdDesireSet>(DEL_DESIRE_SRV, 
-      bind(&MARequestHandler::handleDelDesireRequest, this, _1, _2));
+      bind(&MARequestHandler::handleDelDesireRequest, this, _1, _2), rmw_qos_profile_services_default, callback_group_srv_);
 
-  // add desire publisher -> to publish on the topic and alter the desire set when the request can go through
-  add_desire_publisher_ = this->create_publisher<Desire>(ADD_DESIRE_TOPIC, 10);
-  // del desire publisher -> to publish on the topic and alter the desire set when the request can go through
-  del_desire_publisher_ = this->create_publisher<Desire>(DEL_DESIRE_TOPIC, 10);
-
-  // init two locks for waiting desire upd
-  desire_set_upd_locks_ = vector<mutex>(2);
-  // init two counter for waiting desire upd
-  desire_waiting_for_counter_ = vector<int>(2);
-  // init two empty managed desires where to store the two you're waiting for an update
-  desire_waiting_for_ = vector<ManagedDesire>(2);
+  // init servers for handling check/add/del desire batch requests from other agents
+  chk_desire_batch_server_ = this->create_service<CheckDesireBatch>(CK_DESIRE_BATCH_SRV, 
+      bind(&MARequestHandler::handleCheckDesireBatchRequest, this, _1, _2), rmw_qos_profile_services_default, callback_group_srv_);
+  add_desire_batch_server_ = this->create_service<UpdDesireSetBatch>(ADD_DESIRE_BATCH_SRV, 
+      bind(&MARequestHandler::handleUpdDesireBatchRequest, this, _1, _2, ADD_I), rmw_qos_profile_services_default, callback_group_srv_);
+  del_desire_batch_server_ = this->create_service<UpdDesireSetBatch>(DEL_DESIRE_BATCH_SRV, 
+      bind(&MARequestHandler::handleUpdDesireBatchRequest, this, _1, _2, DEL_I), rmw_qos_profile_services_default, callback_group_srv_);
 
   string acceptingBeliefsMsg = "accepting beliefs alteration from: ";
   vector<string> acceptingBeliefsGroups = this->get_parameter(PARAM_BELIEF_WRITE).as_string_array();
@@ -303,89 +328,115 @@ float MARequestHandler::getMaxAcceptedPriority(const string& requestingAgentGrou
 }
 
 /*
-  @updIndex to be used to know which lock has to be checked among the two in desire_set_upd_locks_
-  and which waiting counter has to be incremented and/or checked
-
-  @countCheck in order to check if desire is present (ADD op) or not present (DEL op)
+    The desire set has been updated
 */
-void MARequestHandler::checkDesireSetWaitingUpd(const int& updIndex, const int& countCheck)
+void MARequestHandler::updatedDesireSet(const DesireSet::ConstSharedPtr msg)
 {
-  if(updIndex > desire_set_upd_locks_.size() || countCheck < 0)//invalid params
-    return;
-
-    
-  if(desire_set_upd_locks_[updIndex].try_lock())//try lock 
-  {
-    // if acquired, release immediately (no waiting for any belief upd operation)
-    desire_set_upd_locks_[updIndex].unlock();
-  }
-  else
-  {
-    //waiting for a belief upd operation
-    if(desire_set_.count(desire_waiting_for_[updIndex]) == countCheck || desire_waiting_for_counter_[updIndex] == MAX_WAIT_UPD)
-      desire_set_upd_locks_[updIndex].unlock();// acquired by add_desire/del_desire srv, release it so it can proceed if alteration done or waited too much already
-    else
-      desire_waiting_for_counter_[updIndex]++;
-  }
+    process_desire_set_upd_lock_.lock();
+    {
+      desire_set_ = BDIFilter::extractMGDesires(msg->value);
+    }
+    process_desire_set_upd_lock_.unlock();
 }
 
 /*
-    The desire set has been updated
+    The belief set has been updated
 */
-void MARequestHandler::updatedDesireSet(const DesireSet::SharedPtr msg)
+void MARequestHandler::updatedBeliefSet(const BeliefSet::ConstSharedPtr msg)
 {
-    process_desire_set_upd_lock_.lock();
+    process_belief_set_upd_lock_.lock();
     {
-      desire_set_ = BDIFilter::extractMGDesires(msg->value);
+      belief_set_mirror_.applySnapshot(*msg);
+    }
+    process_belief_set_upd_lock_.unlock();
+}
 
-              
-      //check for waiting belief set alteration
-      checkDesireSetWaitingUpd(ADD_I, 1);//check belief set for addition
-      checkDesireSetWaitingUpd(DEL_I, 0);//check belief set for deletion
+/*
+    A belief set delta has been received (ask for a new snapshot if some delta has been missed)
+*/
+void MARequestHandler::updatedBeliefSetDelta(const BeliefSetDelta::ConstSharedPtr msg)
+{
+    process_belief_set_upd_lock_.lock();
+    {
+      if(belief_set_mirror_.applyDelta(*msg) == BeliefSetMirror::GAP)
+        belief_set_request_publisher_->publish(std_msgs::msg::Empty());
     }
-    process_desire_set_upd_lock_.unlock();
+    process_belief_set_upd_lock_.unlock();
 }
 
 /*
-  @updIndex to be used to know which lock has to be checked among the two in belief_set_upd_locks_
-  and which waiting counter has to be incremented and/or checked
+  Submit the write of @beliefs (@updIndex = ADD_I/DEL_I) to the belief manager and wait for its acknowledgement
+  (at most WRITE_ACK_TIMEOUT ms): return it, if it has come in time
+*/
+optional<WriteAck> MARequestHandler::writeBeliefSet(const vector<Belief>& beliefs, const int& updIndex)
+{
+  BeliefSetWrite write_msg = BeliefSetWrite();
+  write_msg.request_id = next_write_id_++;
+  write_msg.operation = (updIndex == ADD_I)? write_msg.ADD : write_msg.DEL;
+  write_msg.value = beliefs;
+
+  auto ack = std::make_shared<std::promise<WriteAck>>();
+  std::future<WriteAck> ack_future = ack->get_future();
+  mtx_pending_writes_.lock();
+    pending_belief_writes_[write_msg.request_id] = ack;
+  mtx_pending_writes_.unlock();
+
+  belief_set_write_publisher_->publish(write_msg);
+  return waitWriteAck(pending_belief_writes_, write_msg.request_id, ack_future);
+}
 
-  @countCheck in order to check if belief is present (ADD op) or not present (DEL op)
+/*
+  Submit the write of @desires (@updIndex = ADD_I/DEL_I) to the scheduler and wait for its acknowledgement
+  (at most WRITE_ACK_TIMEOUT ms): return it, if it has come in time
 */
-void MARequestHandler::checkBeliefSetWaitingUpd(const int& updIndex, const int& countCheck)
+optional<WriteAck> MARequestHandler::writeDesireSet(const vector<Desire>& desires, const int& updIndex)
 {
-  if(updIndex > belief_set_upd_locks_.size() || countCheck < 0)//invalid params
-    return;
+  DesireSetWrite write_msg = DesireSetWrite();
+  write_msg.request_id = next_write_id_++;
+  write_msg.operation = (updIndex == ADD_I)? write_msg.ADD : write_msg.DEL;
+  write_msg.value = desires;
+
+  auto ack = std::make_shared<std::promise<WriteAck>>();
+  std::future<WriteAck> ack_future = ack->get_future();
+  mtx_pending_writes_.lock();
+    pending_desire_writes_[write_msg.request_id] = ack;
+  mtx_pending_writes_.unlock();
+
+  desire_set_write_publisher_->publish(write_msg);
+  return waitWriteAck(pending_desire_writes_, write_msg.request_id, ack_future);
+}
 
-  if(belief_set_upd_locks_[updIndex].try_lock())//try lock 
-  {
-    // if acquired, release immediately (no waiting for any belief upd operation)
-    belief_set_upd_locks_[updIndex].unlock();
-  }
-  else
-  {
-    //waiting for a belief upd operation
-    if(belief_set_.count(belief_waiting_for_[updIndex]) == countCheck || belief_waiting_for_counter_[updIndex] == MAX_WAIT_UPD)
-      belief_set_upd_locks_[updIndex].unlock();// acquired by add_belief/del_belief srv, release it so it can proceed if alteration done or waited too much already
-    else
-      belief_waiting_for_counter_[updIndex]++;
-  }
+/*
+  Wait for the acknowledgement of the write @requestId among @pendingWrites (at most WRITE_ACK_TIMEOUT ms)
+*/
+optional<WriteAck> MARequestHandler::waitWriteAck(map<uint64_t, shared_ptr<std::promise<WriteAck>>>& pendingWrites,
+    const uint64_t& requestId, std::future<WriteAck>& ackFuture)
+{
+  bool acknowledged = ackFuture.wait_for(milliseconds(WRITE_ACK_TIMEOUT)) == std::future_status::ready;
+  
+  // not waiting anymore (acknowledged writes have already been removed)
+  mtx_pending_writes_.lock();
+    pendingWrites.erase(requestId);
+  mtx_pending_writes_.unlock();
+
+  if(acknowledged)
+    return ackFuture.get();
+  return std::nullopt;
 }
 
 /*
-    The belief set has been updated
+  A write has been acknowledged: wake up the handler waiting for it among @pendingWrites (if still there)
 */
-void MARequestHandler::updatedBeliefSet(const BeliefSet::SharedPtr msg)
+void MARequestHandler::writeAcknowledged(map<uint64_t, shared_ptr<std::promise<WriteAck>>>& pendingWrites, const WriteAck& ack)
 {
-    process_belief_set_upd_lock_.lock();
+  mtx_pending_writes_.lock();
+    auto pending = pendingWrites.find(ack.request_id);
+    if(pending != pendingWrites.end())
     {
-      belief_set_ = BDIFilter::extractMGBeliefs(msg->value);
-
-      //check for waiting belief set alteration
-      checkBeliefSetWaitingUpd(ADD_I, 1);//check belief set for addition
-      checkBeliefSetWaitingUpd(DEL_I, 0);//check belief set for deletion
+      pending->second->set_value(ack);
+      pendingWrites.erase(pending);
     }
-    process_belief_set_upd_lock_.unlock();
+  mtx_pending_writes_.unlock();
 }
 
 /*  
@@ -401,7 +452,9 @@ void MARequestHandler::handleCheckBeliefRequest(const CheckBelief::Request::Shar
   else
   {
     response->accepted = true;
-    response->found = belief_set_.count(ManagedBelief{request->belief}) == 1;
+    process_belief_set_upd_lock_.lock();
+      response->found = belief_set_mirror_.getBeliefSet().count(ManagedBelief{request->belief}) == 1;
+    process_belief_set_upd_lock_.unlock();
   }
 }
 
@@ -420,16 +473,8 @@ void MARequestHandler::handleAddBeliefRequest(const UpdBeliefSet::Request::Share
   else
   {
     response->accepted = true;
-    add_belief_publisher_->publish(request->belief);
-    
-    belief_set_upd_locks_[ADD_I].lock();
-      belief_waiting_for_[ADD_I] = ManagedBelief{request->belief};
-      belief_waiting_for_counter_[ADD_I] = 0;
-    belief_set_upd_locks_[ADD_I].lock();//stuck until belief_set upd unlock it
-    belief_set_upd_locks_[ADD_I].unlock();//release it
-
-    response->updated = belief_set_.count(ManagedBelief{request->belief}) == 1;
-
+    auto ack = writeBeliefSet({request->belief}, ADD_I);
+    response->updated = ack.has_value() && ack.value().performed.size() == 1 && ack.value().performed[0];
   }
 }
 
@@ -446,15 +491,8 @@ void MARequestHandler::handleDelBeliefRequest(const UpdBeliefSet::Request::Share
   else
   {
     response->accepted = true;
-    del_belief_publisher_->publish(request->belief);
-    
-    belief_set_upd_locks_[DEL_I].lock();
-      belief_waiting_for_[DEL_I] = ManagedBelief{request->belief};
-      belief_waiting_for_counter_[DEL_I] = 0;
-    belief_set_upd_locks_[DEL_I].lock();//stuck until belief_set upd unlock it
-    belief_set_upd_locks_[DEL_I].unlock();//release it
-
-    response->updated = belief_set_.count(ManagedBelief{request->belief}) == 0;
+    auto ack = writeBeliefSet({request->belief}, DEL_I);
+    response->updated = ack.has_value() && ack.value().performed.size() == 1 && ack.value().performed[0];
   }
 }
 
@@ -471,7 +509,9 @@ void MARequestHandler::handleCheckDesireRequest(const CheckDesire::Request::Shar
   else
   {
     response->accepted = true;
-    response->found = desire_set_.count(ManagedDesire{request->desire}) == 1;
+    process_desire_set_upd_lock_.lock();
+      response->found = desire_set_.count(ManagedDesire{request->desire}) == 1;
+    process_desire_set_upd_lock_.unlock();
   }
 }
 
@@ -494,15 +534,15 @@ void MARequestHandler::handleAddDesireRequest(const UpdDesireSet::Request::Share
       response->accepted = true;
       // set at most the desire priority to the fixed upper threshold
       request->desire.priority = std::max(0.000f, std::min(request->desire.priority, maxAcceptedPriority)); 
-      add_desire_publisher_->publish(request->desire);
-              
-      desire_set_upd_locks_[ADD_I].lock();
-        desire_waiting_for_[ADD_I] = ManagedDesire{request->desire};
-        desire_waiting_for_counter_[ADD_I] = 0;
-      desire_set_upd_locks_[ADD_I].lock();//stuck until desire_set upd unlock it
-      desire_set_upd_locks_[ADD_I].unlock();//release it
-
-      response->updated = desire_set_.count(ManagedDesire{request->desire}) == 1 || ManagedDesire{request->desire}.isFulfilled(belief_set_);
+      auto ack = writeDesireSet({request->desire}, ADD_I);
+
+      response->updated = ack.has_value() && ack.value().performed.size() == 1 && ack.value().performed[0];
+      if(!response->updated)// not added, but maybe just because already fulfilled
+      {
+        process_belief_set_upd_lock_.lock();
+          response->updated = ManagedDesire{request->desire}.isFulfilled(belief_set_mirror_.getBeliefSet());
+        process_belief_set_upd_lock_.unlock();
+      }
     }
     else
       response->accepted = false;// max priority for given agent's requesting group is negative -> not accepted
@@ -523,37 +563,114 @@ void MARequestHandler::handleDelDesireRequest(const UpdDesireSet::Request::Share
   else
   {
     response->accepted = true;
-    del_desire_publisher_->publish(request->desire);
-    desire_set_upd_locks_[DEL_I].lock();
-        desire_waiting_for_[DEL_I] = ManagedDesire{request->desire};
-        desire_waiting_for_counter_[DEL_I] = 0;
-    desire_set_upd_locks_[DEL_I].lock();//stuck until desire_set upd unlock it
-    desire_set_upd_locks_[DEL_I].unlock();//release it
-
-    response->updated = desire_set_.count(ManagedDesire{request->desire}) == 0;
+    auto ack = writeDesireSet({request->desire}, DEL_I);
+    response->updated = ack.has_value() && ack.value().performed.size() == 1 && ack.value().performed[0];
   }
 }
 
+/*  
+    Read Belief Batch Request service handler        
+*/
+void MARequestHandler::handleCheckBeliefBatchRequest(const CheckBeliefBatch::Request::SharedPtr request,
+    const CheckBeliefBatch::Response::SharedPtr response)
+{
+  //see if the requesting agent belongs to a group which is entitled to this kind of requests
+  bool accepted = isAcceptableRequest(request->agent_group, BELIEF, CHECK);
+  process_belief_set_upd_lock_.lock();
+  for(const Belief& belief : request->beliefs)
+  {
+    response->accepted.push_back(accepted);
+    response->found.push_back(accepted && belief_set_mirror_.getBeliefSet().count(ManagedBelief{belief}) == 1);
+  }
+  process_belief_set_upd_lock_.unlock();
+}
 
+/*  
+    Add (@updIndex = ADD_I) / Del (@updIndex = DEL_I) Belief Batch Request service handler:
+    the whole batch goes within a single belief set write, acknowledged once by the belief manager
+*/
+void MARequestHandler::handleUpdBeliefBatchRequest(const UpdBeliefSetBatch::Request::SharedPtr request,
+    const UpdBeliefSetBatch::Response::SharedPtr response, const int& updIndex)
+{
+  //see if the requesting agent belongs to a group which is entitled to this kind of requests
+  bool accepted = isAcceptableRequest(request->agent_group, BELIEF, WRITE);
+  response->accepted = vector<bool>(request->beliefs.size(), accepted);
+  response->updated = vector<bool>(request->beliefs.size(), false);
+  if(!accepted || request->beliefs.empty())
+    return;
 
-int main(int argc, char ** argv)
+  auto ack = writeBeliefSet(request->beliefs, updIndex);
+  for(int i = 0; ack.has_value() && i < response->updated.size() && i < ack.value().performed.size(); i++)
+    response->updated[i] = ack.value().performed[i];
+}
+
+/*  
+    Read Desire Batch Request service handler        
+*/
+void MARequestHandler::handleCheckDesireBatchRequest(const CheckDesireBatch::Request::SharedPtr request,
+    const CheckDesireBatch::Response::SharedPtr response)
 {
-  rclcpp::init(argc, argv);
-  auto node = std::make_shared<MARequestHandler>();
-  bool psys2_booted = node->wait_psys2_boot(std::chrono::seconds(8));//Wait max 8 seconds for plansys2 to boot
-  
-  if(psys2_booted)
+  //see if the requesting agent belongs to a group which is entitled to this kind of requests
+  bool accepted = isAcceptableRequest(request->agent_group, DESIRE, CHECK);
+  process_desire_set_upd_lock_.lock();
+  for(const Desire& desire : request->desires)
   {
-    node->init();
-    rclcpp::executors::MultiThreadedExecutor executor;
-    executor.add_node(node);
-    executor.spin();
+    response->accepted.push_back(accepted);
+    response->found.push_back(accepted && desire_set_.count(ManagedDesire{desire}) == 1);
   }
-  else
+  process_desire_set_upd_lock_.unlock();
+}
+
+/*  
+    Add (@updIndex = ADD_I) / Del (@updIndex = DEL_I) Desire Batch Request service handler:
+    the whole batch goes within a single desire set write, acknowledged once by the scheduler
+*/
+void MARequestHandler::handleUpdDesireBatchRequest(const UpdDesireSetBatch::Request::SharedPtr request,
+    const UpdDesireSetBatch::Response::SharedPtr response, const int& updIndex)
+{
+  //see if the requesting agent belongs to a group which is entitled to this kind of requests
+  bool accepted = isAcceptableRequest(request->agent_group, DESIRE, WRITE);
+  float maxAcceptedPriority = getMaxAcceptedPriority(request->agent_group);
+  if(updIndex == ADD_I)
+    accepted = accepted && maxAcceptedPriority >= 0;// max priority for given agent's requesting group is negative -> not accepted
+  
+  response->accepted = vector<bool>(request->desires.size(), accepted);
+  response->updated = vector<bool>(request->desires.size(), false);
+  if(!accepted || request->desires.empty())
+    return;
+
+  if(updIndex == ADD_I)
+    for(Desire& desire : request->desires)
+      // set at most the desire priority to the fixed upper threshold
+      desire.priority = std::max(0.000f, std::min(desire.priority, maxAcceptedPriority));
+
+  auto ack = writeDesireSet(request->desires, updIndex);
+  for(int i = 0; ack.has_value() && i < response->updated.size() && i < ack.value().performed.size(); i++)
+    response->updated[i] = ack.value().performed[i];
+
+  if(updIndex == ADD_I)
   {
-    std::cerr << "PlanSys2 failed to boot: node will not spin and process will terminate" << std::endl;
+    // not added, but maybe just because already fulfilled
+    process_belief_set_upd_lock_.lock();
+    for(int i = 0; i < response->updated.size(); i++)
+      if(!response->updated[i])
+        response->updated[i] = ManagedDesire{request->desires[i]}.isFulfilled(belief_set_mirror_.getBeliefSet());
+    process_belief_set_upd_lock_.unlock();
   }
-  rclcpp::shutdown();
+}
+
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/ma_request_handler.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(MARequestHandler& node)
+{
+    if(!node.wait_psys2_boot(std::chrono::seconds(8)))//Wait max 8 seconds for plansys2 to boot
+        return false;
 
-  return 0;
+    node.init();
+    return true;
 }
+
+typedef CoreComponent<MARequestHandler> MARequestHandlerComponent;
+RCLCPP_COMPONENTS_REGISTER_NODE(MARequestHandlerComponent)
@@ -0,0 +1,26 @@
+// header file for Event Listener node
+#include "ros2_bdi_core/event_listener.hpp"
+
+#include <iostream>
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto node = std::make_shared<EventListener>();
+  
+  if(bootCoreNode(*node))
+  {
+    if(node->hasReactiveRules())//if False, no proper reactive rules defined -> hence no point in having the node running
+        rclcpp::spin(node);
+    else
+        std::cout << "Event Listener has not been provided with any rule to implement Belief Revision Function or Desire Generation Function, thus will be directly terminated" << std::endl;
+  }
+  else
+  {
+    std::cerr << "PlanSys2 failed to boot: node will not spin and process will terminate" << std::endl;
+  }
+  
+  rclcpp::shutdown();
+
+  return 0;
+}
@@ -0,0 +1,26 @@
+// header file for MA Request Handler node
+#include "ros2_bdi_core/ma_request_handler.hpp"
+
+#include <iostream>
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto node = std::make_shared<MARequestHandler>();
+  
+  if(bootCoreNode(*node))
+  {
+    // srv handlers wait for their write acknowledgement: enough threads for MAX_CONCURRENT_WRITES of them + subscriptions
+    rclcpp::executors::MultiThreadedExecutor executor(rclcpp::ExecutorOptions(), MAX_CONCURRENT_WRITES + 2);
+    executor.add_node(node);
+    executor.spin();
+  }
+  else
+  {
+    std::cerr << "PlanSys2 failed to boot: node will not spin and process will terminate" << std::endl;
+  }
+  
+  rclcpp::shutdown();
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+// header file for PlanSys2 Monitor node
+#include "ros2_bdi_core/plansys_monitor.hpp"
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto node = std::make_shared<PlanSysMonitor>();
+
+  bootCoreNode(*node);//waits for PlanSys2 to boot
+  rclcpp::spin(node);
+  rclcpp::shutdown();
+
+  return 0;
+}
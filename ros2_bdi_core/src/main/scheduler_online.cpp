@@ -0,0 +1,23 @@
+// header file for Scheduler (online planning mode) node
+#include "ros2_bdi_core/scheduler_online.hpp"
+
+#include <iostream>
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto node = std::make_shared<SchedulerOnline>();
+  
+  if(bootCoreNode(*node))
+  {
+    rclcpp::spin(node);
+  }
+  else
+  {
+    std::cerr << "PlanSys2 failed to boot: node will not spin and process will terminate" << std::endl;
+  }
+  
+  rclcpp::shutdown();
+
+  return 0;
+}
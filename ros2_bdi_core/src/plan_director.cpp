@@ -11,6 +11,9 @@
 // Inner logic + ROS2 PARAMS & FIXED GLOBAL VALUES for PlanSys2 Monitor node (for psys2 state topic)
 #include "ros2_bdi_core/params/plansys_monitor_params.hpp"
 
+#include <numeric>
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 
 #include "plansys2_msgs/msg/action_execution_info.hpp"
@@ -18,9 +21,14 @@
 #include "ros2_bdi_utils/ManagedConditionsDNF.hpp"
 #include "ros2_bdi_utils/PDDLBDIConverter.hpp"
 #include "ros2_bdi_utils/BDIFilter.hpp"
+#include "ros2_bdi_utils/WildPattern.hpp"
 #include "ros2_bdi_utils/PDDLUtils.hpp"
 
 
+// boot as rclcpp component
+#include "ros2_bdi_core/support/core_component.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
+
 using std::string;
 using std::set;
 using std::map;
@@ -45,6 +53,7 @@ using plansys2_msgs::msg::DurativeAction;
 using ros2_bdi_interfaces::msg::LifecycleStatus;
 using ros2_bdi_interfaces::msg::Belief;
 using ros2_bdi_interfaces::msg::BeliefSet;
+using ros2_bdi_interfaces::msg::BeliefSetDelta;
 using ros2_bdi_interfaces::msg::Desire;
 using ros2_bdi_interfaces::msg::PlanningSystemState;
 using ros2_bdi_interfaces::msg::BDIActionExecutionInfo;
@@ -54,14 +63,19 @@ using ros2_bdi_interfaces::msg::BDIPlan;
 using ros2_bdi_interfaces::srv::BDIPlanExecution;
 
 using BDIManaged::ManagedBelief;
+using BDIManaged::ManagedCondition;
+using BDIManaged::ManagedConditionsConjunction;
 using BDIManaged::ManagedConditionsDNF;
 using BDIManaged::ManagedDesire;
 using BDIManaged::ManagedPlan;
+using BDIManaged::BeliefSetMirror;
+using BDIManaged::WildPattern;
 
-PlanDirector::PlanDirector()
-  : rclcpp::Node(PLAN_DIRECTOR_NODE_NAME), state_(STARTING)
+PlanDirector::PlanDirector(const rclcpp::NodeOptions& options)
+  : rclcpp::Node(PLAN_DIRECTOR_NODE_NAME, options), state_(STARTING)
 {
     psys2_comm_errors_ = 0;
+    context_violated_intention_ = -1;
     this->declare_parameter(PARAM_AGENT_ID, "agent0");
     this->declare_parameter(PARAM_DEBUG, true);
     this->declare_parameter(PARAM_CANCEL_AFTER_DEADLINE, DEFAULT_VAL_CANCEL_AFTER_DEADLINE);
@@ -93,10 +107,14 @@ void PlanDirector::init()
 
     // initializing executor client for psys2
     executor_client_ = std::make_shared<plansys2::ExecutorClient>();
+    // initializing action client for plan executions by psys2 executor (feedback streamed within this node)
+    execute_plan_client_ = rclcpp_action::create_client<ExecutePlan>(this, PSYS2_EXECUTE_PLAN_ACTION);
+    plan_exec_id_ = 0;
+    plan_exec_status_ = BDIPlanExecutionInfo().RUNNING;
     // initializing domain expert client for psys2
     domain_expert_client_ = std::make_shared<plansys2::DomainExpertClient>();
-    // initializing problem expert client for psys2
-    problem_expert_client_ = std::make_shared<plansys2::ProblemExpertClient>();
+    // durative action schemas retrieved through it at first use
+    pddl_metadata_ = BDIManaged::PDDLMetadataCache{domain_expert_client_};
 
     rclcpp::QoS qos_reliable = rclcpp::QoS(10);
     qos_reliable.reliable();
@@ -135,6 +153,11 @@ void PlanDirector::init()
     belief_set_subscriber_ = this->create_subscription<BeliefSet>(
                 BELIEF_SET_TOPIC, qos_reliable,
                 bind(&PlanDirector::updatedBeliefSet, this, _1));
+    //belief_set_delta_subscriber_ 
+    belief_set_delta_subscriber_ = this->create_subscription<BeliefSetDelta>(
+                BELIEF_SET_DELTA_TOPIC, qos_reliable,
+                bind(&PlanDirector::updatedBeliefSetDelta, this, _1));
+    belief_set_request_publisher_ = this->create_publisher<std_msgs::msg::Empty>(BELIEF_SET_REQUEST_TOPIC, qos_reliable);
 
     // belief add + belief del publishers
     belief_add_publisher_ = this->create_publisher<Belief>(ADD_BELIEF_TOPIC, 10);
@@ -198,8 +221,9 @@ void PlanDirector::step()
 
         case EXECUTING:
         {    
-            //RCLCPP_INFO(this->get_logger(), "Checking plan execution");
-            executingPlan();
+            // plan execution monitored upon executor feedback (planFeedback) and belief set updates (checkContextConditions),
+            // just watch here for an executor gone down or not streaming anything anymore (no result would ever arrive)
+            checkExecutorAlive();
             break;
         }
 
@@ -215,16 +239,6 @@ void PlanDirector::step()
     step_counter_++;
 }   
 
-/*
-    Check planExecution feedback from plansys2 executor + check for context conditions
-*/
-void PlanDirector::executingPlan()
-{
-    counter_check_++; 
-    checkPlanExecution(); // get feedback from executor
-    checkContextConditions(); // check if context conditions are still valid and true -> abort otherwise
-}
-
 /*
     When in READY state, msg to publish in plan_execution_info to notify it 
     (i.e. notify you're not executing any plan)
@@ -255,10 +269,31 @@ LifecycleStatus PlanDirector::getLifecycleStatus()
 void PlanDirector::callbackPsys2State(const PlanningSystemState::SharedPtr msg)
 {
     psys2_domain_expert_active_ = msg->domain_expert_active;
+    if(!psys2_domain_expert_active_)
+        pddl_metadata_.invalidateDomain();//domain retrieved again once the domain expert is back
     psys2_problem_expert_active_ = msg->problem_expert_active;
     psys2_executor_active_ = msg->executor_active;
 }
 
+/*
+    Plan currently in execution, abort it if the executor appears down or has not streamed any feedback 
+    for more than N times the plan deadline (N ros2 parameter && >= 1.0)
+*/
+void PlanDirector::checkExecutorAlive()
+{
+    float cancelAfterDeadline = std::max(1.0f, (float) this->get_parameter(PARAM_CANCEL_AFTER_DEADLINE).as_double());
+    float silenceTimeout = cancelAfterDeadline * std::max(1.0f, current_plan_.getPlannedDeadline());
+    float silence = std::chrono::duration<float>(high_resolution_clock::now() - last_plan_feedback_).count();
+    
+    if(!psys2_executor_active_ || silence >= silenceTimeout)
+    {
+        RCLCPP_ERROR(this->get_logger(), (!psys2_executor_active_)? 
+            "PlanSys2 Executor not active anymore: aborting current plan execution" :
+            "No feedback from PlanSys2 Executor for " + std::to_string(silence) + "s: aborting current plan execution");
+        cancelCurrentPlanExecution();
+    }
+}
+
 /*
     Currently executing no plan
 */
@@ -272,8 +307,16 @@ bool PlanDirector::executingNoPlan()
 */
 void PlanDirector::cancelCurrentPlanExecution()
 {
-    //cancel plan execution
-    executor_client_->cancel_plan_execution();
+    //cancel plan execution (if the executor has not accepted it yet, it's cancelled as soon as it does in planGoalResponse)
+    if(plan_goal_handle_)
+    {
+        try{
+            execute_plan_client_->async_cancel_goal(plan_goal_handle_);
+        }catch(const rclcpp_action::exceptions::UnknownGoalHandleError& e){
+            //result already received for it
+        }
+    }
+    plan_exec_status_ = BDIPlanExecutionInfo().ABORT;
     if(this->get_parameter(PARAM_DEBUG).as_bool())
         RCLCPP_INFO(this->get_logger(), "Aborted plan execution");
 
@@ -283,16 +326,81 @@ void PlanDirector::cancelCurrentPlanExecution()
 
 /*
     Start new plan execution -> true if correctly started
+    (@concurrentPlans executed alongside @mp: all of them are merged into a single plan for the PlanSys2 executor)
 */
-bool PlanDirector::startPlanExecution(const ManagedPlan& mp)
+bool PlanDirector::startPlanExecution(const ManagedPlan& mp, const vector<ManagedPlan>& concurrentPlans)
 {
     // prepare plansys2 msg for plan execution
     Plan plan_to_execute = mp.toPsys2Plan();
 
-    // select current_plan_ which will start execution
-    current_plan_ = mp;
+    intentions_ = vector<ManagedPlan>{mp};
+    intentions_.insert(intentions_.end(), concurrentPlans.begin(), concurrentPlans.end());
+    intention_terminated_ = vector<bool>(intentions_.size(), false);
+    context_violated_intention_ = -1;
+    action_intention_.clear();
+    action_intention_index_.clear();
+
+    if(concurrentPlans.size() > 0)
+    {
+        // merge the intentions' actions sorted by planned start time, keeping track of the intention each one comes from
+        vector<PlanItem> items;
+        vector<int> items_intention, items_intention_index;
+        for(int i = 0; i < intentions_.size(); i++)
+        {
+            vector<PlanItem> intention_items = intentions_[i].toPsys2Plan().items;
+            for(int j = 0; j < intention_items.size(); j++)
+            {
+                items.push_back(intention_items[j]);
+                items_intention.push_back(i);
+                items_intention_index.push_back(j);
+            }
+        }
+
+        vector<int> order(items.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&items](int a, int b){return items[a].time < items[b].time;});
+
+        plan_to_execute.items.clear();
+        for(int k : order)
+        {
+            plan_to_execute.items.push_back(items[k]);
+            action_intention_.push_back(items_intention[k]);
+            action_intention_index_.push_back(items_intention_index[k]);
+        }
+        
+        // select current_plan_ which will start execution
+        current_plan_ = ManagedPlan{mp.getPlanQueueIndex(), mp.getFinalTarget(), mp.getPlanTarget(), 
+            plan_to_execute.items, mp.getPrecondition(), mp.getContext()};
+    }
+    else
+        // select current_plan_ which will start execution
+        current_plan_ = mp;
     // current_plan_start_ = high_resolution_clock::now();//plan started now
-    bool started = executor_client_->start_plan_execution(plan_to_execute);
+    bool started = execute_plan_client_->action_server_is_ready();
+    if(started)
+    {
+        // feedback and result are streamed by the executor within this node, tagged with the id of this plan execution
+        uint64_t planExecId = ++plan_exec_id_;
+        plan_goal_handle_.reset();
+        plan_feedback_ = ExecutePlan::Feedback();
+        plan_exec_status_ = BDIPlanExecutionInfo().RUNNING;
+
+        auto goal = ExecutePlan::Goal();
+        goal.plan = plan_to_execute;
+        auto send_goal_options = rclcpp_action::Client<ExecutePlan>::SendGoalOptions();
+        send_goal_options.goal_response_callback = [this, planExecId](std::shared_future<GoalHandleExecutePlan::SharedPtr> future){
+            planGoalResponse(planExecId, future.get());
+        };
+        send_goal_options.feedback_callback = [this, planExecId](GoalHandleExecutePlan::SharedPtr, const std::shared_ptr<const ExecutePlan::Feedback> feedback){
+            planFeedback(planExecId, *feedback);
+        };
+        send_goal_options.result_callback = [this, planExecId](const GoalHandleExecutePlan::WrappedResult& result){
+            planResult(planExecId, result);
+        };
+        execute_plan_client_->async_send_goal(goal, send_goal_options);
+    }
+    else
+        RCLCPP_ERROR(this->get_logger(), "PlanSys2 Executor not available for plan execution");
 
     if(started)
     {
@@ -301,17 +409,21 @@ bool PlanDirector::startPlanExecution(const ManagedPlan& mp)
         first_ts_plan_sec_ = -1;//reset this value
         first_ts_plan_nanosec_ = 0;//reset this value
         last_ts_plan_exec_ = -1.0f;//reset this value
+        last_ts_plan_exec_check_ = high_resolution_clock::now();
+        last_plan_feedback_ = last_ts_plan_exec_check_;
         
         counter_check_ = 0;//checks performed during this plan exec
 
-        //WORK TIMER set to PLAN EXEC MODE (callback checks more frequent)
-        resetWorkTimer(PLAN_INTERVAL);
+        initPlanExecutionInfo(plan_to_execute.items);
+        initContextMonitor();
 
         if(this->get_parameter(PARAM_DEBUG).as_bool())
         {
             string plan_string = "";
             for(PlanItem pi : plan_to_execute.items)
                 plan_string +=  std::to_string(pi.time) + "\t" + pi.action + "\t\t" + std::to_string(pi.duration) + "\n";
+            if(intentions_.size() > 1)
+                plan_string += "(" + std::to_string(intentions_.size()) + " intentions executed concurrently)\n";
             RCLCPP_INFO(this->get_logger(), "Started new plan execution:\n" + plan_string + "\n");
         }
         
@@ -320,17 +432,6 @@ bool PlanDirector::startPlanExecution(const ManagedPlan& mp)
     return started;
 }
 
-// redefine workint timer interval
-void PlanDirector::resetWorkTimer(const int& ms)
-{
-    if(!do_work_timer_->is_canceled())
-        do_work_timer_->cancel();
-    
-    do_work_timer_ = this->create_wall_timer(
-        milliseconds(ms),
-        bind(&PlanDirector::step, this));
-}
-
 /*
     Return true if plan exec request is well formed 
         - request = ABORT | EXECUTE
@@ -349,66 +450,72 @@ bool PlanDirector::validPlanRequest(const BDIPlanExecution::Request::SharedPtr r
         return false;
     }    
 
-    auto plan = request->plan;
-    if(plan.psys2_plan.items.size() == 0)
+    vector<BDIPlan> plans = {request->plan};
+    plans.insert(plans.end(), request->concurrent_plans.begin(), request->concurrent_plans.end());
+    for(const BDIPlan& plan : plans)
     {
-        if(this->get_parameter(PARAM_DEBUG).as_bool())
-            RCLCPP_INFO(this->get_logger(), "Plan request with empty plan");
-        return false;
-    }
+        if(plan.psys2_plan.items.size() == 0)
+        {
+            if(this->get_parameter(PARAM_DEBUG).as_bool())
+                RCLCPP_INFO(this->get_logger(), "Plan request with empty plan");
+            return false;
+        }
 
-    if(!psys2_domain_expert_active_ || !psys2_problem_expert_active_)
-        psys2_comm_errors_++;
-    else
-    {
-        for(auto planItemObj : plan.psys2_plan.items)
+        if(!psys2_domain_expert_active_ || !psys2_problem_expert_active_)
+            psys2_comm_errors_++;
+        else
         {
-            vector<string> actionItems = PDDLUtils::extractPlanItemActionElements(planItemObj.action);
-            if(actionItems.size() == 0)
-                return false;//plan item action not valid
-            else
+            for(auto planItemObj : plan.psys2_plan.items)
             {
-                string actName = actionItems[0];//first position action name
-                shared_ptr<DurativeAction> actDA = domain_expert_client_->getDurativeAction(actName);//retrieve it from the domain expert
-                if(actDA->parameters.size() != actionItems.size() - 1)
-                {
-                    if(this->get_parameter(PARAM_DEBUG).as_bool())
-                        RCLCPP_INFO(this->get_logger(), "Plan request operation not valid: dur. action " + actName + " has wrong number of params");
-                    return false;//plan item not valid -> unexpected num of parameters wrt domain definition of durative act
-                }  
-                    
-                for(int i = 0 ; i<actDA->parameters.size(); i++)
+                vector<string> actionItems = PDDLUtils::extractPlanItemActionElements(planItemObj.action);
+                if(actionItems.size() == 0)
+                    return false;//plan item action not valid
+                else
                 {
-                    plansys2_msgs::msg::Param paramDA = actDA->parameters[i];//retrieve param domain definition
-                    std::optional<plansys2::Instance> paramInstanceOpt = problem_expert_client_->getInstance(actionItems[i+1]);//retrieve corresponding parameter from plan item action
-                    if(!paramInstanceOpt.has_value())
+                    string actName = actionItems[0];//first position action name
+                    shared_ptr<DurativeAction> actDA = pddl_metadata_.getDurativeAction(actName);//retrieve its domain definition
+                    if(actDA == nullptr)
                     {
                         if(this->get_parameter(PARAM_DEBUG).as_bool())
-                            RCLCPP_INFO(this->get_logger(), "Plan request operation not valid: dur. action " + actName + " presents invalid instance " + actionItems[i+1]);
-                        
-                        return false;//invalid instance
+                            RCLCPP_INFO(this->get_logger(), "Plan request operation not valid: dur. action " + actName + " not defined in the domain");
+                        return false;//plan item not valid -> unknown durative act
+                    }
+                    else if(actDA->parameters.size() != actionItems.size() - 1)
+                    {
+                        if(this->get_parameter(PARAM_DEBUG).as_bool())
+                            RCLCPP_INFO(this->get_logger(), "Plan request operation not valid: dur. action " + actName + " has wrong number of params");
+                        return false;//plan item not valid -> unexpected num of parameters wrt domain definition of durative act
                     }  
-                    else
+                    
+                    for(int i = 0 ; i<actDA->parameters.size(); i++)
                     {
-                        plansys2::Instance paramInstance = paramInstanceOpt.value();
+                        plansys2_msgs::msg::Param paramDA = actDA->parameters[i];//retrieve param domain definition
+                        std::optional<string> paramInstanceTypeOpt = pddl_metadata_.getInstanceType(actionItems[i+1]);//retrieve corresponding parameter from plan item action
+                        if(!paramInstanceTypeOpt.has_value())
+                        {
+                            if(this->get_parameter(PARAM_DEBUG).as_bool())
+                                RCLCPP_INFO(this->get_logger(), "Plan request operation not valid: dur. action " + actName + " presents invalid instance " + actionItems[i+1]);
                         
-                        //check type in domain == type in stated action param (check also for subtypes!!!)
-                        if(paramInstance.type != paramDA.type)
+                            return false;//invalid instance
+                        }  
+                        else
                         {
-                            if(std::find(paramDA.sub_types.begin(), paramDA.sub_types.end(), paramInstance.type) == paramDA.sub_types.end())//not even in the subtype array
+                            string paramInstanceType = paramInstanceTypeOpt.value();
+                        
+                            //check type in domain == type in stated action param (check also for subtypes!!!)
+                            if(!pddl_metadata_.typeMatches(paramDA, paramInstanceType))
                             {
                                 if(this->get_parameter(PARAM_DEBUG).as_bool())
                                     RCLCPP_INFO(this->get_logger(), "Plan request operation not valid: dur. action " + actName + " presents invalid typed instance " + actionItems[i+1] +
-                                        ": " + paramDA.type + " needed, " + paramInstance.type + " found");
-                                
+                                        ": " + paramDA.type + " needed, " + paramInstanceType + " found");
+                            
                                 return false;//instance valid, but do not respect type of the expected param for the action
                             }
-                            
-                        }  
-                    }    
+                        }    
+                    }
                 }
-            }
             
+            }
         }
     }
     return true;
@@ -437,7 +544,8 @@ void PlanDirector::handlePlanRequest(const BDIPlanExecution::Request::SharedPtr
         //when aborting do not check preconditions and/or context... plan executed considered equivalent regardless of that
         ManagedPlan mp_abort = ManagedPlan{request->plan.psys2_plan.plan_index, mdPlan, request->plan.psys2_plan.items};
 
-        if(current_plan_ == mp_abort)//request to abort plan which is currently in execution
+        //request to abort plan which is currently in execution (or executed concurrently with it: all of them are aborted then)
+        if(current_plan_ == mp_abort || std::find(intentions_.begin(), intentions_.end(), mp_abort) != intentions_.end())
         {
             cancelCurrentPlanExecution();
             done = executingNoPlan();
@@ -450,20 +558,34 @@ void PlanDirector::handlePlanRequest(const BDIPlanExecution::Request::SharedPtr
     else if(request->request == request->EXECUTE && state_ == READY)//no plan currently in exec
     {
         ManagedPlan requestedPlan = ManagedPlan{request->plan.psys2_plan.plan_index, mdPlan, request->plan.psys2_plan.items, mdPlanPrecondition, mdPlanContext};
-        // verify precondition before actually trying triggering executor
-        if(requestedPlan.getPrecondition().isSatisfied(belief_set_)) // check again user defined precondition just for first subplan
+        vector<ManagedPlan> concurrentPlans;
+        for(const BDIPlan& concurrentPlan : request->concurrent_plans)
+            concurrentPlans.push_back(ManagedPlan{concurrentPlan.psys2_plan.plan_index, ManagedDesire{concurrentPlan.target}, concurrentPlan.psys2_plan.items, 
+                ManagedConditionsDNF{concurrentPlan.precondition}, ManagedConditionsDNF{concurrentPlan.context}});
+        
+        vector<ManagedPlan> requestedPlans = {requestedPlan};
+        requestedPlans.insert(requestedPlans.end(), concurrentPlans.begin(), concurrentPlans.end());
+        bool executable = true;
+        for(int i = 0; i < requestedPlans.size() && executable; i++)
         {
-            bool desire_precondition_check = requestedPlan.getPlanQueueIndex() > 0;// no need to check target precondition here, executing an intermediate plan
-            if(requestedPlan.getPlanQueueIndex() == 0)
-                desire_precondition_check = requestedPlan.getFinalTarget().getPrecondition().isSatisfied(belief_set_);
+            // verify precondition before actually trying triggering executor
+            executable = requestedPlans[i].getPrecondition().isSatisfied(belief_set_mirror_.getBeliefSet()); // check again user defined precondition just for first subplan
             
-            if(desire_precondition_check)
-            {
-                bool started = startPlanExecution(requestedPlan);
-                done = started && state_ == EXECUTING;
-                if(done)
-                    checkPlanExecution();// 1st checkPlanExecution for this plan (if started)
-            }
+            // no need to check target precondition for an intermediate plan
+            if(executable && requestedPlans[i].getPlanQueueIndex() == 0)
+                executable = requestedPlans[i].getFinalTarget().getPrecondition().isSatisfied(belief_set_mirror_.getBeliefSet());
+            
+            // plans to be executed concurrently cannot share actions or instances
+            for(int j = 0; j < i && executable; j++)
+                executable = !ManagedPlan::conflicting(requestedPlans[j], requestedPlans[i]);
+        }
+
+        if(executable)
+        {
+            bool started = startPlanExecution(requestedPlan, concurrentPlans);
+            done = started && state_ == EXECUTING;
+            if(done)
+                checkPlanExecution();// 1st checkPlanExecution for this plan (if started)
         }
     }
         
@@ -471,22 +593,139 @@ void PlanDirector::handlePlanRequest(const BDIPlanExecution::Request::SharedPtr
 }
 
 /*
-    Plan currently in execution, monitor and publish the feedback of its development
+    Executor has accepted (@goalHandle) or rejected (nullptr) the execution of the plan identified by @planExecId
 */
-void PlanDirector::checkContextConditions()
+void PlanDirector::planGoalResponse(const uint64_t& planExecId, const GoalHandleExecutePlan::SharedPtr& goalHandle)
 {
-    if(!current_plan_.getContext().isSatisfied(belief_set_))
+    if(planExecId != plan_exec_id_ || state_ != EXECUTING)
     {
-        //need to abort current plan execution because context condition are not valid anymore
-        if(this->get_parameter(PARAM_DEBUG).as_bool())
-            RCLCPP_INFO(this->get_logger(), "Aborting current plan execution because context conditions are not satisfied");
-        
-        cancelCurrentPlanExecution();
-    }else{
-        if(counter_check_ % 4 == 0 && this->get_parameter(PARAM_DEBUG).as_bool())//print just every 4 checks
-            RCLCPP_INFO(this->get_logger(), "Current plan execution can go on: at least a context condition clause is satisfied");
+        // plan execution already aborted before being accepted
+        if(goalHandle)
+            execute_plan_client_->async_cancel_goal(goalHandle);
+        return;
     }
 
+    if(!goalHandle)
+    {
+        RCLCPP_ERROR(this->get_logger(), "Plan execution rejected by PlanSys2 Executor");
+        plan_exec_status_ = BDIPlanExecutionInfo().ABORT;
+        checkPlanExecution();//to publish aborting and notifying subscribers
+    }
+    else
+        plan_goal_handle_ = goalHandle;
+}
+
+/*
+    Executor has streamed a feedback about the execution of the plan identified by @planExecId
+*/
+void PlanDirector::planFeedback(const uint64_t& planExecId, const ExecutePlan::Feedback& feedback)
+{
+    if(planExecId != plan_exec_id_ || state_ != EXECUTING)
+        return;
+
+    counter_check_++;
+    last_plan_feedback_ = high_resolution_clock::now();
+    plan_feedback_ = feedback;
+    checkPlanExecution();
+}
+
+/*
+    Executor has terminated the execution of the plan identified by @planExecId
+*/
+void PlanDirector::planResult(const uint64_t& planExecId, const GoalHandleExecutePlan::WrappedResult& result)
+{
+    if(planExecId != plan_exec_id_ || state_ != EXECUTING)
+        return;
+
+    if(result.result)
+        plan_feedback_.action_execution_status = result.result->action_execution_status;
+    plan_exec_status_ = (result.code == rclcpp_action::ResultCode::SUCCEEDED && result.result && result.result->success)?
+        BDIPlanExecutionInfo().SUCCESSFUL : BDIPlanExecutionInfo().ABORT;
+    checkPlanExecution();
+}
+
+/*
+    Index the context condition clauses of the intentions in execution by the names of the beliefs they check
+    and evaluate all of them against the current belief set
+*/
+void PlanDirector::initContextMonitor()
+{
+    context_clauses_by_belief_ = vector<map<string, vector<int>>>(intentions_.size());
+    for(int i = 0; i < intentions_.size(); i++)
+    {
+        const vector<ManagedConditionsConjunction>& clauses = intentions_[i].getContext().getClausesRef();
+        for(int c = 0; c < clauses.size(); c++)
+            for(const ManagedCondition& literal : clauses[c].getLiteralsRef())
+            {
+                // instances named by a placeholder and names with wild chars can match any altered belief: always checked ("")
+                string beliefName = literal.getMGBelief().getName();
+                bool anyName = beliefName.find("{") == 0 || !WildPattern{beliefName}.isLiteral();
+                vector<int>& beliefClauses = context_clauses_by_belief_[i][anyName? "" : beliefName];
+                if(beliefClauses.size() == 0 || beliefClauses.back() != c)
+                    beliefClauses.push_back(c);
+            }
+    }
+
+    context_clauses_satisfied_.clear();
+    checkContextConditions();
+}
+
+/*
+    Plan currently in execution, re-evaluate the context condition clauses checking any of the altered beliefs
+    (all of them if @alteredBeliefs is empty) and abort the plan execution if they're not satisfied anymore
+*/
+void PlanDirector::checkContextConditions(const set<string>& alteredBeliefs)
+{
+    bool fullCheck = alteredBeliefs.size() == 0 || context_clauses_satisfied_.size() != intentions_.size();
+    if(fullCheck)
+        context_clauses_satisfied_ = vector<vector<bool>>(intentions_.size());
+    
+    for(int i = 0; i < intentions_.size(); i++)
+    {
+        if(intention_terminated_[i])
+            continue;
+
+        const vector<ManagedConditionsConjunction>& clauses = intentions_[i].getContext().getClausesRef();
+        if(fullCheck)
+        {
+            context_clauses_satisfied_[i] = vector<bool>(clauses.size());
+            for(int c = 0; c < clauses.size(); c++)
+                context_clauses_satisfied_[i][c] = clauses[c].isSatisfied(belief_set_mirror_.getBeliefSet());
+        }
+        else
+        {
+            // just the clauses checking an altered belief (or any name, see initContextMonitor) can have changed their value
+            set<int> touchedClauses;
+            for(const auto& beliefClauses : context_clauses_by_belief_[i])
+                if(beliefClauses.first == "" || alteredBeliefs.count(beliefClauses.first) > 0)
+                    touchedClauses.insert(beliefClauses.second.begin(), beliefClauses.second.end());
+            
+            if(touchedClauses.size() == 0)
+                continue;
+            
+            for(int c : touchedClauses)
+                context_clauses_satisfied_[i][c] = clauses[c].isSatisfied(belief_set_mirror_.getBeliefSet());
+        }
+
+        // context satisfied if at least a clause is satisfied (or no clause at all)
+        bool contextSatisfied = clauses.size() == 0 || 
+            std::find(context_clauses_satisfied_[i].begin(), context_clauses_satisfied_[i].end(), true) != context_clauses_satisfied_[i].end();
+        if(!contextSatisfied)
+        {
+            //need to abort current plan execution because context condition are not valid anymore 
+            //(intentions executed concurrently cannot be aborted separately)
+            if(this->get_parameter(PARAM_DEBUG).as_bool())
+                RCLCPP_INFO(this->get_logger(), "Aborting current plan execution because context conditions are not satisfied for desire \"" + 
+                    intentions_[i].getPlanTarget().getName() + "\"");
+            
+            context_violated_intention_ = i;
+            cancelCurrentPlanExecution();
+            return;
+        }
+    }
+
+    if(counter_check_ % 4 == 0 && this->get_parameter(PARAM_DEBUG).as_bool())//print just every 4 checks
+        RCLCPP_INFO(this->get_logger(), "Current plan execution can go on: at least a context condition clause is satisfied");
 }
 
 /* 
@@ -506,23 +745,30 @@ void PlanDirector::publishRollbackBeliefs(const vector<Belief> rollback_belief_a
 */
 void PlanDirector::checkPlanExecution()
 {   
-    //get feedback from plansys2 api
-    auto feedback = executor_client_->getFeedBack();
-    BDIPlanExecutionInfo planExecutionInfo = getPlanExecutionInfo(feedback);
+    //last feedback streamed by plansys2 executor
+    const BDIPlanExecutionInfo& planExecutionInfo = getPlanExecutionInfo(plan_feedback_);
     current_plan_.setUpdatedInfo(planExecutionInfo); 
 
-    plan_exec_publisher_->publish(planExecutionInfo);
+    // one info per intention executed concurrently (just the one of current_plan_ otherwise)
+    vector<BDIPlanExecutionInfo> splitExecutionInfo;
+    if(intentions_.size() > 1)
+        splitExecutionInfo = splitPlanExecutionInfo(planExecutionInfo);
+    const BDIPlanExecutionInfo* intentionsExecutionInfo = (intentions_.size() > 1)? splitExecutionInfo.data() : &planExecutionInfo;
+    const int intentionsCount = (intentions_.size() > 1)? splitExecutionInfo.size() : 1;
+    for(int i = 0; i < intentionsCount; i++)
+        plan_exec_publisher_->publish(intentionsExecutionInfo[i]);
 
     if(planExecutionInfo.status != planExecutionInfo.RUNNING)
     {
         ManagedDesire targetDes = current_plan_.getPlanTarget();
         //in any case plan execution has stopped, so go back to printing out you're not executing any plan
-        resetWorkTimer(NO_PLAN_INTERVAL);
+        plan_goal_handle_.reset();
         setNoPlanMsg();
         setState(READY);
 
-        if(planExecutionInfo.status == planExecutionInfo.ABORT /*&& !targetDes.isFulfilled(belief_set_)*/)//plan execution aborted -> beliefs rollback
-            publishRollbackBeliefs(planExecutionInfo.target.rollback_belief_add, planExecutionInfo.target.rollback_belief_del);
+        for(int i = 0; i < intentionsCount; i++)
+            if(intentionsExecutionInfo[i].status == intentionsExecutionInfo[i].ABORT /*&& !targetDes.isFulfilled(belief_set_mirror_.getBeliefSet())*/)//plan execution aborted -> beliefs rollback
+                publishRollbackBeliefs(intentionsExecutionInfo[i].target.rollback_belief_add, intentionsExecutionInfo[i].target.rollback_belief_del);
         
         // ended run log 
         if(this->get_parameter(PARAM_DEBUG).as_bool()){
@@ -535,8 +781,13 @@ void PlanDirector::checkPlanExecution()
         
         //check if you've surpassed N times the estimated deadline (N ros2 parameter && >= 1.0)
         float cancelAfterDeadline = std::max(1.0f, (float) this->get_parameter(PARAM_CANCEL_AFTER_DEADLINE).as_double());
-        if(planExecutionInfo.current_time >= cancelAfterDeadline * planExecutionInfo.target.deadline)
-            cancelCurrentPlanExecution();
+        for(int i = 0; i < intentionsCount; i++)
+            if(intentionsExecutionInfo[i].status == intentionsExecutionInfo[i].RUNNING && 
+                intentionsExecutionInfo[i].current_time >= cancelAfterDeadline * intentionsExecutionInfo[i].target.deadline)
+            {
+                cancelCurrentPlanExecution();
+                break;
+            }
     }
 }
 
@@ -570,116 +821,239 @@ ActionExecutionInfo extractEarliestAction(const vector<ActionExecutionInfo>& psy
     return earliest_action;
 }
 
+/*
+    Prepare the BDIPlanExecutionInfo of the plan just started (@planBody sent to the executor) and the index of its actions, 
+    so that executor feedback can then be applied to it in place
+*/
+void PlanDirector::initPlanExecutionInfo(const vector<PlanItem>& planBody)
+{
+    plan_exec_info_ = BDIPlanExecutionInfo();
+    plan_exec_info_.target = current_plan_.getPlanTarget().toDesire();
+    plan_exec_info_.planned_deadline = current_plan_.getPlannedDeadline();
+    plan_exec_info_.status = plan_exec_info_.RUNNING;
+
+    action_full_names_.clear();
+    action_plan_index_.clear();
+    for(int i = 0; i < planBody.size(); i++)
+    {
+        action_full_names_.push_back(PDDLBDIConverter::getActionFullName(planBody[i]));
+        action_plan_index_[action_full_names_[i]] = i;
+        // fields depending just on the plan body are set once here
+        plan_exec_info_.actions_exec_info.push_back(PDDLBDIConverter::buildBDIActionExecutionInfo(std::nullopt, planBody, i, -1, 0));
+    }
+
+    action_feedback_index_ = vector<int>(planBody.size(), -1);
+    feedback_size_ = -1;
+    action_feedback_stamp_ = vector<ActionFeedbackStamp>(planBody.size(), ActionFeedbackStamp{-1, 0, 0, 0.0f});
+}
+
+/*
+    Map each action of the plan in execution to the index of its status within the executor feedback
+*/
+void PlanDirector::resolveFeedbackIndexes(const vector<ActionExecutionInfo>& actionsFeedback)
+{
+    std::fill(action_feedback_index_.begin(), action_feedback_index_.end(), -1);
+    for(int j = 0; j < actionsFeedback.size(); j++)
+    {
+        auto action = action_plan_index_.find(actionsFeedback[j].action_full_name);
+        if(action != action_plan_index_.end())
+            action_feedback_index_[action->second] = j;
+    }
+    feedback_size_ = actionsFeedback.size();
+}
+
 /* 
-    Use PlanSys2 feedback received from the executor to build the BDIPlanExecutionInfo to be published to the respecive topic
+    Use PlanSys2 feedback received from the executor to update the BDIPlanExecutionInfo to be published to the respecive topic
     Call NECESSARY to update the properties regarding the status of the current monitored/managed plan exec.
 */
-BDIPlanExecutionInfo PlanDirector::getPlanExecutionInfo(const ExecutorClient::ExecutePlan::Feedback& feedback)
+const BDIPlanExecutionInfo& PlanDirector::getPlanExecutionInfo(const ExecutePlan::Feedback& feedback)
 {
-    // retrieve plan body (action with duration and planned start step by step as computed by the pddl planner)
-    vector<PlanItem> current_plan_body = current_plan_.toPsys2Plan().items;
-
-    BDIPlanExecutionInfo planExecutionInfo = BDIPlanExecutionInfo();
+    const vector<ActionExecutionInfo>& actionsFeedback = feedback.action_execution_status;
     float status_time_s = -1.0;//current exec time relatively to plan start referred as the "zero" time point
     int executing = 0;
     
-    if(first_ts_plan_sec_ < 0 && feedback.action_execution_status.size() > 0)//NOTE: update first ts for plan if it's not init yet and you've received the first significant feedback
+    bool firstTsSet = false;
+    if(first_ts_plan_sec_ < 0 && actionsFeedback.size() > 0)//NOTE: update first ts for plan if it's not init yet and you've received the first significant feedback
     {
         //set just for earliest start timestamp captured in this plan exec (then always subtract from it)
-        ActionExecutionInfo psys2_action_earliest = extractEarliestAction(feedback.action_execution_status);
+        ActionExecutionInfo psys2_action_earliest = extractEarliestAction(actionsFeedback);
         if(psys2_action_earliest.start_stamp.sec >= 0)
         {
             first_ts_plan_sec_ = psys2_action_earliest.start_stamp.sec;
             first_ts_plan_nanosec_ = psys2_action_earliest.start_stamp.nanosec;
+            firstTsSet = true;//relative times of all actions to be recomputed
         }
     }
 
-    // find executing action status
-    for (int i=0; i<current_plan_body.size(); i++) {
-        string timex1000s = std::to_string(static_cast<int>(current_plan_body[i].time * 1000));
-        string action_full_name = current_plan_body[i].action + ":" + timex1000s;
-        int aindex_psys2_feed = PDDLBDIConverter::getActionIndex(feedback.action_execution_status,  action_full_name);
-        
-        std::optional<ActionExecutionInfo> psys2_action_feed_opt = {};
+    if(feedback_size_ != actionsFeedback.size())
+        resolveFeedbackIndexes(actionsFeedback);
+
+    // apply feedback just to the actions whose status has changed since the last one
+    for(int i = 0; i < plan_exec_info_.actions_exec_info.size(); i++)
+    {
+        int aindex_psys2_feed = action_feedback_index_[i];
+        if(aindex_psys2_feed >= 0 && actionsFeedback[aindex_psys2_feed].action_full_name != action_full_names_[i])
+        {
+            // executor reordered its feedback
+            resolveFeedbackIndexes(actionsFeedback);
+            aindex_psys2_feed = action_feedback_index_[i];
+        }
+
+        BDIActionExecutionInfo& bdiActionExecutionInfo = plan_exec_info_.actions_exec_info[i];
         if(aindex_psys2_feed >= 0)
         {
-            psys2_action_feed_opt = feedback.action_execution_status[aindex_psys2_feed];     
-            executing += (psys2_action_feed_opt.value().status == psys2_action_feed_opt.value().EXECUTING)? 1 : 0;
-        }   
+            const ActionExecutionInfo& psys2_action_feed = actionsFeedback[aindex_psys2_feed];
+            executing += (psys2_action_feed.status == psys2_action_feed.EXECUTING)? 1 : 0;
 
-        BDIActionExecutionInfo bdiActionExecutionInfo = PDDLBDIConverter::buildBDIActionExecutionInfo(psys2_action_feed_opt, current_plan_body, i,
-                first_ts_plan_sec_, first_ts_plan_nanosec_);
-        planExecutionInfo.actions_exec_info.push_back(bdiActionExecutionInfo);//add action execution info to plan execution info 
+            ActionFeedbackStamp& stamp = action_feedback_stamp_[i];
+            if(firstTsSet || stamp.status != psys2_action_feed.status || stamp.completion != psys2_action_feed.completion ||
+                stamp.status_sec != psys2_action_feed.status_stamp.sec || stamp.status_nanosec != psys2_action_feed.status_stamp.nanosec)
+            {
+                PDDLBDIConverter::updateBDIActionExecutionInfo(bdiActionExecutionInfo, psys2_action_feed, action_plan_index_,
+                    first_ts_plan_sec_, first_ts_plan_nanosec_);
+                stamp = ActionFeedbackStamp{psys2_action_feed.status, psys2_action_feed.status_stamp.sec, 
+                    psys2_action_feed.status_stamp.nanosec, psys2_action_feed.completion};
+            }
+        }
 
         // plan status time
         if(bdiActionExecutionInfo.status == bdiActionExecutionInfo.RUNNING)
             status_time_s = std::max(status_time_s, bdiActionExecutionInfo.actual_start + bdiActionExecutionInfo.exec_time);// actual start time for action + duration action up to now
     }
 
-    //TODO sort before directly on Plansys2 feedback DO IT!!!!! SHOULD BE SOLVED
-    sort(planExecutionInfo.actions_exec_info.begin(), planExecutionInfo.actions_exec_info.end(), 
-        [](BDIActionExecutionInfo bdi_a1, BDIActionExecutionInfo bdi_a2){
-            return bdi_a1.index < bdi_a2.index;
-        }
-    );
-    
-    planExecutionInfo.target = current_plan_.getPlanTarget().toDesire();
-    planExecutionInfo.planned_deadline = current_plan_.getPlannedDeadline();
-    planExecutionInfo.estimated_deadline = current_plan_.getUpdatedEstimatedDeadline();
-    
+    plan_exec_info_.estimated_deadline = current_plan_.getUpdatedEstimatedDeadline();
     
     // current time s computed by difference from fist start ts of first action executed within the plan
-    planExecutionInfo.current_time = (status_time_s >= 0.0f)? status_time_s : 0.0f;
+    plan_exec_info_.current_time = (status_time_s >= 0.0f)? status_time_s : 0.0f;
+    auto now = high_resolution_clock::now();
     if(executing == 0 && last_ts_plan_exec_ > 0.0f)//last steps -> no action executing right now
-        planExecutionInfo.current_time = last_ts_plan_exec_ + (PLAN_INTERVAL / pow(10,3)); //add plan interval in sec from last check
-    last_ts_plan_exec_ = planExecutionInfo.current_time;
-    planExecutionInfo.status = getPlanExecutionStatus();
+        plan_exec_info_.current_time = last_ts_plan_exec_ + std::chrono::duration<float>(now - last_ts_plan_exec_check_).count(); //add time in sec from last check
+    last_ts_plan_exec_ = plan_exec_info_.current_time;
+    last_ts_plan_exec_check_ = now;
+    plan_exec_info_.status = getPlanExecutionStatus();
 
-    return planExecutionInfo;
+    return plan_exec_info_;
 }
 
 /*
-    Retrieve from PlanSys2 Executor status info about current plan execution: RUNNING, SUCCESSFUL, ABORT
+    Split the execution info of the plan in execution into the ones of the intentions merged into it 
+    (just the ones not already notified as terminated)
+    Intentions aborted just because another one failed or had its context violated are marked as sibling aborts
 */
-int16_t PlanDirector::getPlanExecutionStatus()
+vector<BDIPlanExecutionInfo> PlanDirector::splitPlanExecutionInfo(const BDIPlanExecutionInfo& planExecutionInfo)
 {
-    int16_t result = BDIPlanExecutionInfo().RUNNING;
-    if (!executor_client_->execute_and_check_plan() && executor_client_->getResult()) //plan stopped
-    {      
-        if(executor_client_->getResult().value().success)//successful  run
-            result = BDIPlanExecutionInfo().SUCCESSFUL;
-        
-        else //plan aborted
-            result = BDIPlanExecutionInfo().ABORT;
-    }   
+    vector<BDIPlanExecutionInfo> intentionsExecutionInfo = vector<BDIPlanExecutionInfo>(intentions_.size());
+    for(const BDIActionExecutionInfo& actionExecutionInfo : planExecutionInfo.actions_exec_info)
+    {
+        int i = action_intention_[actionExecutionInfo.index];
+        BDIActionExecutionInfo intentionActionExecutionInfo = actionExecutionInfo;
+        intentionActionExecutionInfo.index = action_intention_index_[actionExecutionInfo.index];
+        intentionActionExecutionInfo.wait_action_indexes.clear();
+        for(auto waitIndex : actionExecutionInfo.wait_action_indexes)
+            if(waitIndex >= 0 && waitIndex < action_intention_.size() && action_intention_[waitIndex] == i)
+                intentionActionExecutionInfo.wait_action_indexes.push_back(action_intention_index_[waitIndex]);
+        intentionsExecutionInfo[i].actions_exec_info.push_back(intentionActionExecutionInfo);
+    }
+
+    // intentions responsible for the abortion of the whole plan (failed actions or context violated)
+    vector<bool> abortCause = vector<bool>(intentions_.size(), false);
+    bool abortCaused = false;
+    for(int i = 0; i < intentions_.size(); i++)
+    {
+        for(const BDIActionExecutionInfo& actionExecutionInfo : intentionsExecutionInfo[i].actions_exec_info)
+            abortCause[i] = abortCause[i] || actionExecutionInfo.status == actionExecutionInfo.FAILED;
+        abortCause[i] = abortCause[i] || i == context_violated_intention_;
+        abortCaused = abortCaused || abortCause[i];
+    }
+
+    vector<BDIPlanExecutionInfo> result;
+    for(int i = 0; i < intentions_.size(); i++)
+    {
+        if(intention_terminated_[i])
+            continue;
+
+        BDIPlanExecutionInfo& intentionExecutionInfo = intentionsExecutionInfo[i];
+        sort(intentionExecutionInfo.actions_exec_info.begin(), intentionExecutionInfo.actions_exec_info.end(), 
+            [](const BDIActionExecutionInfo& bdi_a1, const BDIActionExecutionInfo& bdi_a2){
+                return bdi_a1.index < bdi_a2.index;
+            }
+        );
+
+        bool allSuccessful = true, someFailed = false;
+        for(const BDIActionExecutionInfo& actionExecutionInfo : intentionExecutionInfo.actions_exec_info)
+        {
+            allSuccessful = allSuccessful && actionExecutionInfo.status == actionExecutionInfo.SUCCESSFUL;
+            someFailed = someFailed || actionExecutionInfo.status == actionExecutionInfo.FAILED;
+        }
+
+        // an intention can terminate before the others executed concurrently with it
+        intentionExecutionInfo.status = 
+            (allSuccessful || planExecutionInfo.status == planExecutionInfo.SUCCESSFUL)? planExecutionInfo.SUCCESSFUL :
+            (someFailed || planExecutionInfo.status == planExecutionInfo.ABORT)? planExecutionInfo.ABORT : planExecutionInfo.RUNNING;
+        intentionExecutionInfo.sibling_abort = intentionExecutionInfo.status == intentionExecutionInfo.ABORT && abortCaused && !abortCause[i];
+        intentionExecutionInfo.target = intentions_[i].getPlanTarget().toDesire();
+        intentionExecutionInfo.current_time = planExecutionInfo.current_time;
+        intentionExecutionInfo.planned_deadline = intentions_[i].getPlannedDeadline();
+        intentions_[i].setUpdatedInfo(intentionExecutionInfo);
+        intentionExecutionInfo.estimated_deadline = intentions_[i].getUpdatedEstimatedDeadline();
+
+        intention_terminated_[i] = intentionExecutionInfo.status != intentionExecutionInfo.RUNNING;
+        result.push_back(intentionExecutionInfo);
+    }
     return result;
 }
 
 /*
-    The belief set has been updated
+    The belief set has been updated (full snapshot)
 */
-void PlanDirector::updatedBeliefSet(const BeliefSet::SharedPtr msg)
+void PlanDirector::updatedBeliefSet(const BeliefSet::ConstSharedPtr msg)
 {
-    belief_set_ = BDIFilter::extractMGBeliefs(msg->value);
+    if(belief_set_mirror_.applySnapshot(*msg) == BeliefSetMirror::UPDATED)
+    {
+        pddl_metadata_.syncInstances(belief_set_mirror_.getBeliefSet());
+        if(state_ == EXECUTING)
+            checkContextConditions();// check if context conditions are still valid and true -> abort otherwise
+    }
 }
 
-int main(int argc, char ** argv)
+/*
+    The belief set has been updated (delta wrt. previous version)
+*/
+void PlanDirector::updatedBeliefSetDelta(const BeliefSetDelta::ConstSharedPtr msg)
 {
-  rclcpp::init(argc, argv);
-  auto node = std::make_shared<PlanDirector>();
-  bool psys2_booted = node->wait_psys2_boot(std::chrono::seconds(8));//Wait max 8 seconds for plansys2 to boot
-  
-  if(psys2_booted)
-  {
-    node->init();
-    rclcpp::spin(node);
-  }
-  else
-  {
-    std::cerr << "PlanSys2 failed to boot: node will not spin and process will terminate" << std::endl;
-  }
-  
-  rclcpp::shutdown();
-
-  return 0;
+    BeliefSetMirror::UpdateResult result = belief_set_mirror_.applyDelta(*msg);
+    if(result == BeliefSetMirror::GAP)//missed some update, ask for a full snapshot
+        belief_set_request_publisher_->publish(std_msgs::msg::Empty());
+    
+    else if(result == BeliefSetMirror::UPDATED)
+        pddl_metadata_.updateInstances(msg->added, msg->removed);
+
+    if(result == BeliefSetMirror::UPDATED && state_ == EXECUTING)
+    {
+        // check if context conditions are still valid and true -> abort otherwise (just clauses checking altered beliefs)
+        set<string> alteredBeliefs;
+        for(const Belief& b : msg->added)
+            alteredBeliefs.insert(b.name);
+        for(const Belief& b : msg->removed)
+            alteredBeliefs.insert(b.name);
+        for(const Belief& b : msg->modified)
+            alteredBeliefs.insert(b.name);
+        checkContextConditions(alteredBeliefs);
+    }
 }
+
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/plan_director.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(PlanDirector& node)
+{
+    if(!node.wait_psys2_boot(std::chrono::seconds(8)))//Wait max 8 seconds for plansys2 to boot
+        return false;
+
+    node.init();
+    return true;
+}
+
+typedef CoreComponent<PlanDirector> PlanDirectorComponent;
+RCLCPP_COMPONENTS_REGISTER_NODE(PlanDirectorComponent)
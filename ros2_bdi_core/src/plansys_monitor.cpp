@@ -7,6 +7,12 @@
 // Scheduler params
 #include "ros2_bdi_core/params/scheduler_params.hpp"
 
+#include <thread>
+
+// boot as rclcpp component
+#include "ros2_bdi_core/support/core_component.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
+
 using std::string;
 using std::shared_ptr;
 using std::chrono::milliseconds;
@@ -18,7 +24,7 @@ using ros2_bdi_interfaces::msg::LifecycleStatus;
 using ros2_bdi_interfaces::msg::PlanningSystemState;
 
 
-PlanSysMonitor::PlanSysMonitor() : rclcpp::Node(PSYS_MONITOR_NODE_NAME)
+PlanSysMonitor::PlanSysMonitor(const rclcpp::NodeOptions& options) : rclcpp::Node(PSYS_MONITOR_NODE_NAME, options)
 {
     this->declare_parameter(PARAM_AGENT_ID, "agent0");
     this->declare_parameter(PARAM_DEBUG, true);
@@ -182,16 +188,17 @@ void PlanSysMonitor::checkPsysNodeActive(const string& psysNodeName)
         psys_active_.executor_active = activeResult;
 }
 
-
-int main(int argc, char ** argv)
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/plansys_monitor.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(PlanSysMonitor& node)
 {
-  rclcpp::init(argc, argv);
-  auto node = std::make_shared<PlanSysMonitor>();
-  std::this_thread::sleep_for(std::chrono::seconds(1));//WAIT PSYS2 TO BOOT
-
-  node->init();
-  rclcpp::spin(node);
-  rclcpp::shutdown();
+    std::this_thread::sleep_for(std::chrono::seconds(1));//WAIT PSYS2 TO BOOT
 
-  return 0;
+    node.init();
+    return true;
 }
+
+typedef CoreComponent<PlanSysMonitor> PlanSysMonitorComponent;
+RCLCPP_COMPONENTS_REGISTER_NODE(PlanSysMonitorComponent)
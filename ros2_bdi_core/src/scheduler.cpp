@@ -11,6 +11,7 @@
 // Inner logic + ROS2 PARAMS & FIXED GLOBAL VALUES for PlanSys2 Monitor node (for psys2 state topic)
 #include "ros2_bdi_core/params/plansys_monitor_params.hpp"
 
+#include <algorithm>
 
 #include <yaml-cpp/exceptions.h>
 
@@ -32,6 +33,7 @@ using std::chrono::milliseconds;
 using std::bind;
 using std::placeholders::_1;
 using std::optional;
+using std::function;
 
 using plansys2::DomainExpertClient;
 using plansys2::ProblemExpertClient;
@@ -46,13 +48,17 @@ using ros2_bdi_interfaces::msg::LifecycleStatus;
 using ros2_bdi_interfaces::msg::Belief;
 using ros2_bdi_interfaces::msg::Desire;
 using ros2_bdi_interfaces::msg::BeliefSet;
+using ros2_bdi_interfaces::msg::BeliefSetDelta;
 using ros2_bdi_interfaces::msg::DesireSet;
+using ros2_bdi_interfaces::msg::DesireSetWrite;
+using ros2_bdi_interfaces::msg::WriteAck;
 using ros2_bdi_interfaces::msg::Condition;
 using ros2_bdi_interfaces::msg::ConditionsConjunction;
 using ros2_bdi_interfaces::msg::ConditionsDNF;
 using ros2_bdi_interfaces::msg::PlanningSystemState;
 using ros2_bdi_interfaces::msg::BDIActionExecutionInfo;
 using ros2_bdi_interfaces::msg::BDIActionExecutionInfoMin;
+using ros2_bdi_interfaces::msg::BDIPlan;
 using ros2_bdi_interfaces::msg::BDIPlanExecutionInfo;
 using ros2_bdi_interfaces::msg::BDIPlanExecutionInfoMin;
 using ros2_bdi_interfaces::srv::BDIPlanExecution;
@@ -60,10 +66,12 @@ using ros2_bdi_interfaces::srv::BDIPlanExecution;
 using BDIManaged::ManagedParam;
 using BDIManaged::ManagedBelief;
 using BDIManaged::ManagedDesire;
+using BDIManaged::WildPattern;
 using BDIManaged::ManagedPlan;
+using BDIManaged::BeliefSetMirror;
 
-Scheduler::Scheduler()
-  : rclcpp::Node(SCHEDULER_NODE_NAME), state_(STARTING)
+Scheduler::Scheduler(const rclcpp::NodeOptions& options)
+  : rclcpp::Node(SCHEDULER_NODE_NAME, options), state_(STARTING)
 {
     psys2_comm_errors_ = 0;
     
@@ -77,6 +85,10 @@ Scheduler::Scheduler()
     this->declare_parameter(PARAM_RESCHEDULE_POLICY, VAL_RESCHEDULE_POLICY_NO_IF_EXEC);
     this->declare_parameter(PARAM_AUTOSUBMIT_PREC, false);
     this->declare_parameter(PARAM_AUTOSUBMIT_CONTEXT, false);
+    this->declare_parameter(PARAM_PLANNING_WORKERS, 1);
+    this->declare_parameter(PARAM_MAX_INTENTIONS, 1);
+    this->declare_parameter(PARAM_EVENT_DRIVEN, false);
+    this->declare_parameter(PARAM_RESCHEDULE_DEBOUNCE, 50);
     this->declare_parameter(PARAM_PLANNING_MODE, PLANNING_MODE_OFFLINE);
 
     sel_planning_mode_ = this->get_parameter(PARAM_PLANNING_MODE).as_string() == PLANNING_MODE_OFFLINE? OFFLINE : ONLINE;
@@ -99,6 +111,8 @@ void Scheduler::init()
 
     // initializing domain expert
     domain_expert_ = std::make_shared<plansys2::DomainExpertClient>();
+    // domain schemas retrieved through it at first use
+    pddl_metadata_ = BDIManaged::PDDLMetadataCache{domain_expert_};
     // initializing problem expert
     problem_expert_ = std::make_shared<plansys2::ProblemExpertClient>();
 
@@ -107,9 +121,15 @@ void Scheduler::init()
 
     // Declare empty desire set
     desire_set_ = set<ManagedDesire>();
+    desire_set_version_ = 0;
+    referenced_beliefs_ = set<string>();
+    referenced_beliefs_version_ = desire_set_version_;
     // wait for it to be init
     init_dset_ = false;
 
+    // init step_counter
+    step_counter_ = 0;
+
     //Desire set publisher
     desire_set_publisher_ = this->create_publisher<DesireSet>(DESIRE_SET_TOPIC, 10);
 
@@ -160,12 +180,23 @@ void Scheduler::init()
                 DEL_DESIRE_TOPIC, qos_reliable,
                 bind(&Scheduler::delDesireTopicCallBack, this, _1));
 
+    //Desire set write requests (acknowledged once processed)
+    desire_set_write_subscriber_ = this->create_subscription<DesireSetWrite>(
+                DESIRE_SET_WRITE_TOPIC, qos_reliable,
+                bind(&Scheduler::desireSetWriteTopicCallBack, this, _1));
+    desire_set_write_ack_publisher_ = this->create_publisher<WriteAck>(DESIRE_SET_WRITE_ACK_TOPIC, qos_reliable);
+
     //belief_set_subscriber_ 
     belief_set_subscriber_ = this->create_subscription<BeliefSet>(
                 BELIEF_SET_TOPIC, qos_reliable,
                 bind(&Scheduler::updatedBeliefSet, this, _1));
+    //belief_set_delta_subscriber_ 
+    belief_set_delta_subscriber_ = this->create_subscription<BeliefSetDelta>(
+                BELIEF_SET_DELTA_TOPIC, qos_reliable,
+                bind(&Scheduler::updatedBeliefSetDelta, this, _1));
+    belief_set_request_publisher_ = this->create_publisher<std_msgs::msg::Empty>(BELIEF_SET_REQUEST_TOPIC, qos_reliable);
 
-    plan_exec_srv_client_ = std::make_shared<TriggerPlanClient>(PLAN_EXECUTION_SRV + string("_s_caller"));
+    plan_exec_srv_client_ = std::make_shared<TriggerPlanClient>(PLAN_EXECUTION_SRV + string("_s_caller"), asyncSrvHost(this));
 
     plan_exec_info_subscriber_ = this->create_subscription<BDIPlanExecutionInfo>(
         PLAN_EXECUTION_TOPIC, 10,
@@ -177,6 +208,21 @@ void Scheduler::init()
         milliseconds(500),
         bind(&Scheduler::step, this));
 
+    //in event driven mode reschedulings are triggered by relevant events and coalesced within the debounce interval
+    event_driven_ = this->get_parameter(PARAM_EVENT_DRIVEN).as_bool();
+    reschedule_pending_ = false;
+    plan_exec_request_pending_ = false;
+    reschedule_held_ = false;
+    reschedule_timer_ = this->create_wall_timer(
+        milliseconds(std::max<int64_t>(1, this->get_parameter(PARAM_RESCHEDULE_DEBOUNCE).as_int())),
+        bind(&Scheduler::debouncedReschedule, this));
+    reschedule_timer_->cancel();//armed by requestReschedule()
+
+    // open connection to plan library and init. tables, if not already present
+    planlib_db_ = std::make_shared<PlanLibrary::BDIPlanLibrary>("/tmp/"+agent_id_+"/"+PLAN_LIBRARY_NAME);
+    planlib_conn_ok_ = planlib_db_->initPlanLibrary();
+    discarded_stored_plans_ = set<int>();
+
     RCLCPP_INFO(this->get_logger(), "Scheduler node initialized");
 }
   
@@ -218,6 +264,8 @@ void Scheduler::step()
                     {    
                         setState(SCHEDULING);//corresponding planner is active too, so you can jump to scheduling state
                         lifecycle_status_publisher_->publish(getLifecycleStatus());
+                        if(event_driven_)
+                            requestReschedule();//no rescheduling at next step: look for a plan right away
                     }
                 }
             }else{
@@ -243,6 +291,17 @@ void Scheduler::step()
 
         case SCHEDULING:
         {   
+            if(event_driven_)
+            {
+                //desire set is published at every alteration, reschedulings are triggered by events
+                if(step_counter_ % 4 == 0)
+                    publishDesireSet();
+                //retry now and then desires still waiting for a plan
+                if(step_counter_ % EVENT_DRIVEN_FALLBACK_STEPS == 0 && desire_set_.size() > 0 && noPlanExecuting())
+                    requestReschedule();
+                break;
+            }
+
             publishDesireSet();
 
             auto reschedulePolicy = this->get_parameter(PARAM_RESCHEDULE_POLICY).as_string();
@@ -250,8 +309,8 @@ void Scheduler::step()
                 Either the reschedule policy is no if a plan is executing AND there is no plan currently in exec
                 or the reschedule policy allows rescheduling while plan is in exec
             */
-            if(reschedulePolicy == VAL_RESCHEDULE_POLICY_NO_IF_EXEC && noPlanExecuting() 
-                || reschedulePolicy != VAL_RESCHEDULE_POLICY_NO_IF_EXEC)
+            if(!plan_exec_request_pending_ && (reschedulePolicy == VAL_RESCHEDULE_POLICY_NO_IF_EXEC && noPlanExecuting() 
+                || reschedulePolicy != VAL_RESCHEDULE_POLICY_NO_IF_EXEC))
             {
                 if(this->get_parameter(PARAM_DEBUG).as_bool())
                     RCLCPP_INFO(this->get_logger(), "Reschedule to select new plan to be executed");
@@ -272,11 +331,11 @@ void Scheduler::step()
 }
 
 /*
-    Publish target goal info to belief set
+    Publish target goal info of @mp to belief set
 */
-void Scheduler::publishTargetGoalInfo(const GoalBeliefOp& op)
+void Scheduler::publishTargetGoalInfo(const GoalBeliefOp& op, const ManagedPlan& mp)
 {
-    for(auto belief : current_plan_.getFinalTarget().getValue())
+    for(auto belief : mp.getFinalTarget().getValue())
     {
         if(op == ADD_GOAL_BELIEFS)
             add_belief_publisher_->publish(belief.toFulfillmentBelief());
@@ -300,9 +359,11 @@ LifecycleStatus Scheduler::getLifecycleStatus()
 */
 void Scheduler::publishDesireSet()
 {
-    DesireSet dset_msg = BDIFilter::extractDesireSetMsg(desire_set_);
-    dset_msg.agent_id = agent_id_;
-    desire_set_publisher_->publish(dset_msg);
+    // handed over as unique_ptr: moved to the subscribers within the same process (intra-process comms) without copies
+    auto dset_msg = std::make_unique<DesireSet>(BDIFilter::extractDesireSetMsg(desire_set_));
+    dset_msg->agent_id = agent_id_;
+    dset_msg->version = desire_set_version_;
+    desire_set_publisher_->publish(std::move(dset_msg));
 }
 
 /*
@@ -310,10 +371,122 @@ void Scheduler::publishDesireSet()
 */
 void Scheduler::callbackPsys2State(const PlanningSystemState::SharedPtr msg)
 {
+    bool plannerWasActive = (sel_planning_mode_ == OFFLINE)? psys2_planner_active_ : javaff_planner_active_;
+
     psys2_problem_expert_active_ = msg->problem_expert_active;
     psys2_domain_expert_active_ = msg->domain_expert_active;
+    if(!psys2_domain_expert_active_)
+        invalidateDomain();//domain retrieved again once the domain expert is back
     psys2_planner_active_ = msg->offline_planner_active;
     javaff_planner_active_ = msg->online_planner_active;
+
+    bool plannerActive = (sel_planning_mode_ == OFFLINE)? psys2_planner_active_ : javaff_planner_active_;
+    if(event_driven_ && state_ == SCHEDULING && !plannerWasActive && plannerActive)//planner back available
+        requestReschedule();
+}
+
+/*
+    PlanSys2 domain expert gone down: drop whatever has been derived from the domain, 
+    so that it is retrieved again once the domain expert is back
+*/
+void Scheduler::invalidateDomain()
+{
+    pddl_metadata_.invalidateDomain();
+}
+
+/*
+    Something relevant for the scheduling has happened: reschedule right away in polling mode,
+    otherwise within PARAM_RESCHEDULE_DEBOUNCE ms, coalescing further requests in between into a single rescheduling
+*/
+void Scheduler::requestReschedule()
+{
+    if(plan_exec_request_pending_)
+    {
+        reschedule_held_ = true;//performed as the plan director answers (see planExecRequestDone)
+        return;
+    }
+
+    if(!event_driven_)
+    {
+        reschedule();
+        return;
+    }
+
+    if(!reschedule_pending_)//otherwise already covered by the pending one
+    {
+        reschedule_pending_ = true;
+        reschedule_timer_->reset();
+    }
+}
+
+/*
+    Debounce interval elapsed after a reschedule request: perform the rescheduling
+*/
+void Scheduler::debouncedReschedule()
+{
+    reschedule_timer_->cancel();//one-shot
+    reschedule_pending_ = false;
+
+    if(plan_exec_request_pending_)
+        reschedule_held_ = true;//performed as the plan director answers (see planExecRequestDone)
+    else if(state_ == SCHEDULING)
+    {
+        if(this->get_parameter(PARAM_DEBUG).as_bool())
+            RCLCPP_INFO(this->get_logger(), "Reschedule to select new plan to be executed");
+        reschedule();
+    }
+}
+
+/*
+    Return true if some of @beliefs is referenced by a desire in the desire set (in its value, precondition or context),
+    either by name or by a name with wild chars/placeholder matching it
+*/
+bool Scheduler::referencedByDesires(const vector<Belief>& beliefs)
+{
+    if(beliefs.empty())
+        return false;
+
+    if(referenced_beliefs_version_ != desire_set_version_)//desire set altered since last computation
+    {
+        // exact names within a set, names with wild chars as patterns (instances named by a placeholder match any name)
+        auto addReference = [this](const string& name)
+        {
+            WildPattern pattern = (name.find("{") == 0 && name.find("}") == name.length()-1)? WildPattern{"*"} : WildPattern{name};
+            if(pattern.isLiteral())
+                referenced_beliefs_.insert(name);
+            else
+                referenced_patterns_.push_back(pattern);
+        };
+
+        mtx_add_del_.lock();
+        {
+            referenced_beliefs_.clear();
+            referenced_patterns_.clear();
+            for(const ManagedDesire& md : desire_set_)
+            {
+                for(const ManagedBelief& mb : md.getValue())
+                    addReference(mb.getName());
+                for(const auto& clause : md.getPrecondition().getClauses())
+                    for(const auto& literal : clause.getLiteralsRef())
+                        addReference(literal.getMGBelief().getName());
+                for(const auto& clause : md.getContext().getClauses())
+                    for(const auto& literal : clause.getLiteralsRef())
+                        addReference(literal.getMGBelief().getName());
+            }
+            referenced_beliefs_version_ = desire_set_version_;
+        }
+        mtx_add_del_.unlock();
+    }
+
+    for(const Belief& b : beliefs)
+    {
+        if(referenced_beliefs_.count(b.name) > 0)
+            return true;
+        for(const WildPattern& pattern : referenced_patterns_)
+            if(pattern.matches(b.name))
+                return true;
+    }
+    return false;
 }
 
 /*
@@ -350,7 +523,7 @@ TargetBeliefAcceptance Scheduler::targetBeliefAcceptanceCheck(const ManagedBelie
     if(mb.pddlType() != Belief().PREDICATE_TYPE)//not predicate -> not accepted
             return UNKNOWN_PREDICATE;
 
-    optional<Predicate> optPredDef = domain_expert_->getPredicate(mb.getName());
+    optional<Predicate> optPredDef = pddl_metadata_.getPredicate(mb.getName());
     if(!optPredDef.has_value())//incorrect predicate name
         return UNKNOWN_PREDICATE;
 
@@ -362,12 +535,11 @@ TargetBeliefAcceptance Scheduler::targetBeliefAcceptanceCheck(const ManagedBelie
     for(int i=0; i<params.size(); i++)
     {
         string instanceName = params[i].name;
-        optional<Instance> opt_ins = problem_expert_->getInstance(instanceName);
+        optional<string> opt_ins_type = pddl_metadata_.getInstanceType(instanceName);
         
-        if(!opt_ins.has_value())//found a not valid instance in one of the goal predicates       
+        if(!opt_ins_type.has_value())//found a not valid instance in one of the goal predicates       
             return UNKNOWN_INSTANCES;
-        else if(opt_ins.value().type != predDef.parameters[i].type && //instance types not matching definition
-            std::find(predDef.parameters[i].sub_types.begin(), predDef.parameters[i].sub_types.end(), opt_ins.value().type) == predDef.parameters[i].sub_types.end()) //failing also checks within sub types
+        else if(!pddl_metadata_.typeMatches(predDef.parameters[i], opt_ins_type.value())) //instance types not matching definition (nor its sub types)
             return UNKNOWN_INSTANCES;
     }
 
@@ -397,83 +569,136 @@ TargetBeliefAcceptance Scheduler::desireAcceptanceCheck(const ManagedDesire& md)
 }
 
 /*
-    Launch execution of selectedPlan; if successful current plan is pushed into waiting plans for execution gets value of selectedPlan
-    return true if successful
+    Launch execution of selectedPlan (alongside concurrentPlans, if any); if successful current_plan_ gets value of selectedPlan
+    and concurrent_plans_ the value of concurrentPlans
+    The request is served without blocking: @onTriggered is called with the outcome once the plan director answers
+    (reschedulings are held in the meantime)
 */
-bool Scheduler::launchPlanExecution(const BDIManaged::ManagedPlan& selectedPlan)
+void Scheduler::launchPlanExecution(const BDIManaged::ManagedPlan& selectedPlan, const vector<ManagedPlan>& concurrentPlans,
+    const function<void(bool)>& onTriggered)
 {   
     //trigger plan execution
-    bool triggered = plan_exec_srv_client_->triggerPlanExecution(selectedPlan.toPlan());
-    if(triggered)
-    {
-        current_plan_ = selectedPlan;// selectedPlan can now be set as currently executing plan
-        publishTargetGoalInfo(ADD_GOAL_BELIEFS);
-    }
+    vector<BDIPlan> concurrentBDIPlans;
+    for(const ManagedPlan& concurrentPlan : concurrentPlans)
+        concurrentBDIPlans.push_back(concurrentPlan.toPlan());
 
-    if(this->get_parameter(PARAM_DEBUG).as_bool())
+    plan_exec_request_pending_ = true;
+    plan_exec_srv_client_->triggerPlanExecutionAsync(selectedPlan.toPlan(), concurrentBDIPlans, 
+        [this, selectedPlan, concurrentPlans, onTriggered](bool triggered)
+        {
+            if(triggered)
+            {
+                current_plan_ = selectedPlan;// selectedPlan can now be set as currently executing plan
+                publishTargetGoalInfo(ADD_GOAL_BELIEFS);
+                concurrent_plans_ = concurrentPlans;
+                for(const ManagedPlan& concurrentPlan : concurrent_plans_)
+                    publishTargetGoalInfo(ADD_GOAL_BELIEFS, concurrentPlan);
+            }
+
+            if(this->get_parameter(PARAM_DEBUG).as_bool())
+            {
+                if(triggered) RCLCPP_INFO(this->get_logger(), "Triggered new plan execution fulfilling desire \"" + current_plan_.getPlanTarget().getName() + "\" success");
+                else RCLCPP_INFO(this->get_logger(), "Triggered new plan execution fulfilling desire \"" + selectedPlan.getPlanTarget().getName() + "\" failed");
+            }
+
+            planExecRequestDone();
+            onTriggered(triggered);
+        });
+}
+
+/*
+    Abort execution of current plan; if successful current plan (and the ones executed concurrently with it) are dropped
+    The request is served without blocking: @onAborted is called with the outcome once the plan director answers
+    (reschedulings are held in the meantime)
+*/
+void Scheduler::abortCurrentPlanExecution(const function<void(bool)>& onAborted)
+{
+    ManagedPlan abortingPlan = current_plan_;
+    plan_exec_request_pending_ = true;
+    plan_exec_srv_client_->abortPlanExecutionAsync(abortingPlan.toPlan(), [this, abortingPlan, onAborted](bool aborted)
     {
-        if(triggered) RCLCPP_INFO(this->get_logger(), "Triggered new plan execution fulfilling desire \"" + current_plan_.getPlanTarget().getName() + "\" success");
-        else RCLCPP_INFO(this->get_logger(), "Triggered new plan execution fulfilling desire \"" + selectedPlan.getPlanTarget().getName() + "\" failed");
-    }
+        // in the meantime the plan might have terminated by itself
+        aborted = aborted && !noPlanExecuting() && current_plan_ == abortingPlan;
+        if(aborted)
+        {
+            if(this->get_parameter(PARAM_DEBUG).as_bool())
+                RCLCPP_INFO(this->get_logger(), "Aborted plan execution fulfilling desire \"%s\"", current_plan_.getFinalTarget().getName());
+            
+            publishTargetGoalInfo(DEL_GOAL_BELIEFS);//goal disactivated -> upd belief set
+            current_plan_ = BDIManaged::ManagedPlan{}; //no plan in execution
+            
+            //plans executed concurrently are aborted with it
+            for(const ManagedPlan& concurrentPlan : concurrent_plans_)
+                publishTargetGoalInfo(DEL_GOAL_BELIEFS, concurrentPlan);
+            concurrent_plans_.clear();
+        }
 
-    return triggered;
+        planExecRequestDone();
+        onAborted(aborted);
+    });
 }
 
 /*
-    Abort execution of current plan; if successful waiting plans is popped empty
-    return true if successful
+    A trigger/abort request toward the plan director (or a search request toward JavaFF) has been answered: 
+    perform the reschedulings held in the meantime
 */
-bool Scheduler::abortCurrentPlanExecution()
+void Scheduler::planExecRequestDone()
 {
-    bool aborted = plan_exec_srv_client_->abortPlanExecution(current_plan_.toPlan());
-    if(aborted)
+    plan_exec_request_pending_ = false;
+    if(reschedule_held_)
     {
-        if(this->get_parameter(PARAM_DEBUG).as_bool())
-            RCLCPP_INFO(this->get_logger(), "Aborted plan execution fulfilling desire \"%s\"", current_plan_.getFinalTarget().getName());
-        
-        publishTargetGoalInfo(DEL_GOAL_BELIEFS);//goal disactivated -> upd belief set
-        current_plan_ = BDIManaged::ManagedPlan{}; //no plan in execution
-    }  
-    return aborted;
+        reschedule_held_ = false;
+        requestReschedule();
+    }
 }
 
 
 /*
     If selected plan fit the minimal requirements for a plan (i.e. not empty body and a desire which is in the desire_set)
     try triggering its execution by srv request to PlanDirector (/{agent}/plan_execution) by exploiting the TriggerPlanClient
+    (aborting first the plan in execution, if the reschedule policy allows it);
+    @onTriggered is called with the outcome without blocking the caller
 
 */
-bool Scheduler::tryTriggerPlanExecution(const ManagedPlan& selectedPlan)
+void Scheduler::tryTriggerPlanExecution(const ManagedPlan& selectedPlan, const function<void(bool)>& onTriggered, 
+    const vector<ManagedPlan>& concurrentPlans)
 {      
     string reschedulePolicy = this->get_parameter(PARAM_RESCHEDULE_POLICY).as_string();
     bool noPlan = noPlanExecuting();
     //rescheduling not ammitted -> a plan already executing and policy not admit any switch with higher priority plans
     if(reschedulePolicy == VAL_RESCHEDULE_POLICY_NO_IF_EXEC && !noPlan)
-        return false;
+        return onTriggered(false);
 
-    //rescheduling possible, but plan currently in exec (substitute just for plan with higher priority)
-    bool planinExec = reschedulePolicy != VAL_RESCHEDULE_POLICY_NO_IF_EXEC && !noPlan;
-    if(planinExec)
+    // launch the plan, if still meaningful once the one in execution (if any) has been aborted
+    auto launch = [this, selectedPlan, concurrentPlans, onTriggered]()
     {
-        //before triggering new plan, abort the one currently in exec
-        if(this->get_parameter(PARAM_DEBUG).as_bool())
-                RCLCPP_INFO(this->get_logger(), "Ready to abort plan for desire \"" + current_plan_.getPlanTarget().getName() + "\"" + 
-                            " in order to trigger plan execution for desire \"" + selectedPlan.getPlanTarget().getName() + "\"");
-            
-        //trigger plan abortion
-        if(!abortCurrentPlanExecution())
-            return false;//current plan abortion failed
-    }
-    
-    //desire still in desire set
-    bool desireInDesireSet = desire_set_.count(selectedPlan.getFinalTarget())==1;
+        //desire still in desire set
+        bool desireInDesireSet = desire_set_.count(selectedPlan.getFinalTarget())==1;
 
-    //check that a proper plan has been selected (with actions and fulfilling a desire in the desire_set_)
-    if(selectedPlan.getActionsExecInfo().size() == 0 || !desireInDesireSet)
-        return false;
-    
+        //check that a proper plan has been selected (with actions and fulfilling a desire in the desire_set_)
+        if(selectedPlan.getActionsExecInfo().size() == 0 || !desireInDesireSet)
+            return onTriggered(false);
+
+        launchPlanExecution(selectedPlan, concurrentPlans, onTriggered);
+    };
+
+    //rescheduling possible, but plan currently in exec (substitute just for plan with higher priority)
+    bool planinExec = reschedulePolicy != VAL_RESCHEDULE_POLICY_NO_IF_EXEC && !noPlan;
+    if(!planinExec)
+        return launch();
 
-    return launchPlanExecution(selectedPlan);
+    //before triggering new plan, abort the one currently in exec
+    if(this->get_parameter(PARAM_DEBUG).as_bool())
+            RCLCPP_INFO(this->get_logger(), "Ready to abort plan for desire \"" + current_plan_.getPlanTarget().getName() + "\"" + 
+                        " in order to trigger plan execution for desire \"" + selectedPlan.getPlanTarget().getName() + "\"");
+        
+    //trigger plan abortion
+    abortCurrentPlanExecution([launch, onTriggered](bool aborted)
+    {
+        if(!aborted)
+            return onTriggered(false);//current plan abortion failed
+        launch();
+    });
 }
 
 /*
@@ -482,41 +707,176 @@ bool Scheduler::tryTriggerPlanExecution(const ManagedPlan& selectedPlan)
 */
 bool Scheduler::isDesireSatisfied(ManagedDesire& md)
 {
-    return md.isFulfilled(belief_set_);
+    return md.isFulfilled(belief_set_mirror_.getBeliefSet());
 }
 
 /*
-    The belief set has been updated
+    Store in the plan library a plan which has been executed successfully (plan lib id of @mp set accordingly)
 */
-void Scheduler::updatedBeliefSet(const BeliefSet::SharedPtr msg)
+void Scheduler::storeExecutedPlan(ManagedPlan& mp)
 {
-    set<ManagedBelief> newBeliefSet = BDIFilter::extractMGBeliefs(msg->value);
-    bool bsetModified = false;//is belief set altered from last update?
+    if(!planlib_conn_ok_ || mp.getActionsExecInfo().size() == 0)
+        return;
     
-    for(ManagedBelief mb : newBeliefSet)
-        if(belief_set_.count(mb) == 0)//check if new belief set has new items
+    int plan_id = planlib_db_->insertPlan(mp);//id of the already stored one, if same plan for same target and preconditions
+    if(plan_id >= 0)
+    {
+        mp.setPlanLibID(plan_id);
+        discarded_stored_plans_.erase(plan_id);//it has just worked out
+    }
+}
+
+/*
+    Retrieve from the plan library the stored plan (earliest deadline first) for the same target and preconditions of @md
+    which is applicable given the current belief set and has not been discarded after an aborted execution
+*/
+optional<ManagedPlan> Scheduler::retrieveStoredPlan(const ManagedDesire& md)
+{
+    if(!planlib_conn_ok_)
+        return std::nullopt;
+
+    for(const ManagedPlan& mp : planlib_db_->retrievePlans(md))
+        if(discarded_stored_plans_.count(mp.getPlanLibID()) == 0 && storedPlanApplicable(mp))
         {
-            bsetModified = true;
-            break;
+            if(this->get_parameter(PARAM_DEBUG).as_bool())
+                RCLCPP_INFO(this->get_logger(), "Stored plan %d retrieved from plan library for desire \"" + md.getName() + "\"", 
+                    mp.getPlanLibID());
+            return mp;
         }
     
-    if(!bsetModified)
-        for(ManagedBelief mb : belief_set_)
-            if(newBeliefSet.count(mb) == 0)//check if new belief set has lost a few items
+    return std::nullopt;
+}
+
+/*
+    Fast applicability check of a stored plan wrt. the current belief set:
+    preconditions of its target hold, every arg of its actions is a known instance
+    and the at start/over all requirements of its first actions (i.e. the ones starting right away) are not violated
+    (requirements of the following actions are still checked by the executor at runtime)
+*/
+bool Scheduler::storedPlanApplicable(const ManagedPlan& mp)
+{
+    const BDIManaged::BeliefStore& belief_set = belief_set_mirror_.getBeliefSet();
+    if(!mp.getPrecondition().isSatisfied(belief_set))
+        return false;
+
+    set<string> instances;
+    for(const ManagedBelief* mb : belief_set.getByPDDLType(Belief().INSTANCE_TYPE))
+        instances.insert(mb->getName());
+
+    const vector<BDIActionExecutionInfo>& actions = mp.getActionsExecInfo();
+    float firstStart = -1.0f;
+    for(const BDIActionExecutionInfo& bdi_ai : actions)
+    {
+        for(const string& arg : bdi_ai.args)
+            if(instances.count(arg) == 0)
+                return false;
+        if(firstStart < 0.0f || bdi_ai.planned_start < firstStart)
+            firstStart = bdi_ai.planned_start;
+    }
+
+    for(const BDIActionExecutionInfo& bdi_ai : actions)
+        if(bdi_ai.planned_start <= firstStart + 0.001f && !actionRequirementsSatisfiable(bdi_ai.name, bdi_ai.args))
+        {
+            if(this->get_parameter(PARAM_DEBUG).as_bool())
+                RCLCPP_INFO(this->get_logger(), "Stored plan %d not applicable: requirements of its first action \"" + 
+                    bdi_ai.name + "\" are not satisfied", mp.getPlanLibID());
+            return false;
+        }
+    return true;
+}
+
+/*
+    False if an at start or over all requirement of the durative action @actionName grounded with @args is violated 
+    by the current belief set: just (negated) predicates within conjunctions are checked, 
+    anything else (disjunctions, numeric expressions) is deemed satisfiable
+*/
+bool Scheduler::actionRequirementsSatisfiable(const string& actionName, const vector<string>& args)
+{
+    shared_ptr<plansys2::DurativeAction> action = pddl_metadata_.getDurativeAction(actionName);
+    if(action == nullptr)
+        return true;//domain not available: left to the executor
+
+    // action params are referred within requirements either by their name or by their position ("?0", "?1", ...)
+    map<string, string> grounding;
+    for(int i = 0; i < action->parameters.size() && i < args.size(); i++)
+    {
+        grounding[action->parameters[i].name] = args[i];
+        grounding["?" + std::to_string(i)] = args[i];
+    }
+
+    const BDIManaged::BeliefStore& belief_set = belief_set_mirror_.getBeliefSet();
+    std::function<bool(const plansys2_msgs::msg::Tree&, const uint32_t&, const bool&)> satisfiable = 
+        [&](const plansys2_msgs::msg::Tree& tree, const uint32_t& nodeId, const bool& negated)
+    {
+        if(nodeId >= tree.nodes.size())
+            return true;
+        
+        const plansys2_msgs::msg::Node& node = tree.nodes[nodeId];
+        if(node.node_type == plansys2_msgs::msg::Node::AND && !negated)
+        {
+            for(const uint32_t& child : node.children)
+                if(!satisfiable(tree, child, false))
+                    return false;
+            return true;
+        }
+        else if(node.node_type == plansys2_msgs::msg::Node::NOT && node.children.size() == 1)
+            return satisfiable(tree, node.children[0], !negated);
+        
+        else if(node.node_type == plansys2_msgs::msg::Node::PREDICATE)
+        {
+            vector<ManagedParam> params;
+            for(const plansys2_msgs::msg::Param& param : node.parameters)
             {
-                bsetModified = true;
-                break;
+                auto grounded = grounding.find(param.name);
+                params.push_back(ManagedParam{(grounded != grounding.end())? grounded->second : param.name});
             }
+            bool holds = belief_set.count(ManagedBelief::buildMBPredicate(node.name, params)) > 0;
+            return negated? !holds : holds;
+        }
 
-    if(bsetModified)//if belief set appears different from last update
+        return true;
+    };
+
+    return satisfiable(action->at_start_requirements, 0, false) && satisfiable(action->over_all_requirements, 0, false);
+}
+
+/*
+    The belief set has been updated (full snapshot)
+*/
+void Scheduler::updatedBeliefSet(const BeliefSet::ConstSharedPtr msg)
+{
+    if(belief_set_mirror_.applySnapshot(*msg) == BeliefSetMirror::UPDATED)//if belief set appears different from last update
     {
-        belief_set_ = newBeliefSet;//update current mirroring of the belief set
-        
-        checkForSatisfiedDesires();//check for satisfied desires
-        if(state_ == SCHEDULING)
-            reschedule();//do a rescheduling
+        pddl_metadata_.syncInstances(belief_set_mirror_.getBeliefSet());
+        alteredBeliefSet(true);
+    }
+}
+
+/*
+    The belief set has been updated (delta wrt. previous version)
+*/
+void Scheduler::updatedBeliefSetDelta(const BeliefSetDelta::ConstSharedPtr msg)
+{
+    BeliefSetMirror::UpdateResult result = belief_set_mirror_.applyDelta(*msg);
+    if(result == BeliefSetMirror::GAP)//missed some update, ask for a full snapshot
+        belief_set_request_publisher_->publish(std_msgs::msg::Empty());
+    else if(result == BeliefSetMirror::UPDATED)
+    {
+        pddl_metadata_.updateInstances(msg->added, msg->removed);
+        alteredBeliefSet(!event_driven_ || referencedByDesires(msg->added) || 
+            referencedByDesires(msg->removed) || referencedByDesires(msg->modified));
     }
-    
+}
+
+/*
+    The mirrored belief set has been altered: check for satisfied desires and reschedule 
+    (just if @relevantForDesires in event driven mode)
+*/
+void Scheduler::alteredBeliefSet(const bool& relevantForDesires)
+{
+    checkForSatisfiedDesires();//check for satisfied desires
+    if(state_ == SCHEDULING && relevantForDesires)
+        requestReschedule();//do a rescheduling
 }
 
 /*  
@@ -554,6 +914,45 @@ void Scheduler::delDesireTopicCallBack(const Desire::SharedPtr msg)
     }
 }
 
+/*  
+    Someone has requested a desire set write: apply it and acknowledge it 
+    with the same request id and the resulting desire set version
+*/
+void Scheduler::desireSetWriteTopicCallBack(const DesireSetWrite::SharedPtr msg)
+{
+    vector<ManagedDesire> mds;
+    vector<ManagedDesire> altered;
+    for(const Desire& desire : msg->value)
+    {
+        ManagedDesire md = ManagedDesire{desire};
+        mds.push_back(md);
+        if((msg->operation == msg->ADD)? addDesire(md) : delDesire(md))
+            altered.push_back(md);
+    }
+
+    WriteAck ack = WriteAck();
+    ack.request_id = msg->request_id;
+    mtx_add_del_.lock();
+        for(const ManagedDesire& md : mds)
+            ack.performed.push_back(desire_set_.count(md) == ((msg->operation == msg->ADD)? 1 : 0));
+        ack.version = desire_set_version_;
+    mtx_add_del_.unlock();
+
+    if(altered.size() > 0)//some alteration done
+    {
+        publishDesireSet();
+
+        //call specific methods of SchedulerOffline/SchedulerOnline
+        for(const ManagedDesire& md : altered)
+            if(msg->operation == msg->ADD)
+                postAddDesireSuccess(md);
+            else
+                postDelDesireSuccess(md);
+    }
+    
+    desire_set_write_ack_publisher_->publish(ack);
+}
+
 /*
     Add desire Critical Section (to be executed AFTER having acquired mtx_add_del_.lock())
 
@@ -584,6 +983,7 @@ bool Scheduler::addDesireCS(ManagedDesire mdAdd, optional<ManagedDesire> necessa
         }
 
         desire_set_.insert(mdAdd);
+        desire_set_version_++;
         computed_plan_desire_map_.insert(std::pair<string, int>(mdAdd.getName(), 0));//to count invalid goal computations and discard after x
         aborted_plan_desire_map_.insert(std::pair<string, int>(mdAdd.getName(), 0));//to count invalid goal computations and discard after x
         
@@ -617,6 +1017,7 @@ bool Scheduler::delDesireCS(const ManagedDesire mdDel, const bool& wipeSameGroup
     if(desire_set_.count(mdDel)!=0)
     {
         desire_set_.erase(desire_set_.find(mdDel));
+        desire_set_version_++;
         computed_plan_desire_map_.erase(mdDel.getName());
         deleted = true;
         //RCLCPP_INFO(this->get_logger(), "Desire \"" + mdDel.getName() + "\" removed!");
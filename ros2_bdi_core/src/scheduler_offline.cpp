@@ -8,10 +8,20 @@
 /* Util classes */
 #include "ros2_bdi_utils/BDIPDDLConverter.hpp"
 #include "ros2_bdi_utils/BDIFilter.hpp"
+#include "ros2_bdi_utils/PDDLUtils.hpp"
+
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+// boot as rclcpp component
+#include "ros2_bdi_core/support/core_component.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
 
 using std::string;
 using std::vector;
 using std::set;
+using std::map;
 using std::shared_ptr;
 using std::chrono::milliseconds;
 using std::bind;
@@ -34,8 +44,10 @@ using ros2_bdi_interfaces::msg::BDIPlanExecutionInfo;
 using ros2_bdi_interfaces::msg::BDIPlanExecutionInfoMin;
 using ros2_bdi_interfaces::srv::BDIPlanExecution;
 
+using BDIManaged::ManagedBelief;
 using BDIManaged::ManagedDesire;
 using BDIManaged::ManagedPlan;
+using BDIManaged::BeliefStore;
 
 
 void SchedulerOffline::init()
@@ -44,23 +56,196 @@ void SchedulerOffline::init()
 
     //init SchedulerOffline specific props
     current_plan_ = ManagedPlan{};
+
+    // one planner client per worker, so that concurrent requests never share the same client (nor node name)
+    int planning_workers = std::max(1, (int) this->get_parameter(PARAM_PLANNING_WORKERS).as_int());
+    planner_workers_.clear();
+    for(int i = 0; i < planning_workers; i++)
+        planner_workers_.push_back(std::make_shared<PlannerWorkerClient>(PLANNER_WORKER_NODE_BASENAME + std::to_string(i)));
 }
 
 /*
     Compute plan from managed desire, setting its belief array representing the desirable state to reach
     as the goal of the PDDL problem 
+    (served from the plan cache if nothing relevant for the goal has changed since it was last computed,
+    otherwise from the plan library if an applicable plan has been stored for it)
 */
 optional<Plan> SchedulerOffline::computePlan(const ManagedDesire& md)
 {   
+    string pddl_goal = BDIPDDLConverter::desireToGoal(md.toDesire());
+    
+    //nothing relevant for this goal has changed since the last time a plan has been computed for it
+    uint64_t fingerprint = relevantBeliefsFingerprint(md);
+    auto cached = plan_cache_.find(pddl_goal);
+    if(cached != plan_cache_.end() && cached->second.fingerprint == fingerprint)
+        return cached->second.plan;
+
+    //stored plan applicable for this goal: dispatched without invoking the planner
+    optional<ManagedPlan> stored = retrieveStoredPlan(md);
+    if(stored.has_value())
+    {
+        optional<Plan> plan = stored.value().toPsys2Plan();
+        plan_cache_[pddl_goal] = PlanCacheEntry{fingerprint, plan, stored.value().getPlanLibID()};
+        return plan;
+    }
+
     //set desire as goal of the pddl_problem
-    if(!problem_expert_->setGoal(Goal{BDIPDDLConverter::desireToGoal(md.toDesire())})){
+    if(!problem_expert_->setGoal(Goal{pddl_goal})){
         //psys2_comm_errors_++;//plansys2 comm. errors
         return std::nullopt;
     }
 
     string pddl_domain = domain_expert_->getDomain();//get domain string
     string pddl_problem = problem_expert_->getProblem();//get problem string
-    return planner_client_->getPlan(pddl_domain, pddl_problem);//compute plan (n.b. goal unfeasible -> plan not computed)
+    optional<Plan> plan = planner_client_->getPlan(pddl_domain, pddl_problem);//compute plan (n.b. goal unfeasible -> plan not computed)
+    //n.b. no plan is not cached: it could come from a planner timeout/error rather than an unfeasible goal
+    if(plan.has_value())
+        plan_cache_[pddl_goal] = PlanCacheEntry{fingerprint, plan, -1};
+    else
+        plan_cache_.erase(pddl_goal);
+    return plan;
+}
+
+/*
+    Compute plans for all the given desires concurrently through the planner workers:
+    domain and problem are retrieved once and each desire gets its own goal specific copy of the problem
+    (the goal of the problem expert is left untouched)
+    (plans still valid in the plan cache or applicable ones stored in the plan library are not computed again)
+    n.b. still blocking: the caller waits for all the workers to be done (each get_plan request up to WAIT_GET_PLAN_TIMEOUT s)
+*/
+map<ManagedDesire, optional<Plan>> SchedulerOffline::computePlans(const vector<ManagedDesire>& candidates)
+{
+    map<ManagedDesire, optional<Plan>> computed_plans;
+
+    //serve from the plan cache whatever is still valid
+    vector<ManagedDesire> mds;
+    vector<string> pddl_goals;
+    vector<uint64_t> fingerprints;
+    for(const ManagedDesire& md : candidates)
+    {
+        string pddl_goal = BDIPDDLConverter::desireToGoal(md.toDesire());
+        uint64_t fingerprint = relevantBeliefsFingerprint(md);
+        auto cached = plan_cache_.find(pddl_goal);
+        if(cached != plan_cache_.end() && cached->second.fingerprint == fingerprint)
+            computed_plans[md] = cached->second.plan;
+        else if(optional<ManagedPlan> stored = retrieveStoredPlan(md))
+        {
+            computed_plans[md] = stored.value().toPsys2Plan();
+            plan_cache_[pddl_goal] = PlanCacheEntry{fingerprint, computed_plans[md], stored.value().getPlanLibID()};
+        }
+        else
+        {
+            mds.push_back(md);
+            pddl_goals.push_back(pddl_goal);
+            fingerprints.push_back(fingerprint);
+        }
+    }
+    if(mds.empty())
+        return computed_plans;
+
+    string pddl_domain = domain_expert_->getDomain();//get domain string
+    string pddl_problem = problem_expert_->getProblem();//get problem string
+
+    vector<string> pddl_problems;
+    for(const string& pddl_goal : pddl_goals)
+        pddl_problems.push_back(PDDLUtils::replacePDDLProblemGoal(pddl_problem, pddl_goal));
+
+    // each worker keeps picking the next desire to plan for, until there are none left
+    vector<optional<Plan>> plans(mds.size());
+    std::atomic<size_t> next_desire{0};
+    auto work = [&](shared_ptr<PlannerWorkerClient> planner)
+    {
+        for(size_t i = next_desire++; i < mds.size(); i = next_desire++)
+            plans[i] = planner->getPlan(pddl_domain, pddl_problems[i]);
+    };
+
+    vector<std::thread> workers;
+    for(size_t w = 0; w < planner_workers_.size() && w < mds.size(); w++)
+        workers.push_back(std::thread(work, planner_workers_[w]));
+    for(std::thread& worker : workers)
+        worker.join();
+
+    for(size_t i = 0; i < mds.size(); i++)
+    {
+        computed_plans[mds[i]] = plans[i];
+        if(plans[i].has_value())//no plan not cached (see computePlan)
+            plan_cache_[pddl_goals[i]] = PlanCacheEntry{fingerprints[i], plans[i], -1};
+        else
+            plan_cache_.erase(pddl_goals[i]);
+    }
+    return computed_plans;
+}
+
+/*
+    PlanSys2 domain expert gone down: drop the domain actions dependencies and the plans computed against the domain too
+*/
+void SchedulerOffline::invalidateDomain()
+{
+    Scheduler::invalidateDomain();
+    domain_actions_.reset();
+    plan_cache_.clear();
+}
+
+/*
+    Fingerprint of the beliefs which can affect planning for the desire: all the instances plus the predicates/functions
+    within the relevance cone of its goal (i.e. the ones read by the domain actions which might lead to it)
+*/
+uint64_t SchedulerOffline::relevantBeliefsFingerprint(const ManagedDesire& md)
+{
+    if(!domain_actions_.has_value())
+    {
+        string pddl_domain = domain_expert_->getDomain();
+        if(pddl_domain.empty())
+            return 0;//domain expert not answering: don't cache empty dependencies (plans meanwhile cached under fingerprint 0)
+        domain_actions_ = PDDLUtils::extractPDDLDomainActionsDependencies(pddl_domain);
+    }
+
+    set<string> goal_names;
+    for(const ManagedBelief& mb : md.getValue())
+        goal_names.insert(mb.getName());
+    set<string> relevant_names = PDDLUtils::computeRelevantPDDLNames(domain_actions_.value(), goal_names);
+
+    // order independent combination of the (mixed) hashes of the relevant beliefs, values and instance types included
+    auto mix = [](uint64_t h)
+    {
+        h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+        return h ^ (h >> 33);
+    };
+    const BeliefStore& belief_set = belief_set_mirror_.getBeliefSet();
+    uint64_t fingerprint = 0;
+    for(const ManagedBelief* mb : belief_set.getByPDDLType(Belief().INSTANCE_TYPE))
+        fingerprint += mix(BeliefStore::hash(*mb) ^ std::hash<string>{}(mb->type().name.str()));
+    for(const string& name : relevant_names)
+    {
+        for(const ManagedBelief* mb : belief_set.getByName(Belief().PREDICATE_TYPE, name))
+            fingerprint += mix(BeliefStore::hash(*mb));
+        for(const ManagedBelief* mb : belief_set.getByName(Belief().FUNCTION_TYPE, name))
+            fingerprint += mix(BeliefStore::hash(*mb) ^ std::hash<float>{}(mb->getValue()));
+    }
+    return fingerprint;
+}
+
+/*
+    Plan lib id of the plan currently cached for the goal of @md (-1 if not retrieved from the plan library)
+*/
+int SchedulerOffline::cachedPlanLibID(const ManagedDesire& md)
+{
+    auto cached = plan_cache_.find(BDIPDDLConverter::desireToGoal(md.toDesire()));
+    return (cached != plan_cache_.end())? cached->second.planlib_id : -1;
+}
+
+/*
+    Drop the cached plans for goals not pursued by any desire anymore
+*/
+void SchedulerOffline::prunePlanCache()
+{
+    set<string> pursued_goals;
+    for(const ManagedDesire& md : desire_set_)
+        pursued_goals.insert(BDIPDDLConverter::desireToGoal(md.toDesire()));
+    
+    for(auto it = plan_cache_.begin(); it != plan_cache_.end(); )
+        it = (pursued_goals.count(it->first) == 0)? plan_cache_.erase(it) : std::next(it);
 }
 
 /*
@@ -82,6 +267,10 @@ void SchedulerOffline::reschedule()
     float selectedDeadline = -1.0f;//  init to negative value
     
     ManagedPlan selectedPlan;
+
+    // multi-intention execution: plans respecting their deadline, among which the ones to execute alongside selectedPlan are picked
+    int maxIntentions = this->get_parameter(PARAM_MAX_INTENTIONS).as_int();
+    vector<ManagedPlan> feasiblePlans;
     
     vector<ManagedDesire> discarded_desires;
     
@@ -89,13 +278,28 @@ void SchedulerOffline::reschedule()
 
     set<ManagedDesire> skip_desires;
 
+    // concurrent planning: compute upfront the plans for all the desires which could be selected
+    // (the ones auto-submitted while iterating are planned for one by one as usual)
+    map<ManagedDesire, optional<Plan>> computed_plans;
+    if(planner_workers_.size() > 1)
+    {
+        vector<ManagedDesire> candidates;
+        for(const ManagedDesire& md : desire_set_)
+            if(!(current_plan_.getFinalTarget() == md) && !pursuedConcurrently(md) && !(planinExec && current_plan_.getFinalTarget().getPriority() > md.getPriority())
+                    && md.getPrecondition().isSatisfied(belief_set_mirror_.getBeliefSet()))
+                candidates.push_back(md);
+        
+        if(candidates.size() > 1)
+            computed_plans = computePlans(candidates);
+    }
+
     for(ManagedDesire md : desire_set_)
     {
         if(skip_desires.count(md) == 1)
             continue;
 
         //desire currently fulfilling
-        if(current_plan_.getFinalTarget() == md)
+        if(current_plan_.getFinalTarget() == md || pursuedConcurrently(md))
             continue;
         
         //plan in exec has higher priority than this one, skip this desire
@@ -106,21 +310,25 @@ void SchedulerOffline::reschedule()
         bool invalidDesire = false;//flag to mark invalid desire
         
         // select just desires with satisyfing precondition and 
-        // with higher or equal priority with respect to the one currently selected
-        bool explicitPreconditionSatisfied = md.getPrecondition().isSatisfied(belief_set_);
-        if(explicitPreconditionSatisfied && md.getPriority() >= highestPriority){
-            optional<Plan> opt_p = computePlan(md);
+        // with higher or equal priority with respect to the one currently selected (any, if more intentions can be executed concurrently)
+        bool explicitPreconditionSatisfied = md.getPrecondition().isSatisfied(belief_set_mirror_.getBeliefSet());
+        if(explicitPreconditionSatisfied && (md.getPriority() >= highestPriority || maxIntentions > 1)){
+            optional<Plan> opt_p = (computed_plans.count(md) > 0)? computed_plans[md] : computePlan(md);
             if(opt_p.has_value())
             {
                 computedPlan = true;
 
                 ManagedPlan mp = ManagedPlan{0, md, opt_p.value().items, md.getPrecondition(), md.getContext()};
+                mp.setPlanLibID(cachedPlanLibID(md));
                 // does computed deadline for this plan respect desire deadline?
                 if(mp.getPlannedDeadline() <= md.getDeadline()) 
                 {
+                    feasiblePlans.push_back(mp);
+
                     // pick it as selected plan iff: no plan selected yet || desire has higher priority than the one selected
                     // or equal priority, but smaller deadline
-                    if(selectedDeadline < 0 || md.getPriority() > highestPriority || mp.getPlannedDeadline() < selectedDeadline)
+                    if(selectedDeadline < 0 || md.getPriority() > highestPriority || 
+                        (md.getPriority() == highestPriority && mp.getPlannedDeadline() < selectedDeadline))
                     {    
                         selectedDeadline = mp.getPlannedDeadline();
                         highestPriority = md.getPriority();
@@ -223,16 +431,53 @@ void SchedulerOffline::reschedule()
     //removed discarded desires
     for(ManagedDesire md : discarded_desires)
         delDesire(md);
+    prunePlanCache();
 
     if(selectedPlan.getActionsExecInfo().size() > 0)
     {
-        bool triggered = tryTriggerPlanExecution(selectedPlan);
-        if(this->get_parameter(PARAM_DEBUG).as_bool())
+        vector<ManagedPlan> concurrentPlans;
+        if(maxIntentions > 1)
+            concurrentPlans = selectConcurrentPlans(selectedPlan, feasiblePlans, maxIntentions - 1);
+
+        int intentions = (int) concurrentPlans.size() + 1;
+        tryTriggerPlanExecution(selectedPlan, [this, intentions](bool triggered)
         {
-            if(triggered) RCLCPP_INFO(this->get_logger(), "Triggered new plan execution success");
-            else RCLCPP_INFO(this->get_logger(), "Triggered new plan execution failed");
-        }
+            if(this->get_parameter(PARAM_DEBUG).as_bool())
+            {
+                if(triggered) RCLCPP_INFO(this->get_logger(), "Triggered new plan execution success (%d concurrent intentions)", intentions);
+                else RCLCPP_INFO(this->get_logger(), "Triggered new plan execution failed");
+            }
+        }, concurrentPlans);
+    }
+}
+
+/*
+    Among @feasiblePlans, select (by priority, then deadline) up to @maxPlans plans to be executed concurrently with @selectedPlan:
+    each of them targets a desire of another group and shares no action/instance with @selectedPlan and with the other ones
+*/
+vector<ManagedPlan> SchedulerOffline::selectConcurrentPlans(const ManagedPlan& selectedPlan, vector<ManagedPlan> feasiblePlans, const int& maxPlans)
+{
+    std::stable_sort(feasiblePlans.begin(), feasiblePlans.end(), [](const ManagedPlan& mp1, const ManagedPlan& mp2){
+        return mp1.getFinalTarget().getPriority() > mp2.getFinalTarget().getPriority() || 
+            (mp1.getFinalTarget().getPriority() == mp2.getFinalTarget().getPriority() && mp1.getPlannedDeadline() < mp2.getPlannedDeadline());
+    });
+
+    vector<ManagedPlan> concurrentPlans;
+    for(const ManagedPlan& mp : feasiblePlans)
+    {
+        if(concurrentPlans.size() >= maxPlans)
+            break;
+
+        bool compatible = mp.getFinalTarget().getDesireGroup() != selectedPlan.getFinalTarget().getDesireGroup() && 
+            !ManagedPlan::conflicting(selectedPlan, mp);
+        for(int i = 0; i < concurrentPlans.size() && compatible; i++)
+            compatible = mp.getFinalTarget().getDesireGroup() != concurrentPlans[i].getFinalTarget().getDesireGroup() && 
+                !ManagedPlan::conflicting(concurrentPlans[i], mp);
+        
+        if(compatible)
+            concurrentPlans.push_back(mp);
     }
+    return concurrentPlans;
 }
 
 /*
@@ -241,7 +486,6 @@ void SchedulerOffline::reschedule()
 void SchedulerOffline::updatePlanExecution(const BDIPlanExecutionInfo::SharedPtr msg)
 {
     auto planExecInfo = (*msg);
-    ManagedDesire targetDesire = ManagedDesire{planExecInfo.target};
 
     if(!noPlanExecuting() && planExecInfo.target.name == current_plan_.getFinalTarget().getName())//current plan selected in execution update
     {
@@ -250,83 +494,153 @@ void SchedulerOffline::updatePlanExecution(const BDIPlanExecutionInfo::SharedPtr
         current_plan_.setCommittedStatus(true);//in offline version, all actions of current plan are ALWAYS committed to be executed
         publishCurrentIntention();
         
-        string targetDesireName = targetDesire.getName();
         if(planExecInfo.status != planExecInfo.RUNNING)//plan not running anymore
         {
-            publishTargetGoalInfo(DEL_GOAL_BELIEFS);
-            mtx_iter_dset_.lock();
-            bool desireAchieved = isDesireSatisfied(targetDesire);
-            if(desireAchieved)
+            ManagedPlan terminatedPlan = current_plan_;
+            bool otherIntentionsRunning = concurrent_plans_.size() > 0;
+            if(otherIntentionsRunning)
             {
-                delDesire(targetDesire, true);//desire achieved -> delete all desires within the same group
+                // plans executed concurrently are still running: the first of them becomes the current plan
+                current_plan_ = concurrent_plans_.front();
+                concurrent_plans_.erase(concurrent_plans_.begin());
+                current_plan_exec_info_ = BDIPlanExecutionInfo();
+                current_plan_exec_info_.target = current_plan_.getFinalTarget().toDesire();
+                current_plan_exec_info_.status = current_plan_exec_info_.RUNNING;
             }
+            else
+                current_plan_ = BDIManaged::ManagedPlan{}; // execution has been terminated, current plan empty
+
+            // current plan already replaced, so that handling the termination cannot abort the still running intentions
+            intentionTerminated(planExecInfo, terminatedPlan);
 
-            if(planExecInfo.status == planExecInfo.SUCCESSFUL)//plan exec completed successful
+            if(!otherIntentionsRunning)
+                requestReschedule();//next reschedule() will select a new plan if computable for a desire in desire set
+        }
+    }
+    else
+    {
+        // update about a plan executed concurrently with the current one
+        for(auto it = concurrent_plans_.begin(); it != concurrent_plans_.end(); it++)
+        {
+            if(planExecInfo.target.name == it->getFinalTarget().getName())
             {
-                if(this->get_parameter(PARAM_DEBUG).as_bool())
-                {   
-                    string addNote = desireAchieved? 
-                        "desire \"" + targetDesireName + "\" achieved will be removed from desire set" : 
-                        "desire \"" + targetDesireName + "\" still not achieved! It'll not removed from the desire set yet";
-                    
-                    RCLCPP_INFO(this->get_logger(), "Plan successfully executed: " + addNote);
+                it->setUpdatedInfo(planExecInfo);
+                it->setCommittedStatus(true);
+                if(planExecInfo.status != planExecInfo.RUNNING)//plan not running anymore
+                {
+                    ManagedPlan terminatedPlan = *it;
+                    concurrent_plans_.erase(it);
+                    intentionTerminated(planExecInfo, terminatedPlan);
                 }
+                break;
             }
+        }
+    }
+}
 
-            else if(planExecInfo.status == planExecInfo.ABORT && !desireAchieved)// plan exec aborted and desire not achieved
-            {
+/*
+    Execution of @mp (current plan or one executed concurrently with it) has terminated as reported by @planExecInfo:
+    remove its target desire if achieved, otherwise count the abortion (and possibly auto-submit its context conditions)
+*/
+void SchedulerOffline::intentionTerminated(const BDIPlanExecutionInfo& planExecInfo, const ManagedPlan& mp)
+{
+    ManagedDesire targetDesire = ManagedDesire{planExecInfo.target};
+    string targetDesireName = targetDesire.getName();
+    publishTargetGoalInfo(DEL_GOAL_BELIEFS, mp);
+    mtx_iter_dset_.lock();
+    bool desireAchieved = isDesireSatisfied(targetDesire);
+    if(desireAchieved)
+    {
+        delDesire(targetDesire, true);//desire achieved -> delete all desires within the same group
+    }
 
-                int maxPlanExecAttempts = this->get_parameter(PARAM_MAX_TRIES_EXEC_PLAN).as_int();
-                aborted_plan_desire_map_[targetDesireName]++;
-                
-                RCLCPP_INFO(this->get_logger(), "Plan execution for fulfilling desire \"" + targetDesireName + 
-                    "\" has been aborted for the %d time (max attempts: %d)", 
-                        aborted_plan_desire_map_[targetDesireName], maxPlanExecAttempts);
-                
-                if(aborted_plan_desire_map_[targetDesireName] >= maxPlanExecAttempts)
+    if(planExecInfo.status == planExecInfo.SUCCESSFUL && desireAchieved)
+    {
+        // persist it, so that it can be retrieved next time the same desire is pursued
+        ManagedPlan executedPlan = mp;
+        storeExecutedPlan(executedPlan);
+    }
+    else if(planExecInfo.status == planExecInfo.ABORT && !planExecInfo.sibling_abort && mp.getPlanLibID() >= 0)
+    {
+        // stored plan not working out in the current context: do not retrieve it again, next time ask the planner
+        discarded_stored_plans_.insert(mp.getPlanLibID());
+        plan_cache_.erase(BDIPDDLConverter::desireToGoal(mp.getPlanTarget().toDesire()));
+    }
+
+    if(planExecInfo.status == planExecInfo.SUCCESSFUL)//plan exec completed successful
+    {
+        if(this->get_parameter(PARAM_DEBUG).as_bool())
+        {   
+            string addNote = desireAchieved? 
+                "desire \"" + targetDesireName + "\" achieved will be removed from desire set" : 
+                "desire \"" + targetDesireName + "\" still not achieved! It'll not removed from the desire set yet";
+            
+            RCLCPP_INFO(this->get_logger(), "Plan successfully executed: " + addNote);
+        }
+    }
+
+    else if(planExecInfo.status == planExecInfo.ABORT && !desireAchieved)// plan exec aborted and desire not achieved
+    {
+
+        int maxPlanExecAttempts = this->get_parameter(PARAM_MAX_TRIES_EXEC_PLAN).as_int();
+        if(planExecInfo.sibling_abort)
+            // aborted along with a plan executed concurrently with it: not its own failure
+            RCLCPP_INFO(this->get_logger(), "Plan execution for fulfilling desire \"" + targetDesireName + 
+                "\" has been aborted along with a concurrent one: not counted as an attempt (%d so far, max attempts: %d)", 
+                    aborted_plan_desire_map_[targetDesireName], maxPlanExecAttempts);
+        else if(mp.getPlanLibID() >= 0)
+            // stored plan (already discarded above) not fitting the current context: the desire itself gets a new plan from the planner
+            RCLCPP_INFO(this->get_logger(), "Execution of stored plan %d for fulfilling desire \"" + targetDesireName + 
+                "\" has been aborted: not counted as an attempt (%d so far, max attempts: %d)", 
+                    mp.getPlanLibID(), aborted_plan_desire_map_[targetDesireName], maxPlanExecAttempts);
+        else
+        {
+            aborted_plan_desire_map_[targetDesireName]++;
+            
+            RCLCPP_INFO(this->get_logger(), "Plan execution for fulfilling desire \"" + targetDesireName + 
+                "\" has been aborted for the %d time (max attempts: %d)", 
+                    aborted_plan_desire_map_[targetDesireName], maxPlanExecAttempts);
+        }
+        
+        if(aborted_plan_desire_map_[targetDesireName] >= maxPlanExecAttempts)
+        {
+            if(this->get_parameter(PARAM_DEBUG).as_bool())
+                RCLCPP_INFO(this->get_logger(), "Desire \"" + targetDesireName + "\" will be removed because it doesn't seem feasible to fulfill it: too many plan abortions!");
+            delDesire(targetDesire, true);
+        
+        }else if(!targetDesire.getContext().isSatisfied(belief_set_mirror_.getBeliefSet()) && this->get_parameter(PARAM_AUTOSUBMIT_CONTEXT).as_bool()){
+            // check for context condition failed 
+            // (just if not already done... that's why you look into the invalid map)
+            // plan exec could have failed cause of them: evaluate if they can be reached and submit the desire to yourself
+            string fulfillContextDesireName = targetDesire.getName() + "_fulfill_context";
+            
+            // extract a desire (if possible) for each clause in the context conditions
+            vector<ManagedDesire> fulfillContextDesires = BDIFilter::conditionsToMGDesire(targetDesire.getContext(), 
+                fulfillContextDesireName, 
+                std::min(targetDesire.getPriority()+0.01f, 1.0f), targetDesire.getDeadline());
+            
+            for(ManagedDesire fulfillContextD : fulfillContextDesires)
+            {
+                if(desire_set_.count(fulfillContextD) == 0 && desireAcceptanceCheck(fulfillContextD) == ACCEPTED)
                 {
                     if(this->get_parameter(PARAM_DEBUG).as_bool())
-                        RCLCPP_INFO(this->get_logger(), "Desire \"" + targetDesireName + "\" will be removed because it doesn't seem feasible to fulfill it: too many plan abortions!");
-                    delDesire(targetDesire, true);
-                
-                }else if(!targetDesire.getContext().isSatisfied(belief_set_) && this->get_parameter(PARAM_AUTOSUBMIT_CONTEXT).as_bool()){
-                    // check for context condition failed 
-                    // (just if not already done... that's why you look into the invalid map)
-                    // plan exec could have failed cause of them: evaluate if they can be reached and submit the desire to yourself
-                    string fulfillContextDesireName = targetDesire.getName() + "_fulfill_context";
-                    
-                    // extract a desire (if possible) for each clause in the context conditions
-                    vector<ManagedDesire> fulfillContextDesires = BDIFilter::conditionsToMGDesire(targetDesire.getContext(), 
-                        fulfillContextDesireName, 
-                        std::min(targetDesire.getPriority()+0.01f, 1.0f), targetDesire.getDeadline());
-                    
-                    for(ManagedDesire fulfillContextD : fulfillContextDesires)
-                    {
-                        if(desire_set_.count(fulfillContextD) == 0 && desireAcceptanceCheck(fulfillContextD) == ACCEPTED)
-                        {
-                            if(this->get_parameter(PARAM_DEBUG).as_bool())
-                                RCLCPP_INFO(this->get_logger(), "Context conditions are not satisfied for desire \"" + targetDesire.getName() + "\" but could be satisfied: " +  
-                                    +  " auto-submission desire \"" + fulfillContextD.getName() + "\"");
-                            fulfillContextD.setParent(targetDesire);//set md as its parent desire
-                            addDesire(fulfillContextD, targetDesire, "_context");
-                        }
-                    }
-                    
+                        RCLCPP_INFO(this->get_logger(), "Context conditions are not satisfied for desire \"" + targetDesire.getName() + "\" but could be satisfied: " +  
+                            +  " auto-submission desire \"" + fulfillContextD.getName() + "\"");
+                    fulfillContextD.setParent(targetDesire);//set md as its parent desire
+                    addDesire(fulfillContextD, targetDesire, "_context");
                 }
-
-                //  if not reached max exec attempt, for now mantain the desire
-                //  if not valid anymore, it'll be eventually removed in next reschedulings, 
-                //  otherwise the plan will be commissioned again until reaching maxPlanExecAttempts
-
-                    
             }
-
-            mtx_iter_dset_.unlock();
-            current_plan_ = BDIManaged::ManagedPlan{}; // execution has been terminated, current plan empty
-            reschedule();
-            //next reschedule() will select a new plan if computable for a desire in desire set
+            
         }
+
+        //  if not reached max exec attempt, for now mantain the desire
+        //  if not valid anymore, it'll be eventually removed in next reschedulings, 
+        //  otherwise the plan will be commissioned again until reaching maxPlanExecAttempts
+
+            
     }
+
+    mtx_iter_dset_.unlock();
 }
 
 void SchedulerOffline::publishCurrentIntention(){
@@ -362,12 +676,16 @@ void SchedulerOffline::checkForSatisfiedDesires()
     {   
         if(isDesireSatisfied(md))//desire already achieved, remove it
         {
-            if(!noPlanExecuting() && current_plan_.getFinalTarget() == md && 
+            if(pursuedConcurrently(md) || (current_plan_.getFinalTarget() == md && concurrent_plans_.size() > 0))
+            {
+                //intentions executed concurrently cannot be aborted alone: desire deleted when its plan terminates
+            }
+            else if(!noPlanExecuting() && current_plan_.getFinalTarget() == md && 
                 current_plan_exec_info_.status == current_plan_exec_info_.RUNNING)  
             {
                 float plan_progress_status = computePlanProgressStatus();
                 
-                if(plan_progress_status < COMPLETED_THRESHOLD)
+                if(plan_progress_status < COMPLETED_THRESHOLD && !plan_exec_request_pending_)//(not already aborting it)
                 {
                     if(this->get_parameter(PARAM_DEBUG).as_bool())
                         RCLCPP_INFO(this->get_logger(), "Current plan execution fulfilling desire \"" + md.getName() + 
@@ -425,7 +743,7 @@ void SchedulerOffline::postAddDesireSuccess(const BDIManaged::ManagedDesire& md)
 
     if(state_ == SCHEDULING && desire_set_.size() > 0 && noPlanExecuting())// still there to be satisfied && no plan selected, rescheduled immediately
     {   
-        reschedule();
+        requestReschedule();
     }
 }
 
@@ -439,24 +757,18 @@ void SchedulerOffline::postDelDesireSuccess(const BDIManaged::ManagedDesire& md)
         abortCurrentPlanExecution();//abort current plan execution
 }
 
-
-
-int main(int argc, char ** argv)
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/scheduler_offline.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(SchedulerOffline& node)
 {
-  rclcpp::init(argc, argv); 
-  auto node = std::make_shared<SchedulerOffline>();
-  bool psys2_booted = node->wait_psys2_boot(std::chrono::seconds(8));//Wait max 8 seconds for plansys2 to boot
-  if(psys2_booted)
-  {
-    node->init();
-    rclcpp::spin(node);
-  }
-  else
-  {
-    std::cerr << "PlanSys2 failed to boot: node will not spin and process will terminate" << std::endl;
-  }
-  
-  rclcpp::shutdown();
-
-  return 0;
+    if(!node.wait_psys2_boot(std::chrono::seconds(8)))//Wait max 8 seconds for plansys2 to boot
+        return false;
+
+    node.init();
+    return true;
 }
+
+typedef CoreComponent<SchedulerOffline> SchedulerOfflineComponent;
+RCLCPP_COMPONENTS_REGISTER_NODE(SchedulerOfflineComponent)
@@ -5,12 +5,18 @@
 // Inner logic + ROS2 PARAMS & FIXED GLOBAL VALUES for Belief Manager node (for plan exec srv & topic)
 #include "ros2_bdi_core/params/plan_director_params.hpp"
 
+#include <algorithm>
+
 /* Util classes */
 #include "ros2_bdi_utils/BDIPDDLConverter.hpp"
 #include "ros2_bdi_utils/BDIFilter.hpp"
 
 #include "ros2_bdi_interfaces/msg/bdi_plan.hpp"
 
+// boot as rclcpp component
+#include "ros2_bdi_core/support/core_component.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
+
 using std::string;
 using std::vector;
 using std::set;
@@ -19,6 +25,7 @@ using std::chrono::milliseconds;
 using std::bind;
 using std::placeholders::_1;
 using std::optional;
+using std::function;
 
 using plansys2::PlannerClient;
 using plansys2::Goal;
@@ -75,7 +82,7 @@ void SchedulerOnline::init()
                 BOOST_DESIRE_TOPIC, rclcpp::QoS(10).reliable(),
                 bind(&SchedulerOnline::boostDesireTopicCallBack, this, _1));
 
-    javaff_client_ = std::make_shared<JavaFFClient>(string("javaff_srvs_caller"));
+    javaff_client_ = std::make_shared<JavaFFClient>(string("javaff_srvs_caller"), asyncSrvHost(this));
 
     javaff_search_subscriber_ = this->create_subscription<SearchResult>(
         JAVAFF_SEARCH_TOPIC, rclcpp::QoS(10).reliable(),
@@ -88,9 +95,6 @@ void SchedulerOnline::init()
     
     //javaff_exec_status_publisher_ init
     javaff_exec_status_publisher_ = this->create_publisher<ExecutionStatus>(JAVAFF_EXEC_STATUS_TOPIC, 10);
-    
-    // open connection to plan library and init. tables, if not already present
-    planlib_conn_ok_ = planlib_db_.initPlanLibrary();
 }
 
 
@@ -99,16 +103,20 @@ void SchedulerOnline::init()
 */
 void SchedulerOnline::storeEnqueuePlan(BDIManaged::ManagedPlan&mp)
 {
+    // plan and its successor relationship stored within a single transaction
+    bool batch = planlib_conn_ok_ && planlib_db_->beginTransaction();
     storePlan(mp);
     if(planlib_conn_ok_ && mp.getPlanLibID() >= 0)
     {
         //mp has been stored
         if(waiting_plans_.size() == 0 && current_plan_.getPlanLibID() >= 0)//mp is successor of current_plan_
-            planlib_db_.markSuccessors(current_plan_, mp);
+            planlib_db_->markSuccessors(current_plan_, mp);
         
         else if(waitingPlansBack().value().getPlanLibID() >= 0)//mp is successor of current_plan_
-            planlib_db_.markSuccessors(waitingPlansBack().value(), mp);
+            planlib_db_->markSuccessors(waitingPlansBack().value(), mp);
     }
+    if(batch)
+        planlib_db_->commitTransaction();
     enqueuePlan(mp);
 
     //Log enqueue
@@ -129,7 +137,7 @@ void SchedulerOnline::storePlan(BDIManaged::ManagedPlan&mp)
 {
     if(planlib_conn_ok_)
     {
-        int new_plan_id = planlib_db_.insertPlan(mp);
+        int new_plan_id = planlib_db_->insertPlan(mp);
         if(new_plan_id >= 0)
             //plan has been stored successfully
             mp.setPlanLibID(new_plan_id);
@@ -148,6 +156,12 @@ void SchedulerOnline::reschedule()
     if(reschedulePolicy == VAL_RESCHEDULE_POLICY_NO_IF_EXEC && !noPlan)//rescheduling not ammitted
         return;
 
+    if(plan_exec_request_pending_)
+    {
+        reschedule_held_ = true;//performed as the pending request is answered (see planExecRequestDone)
+        return;
+    }
+
 
     RCLCPP_INFO(this->get_logger(), "Online rescheduling");
     
@@ -162,7 +176,7 @@ void SchedulerOnline::reschedule()
         // FIRST BASIC RESCHEDULING selects highest priority desire which passes acceptance check, precondition check && has the highest priority atm
         TargetBeliefAcceptance validDesire = Scheduler::desireAcceptanceCheck(md);
         if(validDesire == ACCEPTED && 
-            md.getPrecondition().isSatisfied(belief_set_) && 
+            md.getPrecondition().isSatisfied(belief_set_mirror_.getBeliefSet()) && 
             md.getPriority() > selDesire.getPriority())
             selDesire = md;
         
@@ -189,13 +203,17 @@ void SchedulerOnline::reschedule()
     RCLCPP_INFO(this->get_logger(), "Starting search for the fullfillment of Alex's desire to " + selDesire.getName());
     
 
-    if(selDesire.getValue().size() > 0 && launchPlanSearch(selDesire))//a desire has effectively been selected && a search for it has been launched
-    {    
-        searching_ = true;
-        search_baseline_ = emptySearchBaseline();
-        RCLCPP_INFO(this->get_logger(), "Search started for the fullfillment of Alex's desire to " + selDesire.getName());
-        fulfilling_desire_ = selDesire; 
-    }
+    if(selDesire.getValue().size() > 0)//a desire has effectively been selected
+        launchPlanSearch(selDesire, [this, selDesire](bool launched)
+        {
+            if(launched)//a search for it has been launched
+            {    
+                searching_ = true;
+                search_baseline_ = emptySearchBaseline();
+                RCLCPP_INFO(this->get_logger(), "Search started for the fullfillment of Alex's desire to " + selDesire.getName());
+                fulfilling_desire_ = selDesire; 
+            }
+        });
 }
 
 void SchedulerOnline::abortedPlanHandler(const bool handleDelete)
@@ -247,6 +265,20 @@ void SchedulerOnline::resetSearchInfo()
 
 }
 
+/*
+    Continuation for the abortion of the current plan: if aborted, init all info related to current desire in pursuit
+    (unless a new one has been picked in the meantime)
+*/
+function<void(bool)> SchedulerOnline::resetSearchInfoOnAbort()
+{
+    ManagedDesire fulfillingDesire = fulfilling_desire_;
+    return [this, fulfillingDesire](bool aborted)
+    {
+        if(aborted && fulfilling_desire_ == fulfillingDesire)
+            resetSearchInfo();
+    };
+}
+
 /*
     Init all info related to current desire in pursuit & plan to fulfill it, then launch reschedule
 */
@@ -312,8 +344,6 @@ void SchedulerOnline::updatePlanExecution(const BDIPlanExecutionInfo::SharedPtr
             // plan not running anymore
             ManagedDesire finalTarget = current_plan_.getFinalTarget();
             
-            bool callUnexpectedState = false;
-
             if(planExecInfo.status == planExecInfo.SUCCESSFUL)//plan exec completed successful
             {
                 current_plan_ = ManagedPlan{};//no plan executing rn
@@ -325,25 +355,33 @@ void SchedulerOnline::updatePlanExecution(const BDIPlanExecutionInfo::SharedPtr
                     //launch plan execution
                     if(nextPPlanToExec.has_value() && nextPPlanToExec.value().getActionsExecInfo().size() > 0)
                     {
-                        bool triggeredNewPlanExec;
-                        triggeredNewPlanExec = tryTriggerPlanExecution(nextPPlanToExec.value());
-                        if(triggeredNewPlanExec)
-                            executing_pplan_index_ = nextPPlanToExec.value().getPlanQueueIndex();
-                        callUnexpectedState = !triggeredNewPlanExec;//if failed, call unexpected state srv
-                        
-                        if(this->get_parameter(PARAM_DEBUG).as_bool())
+                        int nextPPlanIndex = nextPPlanToExec.value().getPlanQueueIndex();
+                        tryTriggerPlanExecution(nextPPlanToExec.value(), [this, nextPPlanIndex, finalTarget](bool triggeredNewPlanExec)
                         {
-                            string plan_queue_indexes = "";
-                            for(int i=0; i<waiting_plans_.size(); i++)
-                                plan_queue_indexes += std::to_string(waiting_plans_[i].getPlanQueueIndex()) + ", ";
                             if(triggeredNewPlanExec)
-                                RCLCPP_INFO(this->get_logger(), "Started plan with index " + std::to_string(executing_pplan_index_) + "\n" + 
-                                                    " Current waiting queue status: " + plan_queue_indexes + "\"");
-                            else
-                                RCLCPP_INFO(this->get_logger(), "Failed to start new plan with index " + std::to_string(nextPPlanToExec.value().getPlanQueueIndex()) + "\n" +
-                                                    " Calling unexpectedState service\n" + 
-                                                    " Current waiting queue status: " + plan_queue_indexes + "\"");
-                        }
+                                executing_pplan_index_ = nextPPlanIndex;
+                            
+                            if(this->get_parameter(PARAM_DEBUG).as_bool())
+                            {
+                                string plan_queue_indexes = "";
+                                for(int i=0; i<waiting_plans_.size(); i++)
+                                    plan_queue_indexes += std::to_string(waiting_plans_[i].getPlanQueueIndex()) + ", ";
+                                if(triggeredNewPlanExec)
+                                    RCLCPP_INFO(this->get_logger(), "Started plan with index " + std::to_string(executing_pplan_index_) + "\n" + 
+                                                        " Current waiting queue status: " + plan_queue_indexes + "\"");
+                                else
+                                    RCLCPP_INFO(this->get_logger(), "Failed to start new plan with index " + std::to_string(nextPPlanIndex) + "\n" +
+                                                        " Calling unexpectedState service\n" + 
+                                                        " Current waiting queue status: " + plan_queue_indexes + "\"");
+                            }
+
+                            //if failed (and desire not achieved in the meantime), call unexpected state srv
+                            if(!triggeredNewPlanExec && desire_set_.count(finalTarget) > 0 && !isDesireSatisfied(finalTarget))
+                            {
+                                abortedPlanHandler();//increment counter for aborted plans that aimed at fulfilling desire x
+                                handleUnexpectedState();
+                            }
+                        });
                     }
                 }
                 else if(!searching_)
@@ -370,27 +408,42 @@ void SchedulerOnline::updatePlanExecution(const BDIPlanExecutionInfo::SharedPtr
                 return;
             }
 
-            if(!desireAchieved && (callUnexpectedState || planExecInfo.status == planExecInfo.ABORT))
+            if(planExecInfo.status == planExecInfo.ABORT)
             {
-                callUnexpectedState = true;
                 abortedPlanHandler();//increment counter for aborted plans that aimed at fulfilling desire x
-            }
-
-            if(callUnexpectedState)//handle the following with unexpected state srv
-            {   
-                publishTargetGoalInfo(DEL_GOAL_BELIEFS);
-                //tmp cleaning //TODO need to be revised this after having fixed search full reset 
-                current_plan_ = ManagedPlan{};//no plan executing rn
-                waiting_plans_ = vector<ManagedPlan>();
-                executing_pplan_index_ = -1;//will be put to 0 as soon as next first computed and received pplan is launched for execution and then upd over time 
-                searching_ = javaff_client_->callUnexpectedStateSrv(problem_expert_->getProblem());
-                if(!searching_)
-                    forcedReschedule();//if service call failed, just reschedule from scratch solution!!!
+                handleUnexpectedState();//handle the following with unexpected state srv
             }
         }
     }
 }
 
+/*
+    Current plan could not go on: drop it along with the waiting ones and ask JavaFF to search again from the current state
+    (reschedule from scratch if the unexpected state srv call fails)
+    The request is served without blocking: reschedulings are held until JavaFF answers
+*/
+void SchedulerOnline::handleUnexpectedState()
+{
+    publishTargetGoalInfo(DEL_GOAL_BELIEFS);
+    //tmp cleaning //TODO need to be revised this after having fixed search full reset 
+    current_plan_ = ManagedPlan{};//no plan executing rn
+    waiting_plans_ = vector<ManagedPlan>();
+    executing_pplan_index_ = -1;//will be put to 0 as soon as next first computed and received pplan is launched for execution and then upd over time 
+    searching_ = true;//search results coming before the answer are not to be dropped
+    plan_exec_request_pending_ = true;
+    javaff_client_->callUnexpectedStateSrvAsync(problem_expert_->getProblem(), [this](bool handled)
+    {
+        if(!handled)
+        {
+            searching_ = false;
+            reschedule_held_ = false;//covered by the forced rescheduling below
+        }
+        planExecRequestDone();
+        if(!handled)
+            forcedReschedule();//if service call failed, just reschedule from scratch solution!!!
+    });
+}
+
 /* 
     compare passed search baseline with current one
         returns: 
@@ -460,8 +513,14 @@ void SchedulerOnline::updatedSearchResult(const SearchResult::SharedPtr msg)
             //search is progressing
             if(!noPlanExecuting() && !current_plan_.getFinalTarget().equalsOrSupersetIgnoreAdvancedInfo(fulfilling_desire_))//started a new search for a different desire -> should abort old executing plan
             {    
-                if(abortCurrentPlanExecution())//if aborted is correctly performed, clean away the current waiting list as well, exploiting new msg to build the new one, for new instantiated search
-                    resetSearchInfo();
+                //if aborted is correctly performed, clean away the current waiting list as well, exploiting new msg to build the new one, for new instantiated search
+                //(the answer comes later on: just the waiting plans for other desires are dropped then)
+                abortCurrentPlanExecution([this](bool aborted)
+                {
+                    if(aborted)
+                        waiting_plans_.erase(std::remove_if(waiting_plans_.begin(), waiting_plans_.end(), [this](const ManagedPlan& mp){
+                            return !mp.getFinalTarget().equalsOrSupersetIgnoreAdvancedInfo(fulfilling_desire_);}), waiting_plans_.end());
+                });
             }
 
             if(matching_baseline) // search baseline is matching with previously received search result
@@ -473,8 +532,7 @@ void SchedulerOnline::updatedSearchResult(const SearchResult::SharedPtr msg)
             {   
                 // search baseline is NOT matching with previously received search results
                 // received sub plan with a different search baseline wrt previous notification
-                if(processSearchResultWithNewBaseline(msg))
-                    search_baseline_ = msg->search_baseline;//update search baseline
+                processSearchResultWithNewBaseline(msg);//search baseline updated if accepted
                 // javaff will stop curr search via exec status because it is too late compared to current exec status
             }
             
@@ -537,21 +595,24 @@ bool SchedulerOnline::launchFirstPPlanExecution(const PartialPlan& firstpplan)
     if(firstPPlanToExec.getActionsExecInfo().size() > 0)
     {   
         storePlan(firstPPlanToExec);
-        bool triggered = tryTriggerPlanExecution(firstPPlanToExec);
-        if(this->get_parameter(PARAM_DEBUG).as_bool())
+        int firstPPlanIndex = firstPPlanToExec.getPlanQueueIndex();
+        ManagedDesire fulfillingDesire = fulfilling_desire_;
+        tryTriggerPlanExecution(firstPPlanToExec, [this, firstPPlanIndex, fulfillingDesire](bool triggered)
         {
-            if(triggered) RCLCPP_INFO(this->get_logger(), "Triggered new plan execution success");
-            else RCLCPP_INFO(this->get_logger(), "Triggered new plan execution failed");
-        }
+            if(this->get_parameter(PARAM_DEBUG).as_bool())
+            {
+                if(triggered) RCLCPP_INFO(this->get_logger(), "Triggered new plan execution success");
+                else RCLCPP_INFO(this->get_logger(), "Triggered new plan execution failed");
+            }
 
-        if(!triggered)// just reschedule from scratch
-        {
-            abortedPlanHandler();
-            forcedReschedule();
-            return false;
-        }
-        else
-            executing_pplan_index_ = firstPPlanToExec.getPlanQueueIndex();
+            if(triggered)
+                executing_pplan_index_ = firstPPlanIndex;
+            else if(fulfilling_desire_ == fulfillingDesire)// just reschedule from scratch (if still pursuing the same desire)
+            {
+                abortedPlanHandler();
+                forcedReschedule();
+            }
+        });
     }
     else
         return false;
@@ -562,7 +623,7 @@ bool SchedulerOnline::launchFirstPPlanExecution(const PartialPlan& firstpplan)
 /*
     Process updated search result presenting a new search baseline compared to previous msgs of the same type
 */
-bool SchedulerOnline::processSearchResultWithNewBaseline(const javaff_interfaces::msg::SearchResult::SharedPtr msg)
+void SchedulerOnline::processSearchResultWithNewBaseline(const javaff_interfaces::msg::SearchResult::SharedPtr msg)
 {
     // processSearchResultWithNewBaseline
     //      check if still feasible wrt. search_baseline and request early abort.
@@ -572,7 +633,7 @@ bool SchedulerOnline::processSearchResultWithNewBaseline(const javaff_interfaces
 
     if(psys2_current_plan.items.size() > 0 && psys2_current_plan.items.size() != msg->search_baseline.committed_actions.size())
     {
-        return false; // plans do not match: cannot be handled
+        return; // plans do not match: cannot be handled
     }
     
     // std::cout << "SchedulerOnline::processSearchResultWithNewBaseline\npindex: " << std::to_string(msg->search_baseline.executing_plan_index) << std::flush << std::endl;
@@ -591,26 +652,10 @@ bool SchedulerOnline::processSearchResultWithNewBaseline(const javaff_interfaces
             committed_counter++;
     }
 
-    bool successful_update = false;// it was possible to process successfully the search result with new baseline (i.e. not too late)
-
-    bool early_abort_request_success = false;
-    if(committed_counter < psys2_current_plan.items.size())
+    // search result with new baseline accepted (i.e. not too late): substitute plan queue and baseline
+    auto applySearchResult = [this, msg]()
     {
-        //in this case it make sense to do an early abort request
-        BDIPlan early_abort_bdiplan = BDIPlan{};
-        early_abort_bdiplan.target = current_plan_.getPlanTarget().toDesire();
-        early_abort_bdiplan.precondition = current_plan_.getPrecondition().toConditionsDNF();
-        early_abort_bdiplan.psys2_plan = psys2_current_plan;
-        early_abort_bdiplan.context = current_plan_.getContext().toConditionsDNF();
-        early_abort_request_success = plan_exec_srv_client_->earlyArrestRequest(early_abort_bdiplan);
-        if(this->get_parameter(PARAM_DEBUG).as_bool())
-            if(early_abort_request_success) RCLCPP_INFO(this->get_logger(), "Early arrest request: ACCEPTED");
-            else RCLCPP_INFO(this->get_logger(), "Early arrest request: TOO LATE!");
-    }
-
-    if(committed_counter == psys2_current_plan.items.size() || early_abort_request_success)
-    {
-        successful_update = true;
+        bool successful_update = true;
         int i = msg->base_plan_index;
 
         if(noPlanExecuting() && msg->plans[i].plan.items.size() > 0)
@@ -633,23 +678,46 @@ bool SchedulerOnline::processSearchResultWithNewBaseline(const javaff_interfaces
                 storeEnqueuePlan(computedMPP);
                 i++;
             }
+            search_baseline_ = msg->search_baseline;//update search baseline
         }
-        
+    };
+
+    if(committed_counter == psys2_current_plan.items.size())
+    {
+        applySearchResult();
+        return;
     }
 
-    return successful_update;
+    //in this case it make sense to do an early abort request (answered without blocking)
+    BDIPlan early_abort_bdiplan = BDIPlan{};
+    early_abort_bdiplan.target = current_plan_.getPlanTarget().toDesire();
+    early_abort_bdiplan.precondition = current_plan_.getPrecondition().toConditionsDNF();
+    early_abort_bdiplan.psys2_plan = psys2_current_plan;
+    early_abort_bdiplan.context = current_plan_.getContext().toConditionsDNF();
+    plan_exec_srv_client_->earlyArrestRequestAsync(early_abort_bdiplan, [this, applySearchResult](bool early_abort_request_success)
+    {
+        if(this->get_parameter(PARAM_DEBUG).as_bool())
+            if(early_abort_request_success) RCLCPP_INFO(this->get_logger(), "Early arrest request: ACCEPTED");
+            else RCLCPP_INFO(this->get_logger(), "Early arrest request: TOO LATE!");
+
+        if(early_abort_request_success)
+            applySearchResult();
+    });
 }
 
 
 /*
     Launch a new plan search
+    The request is served without blocking: @onLaunched is called with the outcome once JavaFF answers
+    (reschedulings are held in the meantime)
 */
-bool SchedulerOnline::launchPlanSearch(const BDIManaged::ManagedDesire& selDesire)
+void SchedulerOnline::launchPlanSearch(const BDIManaged::ManagedDesire& selDesire, const function<void(bool)>& onLaunched)
 {
     //set desire as goal of the pddl_problem
     if(!problem_expert_->setGoal(Goal{BDIPDDLConverter::desireToGoal(selDesire.toDesire())})){
         //psys2_comm_errors_++;//plansys2 comm. errors
-        return false;
+        onLaunched(false);
+        return;
     }
 
     string pddl_problem = problem_expert_->getProblem();//get problem string
@@ -657,7 +725,13 @@ bool SchedulerOnline::launchPlanSearch(const BDIManaged::ManagedDesire& selDesir
     int maxEmptySearchIntervals = this->get_parameter(JAVAFF_SEARCH_MAX_EMPTY_SEARCH_INTERVALS_PARAM).as_int();
     intervalSearchMS = intervalSearchMS >= 100? intervalSearchMS : 100;
     maxEmptySearchIntervals = maxEmptySearchIntervals > 0? maxEmptySearchIntervals : 16;
-    return javaff_client_->launchPlanSearch(selDesire.toDesire(), pddl_problem, intervalSearchMS, maxEmptySearchIntervals);
+    plan_exec_request_pending_ = true;
+    javaff_client_->launchPlanSearchAsync(selDesire.toDesire(), pddl_problem, intervalSearchMS, maxEmptySearchIntervals, 
+        [this, onLaunched](bool launched)
+        {
+            onLaunched(launched);
+            planExecRequestDone();
+        });
 }
 
 /*
@@ -694,15 +768,14 @@ void SchedulerOnline::checkForSatisfiedDesires()
             {
                 float plan_progress_status = computePlanProgressStatus();
                 
-                if(plan_progress_status < COMPLETED_THRESHOLD)
+                if(plan_progress_status < COMPLETED_THRESHOLD && !plan_exec_request_pending_)//(not already aborting it)
                 {
                     if(this->get_parameter(PARAM_DEBUG).as_bool())
                         RCLCPP_INFO(this->get_logger(), "Current plan execution fulfilling desire \"" + md.getName() + 
                             "\" will be aborted since desire is already fulfilled and plan exec. is still far from being completed " +
                             "(progress status = %f)", plan_progress_status);
 
-                    if(abortCurrentPlanExecution())
-                        resetSearchInfo();
+                    abortCurrentPlanExecution(resetSearchInfoOnAbort());
                 }
             }
             else
@@ -737,7 +810,7 @@ void SchedulerOnline::boostDesireTopicCallBack(const Desire::SharedPtr msg)
     else if (mdBoost.getName() == fulfilling_desire_.getName())
     {
         bool boosted = false;
-        if(mdBoost.getPrecondition().isSatisfied(belief_set_) && mdBoost.getContext().isSatisfied(belief_set_))
+        if(mdBoost.getPrecondition().isSatisfied(belief_set_mirror_.getBeliefSet()) && mdBoost.getContext().isSatisfied(belief_set_mirror_.getBeliefSet()))
         {
             // perform online boost
             ManagedDesire original_desire = fulfilling_desire_.clone();
@@ -811,7 +884,7 @@ void SchedulerOnline::postAddDesireSuccess(const BDIManaged::ManagedDesire& md)
 
     if(state_ == SCHEDULING && desire_set_.size() > 0 && noPlanExecuting())// still there to be satisfied && no plan selected, rescheduled immediately
     {   
-        reschedule();
+        requestReschedule();
     }
 }
 
@@ -824,29 +897,22 @@ void SchedulerOnline::postDelDesireSuccess(const BDIManaged::ManagedDesire& md)
     if(md == current_plan_.getFinalTarget())//deleted desire of current executing plan)
     {
         //ABORT CURRENT AND WAITING PLANS
-        if(abortCurrentPlanExecution())
-            resetSearchInfo();
+        abortCurrentPlanExecution(resetSearchInfoOnAbort());
     }
 }
 
-
-
-int main(int argc, char ** argv)
+/*
+    Boot sequence of the node, performed both by its standalone executable (see main/scheduler_online.cpp) and by its component (see CoreComponent):
+    returns false if the node could not be started (e.g. PlanSys2 not booted in time)
+*/
+bool bootCoreNode(SchedulerOnline& node)
 {
-  rclcpp::init(argc, argv); 
-  auto node = std::make_shared<SchedulerOnline>();
-  bool psys2_booted = node->wait_psys2_boot(std::chrono::seconds(8));//Wait max 8 seconds for plansys2 to boot
-  if(psys2_booted)
-  {
-    node->init();
-    rclcpp::spin(node);
-  }
-  else
-  {
-    std::cerr << "PlanSys2 failed to boot: node will not spin and process will terminate" << std::endl;
-  }
-  
-  rclcpp::shutdown();
-
-  return 0;
+    if(!node.wait_psys2_boot(std::chrono::seconds(8)))//Wait max 8 seconds for plansys2 to boot
+        return false;
+
+    node.init();
+    return true;
 }
+
+typedef CoreComponent<SchedulerOnline> SchedulerOnlineComponent;
+RCLCPP_COMPONENTS_REGISTER_NODE(SchedulerOnlineComponent)
@@ -4,6 +4,8 @@
 #include "ros2_bdi_core/params/scheduler_params.hpp"
 
 using std::string;
+using std::optional;
+using std::function;
 
 using BDIManaged::ManagedDesire;
 
@@ -11,102 +13,58 @@ using javaff_interfaces::srv::JavaFFPlan;
 using javaff_interfaces::srv::UnexpectedState;
 
 
-JavaFFClient::JavaFFClient(const string& nodeBasename)
+JavaFFClient::JavaFFClient(const string& nodeBasename, const optional<AsyncSrvHost>& asyncHost)
 {
     caller_node_ = rclcpp::Node::make_shared(nodeBasename);
-    start_plan_client_ = caller_node_->create_client<JavaFFPlan>(JAVAFF_START_PLAN_SRV);
-    unexpected_state_client_ = caller_node_->create_client<UnexpectedState>(JAVAFF_UNEXPECTED_STATE_SRV);
+
+    async_host_ = asyncHost;
+    if(async_host_.has_value())
+    {
+        async_start_plan_client_ = createAsyncSrvClient<JavaFFPlan>(async_host_.value(), JAVAFF_START_PLAN_SRV);
+        async_unexpected_state_client_ = createAsyncSrvClient<UnexpectedState>(async_host_.value(), JAVAFF_UNEXPECTED_STATE_SRV);
+    }
 }
 
-bool JavaFFClient::launchPlanSearch(const ros2_bdi_interfaces::msg::Desire& fulfilling_desire, const string& problem, const int& interval, const int& max_empty_search_intervals)
+/* 
+    Launch a plan search fulfilling @fulfilling_desire without blocking: @onResult is called with the outcome of the request
+    within the executor of the async host node (false on timeout or if no async host has been given)
+*/
+void JavaFFClient::launchPlanSearchAsync(const ros2_bdi_interfaces::msg::Desire& fulfilling_desire, const string& problem, const int& interval, const int& max_empty_search_intervals,
+    const function<void(bool)>& onResult)
 {
+    if(!async_host_.has_value())
+    {
+        RCLCPP_ERROR(caller_node_->get_logger(), "No async host node given for non blocking requests to %s srv", JAVAFF_START_PLAN_SRV);
+        onResult(false);
+        return;
+    }
+
     auto req = std::make_shared<JavaFFPlan::Request>();
     req->fulfilling_desire = fulfilling_desire;
     req->problem = problem;
     req->search_interval = interval;
     req->max_empty_search_intervals = max_empty_search_intervals;
-    return makePlanSearchRequest(req);
+    asyncSrvRequest<JavaFFPlan>(async_host_.value(), async_start_plan_client_, req, 
+        [onResult](JavaFFPlan::Response::SharedPtr response){ onResult(response != nullptr && response->accepted); },
+        std::chrono::seconds(WAIT_RESPONSE_TIMEOUT));
 }
 
 /* 
-    Manage the request call toward the javaff start_plan service
+    Notify an unexpected state to JavaFF without blocking: @onResult is called with the outcome of the request
+    within the executor of the async host node (false on timeout or if no async host has been given)
 */
-bool JavaFFClient::makePlanSearchRequest(const JavaFFPlan::Request::SharedPtr& request)
+void JavaFFClient::callUnexpectedStateSrvAsync(const string& pddl_problem, const function<void(bool)>& onResult)
 {
-    try{
-        while (!start_plan_client_->wait_for_service(std::chrono::seconds(WAIT_SRV_UP))) {
-            if (!rclcpp::ok()) {
-                return false;
-            }
-            RCLCPP_ERROR_STREAM(
-                caller_node_->get_logger(),
-                start_plan_client_->get_service_name() <<
-                    " service client: waiting for service to appear...");
-        }
-        auto future_result = start_plan_client_->async_send_request(request);
-        if (rclcpp::spin_until_future_complete(caller_node_, future_result, std::chrono::seconds(WAIT_RESPONSE_TIMEOUT)) !=
-            rclcpp::FutureReturnCode::SUCCESS)
-        {
-            return false;
-        }
-
-        auto response = future_result.get();
-        return response->accepted;
-    
-    }
-    catch(const rclcpp::exceptions::RCLError& rclerr)
-    {
-        RCLCPP_ERROR(caller_node_->get_logger(), rclerr.what());
-    }
-    catch(const std::exception &e)
+    if(!async_host_.has_value())
     {
-        RCLCPP_ERROR(caller_node_->get_logger(), "Response error in while trying to call %s srv", JAVAFF_START_PLAN_SRV);
+        RCLCPP_ERROR(caller_node_->get_logger(), "No async host node given for non blocking requests to %s srv", JAVAFF_UNEXPECTED_STATE_SRV);
+        onResult(false);
+        return;
     }
-    
-    return false;
-}
 
-bool JavaFFClient::callUnexpectedStateSrv(const string& pddl_problem)
-{
     auto req = std::make_shared<UnexpectedState::Request>();
     req->pddl_problem = pddl_problem;
-    return makeUnexpectedStateRequest(req);
+    asyncSrvRequest<UnexpectedState>(async_host_.value(), async_unexpected_state_client_, req, 
+        [onResult](UnexpectedState::Response::SharedPtr response){ onResult(response != nullptr && response->handled); },
+        std::chrono::seconds(WAIT_RESPONSE_TIMEOUT));
 }
-
-/* 
-    Manage the request call toward the javaff unexpected_state service
-*/
-bool JavaFFClient::makeUnexpectedStateRequest(const UnexpectedState::Request::SharedPtr& request)
-{
-    try{
-        while (!unexpected_state_client_->wait_for_service(std::chrono::seconds(WAIT_SRV_UP))) {
-            if (!rclcpp::ok()) {
-                return false;
-            }
-            RCLCPP_ERROR_STREAM(
-                caller_node_->get_logger(),
-                unexpected_state_client_->get_service_name() <<
-                    " service client: waiting for service to appear...");
-        }
-        auto future_result = unexpected_state_client_->async_send_request(request);
-        if (rclcpp::spin_until_future_complete(caller_node_, future_result, std::chrono::seconds(WAIT_RESPONSE_TIMEOUT)) !=
-            rclcpp::FutureReturnCode::SUCCESS)
-        {
-            return false;
-        }
-
-        auto response = future_result.get();
-        return response->handled;
-    
-    }
-    catch(const rclcpp::exceptions::RCLError& rclerr)
-    {
-        RCLCPP_ERROR(caller_node_->get_logger(), rclerr.what());
-    }
-    catch(const std::exception &e)
-    {
-        RCLCPP_ERROR(caller_node_->get_logger(), "Response error in while trying to call %s srv", JAVAFF_UNEXPECTED_STATE_SRV);
-    }
-    
-    return false;
-}
\ No newline at end of file
@@ -0,0 +1,61 @@
+/*  Header for supporting planner client node to make concurrent get_plan requests */
+#include "ros2_bdi_core/support/planner_worker_client.hpp"
+/* Inner logic + ROS2 PARAMS & FIXED GLOBAL VALUES for Scheduler node (timeout for srv)*/
+#include "ros2_bdi_core/params/scheduler_params.hpp"
+
+using std::string;
+using std::optional;
+
+using plansys2_msgs::msg::Plan;
+using plansys2_msgs::srv::GetPlan;
+
+
+PlannerWorkerClient::PlannerWorkerClient(const string& nodeName)
+{
+    caller_node_ = rclcpp::Node::make_shared(nodeName);
+    get_plan_client_ = caller_node_->create_client<GetPlan>(PSYS2_GET_PLAN_SRV);
+}
+
+/* 
+    Manage the request call toward the planner get_plan service
+*/
+optional<Plan> PlannerWorkerClient::getPlan(const string& domain, const string& problem)
+{
+    try{
+        while (!get_plan_client_->wait_for_service(std::chrono::seconds(WAIT_SRV_UP))) {
+            if (!rclcpp::ok()) {
+                return std::nullopt;
+            }
+            RCLCPP_ERROR_STREAM(
+                caller_node_->get_logger(),
+                get_plan_client_->get_service_name() <<
+                    " service client: waiting for service to appear...");
+        }
+
+        auto request = std::make_shared<GetPlan::Request>();
+        request->domain = domain;
+        request->problem = problem;
+        auto future_result = get_plan_client_->async_send_request(request);
+        if (rclcpp::spin_until_future_complete(caller_node_, future_result, std::chrono::seconds(WAIT_GET_PLAN_TIMEOUT)) !=
+            rclcpp::FutureReturnCode::SUCCESS)
+        {
+            return std::nullopt;
+        }
+
+        auto response = future_result.get();
+        if(response->success)
+            return response->plan;
+        
+        RCLCPP_ERROR(caller_node_->get_logger(), "Get plan error: %s", response->error_info.c_str());
+    }
+    catch(const rclcpp::exceptions::RCLError& rclerr)
+    {
+        RCLCPP_ERROR(caller_node_->get_logger(), rclerr.what());
+    }
+    catch(const std::exception &e)
+    {
+        RCLCPP_ERROR(caller_node_->get_logger(), "Response error in while trying to call %s srv", PSYS2_GET_PLAN_SRV);
+    }
+    
+    return std::nullopt;
+}
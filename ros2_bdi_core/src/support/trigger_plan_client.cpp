@@ -6,22 +6,33 @@
 #include "ros2_bdi_core/params/scheduler_params.hpp"
 
 using std::string;
+using std::vector;
+using std::optional;
+using std::function;
 
 using ros2_bdi_interfaces::msg::BDIPlan;
 using ros2_bdi_interfaces::srv::BDIPlanExecution;
 
- /* Constructor for the supporting node for calling the plan_execution service */
-TriggerPlanClient::TriggerPlanClient(const string& nodeBasename)
+/* 
+    Constructor for the supporting node for calling the plan_execution service
+    (@asyncHost, if given, is the node whose executor serves the non blocking requests)
+*/
+TriggerPlanClient::TriggerPlanClient(const string& nodeBasename, const optional<AsyncSrvHost>& asyncHost)
 {
     caller_node_ = rclcpp::Node::make_shared(nodeBasename);
     caller_client_ = caller_node_->create_client<BDIPlanExecution>(PLAN_EXECUTION_SRV);
+
+    async_host_ = asyncHost;
+    if(async_host_.has_value())
+        async_client_ = createAsyncSrvClient<BDIPlanExecution>(async_host_.value(), PLAN_EXECUTION_SRV);
 }
 
-/* Return true if operation is successful */
-bool TriggerPlanClient::triggerPlanExecution(const BDIPlan& bdiPlan)
+/* Return true if operation is successful (@concurrentPlans to be executed alongside @bdiPlan) */
+bool TriggerPlanClient::triggerPlanExecution(const BDIPlan& bdiPlan, const vector<BDIPlan>& concurrentPlans)
 {
     auto req = std::make_shared<BDIPlanExecution::Request>();
     req->plan = bdiPlan;
+    req->concurrent_plans = concurrentPlans;
     req->request = req->EXECUTE;
     return makePlanExecutionRequest(req);
 }
@@ -43,6 +54,35 @@ bool TriggerPlanClient::earlyArrestRequest(const BDIPlan& bdiPlan)
     req->request = req->EARLY_ABORT;
     return makePlanExecutionRequest(req);
 }
+/* 
+    Non blocking versions of the above: @onResult is called with the outcome of the operation
+    within the executor of the async host node (false on timeout or if no async host has been given)
+*/
+void TriggerPlanClient::triggerPlanExecutionAsync(const BDIPlan& bdiPlan, const vector<BDIPlan>& concurrentPlans, const function<void(bool)>& onResult)
+{
+    auto req = std::make_shared<BDIPlanExecution::Request>();
+    req->plan = bdiPlan;
+    req->concurrent_plans = concurrentPlans;
+    req->request = req->EXECUTE;
+    makePlanExecutionRequestAsync(req, onResult);
+}
+
+void TriggerPlanClient::abortPlanExecutionAsync(const BDIPlan& bdiPlan, const function<void(bool)>& onResult)
+{
+    auto req = std::make_shared<BDIPlanExecution::Request>();
+    req->plan = bdiPlan;
+    req->request = req->ABORT;
+    makePlanExecutionRequestAsync(req, onResult);
+}
+
+void TriggerPlanClient::earlyArrestRequestAsync(const BDIPlan& bdiPlan, const function<void(bool)>& onResult)
+{
+    auto req = std::make_shared<BDIPlanExecution::Request>();
+    req->plan = bdiPlan;
+    req->request = req->EARLY_ABORT;
+    makePlanExecutionRequestAsync(req, onResult);
+}
+
 /* 
     Manage the request call toward the plan_execution service, so that the public functions
     for triggering/aborting plan execution are just wrappers for it avoiding code duplication
@@ -83,4 +123,19 @@ bool TriggerPlanClient::makePlanExecutionRequest(const BDIPlanExecution::Request
     }
     
     return false;
+}
+
+/* Non blocking version of makePlanExecutionRequest */
+void TriggerPlanClient::makePlanExecutionRequestAsync(const BDIPlanExecution::Request::SharedPtr& request, const function<void(bool)>& onResult)
+{
+    if(!async_host_.has_value())
+    {
+        RCLCPP_ERROR(caller_node_->get_logger(), "No async host node given for non blocking requests to %s srv", PLAN_EXECUTION_SRV);
+        onResult(false);
+        return;
+    }
+
+    asyncSrvRequest<BDIPlanExecution>(async_host_.value(), async_client_, request, 
+        [onResult](BDIPlanExecution::Response::SharedPtr response){ onResult(response != nullptr && response->success); },
+        std::chrono::seconds(WAIT_RESPONSE_TIMEOUT));
 }
\ No newline at end of file
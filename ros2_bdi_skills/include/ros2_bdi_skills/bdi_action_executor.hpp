@@ -8,6 +8,7 @@
 #include <set>
 #include <tuple>
 #include <map>
+#include <functional>
 
 #include "plansys2_problem_expert/ProblemExpertClient.hpp"
 #include "plansys2_executor/ExecutorClient.hpp"
@@ -16,6 +17,7 @@
 
 #include "ros2_bdi_interfaces/msg/belief.hpp"
 #include "ros2_bdi_interfaces/msg/belief_set.hpp"
+#include "ros2_bdi_interfaces/msg/belief_set_delta.hpp"
 #include "ros2_bdi_interfaces/msg/desire.hpp"
 #include "ros2_bdi_interfaces/srv/check_belief.hpp"
 #include "ros2_bdi_interfaces/srv/upd_belief_set.hpp"
@@ -25,6 +27,7 @@
 #include "ros2_bdi_utils/ManagedBelief.hpp"
 #include "ros2_bdi_utils/ManagedDesire.hpp"
 #include "ros2_bdi_utils/BDIFilter.hpp"
+#include "ros2_bdi_utils/BeliefSetMirror.hpp"
 
 #include "ros2_bdi_skills/communications_structs.hpp"
 #include "ros2_bdi_skills/communications_client.hpp"
@@ -35,6 +38,7 @@
 // #include "javaff_interfaces/msg/action_execution_status.hpp"
 // #include "javaff_interfaces/msg/execution_status.hpp"
 
+#include "std_msgs/msg/empty.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "rclcpp_action/rclcpp_action.hpp"
 
@@ -42,7 +46,9 @@ typedef std::tuple
         <
           std::string, 
           BDIManaged::ManagedDesire, 
-          rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSet>::SharedPtr
+          rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSet>::SharedPtr,
+          rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSetDelta>::SharedPtr,
+          rclcpp::Publisher<std_msgs::msg::Empty>::SharedPtr
         > 
 
         MonitorDesire;
@@ -125,6 +131,39 @@ protected:
     BDICommunications::UpdDesireResult sendUpdDesireRequest(const std::string& agent_ref, 
         const ros2_bdi_interfaces::msg::Desire& desire, const BDICommunications::UpdOperation& op, const bool& monitor_fulfill);
 
+    /*
+      Batch versions of the above: all the beliefs/desires go to @agent_ref within a single request
+      and a single belief/desire set alteration on its side (results in the same order of the request ones)
+    */
+    std::vector<BDICommunications::CheckBeliefResult> sendCheckBeliefBatchRequest(const std::string& agent_ref, 
+        const std::vector<ros2_bdi_interfaces::msg::Belief>& beliefs);
+    std::vector<BDICommunications::UpdBeliefResult> sendUpdBeliefBatchRequest(const std::string& agent_ref, 
+        const std::vector<ros2_bdi_interfaces::msg::Belief>& beliefs, const BDICommunications::UpdOperation& op);
+    std::vector<BDICommunications::CheckDesireResult> sendCheckDesireBatchRequest(const std::string& agent_ref, 
+        const std::vector<ros2_bdi_interfaces::msg::Desire>& desires);
+    std::vector<BDICommunications::UpdDesireResult> sendUpdDesireBatchRequest(const std::string& agent_ref, 
+        const std::vector<ros2_bdi_interfaces::msg::Desire>& desires, const BDICommunications::UpdOperation& op, const bool& monitor_fulfill);
+
+    /*
+      Non blocking versions of the above: doWork goes on straight away (as well as belief updates processing)
+      and @onResult is called within this node's executor as soon as the response comes (or the request fails/times out)
+    */
+    void sendCheckBeliefRequestAsync(const std::string& agent_ref, const ros2_bdi_interfaces::msg::Belief& belief, 
+        const std::function<void(const BDICommunications::CheckBeliefResult&)>& onResult);
+    void sendUpdBeliefRequestAsync(const std::string& agent_ref, const ros2_bdi_interfaces::msg::Belief& belief, 
+        const BDICommunications::UpdOperation& op, const std::function<void(const BDICommunications::UpdBeliefResult&)>& onResult);
+    void sendCheckDesireRequestAsync(const std::string& agent_ref, const ros2_bdi_interfaces::msg::Desire& desire, 
+        const std::function<void(const BDICommunications::CheckDesireResult&)>& onResult);
+    void sendUpdDesireRequestAsync(const std::string& agent_ref, const ros2_bdi_interfaces::msg::Desire& desire, 
+        const BDICommunications::UpdOperation& op, const bool& monitor_fulfill, 
+        const std::function<void(const BDICommunications::UpdDesireResult&)>& onResult);
+
+    /*
+      Call @onReady within this node's executor as soon as the communication services of @agent_ref are up
+      (straight away, if they're already known to be): requests to it won't wait for them from then on
+    */
+    void notifyWhenAgentReady(const std::string& agent_ref, const std::function<void(const std::string&)>& onReady);
+
     /*
       if no monitored desire, just return false
       otherwise check if it is fulfilled in the respective monitored belief set
@@ -172,12 +211,18 @@ private:
     */
     void agentBeliefSetCallback(const ros2_bdi_interfaces::msg::BeliefSet::SharedPtr msg);
 
+    /*
+      apply a delta to the current monitored belief set (ask for a new snapshot if some delta has been missed)
+    */
+    void agentBeliefSetDeltaCallback(const ros2_bdi_interfaces::msg::BeliefSetDelta::SharedPtr msg);
+
 
-    //currently monitored desires: vector of tuples in the form (agent_id, desire to fulfill, subs to belief set of agent_id)
+    //currently monitored desires: vector of tuples in the form 
+    // (agent_id, desire to fulfill, subs to belief set of agent_id, subs to belief set delta of agent_id, pub of belief set requests to agent_id)
     std::vector<MonitorDesire>  monitored_desires_;
 
-    //currently monitoring belief sets: map (agent_id, belief set for agent_id)
-    std::map<std::string, std::set<BDIManaged::ManagedBelief>> monitored_bsets_;
+    //currently monitoring belief sets: map (agent_id, belief set mirror for agent_id)
+    std::map<std::string, BDIManaged::BeliefSetMirror> monitored_bsets_;
 
     // action name
     std::string action_name_;
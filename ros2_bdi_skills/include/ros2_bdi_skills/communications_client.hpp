@@ -4,6 +4,11 @@
 #include <algorithm>
 #include <string>
 #include <memory>
+#include <optional>
+#include <functional>
+#include <map>
+#include <vector>
+#include <mutex>
 
 #include "ros2_bdi_interfaces/msg/belief.hpp"
 #include "ros2_bdi_interfaces/msg/desire.hpp"
@@ -11,9 +16,14 @@
 #include "ros2_bdi_interfaces/srv/upd_belief_set.hpp"
 #include "ros2_bdi_interfaces/srv/check_desire.hpp"
 #include "ros2_bdi_interfaces/srv/upd_desire_set.hpp"
+#include "ros2_bdi_interfaces/srv/check_belief_batch.hpp"
+#include "ros2_bdi_interfaces/srv/upd_belief_set_batch.hpp"
+#include "ros2_bdi_interfaces/srv/check_desire_batch.hpp"
+#include "ros2_bdi_interfaces/srv/upd_desire_set_batch.hpp"
 
 #include "rclcpp/rclcpp.hpp"
 
+#include "ros2_bdi_core/support/async_srv_request.hpp"
 #include "ros2_bdi_skills/communications_structs.hpp"
 
 namespace BDICommunications{
@@ -26,6 +36,11 @@ namespace BDICommunications{
     {
         public:
             CommunicationsClient();
+            /*
+                @asyncHost is the node whose executor serves the non blocking requests
+                (i.e. the one of the action executor making them)
+            */
+            explicit CommunicationsClient(const AsyncSrvHost& asyncHost);
 
             /*
                 Sending CHECK belief request
@@ -70,23 +85,113 @@ namespace BDICommunications{
             BDICommunications::UpdDesireResult updDesireRequest(const std::string& agent_ref, 
                     const std::string& agent_group, const ros2_bdi_interfaces::msg::Desire& desire, const UpdOperation& op);
 
+            /*
+                Batch versions of the above requests: all the beliefs/desires go to @agent_ref within a single request
+                (results in the same order of the request ones)
+            */
+            std::vector<BDICommunications::CheckBeliefResult> checkBeliefBatchRequest(const std::string& agent_ref, 
+                    const std::string& agent_group, const std::vector<ros2_bdi_interfaces::msg::Belief>& beliefs);
+            
+            std::vector<BDICommunications::UpdBeliefResult> updBeliefBatchRequest(const std::string& agent_ref, 
+                    const std::string& agent_group, const std::vector<ros2_bdi_interfaces::msg::Belief>& beliefs, const UpdOperation& op);
+            
+            std::vector<BDICommunications::CheckDesireResult> checkDesireBatchRequest(const std::string& agent_ref, 
+                    const std::string& agent_group, const std::vector<ros2_bdi_interfaces::msg::Desire>& desires);
+            
+            std::vector<BDICommunications::UpdDesireResult> updDesireBatchRequest(const std::string& agent_ref, 
+                    const std::string& agent_group, const std::vector<ros2_bdi_interfaces::msg::Desire>& desires, const UpdOperation& op);
+
+            /*
+                Non blocking versions of the above requests: the caller goes on straight away and @onResult is called
+                within the executor of the async host node as the response comes (or the request fails/times out,
+                with accepted = false in the result)
+            */
+            void checkBeliefRequestAsync(const std::string& agent_ref, const std::string& agent_group, 
+                    const ros2_bdi_interfaces::msg::Belief& belief, 
+                    const std::function<void(const BDICommunications::CheckBeliefResult&)>& onResult);
+            
+            void updBeliefRequestAsync(const std::string& agent_ref, const std::string& agent_group, 
+                    const ros2_bdi_interfaces::msg::Belief& belief, const UpdOperation& op,
+                    const std::function<void(const BDICommunications::UpdBeliefResult&)>& onResult);
+            
+            void checkDesireRequestAsync(const std::string& agent_ref, const std::string& agent_group, 
+                    const ros2_bdi_interfaces::msg::Desire& desire, 
+                    const std::function<void(const BDICommunications::CheckDesireResult&)>& onResult);
+            
+            void updDesireRequestAsync(const std::string& agent_ref, const std::string& agent_group, 
+                    const ros2_bdi_interfaces::msg::Desire& desire, const UpdOperation& op,
+                    const std::function<void(const BDICommunications::UpdDesireResult&)>& onResult);
+
+            /*
+                Call @onReady (within the async host node executor) as soon as the communication services
+                of @agent_ref are up (straight away, if they're already known to be)
+            */
+            void notifyWhenReady(const std::string& agent_ref, const std::function<void(const std::string&)>& onReady);
+
         private:
-            // node to be spinned while making request
-            rclcpp::Node::SharedPtr node_;
+            // clients to the communication services of an agent
+            typedef struct{
+                rclcpp::Client<ros2_bdi_interfaces::srv::CheckBelief>::SharedPtr ck_belief;
+                rclcpp::Client<ros2_bdi_interfaces::srv::UpdBeliefSet>::SharedPtr add_belief;
+                rclcpp::Client<ros2_bdi_interfaces::srv::UpdBeliefSet>::SharedPtr del_belief;
+                rclcpp::Client<ros2_bdi_interfaces::srv::CheckDesire>::SharedPtr ck_desire;
+                rclcpp::Client<ros2_bdi_interfaces::srv::UpdDesireSet>::SharedPtr add_desire;
+                rclcpp::Client<ros2_bdi_interfaces::srv::UpdDesireSet>::SharedPtr del_desire;
+                // batch services (just for blocking requests)
+                rclcpp::Client<ros2_bdi_interfaces::srv::CheckBeliefBatch>::SharedPtr ck_belief_batch;
+                rclcpp::Client<ros2_bdi_interfaces::srv::UpdBeliefSetBatch>::SharedPtr add_belief_batch;
+                rclcpp::Client<ros2_bdi_interfaces::srv::UpdBeliefSetBatch>::SharedPtr del_belief_batch;
+                rclcpp::Client<ros2_bdi_interfaces::srv::CheckDesireBatch>::SharedPtr ck_desire_batch;
+                rclcpp::Client<ros2_bdi_interfaces::srv::UpdDesireSetBatch>::SharedPtr add_desire_batch;
+                rclcpp::Client<ros2_bdi_interfaces::srv::UpdDesireSetBatch>::SharedPtr del_desire_batch;
+            }AgentSrvClients;
+
+            // everything known about the communication services of an agent
+            typedef struct{
+                AgentSrvClients clients;// on node_ (blocking requests)
+                AgentSrvClients async_clients;// on the async host node (non blocking requests)
+                bool live;// services known to be up: requests skip waiting for them
+                std::vector<std::function<void(const std::string&)>> on_ready;// to be called as soon as they're up
+            }AgentCommunications;
+
+            /* true if there is an async host node for non blocking requests (error logged otherwise) */
+            bool checkAsyncHost(const std::string& serviceName);
+
+            /* clients for @agent_ref, created the first time it is referred to */
+            std::shared_ptr<AgentCommunications> agentCommunications(const std::string& agent_ref);
+
+            /* false if services of @agent_ref are not known to be up and do not appear within WAIT_SRV_UP */
+            bool waitForAgentServices(const std::string& agent_ref, const rclcpp::ClientBase::SharedPtr& client);
+
+            /* 
+                Record whether services of @agent_ref are up, 
+                calling pending ready notifications when they are 
+            */
+            void setAgentLive(const std::string& agent_ref, const bool& live);
+
+            /* check whether services of agents someone is waiting for have shown up */
+            void checkAwaitedAgents();
 
-            // below client instances to be instantiated while making a request to ...
+            /* 
+                Send @request to @agent_ref through @client spinning node_ while waiting for the response
+                (nullptr if the service is down or no response comes in time)
+            */
+            template<typename ServiceT>
+            typename ServiceT::Response::SharedPtr sendBlockingRequest(const std::string& agent_ref, 
+                    const typename rclcpp::Client<ServiceT>::SharedPtr& client, const typename ServiceT::Request::SharedPtr& request);
 
-            // ... @agent_ref/check_belief_srv
-            rclcpp::Client<ros2_bdi_interfaces::srv::CheckBelief>::SharedPtr ck_belief_client_;
+            // node to be spinned while making request
+            rclcpp::Node::SharedPtr node_;
 
-            // ... @agent_ref/check_desire_srv
-            rclcpp::Client<ros2_bdi_interfaces::srv::CheckDesire>::SharedPtr ck_desire_client_;
+            // node serving non blocking requests
+            std::optional<AsyncSrvHost> async_host_;
 
-            // ... @agent_ref/add_belief_srv OR  ... @agent_ref/del_belief_srv
-            rclcpp::Client<ros2_bdi_interfaces::srv::UpdBeliefSet>::SharedPtr upd_belief_client_;
+            // clients and discovery info per agent (agent_ref -> communications)
+            std::map<std::string, std::shared_ptr<AgentCommunications>> agents_;
+            std::mutex agents_mtx_;
 
-            // ... @agent_ref/add_desire_srv OR  ... @agent_ref/del_desire_srv
-            rclcpp::Client<ros2_bdi_interfaces::srv::UpdDesireSet>::SharedPtr upd_desire_client_;
+            // polling the services of agents someone is waiting for (on the async host node)
+            rclcpp::TimerBase::SharedPtr ready_watch_timer_;
     };
 };
 
@@ -25,6 +25,7 @@ using plansys2::ExecutorClient;
 
 using ros2_bdi_interfaces::msg::Belief;            
 using ros2_bdi_interfaces::msg::BeliefSet;            
+using ros2_bdi_interfaces::msg::BeliefSetDelta;            
 using ros2_bdi_interfaces::msg::Desire;  
 using ros2_bdi_interfaces::srv::CheckBelief;  
 using ros2_bdi_interfaces::srv::UpdBeliefSet;  
@@ -66,7 +67,7 @@ BDIActionExecutor::BDIActionExecutor(const string action_name, const int working
       // agent's group name
       agent_group_ = this->get_parameter(PARAM_AGENT_GROUP_ID).as_string();
 
-      comm_client_ = std::make_shared<CommunicationsClient>();
+      comm_client_ = std::make_shared<CommunicationsClient>(asyncSrvHost(this));
 
       // set agent id as specialized arguments
       vector<string> specialized_arguments = vector<string>();
@@ -180,7 +181,11 @@ rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn
     
     monitored_bsets_.clear();
     for(auto monitor_desire : monitored_desires_)
+    {
       std::get<2>(monitor_desire).reset();//should allow to cancel subscription to topic (https://answers.ros.org/question/354792/rclcpp-how-to-unsubscribe-from-a-topic/)
+      std::get<3>(monitor_desire).reset();
+      std::get<4>(monitor_desire).reset();
+    }
     monitored_desires_.clear();
 
     // exec_status_to_planner_publisher_->on_deactivate();
@@ -254,6 +259,77 @@ UpdDesireResult BDIActionExecutor::sendUpdDesireRequest(const string& agent_ref,
   return res;
 }
 
+/*
+  Batch versions of the above: all the beliefs/desires go to @agent_ref within a single request
+  and a single belief/desire set alteration on its side (results in the same order of the request ones)
+*/
+vector<CheckBeliefResult> BDIActionExecutor::sendCheckBeliefBatchRequest(const string& agent_ref, const vector<Belief>& beliefs)
+{
+  return comm_client_->checkBeliefBatchRequest(agent_ref, agent_group_, beliefs);
+}
+
+vector<UpdBeliefResult> BDIActionExecutor::sendUpdBeliefBatchRequest(const string& agent_ref, const vector<Belief>& beliefs, const UpdOperation& op)
+{
+  return comm_client_->updBeliefBatchRequest(agent_ref, agent_group_, beliefs, op);
+}
+
+vector<CheckDesireResult> BDIActionExecutor::sendCheckDesireBatchRequest(const string& agent_ref, const vector<Desire>& desires)
+{
+  return comm_client_->checkDesireBatchRequest(agent_ref, agent_group_, desires);
+}
+
+vector<UpdDesireResult> BDIActionExecutor::sendUpdDesireBatchRequest(const string& agent_ref, const vector<Desire>& desires, const UpdOperation& op, const bool& monitor_fulfill)
+{
+  auto results = comm_client_->updDesireBatchRequest(agent_ref, agent_group_, desires, op);
+  for(const auto& res : results)
+    if(res.accepted && res.performed && monitor_fulfill)
+      monitor(agent_ref, res.desire);
+  return results;
+}
+
+/*
+  Non blocking versions of the above: doWork goes on straight away (as well as belief updates processing)
+  and @onResult is called within this node's executor as soon as the response comes (or the request fails/times out)
+*/
+void BDIActionExecutor::sendCheckBeliefRequestAsync(const string& agent_ref, const Belief& belief, 
+  const std::function<void(const CheckBeliefResult&)>& onResult)
+{
+  comm_client_->checkBeliefRequestAsync(agent_ref, agent_group_, belief, onResult);
+}
+
+void BDIActionExecutor::sendUpdBeliefRequestAsync(const string& agent_ref, const Belief& belief, const UpdOperation& op, 
+  const std::function<void(const UpdBeliefResult&)>& onResult)
+{
+  comm_client_->updBeliefRequestAsync(agent_ref, agent_group_, belief, op, onResult);
+}
+
+void BDIActionExecutor::sendCheckDesireRequestAsync(const string& agent_ref, const Desire& desire, 
+  const std::function<void(const CheckDesireResult&)>& onResult)
+{
+  comm_client_->checkDesireRequestAsync(agent_ref, agent_group_, desire, onResult);
+}
+
+void BDIActionExecutor::sendUpdDesireRequestAsync(const string& agent_ref, const Desire& desire, const UpdOperation& op, const bool& monitor_fulfill,
+  const std::function<void(const UpdDesireResult&)>& onResult)
+{
+  comm_client_->updDesireRequestAsync(agent_ref, agent_group_, desire, op, 
+    [this, agent_ref, desire, monitor_fulfill, onResult](const UpdDesireResult& res)
+    {
+      if(res.accepted && res.performed && monitor_fulfill)
+        monitor(agent_ref, desire);
+      onResult(res);
+    });
+}
+
+/*
+  Call @onReady within this node's executor as soon as the communication services of @agent_ref are up
+  (straight away, if they're already known to be): requests to it won't wait for them from then on
+*/
+void BDIActionExecutor::notifyWhenAgentReady(const string& agent_ref, const std::function<void(const string&)>& onReady)
+{
+  comm_client_->notifyWhenReady(agent_ref, onReady);
+}
+
 /*
   if no monitored desire, just return false
   otherwise check if it is fulfilled in the respective monitored belief set
@@ -264,7 +340,7 @@ bool BDIActionExecutor::isMonitoredDesireFulfilled(const std::string& agent_ref,
   {
     if(std::get<0>(monitor_desire) == agent_ref && std::get<1>(monitor_desire) == ManagedDesire{desire})
       return monitored_bsets_.find(agent_ref) != monitored_bsets_.end() &&
-        (ManagedDesire{desire}).isFulfilled(monitored_bsets_.find(agent_ref)->second);
+        (ManagedDesire{desire}).isFulfilled(monitored_bsets_.find(agent_ref)->second.getBeliefSet());
   }   
   return false;
 }
@@ -280,8 +356,16 @@ void BDIActionExecutor::monitor(const string& agent_ref, const Desire& desire)
   rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSet>::SharedPtr agent_belief_set_subscriber = this->create_subscription<BeliefSet>(
             "/"+agent_ref+"/"+BELIEF_SET_TOPIC, qos_reliable,
             bind(&BDIActionExecutor::agentBeliefSetCallback, this, _1));
-
-  monitored_desires_.push_back(std::make_tuple(agent_ref, ManagedDesire{desire}, agent_belief_set_subscriber));
+  
+  rclcpp::Subscription<ros2_bdi_interfaces::msg::BeliefSetDelta>::SharedPtr agent_belief_set_delta_subscriber = this->create_subscription<BeliefSetDelta>(
+            "/"+agent_ref+"/"+BELIEF_SET_DELTA_TOPIC, qos_reliable,
+            bind(&BDIActionExecutor::agentBeliefSetDeltaCallback, this, _1));
+
+  rclcpp::Publisher<std_msgs::msg::Empty>::SharedPtr agent_belief_set_request_publisher = this->create_publisher<std_msgs::msg::Empty>(
+            "/"+agent_ref+"/"+BELIEF_SET_REQUEST_TOPIC, qos_reliable);
+  
+  monitored_desires_.push_back(std::make_tuple(agent_ref, ManagedDesire{desire}, 
+    agent_belief_set_subscriber, agent_belief_set_delta_subscriber, agent_belief_set_request_publisher));
 }
 
 /*
@@ -289,9 +373,21 @@ void BDIActionExecutor::monitor(const string& agent_ref, const Desire& desire)
 */
 void BDIActionExecutor::agentBeliefSetCallback(const BeliefSet::SharedPtr msg)
 {
-  map<string, set<ManagedBelief>>::iterator it = monitored_bsets_.find(msg->agent_id);
-  if(it != monitored_bsets_.end())
-    it->second = BDIFilter::extractMGBeliefs(msg->value);
-  else
-    monitored_bsets_.insert(monitored_bsets_.begin(), pair<string, set<ManagedBelief>>(msg->agent_id, BDIFilter::extractMGBeliefs(msg->value)));
+  monitored_bsets_[msg->agent_id].applySnapshot(*msg);
+}
+
+/*
+  apply a delta to the current monitored belief set (ask for a new snapshot if some delta has been missed)
+*/
+void BDIActionExecutor::agentBeliefSetDeltaCallback(const BeliefSetDelta::SharedPtr msg)
+{
+  if(monitored_bsets_[msg->agent_id].applyDelta(*msg) == BDIManaged::BeliefSetMirror::GAP)
+  {
+    for(auto monitor_desire : monitored_desires_)
+      if(std::get<0>(monitor_desire) == msg->agent_id)
+      {
+        std::get<4>(monitor_desire)->publish(std_msgs::msg::Empty());
+        break;
+      }
+  }
 }
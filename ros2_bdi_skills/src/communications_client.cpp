@@ -9,7 +9,13 @@
 //seconds to wait before giving up on waiting for the response
 #define WAIT_RESPONSE_TIMEOUT 1
 
+//milliseconds between two checks of the services of agents someone is waiting for
+#define READY_WATCH_PERIOD 500
+
 using std::string;
+using std::function;
+using std::vector;
+using std::shared_ptr;
 
 using ros2_bdi_interfaces::msg::Belief;                
 using ros2_bdi_interfaces::msg::Desire;  
@@ -17,6 +23,10 @@ using ros2_bdi_interfaces::srv::CheckBelief;
 using ros2_bdi_interfaces::srv::UpdBeliefSet;  
 using ros2_bdi_interfaces::srv::CheckDesire;  
 using ros2_bdi_interfaces::srv::UpdDesireSet; 
+using ros2_bdi_interfaces::srv::CheckBeliefBatch;  
+using ros2_bdi_interfaces::srv::UpdBeliefSetBatch;  
+using ros2_bdi_interfaces::srv::CheckDesireBatch;  
+using ros2_bdi_interfaces::srv::UpdDesireSetBatch; 
 
 using BDICommunications::CommunicationsClient;
 using BDICommunications::UpdOperation;
@@ -32,86 +42,162 @@ CommunicationsClient::CommunicationsClient()
     node_ = rclcpp::Node::make_shared("communications_client");
 }
 
-CheckBeliefResult CommunicationsClient::checkBeliefRequest(const string& agent_ref, const string& agent_group, const Belief& belief)
+/*
+    @asyncHost is the node whose executor serves the non blocking requests
+    (i.e. the one of the action executor making them)
+*/
+CommunicationsClient::CommunicationsClient(const AsyncSrvHost& asyncHost) : CommunicationsClient()
 {
-    string serviceName = "/" + agent_ref + "/" + CK_BELIEF_SRV;
-    CheckBeliefResult res{belief, false, false};
-
-    try{
-        ck_belief_client_ = node_->create_client<CheckBelief>(serviceName);
-    
-        while (!ck_belief_client_->wait_for_service(std::chrono::seconds(WAIT_SRV_UP))) {
-            RCLCPP_ERROR_STREAM(
-                node_->get_logger(),
-                ck_belief_client_->get_service_name() <<
-                    " service appears to be down");
-                    
-            return res;
-        }
-        auto request = std::make_shared<CheckBelief::Request>();
-        request->belief = belief;
-        request->agent_group = agent_group;
-        auto future_result = ck_belief_client_->async_send_request(request);
+    async_host_ = asyncHost;
+    ready_watch_timer_ = createAsyncSrvTimer(asyncHost, std::chrono::milliseconds(READY_WATCH_PERIOD), 
+        std::bind(&CommunicationsClient::checkAwaitedAgents, this));
+}
 
-        if (rclcpp::spin_until_future_complete(node_, future_result, std::chrono::seconds(WAIT_RESPONSE_TIMEOUT)) !=
-            rclcpp::FutureReturnCode::SUCCESS)
-        {
-            return res;
-        }
+/* true if there is an async host node for non blocking requests (error logged otherwise) */
+bool CommunicationsClient::checkAsyncHost(const string& serviceName)
+{
+    if(!async_host_.has_value())
+        RCLCPP_ERROR_STREAM(node_->get_logger(), "No async host node given for non blocking requests to " << serviceName);
+    return async_host_.has_value();
+}
 
-        auto response = future_result.get();
-        res.accepted = response->accepted;
-        res.found = response->found;
-    
+/* clients for @agent_ref, created the first time it is referred to */
+shared_ptr<CommunicationsClient::AgentCommunications> CommunicationsClient::agentCommunications(const string& agent_ref)
+{
+    std::lock_guard<std::mutex> lock(agents_mtx_);
+    auto found = agents_.find(agent_ref);
+    if(found != agents_.end())
+        return found->second;
+
+    string prefix = "/" + agent_ref + "/";
+    auto agent = std::make_shared<AgentCommunications>();
+    agent->live = false;
+    agent->clients.ck_belief = node_->create_client<CheckBelief>(prefix + CK_BELIEF_SRV);
+    agent->clients.add_belief = node_->create_client<UpdBeliefSet>(prefix + ADD_BELIEF_SRV);
+    agent->clients.del_belief = node_->create_client<UpdBeliefSet>(prefix + DEL_BELIEF_SRV);
+    agent->clients.ck_desire = node_->create_client<CheckDesire>(prefix + CK_DESIRE_SRV);
+    agent->clients.add_desire = node_->create_client<UpdDesireSet>(prefix + ADD_DESIRE_SRV);
+    agent->clients.del_desire = node_->create_client<UpdDesireSet>(prefix + DEL_DESIRE_SRV);
+    agent->clients.ck_belief_batch = node_->create_client<CheckBeliefBatch>(prefix + CK_BELIEF_BATCH_SRV);
+    agent->clients.add_belief_batch = node_->create_client<UpdBeliefSetBatch>(prefix + ADD_BELIEF_BATCH_SRV);
+    agent->clients.del_belief_batch = node_->create_client<UpdBeliefSetBatch>(prefix + DEL_BELIEF_BATCH_SRV);
+    agent->clients.ck_desire_batch = node_->create_client<CheckDesireBatch>(prefix + CK_DESIRE_BATCH_SRV);
+    agent->clients.add_desire_batch = node_->create_client<UpdDesireSetBatch>(prefix + ADD_DESIRE_BATCH_SRV);
+    agent->clients.del_desire_batch = node_->create_client<UpdDesireSetBatch>(prefix + DEL_DESIRE_BATCH_SRV);
+    if(async_host_.has_value())
+    {
+        const AsyncSrvHost& host = async_host_.value();
+        agent->async_clients.ck_belief = createAsyncSrvClient<CheckBelief>(host, prefix + CK_BELIEF_SRV);
+        agent->async_clients.add_belief = createAsyncSrvClient<UpdBeliefSet>(host, prefix + ADD_BELIEF_SRV);
+        agent->async_clients.del_belief = createAsyncSrvClient<UpdBeliefSet>(host, prefix + DEL_BELIEF_SRV);
+        agent->async_clients.ck_desire = createAsyncSrvClient<CheckDesire>(host, prefix + CK_DESIRE_SRV);
+        agent->async_clients.add_desire = createAsyncSrvClient<UpdDesireSet>(host, prefix + ADD_DESIRE_SRV);
+        agent->async_clients.del_desire = createAsyncSrvClient<UpdDesireSet>(host, prefix + DEL_DESIRE_SRV);
     }
-    catch(const rclcpp::exceptions::RCLError& rclerr)
+    agents_[agent_ref] = agent;
+    return agent;
+}
+
+/* false if services of @agent_ref are not known to be up and do not appear within WAIT_SRV_UP */
+bool CommunicationsClient::waitForAgentServices(const string& agent_ref, const rclcpp::ClientBase::SharedPtr& client)
+{
     {
-        RCLCPP_ERROR(node_->get_logger(), rclerr.what());
+        std::lock_guard<std::mutex> lock(agents_mtx_);
+        auto found = agents_.find(agent_ref);
+        if(found != agents_.end() && found->second->live)
+            return true;
     }
-    catch(const std::exception &e)
+
+    if(!client->wait_for_service(std::chrono::seconds(WAIT_SRV_UP)))
     {
-        RCLCPP_ERROR(node_->get_logger(), "Response error in " + serviceName);
+        RCLCPP_ERROR_STREAM(
+            node_->get_logger(),
+            client->get_service_name() <<
+                " service appears to be down");
+        return false;
     }
 
-    return res;
+    setAgentLive(agent_ref, true);
+    return true;
 }
 
-UpdBeliefResult CommunicationsClient::updBeliefRequest(const string& agent_ref, const string& agent_group, const Belief& belief, const UpdOperation& op)
+/* 
+    Record whether services of @agent_ref are up, 
+    calling pending ready notifications when they are 
+*/
+void CommunicationsClient::setAgentLive(const string& agent_ref, const bool& live)
 {
-    string serviceName = "/" + agent_ref + "/";
-    if(op == ADD)
-        serviceName += ADD_BELIEF_SRV;
-    else
-        serviceName += DEL_BELIEF_SRV;
+    vector<function<void(const string&)>> on_ready;
+    {
+        std::lock_guard<std::mutex> lock(agents_mtx_);
+        auto found = agents_.find(agent_ref);
+        if(found == agents_.end())
+            return;
+        found->second->live = live;
+        if(live)
+            on_ready.swap(found->second->on_ready);
+    }
 
-    UpdBeliefResult res{belief, op, false, false};
+    for(auto& notify : on_ready)
+        notify(agent_ref);
+}
 
-    try{
-        upd_belief_client_ = node_->create_client<UpdBeliefSet>(serviceName);
-
-        while (!upd_belief_client_->wait_for_service(std::chrono::seconds(WAIT_SRV_UP))) {
-            RCLCPP_ERROR_STREAM(
-                node_->get_logger(),
-                upd_belief_client_->get_service_name() <<
-                    " service appears to be down");
-                    
-            return res;
+/*
+    Call @onReady (within the async host node executor) as soon as the communication services
+    of @agent_ref are up (straight away, if they're already known to be)
+*/
+void CommunicationsClient::notifyWhenReady(const string& agent_ref, const function<void(const string&)>& onReady)
+{
+    auto agent = agentCommunications(agent_ref);
+    {
+        std::lock_guard<std::mutex> lock(agents_mtx_);
+        if(!agent->live)
+        {
+            agent->on_ready.push_back(onReady);
+            return;
         }
+    }
+    onReady(agent_ref);
+}
+
+/* check whether services of agents someone is waiting for have shown up */
+void CommunicationsClient::checkAwaitedAgents()
+{
+    vector<std::pair<string, shared_ptr<AgentCommunications>>> awaited;
+    {
+        std::lock_guard<std::mutex> lock(agents_mtx_);
+        for(const auto& agent : agents_)
+            if(!agent.second->live && !agent.second->on_ready.empty())
+                awaited.push_back(agent);
+    }
+
+    for(const auto& agent : awaited)
+        if(agent.second->async_clients.ck_belief->service_is_ready())
+            setAgentLive(agent.first, true);
+}
 
-        auto request = std::make_shared<UpdBeliefSet::Request>();
-        request->belief = belief;
-        request->agent_group = agent_group;
-        auto future_result = upd_belief_client_->async_send_request(request);
+/* 
+    Send @request to @agent_ref through @client spinning node_ while waiting for the response
+    (nullptr if the service is down or no response comes in time)
+*/
+template<typename ServiceT>
+typename ServiceT::Response::SharedPtr CommunicationsClient::sendBlockingRequest(const string& agent_ref, 
+    const typename rclcpp::Client<ServiceT>::SharedPtr& client, const typename ServiceT::Request::SharedPtr& request)
+{
+    try{
+        if(!waitForAgentServices(agent_ref, client))
+            return nullptr;
 
+        auto future_result = client->async_send_request(request);
         if (rclcpp::spin_until_future_complete(node_, future_result, std::chrono::seconds(WAIT_RESPONSE_TIMEOUT)) !=
             rclcpp::FutureReturnCode::SUCCESS)
         {
-            return res;
+            // wait again for the services on next request
+            setAgentLive(agent_ref, false);
+            return nullptr;
         }
 
-        auto response = future_result.get();
-        res.accepted = response->accepted;
-        res.performed = response->updated;
+        return future_result.get();
     }
     catch(const rclcpp::exceptions::RCLError& rclerr)
     {
@@ -119,101 +205,254 @@ UpdBeliefResult CommunicationsClient::updBeliefRequest(const string& agent_ref,
     }
     catch(const std::exception &e)
     {
-        RCLCPP_ERROR(node_->get_logger(), "Response error in " + serviceName);
+        RCLCPP_ERROR_STREAM(node_->get_logger(), "Response error in " << client->get_service_name());
     }
-
-    return res;
+    return nullptr;
 }
 
-CheckDesireResult CommunicationsClient::checkDesireRequest(const string& agent_ref, const string& agent_group, const Desire& desire)
+CheckBeliefResult CommunicationsClient::checkBeliefRequest(const string& agent_ref, const string& agent_group, const Belief& belief)
 {
-    string serviceName = "/" + agent_ref + "/" + CK_DESIRE_SRV;
-    CheckDesireResult res{desire, false, false};
-
-    try{
-        ck_desire_client_ = node_->create_client<CheckDesire>(serviceName);
-        
-        while (!ck_desire_client_->wait_for_service(std::chrono::seconds(WAIT_SRV_UP))) {
-            RCLCPP_ERROR_STREAM(
-                node_->get_logger(),
-                ck_desire_client_->get_service_name() <<
-                    " service appears to be down");
-                    
-            return res;
-        }
-
-        auto request = std::make_shared<CheckDesire::Request>();
-        request->desire = desire;
-        request->agent_group = agent_group;
-        auto future_result = ck_desire_client_->async_send_request(request);
-
-        if (rclcpp::spin_until_future_complete(node_, future_result, std::chrono::seconds(WAIT_RESPONSE_TIMEOUT)) !=
-            rclcpp::FutureReturnCode::SUCCESS)
-        {
-            return res;
-        }
+    CheckBeliefResult res{belief, false, false};
 
-        auto response = future_result.get();
+    auto request = std::make_shared<CheckBelief::Request>();
+    request->belief = belief;
+    request->agent_group = agent_group;
+    auto response = sendBlockingRequest<CheckBelief>(agent_ref, agentCommunications(agent_ref)->clients.ck_belief, request);
+    if(response != nullptr)
+    {
         res.accepted = response->accepted;
         res.found = response->found;
     }
-    catch(const rclcpp::exceptions::RCLError& rclerr)
+    return res;
+}
+
+UpdBeliefResult CommunicationsClient::updBeliefRequest(const string& agent_ref, const string& agent_group, const Belief& belief, const UpdOperation& op)
+{
+    UpdBeliefResult res{belief, op, false, false};
+
+    auto request = std::make_shared<UpdBeliefSet::Request>();
+    request->belief = belief;
+    request->agent_group = agent_group;
+    auto clients = agentCommunications(agent_ref)->clients;
+    auto response = sendBlockingRequest<UpdBeliefSet>(agent_ref, (op == ADD)? clients.add_belief : clients.del_belief, request);
+    if(response != nullptr)
     {
-        RCLCPP_ERROR(node_->get_logger(), rclerr.what());
+        res.accepted = response->accepted;
+        res.performed = response->updated;
     }
-    catch(const std::exception &e)
+    return res;
+}
+
+CheckDesireResult CommunicationsClient::checkDesireRequest(const string& agent_ref, const string& agent_group, const Desire& desire)
+{
+    CheckDesireResult res{desire, false, false};
+
+    auto request = std::make_shared<CheckDesire::Request>();
+    request->desire = desire;
+    request->agent_group = agent_group;
+    auto response = sendBlockingRequest<CheckDesire>(agent_ref, agentCommunications(agent_ref)->clients.ck_desire, request);
+    if(response != nullptr)
     {
-        RCLCPP_ERROR(node_->get_logger(), "Response error in " + serviceName);
+        res.accepted = response->accepted;
+        res.found = response->found;
     }
-    
     return res;
 }
 
 UpdDesireResult CommunicationsClient::updDesireRequest(const string& agent_ref, const string& agent_group, const Desire& desire, const UpdOperation& op)
 {
-    string serviceName = "/" + agent_ref + "/";
-    if(op == ADD)
-        serviceName += ADD_DESIRE_SRV;
-    else
-        serviceName += DEL_DESIRE_SRV;
-
     UpdDesireResult res{desire, op, false, false};
-    
-    try{
-        upd_desire_client_ = node_->create_client<UpdDesireSet>(serviceName);
-
-        while (!upd_desire_client_->wait_for_service(std::chrono::seconds(WAIT_SRV_UP))) {
-            RCLCPP_ERROR_STREAM(
-                node_->get_logger(),
-                upd_desire_client_->get_service_name() <<
-                    " service appears to be down");
-                    
-            return res;
-        }
-
-        auto request = std::make_shared<UpdDesireSet::Request>();
-        request->desire = desire;
-        request->agent_group = agent_group;
-        auto future_result = upd_desire_client_->async_send_request(request);
-
-        if (rclcpp::spin_until_future_complete(node_, future_result, std::chrono::seconds(WAIT_RESPONSE_TIMEOUT)) !=
-            rclcpp::FutureReturnCode::SUCCESS)
-        {
-            return res;
-        }
 
-        auto response = future_result.get();
+    auto request = std::make_shared<UpdDesireSet::Request>();
+    request->desire = desire;
+    request->agent_group = agent_group;
+    auto clients = agentCommunications(agent_ref)->clients;
+    auto response = sendBlockingRequest<UpdDesireSet>(agent_ref, (op == ADD)? clients.add_desire : clients.del_desire, request);
+    if(response != nullptr)
+    {
         res.accepted = response->accepted;
         res.performed = response->updated;
     }
-    catch(const rclcpp::exceptions::RCLError& rclerr)
+    return res;
+}
+
+/*
+    Batch versions of the above requests: all the beliefs/desires go to @agent_ref within a single request
+    (results in the same order of the request ones)
+*/
+vector<CheckBeliefResult> CommunicationsClient::checkBeliefBatchRequest(const string& agent_ref, const string& agent_group, const vector<Belief>& beliefs)
+{
+    vector<CheckBeliefResult> results;
+    for(const Belief& belief : beliefs)
+        results.push_back(CheckBeliefResult{belief, false, false});
+
+    auto request = std::make_shared<CheckBeliefBatch::Request>();
+    request->beliefs = beliefs;
+    request->agent_group = agent_group;
+    auto response = sendBlockingRequest<CheckBeliefBatch>(agent_ref, agentCommunications(agent_ref)->clients.ck_belief_batch, request);
+    for(int i = 0; response != nullptr && i < results.size() && i < response->accepted.size() && i < response->found.size(); i++)
     {
-        RCLCPP_ERROR(node_->get_logger(), rclerr.what());
+        results[i].accepted = response->accepted[i];
+        results[i].found = response->found[i];
     }
-    catch(const std::exception &e)
+    return results;
+}
+
+vector<UpdBeliefResult> CommunicationsClient::updBeliefBatchRequest(const string& agent_ref, const string& agent_group, const vector<Belief>& beliefs, const UpdOperation& op)
+{
+    vector<UpdBeliefResult> results;
+    for(const Belief& belief : beliefs)
+        results.push_back(UpdBeliefResult{belief, op, false, false});
+
+    auto request = std::make_shared<UpdBeliefSetBatch::Request>();
+    request->beliefs = beliefs;
+    request->agent_group = agent_group;
+    auto clients = agentCommunications(agent_ref)->clients;
+    auto response = sendBlockingRequest<UpdBeliefSetBatch>(agent_ref, (op == ADD)? clients.add_belief_batch : clients.del_belief_batch, request);
+    for(int i = 0; response != nullptr && i < results.size() && i < response->accepted.size() && i < response->updated.size(); i++)
     {
-        RCLCPP_ERROR(node_->get_logger(), "Response error in " + serviceName);
+        results[i].accepted = response->accepted[i];
+        results[i].performed = response->updated[i];
     }
+    return results;
+}
 
-    return res;
+vector<CheckDesireResult> CommunicationsClient::checkDesireBatchRequest(const string& agent_ref, const string& agent_group, const vector<Desire>& desires)
+{
+    vector<CheckDesireResult> results;
+    for(const Desire& desire : desires)
+        results.push_back(CheckDesireResult{desire, false, false});
+
+    auto request = std::make_shared<CheckDesireBatch::Request>();
+    request->desires = desires;
+    request->agent_group = agent_group;
+    auto response = sendBlockingRequest<CheckDesireBatch>(agent_ref, agentCommunications(agent_ref)->clients.ck_desire_batch, request);
+    for(int i = 0; response != nullptr && i < results.size() && i < response->accepted.size() && i < response->found.size(); i++)
+    {
+        results[i].accepted = response->accepted[i];
+        results[i].found = response->found[i];
+    }
+    return results;
+}
+
+vector<UpdDesireResult> CommunicationsClient::updDesireBatchRequest(const string& agent_ref, const string& agent_group, const vector<Desire>& desires, const UpdOperation& op)
+{
+    vector<UpdDesireResult> results;
+    for(const Desire& desire : desires)
+        results.push_back(UpdDesireResult{desire, op, false, false});
+
+    auto request = std::make_shared<UpdDesireSetBatch::Request>();
+    request->desires = desires;
+    request->agent_group = agent_group;
+    auto clients = agentCommunications(agent_ref)->clients;
+    auto response = sendBlockingRequest<UpdDesireSetBatch>(agent_ref, (op == ADD)? clients.add_desire_batch : clients.del_desire_batch, request);
+    for(int i = 0; response != nullptr && i < results.size() && i < response->accepted.size() && i < response->updated.size(); i++)
+    {
+        results[i].accepted = response->accepted[i];
+        results[i].performed = response->updated[i];
+    }
+    return results;
+}
+
+/*
+    Non blocking versions of the above requests: the caller goes on straight away and @onResult is called
+    within the executor of the async host node as the response comes (or the request fails/times out,
+    with accepted = false in the result)
+*/
+void CommunicationsClient::checkBeliefRequestAsync(const string& agent_ref, const string& agent_group, const Belief& belief, 
+    const function<void(const CheckBeliefResult&)>& onResult)
+{
+    string serviceName = "/" + agent_ref + "/" + CK_BELIEF_SRV;
+    CheckBeliefResult res{belief, false, false};
+    if(!checkAsyncHost(serviceName))
+        return onResult(res);
+    
+    auto request = std::make_shared<CheckBelief::Request>();
+    request->belief = belief;
+    request->agent_group = agent_group;
+    asyncSrvRequest<CheckBelief>(async_host_.value(), agentCommunications(agent_ref)->async_clients.ck_belief, request,
+        [this, agent_ref, res, onResult](CheckBelief::Response::SharedPtr response) mutable
+        {
+            setAgentLive(agent_ref, response != nullptr);
+            if(response != nullptr)
+            {
+                res.accepted = response->accepted;
+                res.found = response->found;
+            }
+            onResult(res);
+        }, std::chrono::seconds(WAIT_RESPONSE_TIMEOUT));
+}
+
+void CommunicationsClient::updBeliefRequestAsync(const string& agent_ref, const string& agent_group, const Belief& belief, const UpdOperation& op, 
+    const function<void(const UpdBeliefResult&)>& onResult)
+{
+    string serviceName = "/" + agent_ref + "/" + ((op == ADD)? ADD_BELIEF_SRV : DEL_BELIEF_SRV);
+    UpdBeliefResult res{belief, op, false, false};
+    if(!checkAsyncHost(serviceName))
+        return onResult(res);
+
+    auto request = std::make_shared<UpdBeliefSet::Request>();
+    request->belief = belief;
+    request->agent_group = agent_group;
+    auto clients = agentCommunications(agent_ref)->async_clients;
+    asyncSrvRequest<UpdBeliefSet>(async_host_.value(), (op == ADD)? clients.add_belief : clients.del_belief, request,
+        [this, agent_ref, res, onResult](UpdBeliefSet::Response::SharedPtr response) mutable
+        {
+            setAgentLive(agent_ref, response != nullptr);
+            if(response != nullptr)
+            {
+                res.accepted = response->accepted;
+                res.performed = response->updated;
+            }
+            onResult(res);
+        }, std::chrono::seconds(WAIT_RESPONSE_TIMEOUT));
+}
+
+void CommunicationsClient::checkDesireRequestAsync(const string& agent_ref, const string& agent_group, const Desire& desire, 
+    const function<void(const CheckDesireResult&)>& onResult)
+{
+    string serviceName = "/" + agent_ref + "/" + CK_DESIRE_SRV;
+    CheckDesireResult res{desire, false, false};
+    if(!checkAsyncHost(serviceName))
+        return onResult(res);
+
+    auto request = std::make_shared<CheckDesire::Request>();
+    request->desire = desire;
+    request->agent_group = agent_group;
+    asyncSrvRequest<CheckDesire>(async_host_.value(), agentCommunications(agent_ref)->async_clients.ck_desire, request,
+        [this, agent_ref, res, onResult](CheckDesire::Response::SharedPtr response) mutable
+        {
+            setAgentLive(agent_ref, response != nullptr);
+            if(response != nullptr)
+            {
+                res.accepted = response->accepted;
+                res.found = response->found;
+            }
+            onResult(res);
+        }, std::chrono::seconds(WAIT_RESPONSE_TIMEOUT));
+}
+
+void CommunicationsClient::updDesireRequestAsync(const string& agent_ref, const string& agent_group, const Desire& desire, const UpdOperation& op, 
+    const function<void(const UpdDesireResult&)>& onResult)
+{
+    string serviceName = "/" + agent_ref + "/" + ((op == ADD)? ADD_DESIRE_SRV : DEL_DESIRE_SRV);
+    UpdDesireResult res{desire, op, false, false};
+    if(!checkAsyncHost(serviceName))
+        return onResult(res);
+
+    auto request = std::make_shared<UpdDesireSet::Request>();
+    request->desire = desire;
+    request->agent_group = agent_group;
+    auto clients = agentCommunications(agent_ref)->async_clients;
+    asyncSrvRequest<UpdDesireSet>(async_host_.value(), (op == ADD)? clients.add_desire : clients.del_desire, request,
+        [this, agent_ref, res, onResult](UpdDesireSet::Response::SharedPtr response) mutable
+        {
+            setAgentLive(agent_ref, response != nullptr);
+            if(response != nullptr)
+            {
+                res.accepted = response->accepted;
+                res.performed = response->updated;
+            }
+            onResult(res);
+        }, std::chrono::seconds(WAIT_RESPONSE_TIMEOUT));
 }
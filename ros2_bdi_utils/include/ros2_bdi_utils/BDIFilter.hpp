@@ -11,6 +11,7 @@
 #include "ros2_bdi_interfaces/msg/desire_set.hpp"
 
 #include "ros2_bdi_utils/ManagedBelief.hpp"
+#include "ros2_bdi_utils/BeliefStore.hpp"
 #include "ros2_bdi_utils/ManagedDesire.hpp"
 #include "ros2_bdi_utils/ManagedCondition.hpp"
 #include "ros2_bdi_utils/ManagedConditionsConjunction.hpp"
@@ -24,6 +25,11 @@ namespace BDIFilter
   */
   ros2_bdi_interfaces::msg::BeliefSet extractBeliefSetMsg(const std::set<BDIManaged::ManagedBelief> managed_beliefs);
 
+  /*
+    Extract from passed store of ManagedBelief objects a BeliefSet msg (stamped with the digest of the store)
+  */
+  ros2_bdi_interfaces::msg::BeliefSet extractBeliefSetMsg(const BDIManaged::BeliefStore& managed_beliefs);
+
   /*
     Extract from passed set of ManagedDesire objects a DesireSet msg
   */
@@ -84,6 +90,13 @@ namespace BDIFilter
   */
   std::set<BDIManaged::ManagedBelief> extractMGFunctions(const std::set<BDIManaged::ManagedBelief> managed_beliefs);
 
+  /*
+    Extract from passed store just beliefs of type instance/predicate/function and put them into a set of ManagedBelief objects
+  */
+  std::set<BDIManaged::ManagedBelief> extractMGInstances(const BDIManaged::BeliefStore& managed_beliefs);
+  std::set<BDIManaged::ManagedBelief> extractMGPredicates(const BDIManaged::BeliefStore& managed_beliefs);
+  std::set<BDIManaged::ManagedBelief> extractMGFunctions(const BDIManaged::BeliefStore& managed_beliefs);
+
   /*
     Given array of ManagedCondition, desire base name (added a counter as suffix to distinguish them among each other),
     desire priority, desire deadline use it to build a ManagedDesire putting as value the conditions
@@ -96,7 +109,7 @@ namespace BDIFilter
   /*
     Extract managed belief instances, filtering by type if provided
   */
-  std::set<BDIManaged::ManagedBelief> filterMGBeliefInstances(const std::set<BDIManaged::ManagedBelief>& belief_set, 
+  std::set<BDIManaged::ManagedBelief> filterMGBeliefInstances(const BDIManaged::BeliefStore& belief_set, 
     const BDIManaged::ManagedType& type = BDIManaged::ManagedType{"", std::nullopt});
   
 }  // namespace BDIFilter
@@ -26,6 +26,12 @@ namespace BDIPDDLConverter
   */
   plansys2::Function buildFunction(const BDIManaged::ManagedBelief& mb);
 
+  /*
+      Build PDDL problem fact from ManagedBelief, normalized as per PDDLUtils::extractPDDLProblemFacts
+      (function value excluded) e.g. "r1 - robot", "(robot_at r1 wp1)", "(battery r1)"
+  */
+  std::string buildPDDLProblemFact(const BDIManaged::ManagedBelief& mb);
+
   /*
     Convert Desire into PDDL Goal
   */
@@ -2,31 +2,55 @@
 #define PlanLibrary__UTILS_H_
 
 #include <string>
+#include <vector>
 #include <sqlite3.h>
 
 #include "ros2_bdi_utils/ManagedBelief.hpp"
 #include "ros2_bdi_utils/ManagedCondition.hpp"
+#include "ros2_bdi_utils/ManagedDesire.hpp"
 #include "ros2_bdi_utils/ManagedPlan.hpp"
 
 typedef enum {PLANS,SUCCESSORS} PlanLibTable;
 
-std::string PLANS_TABLE = "plans";
-std::string SUCCESSORS_TABLE = "successors";
+#define PLANS_TABLE "plans"
+#define SUCCESSORS_TABLE "successors"
 
 namespace PlanLibrary
 {
     class BDIPlanLibrary{
         public:
-            BDIPlanLibrary(const std::string& db_filepath): 
-            db_filepath_(db_filepath)
+            BDIPlanLibrary(const std::string& db_filepath):
+            db_filepath_(db_filepath), db_(nullptr), insert_plan_stmt_(nullptr), insert_successors_stmt_(nullptr),
+            select_plan_stmt_(nullptr), select_plans_stmt_(nullptr), in_transaction_(false)
             {}
 
+            // the connection and the prepared statements are owned by a single instance
+            BDIPlanLibrary(const BDIPlanLibrary&) = delete;
+            BDIPlanLibrary& operator=(const BDIPlanLibrary&) = delete;
+            BDIPlanLibrary(BDIPlanLibrary&& other);
+
+            /*
+                Finalize prepared statements and close the connection to the plan library (committing pending batch, if any)
+            */
+            ~BDIPlanLibrary();
+
             /*
-                Open connection to plan library, saving reference pointer to it
+                Open the long-lived connection to plan library (WAL mode), init tables and indexes if not already present
+                and prepare the statements used by the other operations
                     @filepath where plan library is going to be stored in the fs
             */
             bool initPlanLibrary();
 
+            /*
+                Start a batch of operations executed within a single transaction (until commitTransaction)
+            */
+            bool beginTransaction();
+
+            /*
+                Commit the batch of operations started with beginTransaction
+            */
+            bool commitTransaction();
+
             /*
                 Store new plan, if not already present in the db
                 Plan stored with deadline, preconditions and target
@@ -34,29 +58,57 @@ namespace PlanLibrary
             */
             int insertPlan(const BDIManaged::ManagedPlan& mp);
 
+            /*
+                Store new plans within a single transaction
+                return generated ids for stored plans (-1 for the ones which have not been stored)
+            */
+            std::vector<int> insertPlans(const std::vector<BDIManaged::ManagedPlan>& mps);
+
             /*
                 Store in the db relationship mp1 -> mp2
             */
             bool markSuccessors(const BDIManaged::ManagedPlan& mp1, const BDIManaged::ManagedPlan& mp2);
 
+            /*
+                Retrieve stored plans having exactly the same target and preconditions of @md,
+                ordered by ascending deadline (plan lib id of each one already set)
+            */
+            std::vector<BDIManaged::ManagedPlan> retrievePlans(const BDIManaged::ManagedDesire& md);
+
 
         private:
 
             /*
                 create table utility function
-                select the right query to be performed in order to instantiate the table in the db, returns true if query executed successfully
+                select the right query to be performed in order to instantiate the table in the db (if not already defined),
+                returns true if query executed successfully
             */
-            bool createTable(sqlite3* DB, const PlanLibTable& table);
+            bool createTable(const PlanLibTable& table);
 
             /*
-                create table utility function if table is not already defined in the db
-                select the right query to be performed in order to instantiate the table in the db, 
-                returns true if query executed successfully OR selected table is already defined
+                execute a statement without results, returns true if executed successfully
             */
-            bool tryInitTable(sqlite3* DB, const PlanLibTable& table, const std::string& table_name);
+            bool exec(const std::string& query);
+
+            /*
+                serialize the target of the plan as stored in the target column
+            */
+            static std::string targetString(const std::vector<BDIManaged::ManagedBelief>& target_value);
 
             std::string db_filepath_;
+
+            // long-lived connection to the plan library
+            sqlite3* db_;
+
+            // cached prepared statements
+            sqlite3_stmt* insert_plan_stmt_;
+            sqlite3_stmt* insert_successors_stmt_;
+            sqlite3_stmt* select_plan_stmt_;
+            sqlite3_stmt* select_plans_stmt_;
+
+            // batch of operations in progress
+            bool in_transaction_;
     };
 };  // namespace PlanLibrary
 
-#endif  // PlanLibrary__UTILS_H_
\ No newline at end of file
+#endif  // PlanLibrary__UTILS_H_
@@ -0,0 +1,65 @@
+#ifndef BELIEF_SET_MIRROR_H_
+#define BELIEF_SET_MIRROR_H_
+
+#include <set>
+#include <string>
+#include <cstdint>
+
+#include "ros2_bdi_interfaces/msg/belief_set.hpp"
+#include "ros2_bdi_interfaces/msg/belief_set_delta.hpp"
+
+#include "ros2_bdi_utils/ManagedBelief.hpp"
+#include "ros2_bdi_utils/BeliefStore.hpp"
+
+namespace BDIManaged
+{
+    /*
+        Local mirror of the belief set of an agent, kept up to date through the full snapshots (BeliefSet)
+        and the incremental updates (BeliefSetDelta) published by its belief manager
+    */
+    class BeliefSetMirror
+    {
+        public:
+            /* Outcome of applying a snapshot/delta to the mirror */
+            enum UpdateResult {UPDATED, UNCHANGED, STALE, GAP};
+
+            /* Constructor methods */
+            BeliefSetMirror();
+
+            /*
+                Replace the mirror content with a full snapshot, which is always considered authoritative
+                (snapshots stamped with the same digest of the mirrored belief set are not even parsed)
+                Returns UPDATED if the mirrored belief set has changed, UNCHANGED otherwise
+            */
+            UpdateResult applySnapshot(const ros2_bdi_interfaces::msg::BeliefSet& msg);
+
+            /*
+                Apply an incremental update to the mirror
+                Returns UPDATED/UNCHANGED if applied, STALE if already covered by the mirror version (ignored)
+                GAP if some previous delta has been missed (ignored): a new snapshot is needed to resync the mirror
+            */
+            UpdateResult applyDelta(const ros2_bdi_interfaces::msg::BeliefSetDelta& msg);
+
+            /* getter methods for BeliefSetMirror instance prop */
+            const BeliefStore& getBeliefSet() const {return belief_set_;};
+            uint64_t getVersion() const {return version_;};
+
+            /* mirror has received a snapshot and no delta has been missed since the last one */
+            bool isSynced() const {return synced_;};
+
+        private:
+
+            // mirrored belief set
+            BeliefStore belief_set_;
+
+            // version of the mirrored belief set
+            uint64_t version_;
+
+            // snapshot received && no version gap detected after it
+            bool synced_;
+
+    };  // class BeliefSetMirror
+
+}
+
+#endif  // BELIEF_SET_MIRROR_H_
@@ -0,0 +1,151 @@
+#ifndef BELIEF_STORE_H_
+#define BELIEF_STORE_H_
+
+#include <set>
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ros2_bdi_utils/Symbol.hpp"
+#include "ros2_bdi_utils/ManagedBelief.hpp"
+
+namespace BDIManaged
+{
+    /*
+        Hash-indexed container of managed beliefs exposing the same set-like API of std::set<ManagedBelief>
+        (two beliefs are the same element under the same criteria of operator<, i.e. value of functions is not considered)
+
+        Beliefs are kept in a dense vector and looked up through an open-addressing table of precomputed 64-bit hashes.
+        Secondary indexes are maintained by pddl type, by name, by (name, arg position, arg value) and by instance type,
+        all keyed by the ids of the interned symbols (see Symbol)
+        An order independent 128-bit digest of the content is maintained too, so that two stores (even within different
+        processes) can be told equal or different without comparing them element by element
+
+        n.b. iteration order is NOT sorted and any insert/erase invalidates iterators and the pointers returned by the lookups
+    */
+    class BeliefStore
+    {
+        public:
+            typedef std::vector<ManagedBelief>::const_iterator const_iterator;
+            typedef const_iterator iterator;
+            typedef std::array<uint64_t, 2> Digest;
+
+            /* Constructor methods */
+            BeliefStore();
+            explicit BeliefStore(const std::set<ManagedBelief>& beliefs);
+            explicit BeliefStore(const std::vector<ManagedBelief>& beliefs);
+
+            /* set-like API */
+            std::pair<const_iterator, bool> insert(const ManagedBelief& mb);
+            size_t erase(const ManagedBelief& mb);
+            const_iterator find(const ManagedBelief& mb) const;
+            size_t count(const ManagedBelief& mb) const {return find(mb) != end()? 1 : 0;};
+            size_t size() const {return beliefs_.size();};
+            bool empty() const {return beliefs_.empty();};
+            void clear();
+
+            const_iterator begin() const {return beliefs_.begin();};
+            const_iterator end() const {return beliefs_.end();};
+
+            /* beliefs of the given pddl type (INSTANCE/PREDICATE/FUNCTION) */
+            std::vector<const ManagedBelief*> getByPDDLType(const int& pddl_type) const;
+
+            /* beliefs of the given pddl type with the given name (e.g. all the "robot_at" predicates) */
+            std::vector<const ManagedBelief*> getByName(const int& pddl_type, const std::string& name) const;
+            std::vector<const ManagedBelief*> getByName(const int& pddl_type, const Symbol& name) const;
+
+            /* beliefs of the given pddl type and name having @value as argument in position @pos (e.g. ("robot_at", 0, "r1")) */
+            std::vector<const ManagedBelief*> getByArg(const int& pddl_type, const std::string& name, const size_t& pos, const std::string& value) const;
+            std::vector<const ManagedBelief*> getByArg(const int& pddl_type, const Symbol& name, const size_t& pos, const Symbol& value) const;
+
+            /* instances of the given type (subtypes are not considered) */
+            std::vector<const ManagedBelief*> getInstancesByType(const std::string& type) const;
+
+            /* convert the store content into a std::set<ManagedBelief> */
+            std::set<ManagedBelief> toSet() const {return std::set<ManagedBelief>(beliefs_.begin(), beliefs_.end());};
+
+            /* 64-bit hash of a belief (over symbol ids), consistent with operator< (value of functions is not considered) */
+            static uint64_t hash(const ManagedBelief& mb);
+
+            /*
+                Order independent digest of the store content (i.e. sum of the digests of the stored beliefs), all zeros if empty
+            */
+            const Digest& digest() const {return digest_;};
+
+            /*
+                128-bit digest of a belief over its strings (so it does not depend on the process interning them),
+                value of functions and type of instances included
+            */
+            static Digest beliefDigest(const ManagedBelief& mb);
+
+        private:
+            // key of the (name, arg position, arg value) index
+            typedef struct{
+                int pddl_type;
+                uint32_t name;
+                uint32_t pos;
+                uint32_t value;
+            }ArgKey;
+
+            struct ArgKeyHash{
+                size_t operator()(const ArgKey& k) const;
+            };
+
+            struct ArgKeyEqual{
+                bool operator()(const ArgKey& k1, const ArgKey& k2) const
+                {return k1.pddl_type == k2.pddl_type && k1.name == k2.name && k1.pos == k2.pos && k1.value == k2.value;};
+            };
+
+            // set of positions in beliefs_
+            typedef std::unordered_set<uint32_t> Bucket;
+
+            /* same element within the store (i.e. neither mb1 < mb2 nor mb2 < mb1) */
+            static bool sameBelief(const ManagedBelief& mb1, const ManagedBelief& mb2);
+
+            /* slot of the table containing @mb (if any) or -1 */
+            int64_t findSlot(const ManagedBelief& mb, const uint64_t& h) const;
+
+            /* rebuild the lookup table with the given capacity (power of two) */
+            void rehash(const size_t& capacity);
+
+            /* add/remove/move (to @new_pos) the belief in position @pos wrt. the secondary indexes */
+            typedef enum {INDEX_ADD, INDEX_DEL, INDEX_MOVE} IndexOp;
+            void updateIndexes(const uint32_t& pos, const IndexOp& op, const uint32_t& new_pos = 0);
+
+            /* key of the name index */
+            static uint64_t nameKey(const int& pddl_type, const uint32_t& name) {return (((uint64_t) pddl_type) << 32) | name;};
+
+            /* add (or subtract, if !add) the digest of @mb to the digest of the store */
+            void accumulateDigest(const ManagedBelief& mb, const bool& add);
+
+            /* resolve a bucket of positions into pointers to the stored beliefs */
+            std::vector<const ManagedBelief*> resolve(const Bucket* bucket) const;
+
+            // stored beliefs (dense) and their precomputed hashes
+            std::vector<ManagedBelief> beliefs_;
+            std::vector<uint64_t> hashes_;
+
+            // open-addressing table (linear probing) of positions in beliefs_
+            std::vector<int32_t> table_;
+            // occupied + tombstone slots in table_
+            size_t table_used_;
+
+            // secondary indexes
+            std::unordered_map<int, Bucket> by_pddl_type_;
+            std::unordered_map<uint64_t, Bucket> by_name_;
+            std::unordered_map<ArgKey, Bucket, ArgKeyHash, ArgKeyEqual> by_arg_;
+            std::unordered_map<uint32_t, Bucket> by_instance_type_;
+
+            // sum (lane by lane, modulo 2^64) of the digests of the stored beliefs
+            Digest digest_;
+
+    };  // class BeliefStore
+
+}
+
+#endif  // BELIEF_STORE_H_
@@ -8,25 +8,44 @@
 
 #include "ros2_bdi_interfaces/msg/belief.hpp"
 
+#include "ros2_bdi_utils/Symbol.hpp"
+
 const char belief_default_delimiters[2] = {'(', ')'};
 
 
 /* Namespace for wrapper classes wrt. BDI msgs defined in ros2_bdi_interfaces::msg */
 namespace BDIManaged
 {
-    typedef struct{
-        std::string name;
+    /* PDDL type (name is interned, see Symbol) with its optional subtypes */
+    struct ManagedType{
+        Symbol name;
         std::optional<std::vector<std::string>> sub_types;
-    }ManagedType;
 
-    typedef struct{
-        std::string name;
+        ManagedType() {}
+        ManagedType(const Symbol& name, const std::optional<std::vector<std::string>>& sub_types = std::nullopt):
+            name(name), sub_types(sub_types) {}
+        ManagedType(const std::string& name, const std::optional<std::vector<std::string>>& sub_types = std::nullopt):
+            name(Symbol{name}), sub_types(sub_types) {}
+    };
+
+    /* PDDL parameter (name is interned, see Symbol) with its type */
+    struct ManagedParam{
+        Symbol name;
         ManagedType type;
 
-        bool isPlaceholder(){
-            return name.find("{") == 0 && name.find("}") == name.length()-1;
+        ManagedParam() {}
+        ManagedParam(const Symbol& name, const ManagedType& type = ManagedType()):
+            name(name), type(type) {}
+        ManagedParam(const std::string& name, const ManagedType& type = ManagedType()):
+            name(Symbol{name}), type(type) {}
+        ManagedParam(const std::string& name, const std::string& type):
+            name(Symbol{name}), type(ManagedType{type}) {}
+
+        bool isPlaceholder() const{
+            const std::string& s = name.str();
+            return s.find("{") == 0 && s.find("}") == s.length()-1;
         }
-    }ManagedParam;
+    };
 
     /* Wrapper class to easily manage and infer info from a ros2_bdi_interfaces::msg::Belief instance*/
     class ManagedBelief
@@ -36,7 +55,9 @@ namespace BDIManaged
             /* Constructor methods */
             ManagedBelief();
             ManagedBelief(const std::string& name,const int& pddl_type,const ManagedType& type);
+            ManagedBelief(const Symbol& name,const int& pddl_type,const ManagedType& type);
             ManagedBelief(const std::string& name,const int& pddl_type,const std::vector<ManagedParam>& params, const float& value);
+            ManagedBelief(const Symbol& name,const int& pddl_type,const std::vector<ManagedParam>& params, const float& value);
             ManagedBelief(const ros2_bdi_interfaces::msg::Belief& belief);
             
             // Clone a MG Belief DNF
@@ -51,10 +72,11 @@ namespace BDIManaged
             static ManagedBelief buildMBFunction(const std::string& name, const std::vector<ManagedParam>& params, const float& value);
 
             /* getter methods for ManagedBelief instance prop */
-            std::string getName() const {return name_;};
+            const std::string& getName() const {return name_.str();};
+            const Symbol& getSymbol() const {return name_;};
             int pddlType() const {return pddl_type_;};
-            ManagedType type() const {return type_;};
-            std::vector<ManagedParam> getParams() const {return params_;};
+            const ManagedType& type() const {return type_;};
+            const std::vector<ManagedParam>& getParams() const {return params_;};
             float getValue() const {return value_;};
             std::string pddlTypeString() const;
 
@@ -94,7 +116,7 @@ namespace BDIManaged
         private:
             
             /* name of the belief (instance/predicate/function name) */
-            std::string name_;
+            Symbol name_;
 
             /* integer for PDDL TYPE of belief (INSTANCE/PREDICATE/FLUENT)*/
             int pddl_type_; // 1 for INSTANCE ,2 for PREDICATE ,3 for FLUENT/FUNCTION, check ros2_bdi_interfaces::msg::Belief
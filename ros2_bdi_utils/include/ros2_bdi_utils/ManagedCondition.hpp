@@ -9,6 +9,8 @@
 #include "ros2_bdi_interfaces/msg/condition.hpp"
 
 #include "ros2_bdi_utils/ManagedBelief.hpp"
+#include "ros2_bdi_utils/BeliefStore.hpp"
+#include "ros2_bdi_utils/WildPattern.hpp"
 
 /* Namespace for wrapper classes wrt. BDI msgs defined in ros2_bdi_interfaces::msg */
 namespace BDIManaged
@@ -27,16 +29,20 @@ namespace BDIManaged
             ManagedCondition clone();
 
             // return true iff check is VALID && condition is verified against the belief
-            bool performCheckAgainstBelief(const ManagedBelief& mb);
+            bool performCheckAgainstBelief(const ManagedBelief& mb) const;
             // return true iff check is VALID && condition is verified against the beliefs and no belief in vector denies it
-            bool performCheckAgainstBeliefs(const std::vector<ManagedBelief>& mbArray);
+            bool performCheckAgainstBeliefs(const std::vector<ManagedBelief>& mbArray) const;
             // return true iff check is VALID && condition is verified against the beliefs and no belief in set denies it
-            bool performCheckAgainstBeliefs(const std::set<ManagedBelief>& mbSet);
+            // (through the store indexes, see LookupMode)
+            bool performCheckAgainstBeliefs(const BeliefStore& mbSet) const;
 
             /* getter methods for ManagedCondition instance prop -> literals_ */
             ManagedBelief getMGBelief() const {return condition_to_check_;};
             std::string getCheck() const {return check_;};
 
+            // return true iff the check is valid for the pddl type of the belief to be checked
+            bool isValid() const {return valid_check_;};
+
             // convert instance to ros2_bdi_interfaces::msg::Condition msg
             ros2_bdi_interfaces::msg::Condition toCondition() const;
             
@@ -51,7 +57,7 @@ namespace BDIManaged
                 check is VALID && condition is verified against the beliefs and no belief in set denies it
                 n.b. result is true if @mcArray is empty
             */
-            static bool verifyAllManagedConditions(const std::vector<ManagedCondition>& mcArray, const std::set<ManagedBelief>& mbSet);
+            static bool verifyAllManagedConditions(const std::vector<ManagedCondition>& mcArray, const BeliefStore& mbSet);
 
             /* 
                 given array of Condition msg, convert it into an array of ManagedCondition
@@ -59,6 +65,21 @@ namespace BDIManaged
             static std::vector<ManagedCondition> buildArrayMGCondition(const std::vector<ros2_bdi_interfaces::msg::Condition>& conditions);
             
         private:
+            /*
+                How the condition is looked up within a BeliefStore, decided once at construction wrt. wild chars ('?', '*')
+                EXACT_LOOKUP: no wild chars at all, single hash lookup (FALSE_CHECK succeeds iff the lookup fails)
+                ARG_LOOKUP: name without wild chars and at least one param without them, scan beliefs with that arg
+                NAME_LOOKUP: name without wild chars, scan beliefs with that name
+                PDDL_TYPE_SCAN: wild chars in the name, scan beliefs of the same pddl type
+            */
+            typedef enum {EXACT_LOOKUP, ARG_LOOKUP, NAME_LOOKUP, PDDL_TYPE_SCAN} LookupMode;
+
+            // compile name and params into wild patterns, compute lookup mode (and arg position for ARG_LOOKUP) and cache check validity
+            void compile();
+
+            // return true iff mb is equivalent to the belief to be checked wrt. the compiled wild patterns (value not considered)
+            bool wildPatternEqual(const ManagedBelief& mb) const;
+
             // return true iff condition to be checked is valid (e.g. cannot check smaller than for belief of type instance or predicate)
             bool validCheckRequest() const;
             // return true iff check_ is a valid check string property for an Instance type Belief
@@ -73,6 +94,13 @@ namespace BDIManaged
             /*  Check to be performed (consult ros2_bdi_interfaces::msg::Condition msg for info)*/
             std::string check_;
 
+            /* compiled patterns and lookup (see compile) */
+            WildPattern name_pattern_;
+            std::vector<WildPattern> param_patterns_;
+            bool valid_check_;
+            LookupMode lookup_mode_;
+            uint32_t lookup_arg_pos_;
+
     };  // class ManagedCondition
 
     std::ostream& operator<<(std::ostream& os, const ManagedCondition& mc);
@@ -30,6 +30,7 @@ namespace BDIManaged
 
             /* getter method for ManagedConditionsConjunction instance prop -> literals_ */
             std::vector<ManagedCondition> getLiterals() const {return literals_;}
+            const std::vector<ManagedCondition>& getLiteralsRef() const {return literals_;}
 
             void addLiterals(const std::vector<ManagedCondition>& new_literals) {
                 for(ManagedCondition mc : new_literals)
@@ -38,7 +39,7 @@ namespace BDIManaged
 
             // returns true if all literals are satisfied against the passed belief set
             // n.b. result is true if literals_ array is empty
-            bool isSatisfied(const std::set<ManagedBelief>& mbSet);
+            bool isSatisfied(const BeliefStore& mbSet) const;
             
             // convert instance to ros2_bdi_interfaces::msg::ConditionsConjunction format
             ros2_bdi_interfaces::msg::ConditionsConjunction toConditionsConjunction() const;
@@ -36,10 +36,11 @@ class ManagedConditionsDNF
 
         /* getter method for ManagedConditionsDNF instance prop -> clauses_ */
         std::vector<ManagedConditionsConjunction> getClauses() const {return clauses_;}
+        const std::vector<ManagedConditionsConjunction>& getClausesRef() const {return clauses_;}
         
         // return true if at least one clause is satisfied against the passed belief set
         // n.b. result is true if clauses_ array is empty
-        bool isSatisfied(const std::set<ManagedBelief>& mbSet);
+        bool isSatisfied(const BeliefStore& mbSet) const;
 
         // convert instance to ros2_bdi_interfaces::msg::ConditionsDNF
         ros2_bdi_interfaces::msg::ConditionsDNF toConditionsDNF() const;
@@ -50,8 +51,9 @@ class ManagedConditionsDNF
         // return all mg beliefs containing at least a placeholder, e.g. {x}
         std::set<ManagedBelief> getBeliefsWithPlaceholders();
 
-        // extract assigment for all placeholders in mgconditions dnf
-        std::map<std::string, std::vector<ManagedBelief>> extractAssignmentsMap(const std::set<BDIManaged::ManagedBelief>& belief_set);
+        // extract the assignments for all placeholders in mgconditions dnf which satisfy it against the belief set
+        // (joining the literals over the belief set as done for the reactive rules, see ReactiveRuleMatcher)
+        std::vector<std::map<std::string, std::string>> extractAssignmentsMap(const BDIManaged::BeliefStore& belief_set) const;
 
         /* substitute placeholders as per assignments map and return a new ManagedConditionsDNF instance*/
         ManagedConditionsDNF applySubstitution(const std::map<std::string, std::string> assignments) const;
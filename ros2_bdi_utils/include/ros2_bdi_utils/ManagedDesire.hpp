@@ -46,8 +46,8 @@ namespace BDIManaged
             float getDeadline() const {return deadline_;}
             void setDesireGroup(const std::string& desire_group){desire_group_ = desire_group;}
             std::string getDesireGroup() const {return desire_group_;}
-            ManagedConditionsDNF getPrecondition() const {return precondition_;}
-            ManagedConditionsDNF getContext() const {return context_;}
+            const ManagedConditionsDNF& getPrecondition() const {return precondition_;}
+            const ManagedConditionsDNF& getContext() const {return context_;}
             std::vector<ManagedBelief> getRollbackBeliefAdd() const {return rollback_belief_add_;}
             std::vector<ManagedBelief> getRollbackBeliefDel() const {return rollback_belief_del_;}
             
@@ -67,7 +67,7 @@ namespace BDIManaged
             ros2_bdi_interfaces::msg::Desire toDesire() const;
 
             // return true if empty target or if target appears to be achieved in the passed bset
-            bool isFulfilled(const std::set<ManagedBelief>& bset);
+            bool isFulfilled(const BeliefStore& bset);
             
             // return true if otherDesire presents the same exact target value, regardless of other attributes (preconditions, context, deadline,...)
             bool equivalentValue(const ManagedDesire& otherDesire);
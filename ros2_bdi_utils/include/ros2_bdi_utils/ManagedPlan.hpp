@@ -45,9 +45,7 @@ namespace BDIManaged
             {
                 this->exec_status_ = planExecInfo.status;
                 this->last_current_time_ = planExecInfo.current_time;
-                std::vector<ros2_bdi_interfaces::msg::BDIActionExecutionInfo> actions_exec_info = 
-                    std::vector<ros2_bdi_interfaces::msg::BDIActionExecutionInfo> (planExecInfo.actions_exec_info.begin(), planExecInfo.actions_exec_info.end());
-                this->actions_exec_info_ = actions_exec_info;
+                this->actions_exec_info_ = planExecInfo.actions_exec_info;//reusing the already allocated buffers
             }
 
             void setCommittedStatus(const bool& defaultValue)
@@ -76,8 +74,8 @@ namespace BDIManaged
             //TODO fix the logics!!!
             float getUpdatedEstimatedDeadline();
 
-            ManagedConditionsDNF getPrecondition() const {return precondition_;};
-            ManagedConditionsDNF getContext() const {return context_;};
+            const ManagedConditionsDNF& getPrecondition() const {return precondition_;};
+            const ManagedConditionsDNF& getContext() const {return context_;};
             
             /* convert instance to plansys2::msg::Plan format */
             plansys2_msgs::msg::Plan toPsys2Plan() const;
@@ -106,6 +104,12 @@ namespace BDIManaged
             */
             std::string toPsys2PlanString() const;
 
+            /*
+                Return true if @mp1 and @mp2 cannot be executed concurrently, 
+                i.e. they share a (grounded) action or an instance among the args of their actions
+            */
+            static bool conflicting(const ManagedPlan& mp1, const ManagedPlan& mp2);
+
         private:
 
             /*
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 
 #include "plansys2_problem_expert/ProblemExpertClient.hpp"
 
@@ -47,6 +48,13 @@ namespace PDDLBDIConverter
   */
   std::vector<ros2_bdi_interfaces::msg::Belief> convertPDDLFunctions(const std::vector<plansys2::Function> functions);
 
+  /*
+    Convert a PDDL problem fact and its value, as extracted by PDDLUtils::extractPDDLProblemFacts, to ROS2-BDI Belief
+    E.g. "r1 - robot" -> instance, "(robot_at r1 wp1)" -> predicate, "(battery r1)" with value "80" -> function
+    Returns std::nullopt if the fact cannot be parsed
+  */
+  std::optional<ros2_bdi_interfaces::msg::Belief> convertPDDLProblemFact(const std::string& fact, const std::string& value);
+
   /*
     get index of action with given action_name & args in the vector<PlanItem> in current_plan_.body, -1 if not present
     action_full_name is in the form "(a1 p1 p2 p3):timex1000"
@@ -72,6 +80,23 @@ namespace PDDLBDIConverter
     const int& action_index, 
     const int& first_ts_plan_sec, const unsigned int& first_ts_plan_nanosec);
 
+  /*
+    Get the full name of a plan item as reported in PlanSys2 executor feedback, i.e. "(a1 p1 p2 p3):timex1000"
+  */
+  std::string getActionFullName(const plansys2_msgs::msg::PlanItem& plan_item);
+
+  /*
+    Update in place status, timing, progress and waited actions of a BDIActionExecutionInfo 
+    from the corresponding PlanSys2 ActionExecutionInfo (fields depending just on the plan body are left untouched)
+    Waited actions are indexed through action_plan_index (action full name -> index within the plan body)
+
+    Timestamps of corresponding plan start are passed too 
+  */
+  void updateBDIActionExecutionInfo(
+    ros2_bdi_interfaces::msg::BDIActionExecutionInfo& bdi_action_exec_info,
+    const plansys2_msgs::msg::ActionExecutionInfo& psys2_action_feed, 
+    const std::map<std::string, int>& action_plan_index,
+    const int& first_ts_plan_sec, const unsigned int& first_ts_plan_nanosec);
   
 }  // namespace PDDLBDIConverter
 
@@ -0,0 +1,102 @@
+#ifndef PDDL_METADATA_CACHE_H_
+#define PDDL_METADATA_CACHE_H_
+
+#include <set>
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+
+#include "plansys2_domain_expert/DomainExpertClient.hpp"
+
+#include "ros2_bdi_interfaces/msg/belief.hpp"
+
+#include "ros2_bdi_utils/ManagedBelief.hpp"
+#include "ros2_bdi_utils/BeliefStore.hpp"
+#include "ros2_bdi_utils/PDDLTypeLattice.hpp"
+
+namespace BDIManaged
+{
+    /*
+        Local cache of the PDDL metadata which rarely changes at runtime, answering in memory the lookups
+        otherwise performed through synchronous PlanSys2 service calls:
+        predicate/function/durative action schemas and the type lattice are retrieved from the domain expert once 
+        (until invalidateDomain()), instances (with their types) are mirrored from the belief set updates of the agent
+    */
+    class PDDLMetadataCache
+    {
+        public:
+            /* Constructor methods */
+            PDDLMetadataCache();
+            PDDLMetadataCache(const std::shared_ptr<plansys2::DomainExpertClient>& domain_expert);
+
+            /*
+                Schema of predicate/function/durative action @name as defined in the domain,
+                std::nullopt (nullptr for durative actions) if there is no such definition
+            */
+            std::optional<plansys2::Predicate> getPredicate(const std::string& name);
+            std::optional<plansys2::Function> getFunction(const std::string& name);
+            std::shared_ptr<plansys2::DurativeAction> getDurativeAction(const std::string& name);
+
+            /*
+                Drop the schemas retrieved so far, so that they're retrieved again at the next lookup (e.g. domain expert restarted)
+            */
+            void invalidateDomain();
+
+            /*
+                Type of the instance @name, std::nullopt if it is not a known instance
+            */
+            std::optional<std::string> getInstanceType(const std::string& name) const;
+            bool hasInstance(const std::string& name) const {return instances_.count(name) > 0;};
+
+            /*
+                Replace the mirrored instances with the ones within @beliefSet (e.g. upon a belief set snapshot)
+            */
+            void syncInstances(const BeliefStore& beliefSet);
+
+            /*
+                Mirror the instances added/removed by a belief set update (beliefs of other pddl types are ignored)
+            */
+            void updateInstances(const std::vector<ros2_bdi_interfaces::msg::Belief>& added,
+                const std::vector<ros2_bdi_interfaces::msg::Belief>& removed);
+            void addInstance(const ManagedBelief& mb);
+            void removeInstance(const ManagedBelief& mb);
+
+            /*
+                Return true if an instance of type @insType can be used for @param, i.e. same type or one of its sub types
+                (checked through the type lattice, or within the sub types of @param for types not declared in the domain)
+            */
+            bool typeMatches(const plansys2_msgs::msg::Param& param, const std::string& insType);
+
+        private:
+
+            /*
+                Retrieve the names of the predicates, functions and durative actions defined in the domain,
+                returns false if the domain expert has not answered with a domain yet
+            */
+            bool loadDomain();
+
+            // domain expert client used to retrieve the schemas
+            std::shared_ptr<plansys2::DomainExpertClient> domain_expert_;
+
+            // names defined in the domain have been retrieved
+            bool domain_loaded_;
+            std::set<std::string> predicate_names_;
+            std::set<std::string> function_names_;
+            std::set<std::string> durative_action_names_;
+            PDDLTypeLattice type_lattice_;
+
+            // schemas retrieved so far (just for names defined in the domain)
+            std::map<std::string, plansys2::Predicate> predicates_;
+            std::map<std::string, plansys2::Function> functions_;
+            std::map<std::string, std::shared_ptr<plansys2::DurativeAction>> durative_actions_;
+
+            // mirrored instances by name (with their type)
+            std::map<std::string, std::string> instances_;
+
+    };  // class PDDLMetadataCache
+
+}
+
+#endif  // PDDL_METADATA_CACHE_H_
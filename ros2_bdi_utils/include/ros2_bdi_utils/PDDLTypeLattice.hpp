@@ -0,0 +1,61 @@
+#ifndef PDDL_TYPE_LATTICE_H_
+#define PDDL_TYPE_LATTICE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+namespace BDIManaged
+{
+    /*
+        Type hierarchy of a PDDL domain compiled once into integer type ids, each one with the bitset of its ancestors
+        (itself included), so that checking whether a type is a subtype of another one is a single bit test
+    */
+    class PDDLTypeLattice
+    {
+        public:
+            /* Constructor methods */
+            PDDLTypeLattice();
+
+            /*
+                Build the lattice out of the parent of each type (e.g. as returned by PDDLUtils::extractPDDLDomainTypes),
+                types appearing just as parents are included too
+            */
+            explicit PDDLTypeLattice(const std::map<std::string, std::string>& parents);
+
+            /* id of @type, std::nullopt if it is not a type of the domain */
+            std::optional<uint16_t> typeId(const std::string& type) const;
+            bool knows(const std::string& type) const {return ids_.count(type) > 0;};
+
+            /* number of types within the lattice */
+            size_t size() const {return names_.size();};
+            bool empty() const {return names_.empty();};
+
+            /*
+                true if @sub is @super or one of its (direct or indirect) subtypes
+            */
+            bool isSubtype(const uint16_t& sub, const uint16_t& super) const
+            {
+                return (ancestors_[sub * words_ + (super >> 6)] >> (super & 63)) & 1;
+            }
+            bool isSubtype(const std::string& sub, const std::string& super) const;
+
+        private:
+
+            // id of each type, name of each id
+            std::unordered_map<std::string, uint16_t> ids_;
+            std::vector<std::string> names_;
+
+            // 64-bit words per bitset
+            size_t words_;
+            // ancestors bitset of type id t (t itself included) stored in [t * words_, (t+1) * words_)
+            std::vector<uint64_t> ancestors_;
+
+    };  // class PDDLTypeLattice
+
+}
+
+#endif  // PDDL_TYPE_LATTICE_H_
@@ -2,15 +2,71 @@
 #define PDDL__UTILS_H_
 
 #include <vector>
+#include <map>
+#include <set>
 #include <string>
 
 namespace PDDLUtils
 {
+    /*
+        Names of the predicates/functions read (conditions, duration) and written (effects) by a PDDL domain action
+    */
+    typedef struct{
+        std::string name;
+        std::set<std::string> conditions;
+        std::set<std::string> effects;
+    }PDDLActionDependencies;
+
     /*
         Returns all the items within a PlanItem.action string
         E.g. "(dosweep sweeper kitchen)" -> ["dosweep", "sweeper", "kitchen"]
     */
     std::vector<std::string> extractPlanItemActionElements(const std::string& planItemAction); 
+
+    /*
+        Returns the facts stated within the :objects and :init sections of a PDDL problem string,
+        each one normalized into a single-line key which does not depend on the problem whitespaces
+        and mapped to its value (non empty just for functions)
+        E.g. "r1 r2 - robot" -> {"r1 - robot": "", "r2 - robot": ""}, "( = ( battery r1 ) 80 )" -> {"(battery r1)": "80"}
+    */
+    std::map<std::string, std::string> extractPDDLProblemFacts(const std::string& pddlProblem);
+
+    /*
+        Diff the facts of two versions of a PDDL problem string (see extractPDDLProblemFacts), looking just at the part
+        of their :init sections which differs (i.e. the facts around the first and the last differing char)
+        and at their :objects sections, if they differ at all.
+        @added gets the facts of @pddlProblemAfter new or with a new value, @removed the facts of @pddlProblemBefore dropped
+        Returns false if the problems have no :init section (caller should extract all their facts)
+    */
+    bool diffPDDLProblemFacts(const std::string& pddlProblemBefore, const std::string& pddlProblemAfter,
+        std::map<std::string, std::string>& added, std::map<std::string, std::string>& removed);
+
+    /*
+        Returns a copy of the PDDL problem string with its :goal section replaced by @pddlGoal
+        (appended as last section if the problem has no goal yet)
+        E.g. "(define ... (:goal (and (p a))))", "(and (q b))" -> "(define ... ( :goal (and (q b)) ))"
+    */
+    std::string replacePDDLProblemGoal(const std::string& pddlProblem, const std::string& pddlGoal);
+
+    /*
+        Returns the predicates/functions read and written by each action (durative or not) of a PDDL domain string
+        E.g. "(:action move :parameters (?r ?a ?b) :precondition (and (at ?r ?a) (> (battery ?r) 10)) :effect (at ?r ?b))"
+            -> {name: "move", conditions: {"at", "battery"}, effects: {"at"}}
+    */
+    std::vector<PDDLActionDependencies> extractPDDLDomainActionsDependencies(const std::string& pddlDomain);
+
+    /*
+        Returns the names of the predicates/functions which can affect reaching a goal made of @goalNames:
+        the goal ones plus, transitively, the ones read by any action writing a relevant one
+    */
+    std::set<std::string> computeRelevantPDDLNames(const std::vector<PDDLActionDependencies>& actions, const std::set<std::string>& goalNames);
+
+    /*
+        Returns the types declared within the :types section of a PDDL domain string, each one mapped to its parent type
+        (types declared without a parent, or just used as parent, are mapped to "object")
+        E.g. "(:types robot drone - vehicle vehicle dock)" -> {"robot": "vehicle", "drone": "vehicle", "vehicle": "object", "dock": "object"}
+    */
+    std::map<std::string, std::string> extractPDDLDomainTypes(const std::string& pddlDomain);
     
 }  // namespace PDDLUtils
 
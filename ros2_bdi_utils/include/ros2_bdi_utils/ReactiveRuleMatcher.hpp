@@ -0,0 +1,155 @@
+#ifndef REACTIVE_RULE_MATCHER_H_
+#define REACTIVE_RULE_MATCHER_H_
+
+#include <set>
+#include <map>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ros2_bdi_utils/Symbol.hpp"
+#include "ros2_bdi_utils/WildPattern.hpp"
+#include "ros2_bdi_utils/ManagedBelief.hpp"
+#include "ros2_bdi_utils/BeliefStore.hpp"
+#include "ros2_bdi_utils/ManagedReactiveRule.hpp"
+
+namespace BDIManaged
+{
+    /*
+        TREAT-style incremental matcher for a set of reactive rules
+
+        Every literal of every rule condition keeps an alpha memory of the beliefs matching it
+        (with the values they bind to the placeholders, e.g. {x}) and every placeholder keeps the memory of the instances
+        of its type(s), all of them updated belief by belief as the belief set changes.
+        When asked for activations, just the rules touched by the changes join their alpha memories (hash joins on
+        the shared placeholders, FALSE_CHECK literals as absent lookups) and the resulting instantiations
+        are compared with the conflict set of the rule: only the newly satisfied ones are returned
+
+        A rule instantiation assigns an instance (of the right type) to every placeholder of the rule
+    */
+    class ReactiveRuleMatcher
+    {
+        public:
+            /* Constructor methods */
+            ReactiveRuleMatcher();
+            explicit ReactiveRuleMatcher(const std::set<ManagedReactiveRule>& rules);
+
+            /* rebuild all the alpha memories from a belief set snapshot (conflict sets are kept) */
+            void reset(const BeliefStore& belief_set);
+
+            /* update the alpha memories wrt. a belief added to/removed from the belief set */
+            void addBelief(const ManagedBelief& mb);
+            void removeBelief(const ManagedBelief& mb);
+
+            /*
+                rule instantiations (with placeholders already substituted) which have become satisfied
+                since the last call, in rule order
+            */
+            std::vector<ManagedReactiveRule> newActivations();
+
+            /*
+                one shot join: assignments of the placeholders of @condition which satisfy it against the belief set
+                (see ManagedConditionsDNF::extractAssignmentsMap)
+            */
+            static std::vector<std::map<std::string, std::string>> satisfyingAssignments(const ManagedConditionsDNF& condition, const BeliefStore& belief_set);
+
+        private:
+            // values assigned to placeholders, empty symbol meaning not assigned yet
+            typedef std::vector<Symbol> Binding;
+
+            struct BindingHash{
+                size_t operator()(const Binding& b) const;
+            };
+
+            struct BeliefHash{
+                size_t operator()(const ManagedBelief& mb) const {return (size_t) BeliefStore::hash(mb);}
+            };
+
+            struct BeliefEqual{
+                bool operator()(const ManagedBelief& mb1, const ManagedBelief& mb2) const {return !(mb1 < mb2) && !(mb2 < mb1);}
+            };
+
+            // token counts: the same binding might be produced by more beliefs (e.g. wild patterns)
+            typedef std::unordered_map<Binding, uint32_t, BindingHash> TokenMemory;
+
+            /* compiled condition literal with its alpha memory */
+            typedef struct{
+                int pddl_type;
+                std::string check;
+                float value;
+                bool negated;// FALSE_CHECK
+
+                // name: either a placeholder (var index) or a pattern
+                int name_var;
+                WildPattern name_pattern;
+                // params: either a placeholder (var index) or a pattern
+                std::vector<int> param_vars;
+                std::vector<WildPattern> param_patterns;
+
+                // distinct placeholders of the literal (rule var indexes), token values are in this order
+                std::vector<int> vars;
+
+                // alpha memory
+                std::unordered_map<ManagedBelief, Binding, BeliefHash, BeliefEqual> matched;
+                TokenMemory tokens;
+            }Literal;
+
+            /* placeholder of a rule, constrained to the instances of the type(s) of its occurrences */
+            typedef struct{
+                std::string name;
+                std::vector<ManagedType> types;
+                // per type constraint: names of the instances satisfying it
+                std::vector<std::unordered_set<Symbol>> domains;
+            }Placeholder;
+
+            typedef struct{
+                ManagedReactiveRule rule;
+                std::vector<Placeholder> placeholders;
+                // clauses of the DNF as literal indexes (-1 if the clause contains an invalid check, i.e. never satisfied)
+                std::vector<std::vector<int>> clauses;
+                std::vector<Literal> literals;
+                // instantiations satisfied at the last check
+                std::unordered_set<Binding, BindingHash> conflict_set;
+                bool dirty;
+            }CompiledRule;
+
+            /* compile a rule into placeholders and literals */
+            void compileRule(const ManagedReactiveRule& rule);
+            /* var index of the placeholder (added with @type among its constraints) */
+            int placeholderVar(CompiledRule& cr, const std::string& name, const ManagedType& type);
+
+            /* values bound by @mb to the literal placeholders, nullopt if it does not match the literal */
+            static std::optional<Binding> matchLiteral(const Literal& lit, const ManagedBelief& mb);
+            /* true if the instance @mb satisfies the type constraint @type */
+            static bool instanceOfType(const ManagedBelief& mb, const ManagedType& type);
+
+            /* add/remove the instance @mb wrt. the domains of the placeholders */
+            void updateDomains(const ManagedBelief& mb, const bool& add);
+            /* add/remove @mb wrt. every alpha memory */
+            void updateMemories(const ManagedBelief& mb, const bool& add);
+
+            /* all the instantiations of the rule currently satisfied */
+            std::unordered_set<Binding, BindingHash> computeInstantiations(const CompiledRule& cr) const;
+            /* true if @value belongs to the domain of the placeholder */
+            static bool inDomain(const Placeholder& ph, const Symbol& value);
+            /* values in the domain of the placeholder */
+            static std::vector<Symbol> domainValues(const Placeholder& ph);
+            /* extend partial bindings assigning every value in its domain to the placeholder @var */
+            static std::vector<Binding> extendByDomain(const std::vector<Binding>& partial, const Placeholder& ph, const int& var);
+
+            std::vector<CompiledRule> rules_;
+
+            // known instances by name
+            std::unordered_map<Symbol, ManagedBelief> instances_;
+
+            // literals indexed by (pddl type, name) if their name is a literal, the others are always tried
+            std::unordered_map<uint64_t, std::vector<std::pair<size_t, size_t>>> literals_by_name_;
+            std::vector<std::pair<size_t, size_t>> wild_literals_;
+
+    };  // class ReactiveRuleMatcher
+}
+
+#endif  // REACTIVE_RULE_MATCHER_H_
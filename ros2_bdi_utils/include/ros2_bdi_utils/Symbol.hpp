@@ -0,0 +1,85 @@
+#ifndef SYMBOL_H_
+#define SYMBOL_H_
+
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <iostream>
+#include <functional>
+
+namespace BDIManaged
+{
+    /*
+        Interned PDDL identifier (predicate/function/instance/type name)
+
+        Every distinct string is stored once in a process-wide table and referred by a compact integer id,
+        so copying a symbol and checking two symbols for equality are integer operations.
+        The table is thread safe and never shrinks: intern just identifiers coming from the domain/problem,
+        not arbitrary generated strings. Id 0 is reserved to the empty string (default constructed symbol).
+
+        Ordering (operator<) is the lexicographic one of the underlying strings,
+        so sorted containers of managed beliefs keep the same order they had when names were plain strings
+    */
+    class Symbol
+    {
+        public:
+            /* Constructor methods */
+            Symbol(): id_(0) {}
+            explicit Symbol(const std::string& s): id_(intern(s)) {}
+            explicit Symbol(const char* s): id_(intern(std::string{s})) {}
+
+            /* integer id of the symbol within the process-wide table */
+            uint32_t id() const {return id_;}
+
+            /* interned string */
+            const std::string& str() const {return resolve(id_);}
+            operator const std::string&() const {return resolve(id_);}
+
+            bool empty() const {return id_ == 0;}
+
+            /* symbol for @s, nullopt if @s has never been interned (the table is not modified) */
+            static std::optional<Symbol> lookup(const std::string& s);
+
+            /* number of symbols interned so far (empty string included) */
+            static size_t tableSize();
+
+        private:
+            /* id of @s within the table (created if not present yet) */
+            static uint32_t intern(const std::string& s);
+
+            /* string corresponding to an id returned by intern */
+            static const std::string& resolve(const uint32_t& id);
+
+            uint32_t id_;
+
+    };  // class Symbol
+
+    inline bool operator==(const Symbol& s1, const Symbol& s2) {return s1.id() == s2.id();}
+    inline bool operator!=(const Symbol& s1, const Symbol& s2) {return s1.id() != s2.id();}
+    inline bool operator<(const Symbol& s1, const Symbol& s2) {return s1.id() != s2.id() && s1.str() < s2.str();}
+
+    inline bool operator==(const Symbol& s1, const std::string& s2) {return s1.str() == s2;}
+    inline bool operator==(const std::string& s1, const Symbol& s2) {return s1 == s2.str();}
+    inline bool operator!=(const Symbol& s1, const std::string& s2) {return s1.str() != s2;}
+    inline bool operator!=(const std::string& s1, const Symbol& s2) {return s1 != s2.str();}
+
+    inline std::string operator+(const Symbol& s1, const std::string& s2) {return s1.str() + s2;}
+    inline std::string operator+(const std::string& s1, const Symbol& s2) {return s1 + s2.str();}
+    inline std::string operator+(const Symbol& s1, const char* s2) {return s1.str() + s2;}
+    inline std::string operator+(const char* s1, const Symbol& s2) {return s1 + s2.str();}
+    inline std::string operator+(const Symbol& s1, const char& c) {return s1.str() + c;}
+    inline std::string operator+(const char& c, const Symbol& s2) {return c + s2.str();}
+
+    inline std::ostream& operator<<(std::ostream& os, const Symbol& s) {return os << s.str();}
+}
+
+namespace std
+{
+    template<>
+    struct hash<BDIManaged::Symbol>
+    {
+        size_t operator()(const BDIManaged::Symbol& s) const {return std::hash<uint32_t>()(s.id());}
+    };
+}
+
+#endif  // SYMBOL_H_
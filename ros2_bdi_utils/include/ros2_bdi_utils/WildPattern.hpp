@@ -0,0 +1,50 @@
+#ifndef WILD_PATTERN_H_
+#define WILD_PATTERN_H_
+
+#include <string>
+
+#include "ros2_bdi_utils/Symbol.hpp"
+
+namespace BDIManaged
+{
+    /*
+        Pattern potentially containing wild characters that are meant to be replaced by a single char (wild_single_char)
+        or multiple ones (wild_multi_char), compiled once and then matched against any number of texts
+
+        Patterns are classified at construction as ANY ("*"), LITERAL (no wild chars, matched by symbol/string equality),
+        PREFIX ("abc*"), SUFFIX ("*abc") or GLOB (anything else, matched by a greedy scan backtracking only to the last '*')
+    */
+    class WildPattern
+    {
+        public:
+            /* Constructor methods */
+            WildPattern();
+            explicit WildPattern(const std::string& pattern, const char& wild_single_char = '?', const char& wild_multi_char = '*');
+
+            /* true if the pattern has no wild chars (i.e. it matches just the equal text) */
+            bool isLiteral() const {return kind_ == LITERAL;}
+
+            /* true if @text matches the pattern */
+            bool matches(const std::string& text) const;
+            bool matches(const Symbol& text) const;
+
+        private:
+            typedef enum {ANY, LITERAL, PREFIX, SUFFIX, GLOB} PatternKind;
+
+            /* general case: greedy scan, backtracking only to the last multi char met */
+            bool globMatch(const std::string& text) const;
+
+            PatternKind kind_;
+
+            // whole pattern (LITERAL, GLOB) or its fixed part (PREFIX, SUFFIX)
+            std::string text_;
+            // interned pattern (LITERAL)
+            Symbol literal_;
+
+            char wild_single_char_;
+            char wild_multi_char_;
+
+    };  // class WildPattern
+}
+
+#endif  // WILD_PATTERN_H_
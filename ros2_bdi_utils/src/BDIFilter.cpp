@@ -20,6 +20,7 @@ using BDIManaged::ManagedDesire;
 using BDIManaged::ManagedCondition;
 using BDIManaged::ManagedConditionsConjunction;
 using BDIManaged::ManagedConditionsDNF;
+using BDIManaged::BeliefStore;
 
 namespace BDIFilter
 {
@@ -41,6 +42,19 @@ namespace BDIFilter
     return bset_msg; 
   }
 
+  /*
+    Extract from passed store of ManagedBelief objects a BeliefSet msg (stamped with the digest of the store)
+  */
+  BeliefSet extractBeliefSetMsg(const BeliefStore& managed_beliefs)
+  {
+    BeliefSet bset_msg = BeliefSet();
+    bset_msg.value.reserve(managed_beliefs.size());
+    for(const ManagedBelief& mb : managed_beliefs)
+      bset_msg.value.push_back(mb.toBelief());
+    bset_msg.digest = managed_beliefs.digest();
+    return bset_msg; 
+  }
+
   /*
     Extract from passed set of ManagedDesire objects a DesireSet msg
   */
@@ -189,6 +203,34 @@ namespace BDIFilter
     return extracted;
   }
 
+  /*
+    Extract from passed store just beliefs of type instance/predicate/function (through its pddl type index) 
+    and put them into a set of ManagedBelief objects
+  */
+  set<ManagedBelief> extractMGInstances(const BeliefStore& managed_beliefs)
+  {
+    set<ManagedBelief> extracted = set<ManagedBelief>();
+    for(const ManagedBelief* mb : managed_beliefs.getByPDDLType(Belief().INSTANCE_TYPE))
+      extracted.insert(*mb);
+    return extracted;
+  }
+
+  set<ManagedBelief> extractMGPredicates(const BeliefStore& managed_beliefs)
+  {
+    set<ManagedBelief> extracted = set<ManagedBelief>();
+    for(const ManagedBelief* mb : managed_beliefs.getByPDDLType(Belief().PREDICATE_TYPE))
+      extracted.insert(*mb);
+    return extracted;
+  }
+
+  set<ManagedBelief> extractMGFunctions(const BeliefStore& managed_beliefs)
+  {
+    set<ManagedBelief> extracted = set<ManagedBelief>();
+    for(const ManagedBelief* mb : managed_beliefs.getByPDDLType(Belief().FUNCTION_TYPE))
+      extracted.insert(*mb);
+    return extracted;
+  }
+
   /*
     Given array of ManagedCondition, desire base name (added a counter as suffix to distinguish them among each other),
     desire priority, desire deadline use it to build a ManagedDesire putting as value the conditions
@@ -227,21 +269,24 @@ namespace BDIFilter
       
   }
 
-  set<ManagedBelief> filterMGBeliefInstances(const set<ManagedBelief>& belief_set, const ManagedType& type)
+  set<ManagedBelief> filterMGBeliefInstances(const BeliefStore& belief_set, const ManagedType& type)
   {
     set<ManagedBelief> belief_set_filtered;
-    // std::cout << "Looking for type " << type.name;
-    // if(type.sub_types.has_value())
-    //   for(string s : type.sub_types.value())
-    //     std::cout << " or subtype: " << s << ",";
-    // std::cout << std::flush << std::endl;
-    for(ManagedBelief mb : belief_set)
-      if(mb.pddlType() == Belief().INSTANCE_TYPE)
-        if(type.name == "" || type.name == mb.type().name)
-          belief_set_filtered.insert(mb);
-        else if(type.sub_types.has_value() && 
-          std::find(type.sub_types.value().begin(), type.sub_types.value().end(), mb.type().name) != std::end(type.sub_types.value()))
-          belief_set_filtered.insert(mb);
+    if(type.name == "")
+    {
+      for(const ManagedBelief* mb : belief_set.getByPDDLType(Belief().INSTANCE_TYPE))
+        belief_set_filtered.insert(*mb);
+      return belief_set_filtered;
+    }
+
+    // lookup instances of the given type and of its subtypes through the instance type index
+    for(const ManagedBelief* mb : belief_set.getInstancesByType(type.name))
+      belief_set_filtered.insert(*mb);
+    
+    if(type.sub_types.has_value())
+      for(const string& sub_type : type.sub_types.value())
+        for(const ManagedBelief* mb : belief_set.getInstancesByType(sub_type))
+          belief_set_filtered.insert(*mb);
         
     return belief_set_filtered;
   }
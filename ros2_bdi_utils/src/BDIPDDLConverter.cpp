@@ -13,7 +13,7 @@ namespace BDIPDDLConverter
     */
     plansys2::Instance buildInstance(const BDIManaged::ManagedBelief& mb)
     {
-        return plansys2::Instance{mb.getName(), mb.type().name};
+        return plansys2::Instance{mb.getName(), mb.type().name.str()};
     }
 
     /*
@@ -32,6 +32,18 @@ namespace BDIPDDLConverter
         return plansys2::Function{"(" + mb.getName()+ " " + mb.getParamsJoined() + " " + std::to_string(mb.getValue()) + ")"};;
     }
 
+    /*
+        Build PDDL problem fact from ManagedBelief, normalized as per PDDLUtils::extractPDDLProblemFacts
+        (function value excluded) e.g. "r1 - robot", "(robot_at r1 wp1)", "(battery r1)"
+    */
+    string buildPDDLProblemFact(const BDIManaged::ManagedBelief& mb)
+    {
+        if(mb.pddlType() == Belief().INSTANCE_TYPE)
+            return mb.getName() + " - " + mb.type().name;
+        
+        return "(" + mb.getName() + ((mb.getParams().size() > 0)? " " + mb.getParamsJoined() : "") + ")";
+    }
+
     /*
         Convert Desire into PDDL Goal
     */
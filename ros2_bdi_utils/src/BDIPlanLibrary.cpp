@@ -1,91 +1,161 @@
 #include "ros2_bdi_utils/BDIPlanLibrary.hpp"
 
-#include <cstring>
-
 using std::string;
 using std::vector;
 
 using BDIManaged::ManagedBelief;
+using BDIManaged::ManagedDesire;
+using BDIManaged::ManagedPlan;
 using PlanLibrary::BDIPlanLibrary;
 
+BDIPlanLibrary::BDIPlanLibrary(BDIPlanLibrary&& other):
+    db_filepath_(other.db_filepath_), db_(other.db_),
+    insert_plan_stmt_(other.insert_plan_stmt_), insert_successors_stmt_(other.insert_successors_stmt_),
+    select_plan_stmt_(other.select_plan_stmt_), select_plans_stmt_(other.select_plans_stmt_),
+    in_transaction_(other.in_transaction_)
+{
+    other.db_ = nullptr;
+    other.insert_plan_stmt_ = nullptr;
+    other.insert_successors_stmt_ = nullptr;
+    other.select_plan_stmt_ = nullptr;
+    other.select_plans_stmt_ = nullptr;
+    other.in_transaction_ = false;
+}
+
+/*
+    Finalize prepared statements and close the connection to the plan library (committing pending batch, if any)
+*/
+BDIPlanLibrary::~BDIPlanLibrary()
+{
+    if(in_transaction_)
+        commitTransaction();
+
+    // finalize accepts nullptr as no-op
+    sqlite3_finalize(insert_plan_stmt_);
+    sqlite3_finalize(insert_successors_stmt_);
+    sqlite3_finalize(select_plan_stmt_);
+    sqlite3_finalize(select_plans_stmt_);
+
+    if(db_ != nullptr)
+        sqlite3_close(db_);
+}
+
+/*
+    execute a statement without results, returns true if executed successfully
+*/
+bool BDIPlanLibrary::exec(const string& query)
+{
+    char* msg_error = nullptr;
+    int res = sqlite3_exec(db_, query.c_str(), NULL, 0, &msg_error);
+    sqlite3_free(msg_error);
+
+    return res == SQLITE_OK;
+}
+
 /*
     create table utility function
-    select the right query to be performed in order to instantiate the table in the db, returns true if query executed successfully
+    select the right query to be performed in order to instantiate the table in the db (if not already defined),
+    returns true if query executed successfully
 */
-bool BDIPlanLibrary::createTable(sqlite3* DB, const PlanLibTable& table)
+bool BDIPlanLibrary::createTable(const PlanLibTable& table)
 {
     string create_query = "";
     switch(table){
 
         case PLANS:
-            create_query = "CREATE TABLE " + PLANS_TABLE + "("
+            create_query = "CREATE TABLE IF NOT EXISTS " PLANS_TABLE "("
                       "pId              INTEGER     PRIMARY KEY AUTOINCREMENT NOT NULL, "
                       "plan             TEXT    NOT NULL, "
                       "deadline         REAL    NOT NULL, "
                       "preconditions    TEXT, "
                       "target           TEXT    NOT NULL "
-                      " );";
+                      " );"
+                      "CREATE INDEX IF NOT EXISTS " PLANS_TABLE "_target_idx ON " PLANS_TABLE "(target);"
+                      "CREATE INDEX IF NOT EXISTS " PLANS_TABLE "_preconditions_idx ON " PLANS_TABLE "(preconditions);";
             break;
-        
+
         case SUCCESSORS:
-            create_query = "CREATE TABLE " + SUCCESSORS_TABLE + "("
+            create_query = "CREATE TABLE IF NOT EXISTS " SUCCESSORS_TABLE "("
                       "pId              INTEGER     NOT NULL, "
                       "pSuccId          INTEGER     NOT NULL, "
                       "PRIMARY KEY(pId, pSuccId), "
-                      "FOREIGN KEY (pId) REFERENCES " + PLANS_TABLE + "(pId) ON UPDATE CASCADE ON DELETE CASCADE, "
-                      "FOREIGN KEY (pSuccId) REFERENCES " + PLANS_TABLE + "(pId) ON UPDATE CASCADE ON DELETE CASCADE "
+                      "FOREIGN KEY (pId) REFERENCES " PLANS_TABLE "(pId) ON UPDATE CASCADE ON DELETE CASCADE, "
+                      "FOREIGN KEY (pSuccId) REFERENCES " PLANS_TABLE "(pId) ON UPDATE CASCADE ON DELETE CASCADE "
                       ");";
             break;
     }
 
-    char* msg_error;
-    int res = sqlite3_exec(DB, create_query.c_str(), NULL, 0, &msg_error);
-    sqlite3_free(msg_error);
-
-    return res == SQLITE_OK;
+    return exec(create_query);
 }
 
 /*
-    create table utility function if table is not already defined in the db
-    select the right query to be performed in order to instantiate the table in the db, 
-    returns true if query executed successfully OR selected table is already defined
+    Open the long-lived connection to plan library (WAL mode), init tables and indexes if not already present
+    and prepare the statements used by the other operations
 */
-bool BDIPlanLibrary::tryInitTable(sqlite3* DB, const PlanLibTable& table, const string& table_name)
+bool BDIPlanLibrary::initPlanLibrary()
 {
-    string select_query = "SELECT * FROM " + table_name + ";";
-    int select_res = 0;
+    if(db_ != nullptr)
+        return true;//already open
 
-    select_res = sqlite3_exec(DB, select_query.c_str(), NULL, 0, NULL);
-    if (select_res != SQLITE_OK)
+    if(sqlite3_open(db_filepath_.c_str(), &db_) != SQLITE_OK)
     {
-        if(!createTable(DB, table))
-            return false;//table init has failed
+        sqlite3_close(db_);//handle allocated even on failure
+        db_ = nullptr;
+        return false;
     }
-    return true; //either table already existed or creation has been successful
 
+    // readers never block the writer and commits don't wait for a full fsync
+    exec("PRAGMA journal_mode=WAL;");
+    exec("PRAGMA synchronous=NORMAL;");
+    exec("PRAGMA foreign_keys=ON;");
+
+    // PLANS TABLE INIT + SUCCESSORS TABLE INIT
+    if(!createTable(PLANS) || !createTable(SUCCESSORS))
+        return false;
+
+    string insert_plan_query = "INSERT INTO " PLANS_TABLE " (plan,deadline,preconditions,target) VALUES (?,?,?,?);";
+    string insert_successors_query = "INSERT OR IGNORE INTO " SUCCESSORS_TABLE " (pId,pSuccId) VALUES (?,?);";
+    string select_plan_query = "SELECT pId FROM " PLANS_TABLE " WHERE target=? AND preconditions=? AND plan=?;";
+    string select_plans_query = "SELECT pId,plan FROM " PLANS_TABLE " WHERE target=? AND preconditions=? ORDER BY deadline;";
+    return sqlite3_prepare_v2(db_, insert_plan_query.c_str(), -1, &insert_plan_stmt_, NULL) == SQLITE_OK &&
+        sqlite3_prepare_v2(db_, insert_successors_query.c_str(), -1, &insert_successors_stmt_, NULL) == SQLITE_OK &&
+        sqlite3_prepare_v2(db_, select_plan_query.c_str(), -1, &select_plan_stmt_, NULL) == SQLITE_OK &&
+        sqlite3_prepare_v2(db_, select_plans_query.c_str(), -1, &select_plans_stmt_, NULL) == SQLITE_OK;
 }
 
-bool BDIPlanLibrary::initPlanLibrary()
+/*
+    Start a batch of operations executed within a single transaction (until commitTransaction)
+*/
+bool BDIPlanLibrary::beginTransaction()
 {
-    sqlite3* DB;
-    
-    int exit = 0;
-    exit = sqlite3_open(db_filepath_.c_str(), &DB);
-    if (exit)
-        return false;
-    
-    // PLANS TABLE INIT
-    if(!tryInitTable(DB, PLANS, PLANS_TABLE))
+    if(db_ == nullptr || in_transaction_)
         return false;
 
-    // SUCCESSORS TABLE INIT
-    if(!tryInitTable(DB, SUCCESSORS, SUCCESSORS_TABLE))
+    in_transaction_ = exec("BEGIN TRANSACTION;");
+    return in_transaction_;
+}
+
+/*
+    Commit the batch of operations started with beginTransaction
+*/
+bool BDIPlanLibrary::commitTransaction()
+{
+    if(db_ == nullptr || !in_transaction_)
         return false;
 
-    // Close connection to DB
-    sqlite3_close(DB);
+    in_transaction_ = false;
+    return exec("COMMIT;");
+}
 
-    return true;
+/*
+    serialize the target of the plan as stored in the target column
+*/
+string BDIPlanLibrary::targetString(const vector<ManagedBelief>& target_value)
+{
+    string target = "";
+    for(int i=0; i<target_value.size(); i++)
+        target += target_value[i].toString() + ((i != target_value.size()-1) ? "&" : "");
+    return target;
 }
 
 /*
@@ -94,80 +164,108 @@ bool BDIPlanLibrary::initPlanLibrary()
 
     return generated id for stored plan
 */
-int BDIPlanLibrary::insertPlan(const BDIManaged::ManagedPlan& mp)
+int BDIPlanLibrary::insertPlan(const ManagedPlan& mp)
 {
-    int stored_plan_id = -1;
-    sqlite3* DB;
-    
-    int exit = 0;
-    exit = sqlite3_open(db_filepath_.c_str(), &DB);
-    if (exit)
-        return false;
+    if(insert_plan_stmt_ == nullptr || select_plan_stmt_ == nullptr)
+        return -1;
 
-    // retrieve params for the query
-    string plan = mp.toPsys2PlanString(); 
-    string deadline = std::to_string(mp.getPlannedDeadline());
+    // retrieve params for the query (bound, so their content needs no escaping)
+    string plan = mp.toPsys2PlanString();
     string precondition = mp.getPrecondition().toString();
-    string target = "";
-    vector<ManagedBelief> target_value = mp.getPlanTarget().getValue();
-    for(int i=0; i<target_value.size(); i++)
-        target += target_value[i].toString() + ((i != target_value.size()-1) ? "&" : "");
-    
-    string insert_query =  "INSERT INTO " + PLANS_TABLE + " (plan,deadline,preconditions,target) "  
-         "VALUES ('"+plan+"',"+deadline+",'"+precondition+"','"+target+"'); ";
-
-    // prevent sql injections attacks (or most of them)
-    // why?? is it needed? because it's my code and it has to shine :-) 
-    // (and to be less performant as possible)
-    if(insert_query.find_first_of(";") != insert_query.find_last_of(";"))
-        return false;
+    string target = targetString(mp.getPlanTarget().getValue());
 
-    int insert_res = sqlite3_exec(DB, insert_query.c_str(), NULL, 0, NULL);
+    // same plan already stored for the same target and preconditions
+    sqlite3_bind_text(select_plan_stmt_, 1, target.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(select_plan_stmt_, 2, precondition.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(select_plan_stmt_, 3, plan.c_str(), -1, SQLITE_TRANSIENT);
+    int stored_plan_id = -1;
+    if(sqlite3_step(select_plan_stmt_) == SQLITE_ROW)
+        stored_plan_id = sqlite3_column_int(select_plan_stmt_, 0);
+    sqlite3_reset(select_plan_stmt_);
+    sqlite3_clear_bindings(select_plan_stmt_);
+    if(stored_plan_id >= 0)
+        return stored_plan_id;
 
-    if(insert_res == SQLITE_OK)
-    {
-        string retrieve_id_query = "select seq from sqlite_sequence where name='"+PLANS_TABLE+"'";
-        sqlite3_stmt *ppStmt2;
-        int r1 = sqlite3_prepare_v2(DB, retrieve_id_query.c_str(), strlen(retrieve_id_query.c_str()), &ppStmt2, 0);
-        if(r1 == SQLITE_OK && sqlite3_step(ppStmt2) == SQLITE_ROW)
-            stored_plan_id = sqlite3_column_int(ppStmt2,0);
-        int r3 = r1 != SQLITE_OK? r1 : sqlite3_finalize(ppStmt2);
-    }
+    sqlite3_bind_text(insert_plan_stmt_, 1, plan.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_double(insert_plan_stmt_, 2, mp.getPlannedDeadline());
+    sqlite3_bind_text(insert_plan_stmt_, 3, precondition.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(insert_plan_stmt_, 4, target.c_str(), -1, SQLITE_TRANSIENT);
 
-    // Close connection to DB
-    sqlite3_close(DB);
+    if(sqlite3_step(insert_plan_stmt_) == SQLITE_DONE)
+        stored_plan_id = sqlite3_last_insert_rowid(db_);
 
+    sqlite3_reset(insert_plan_stmt_);
+    sqlite3_clear_bindings(insert_plan_stmt_);
     return stored_plan_id;
 }
 
+/*
+    Store new plans within a single transaction
+    return generated ids for stored plans (-1 for the ones which have not been stored)
+*/
+vector<int> BDIPlanLibrary::insertPlans(const vector<ManagedPlan>& mps)
+{
+    bool batch = beginTransaction();//false if already within a batch started by the caller
+
+    vector<int> stored_plan_ids;
+    for(const ManagedPlan& mp : mps)
+        stored_plan_ids.push_back(insertPlan(mp));
+
+    if(batch)
+        commitTransaction();
+    return stored_plan_ids;
+}
+
 /*
     Store in the db relationship mp1 -> mp2
 */
-bool BDIPlanLibrary::markSuccessors(const BDIManaged::ManagedPlan& mp1, const BDIManaged::ManagedPlan& mp2)
+bool BDIPlanLibrary::markSuccessors(const ManagedPlan& mp1, const ManagedPlan& mp2)
 {
-    sqlite3* DB;
-    
-    int exit = 0;
-    exit = sqlite3_open(db_filepath_.c_str(), &DB);
-    if (exit)
+    if(insert_successors_stmt_ == nullptr)
         return false;
 
-    // retrieve params for the query
-    string planID1 = std::to_string(mp1.getPlanLibID());
-    string planID2 = std::to_string(mp2.getPlanLibID());
+    sqlite3_bind_int(insert_successors_stmt_, 1, mp1.getPlanLibID());
+    sqlite3_bind_int(insert_successors_stmt_, 2, mp2.getPlanLibID());
 
-    string insert_query =  "INSERT INTO " + SUCCESSORS_TABLE + " (pId,pSuccId) "  
-         "VALUES ('"+planID1+"',"+planID2+"); ";
+    bool inserted = sqlite3_step(insert_successors_stmt_) == SQLITE_DONE;
 
-    // prevent sql injections attacks (or most of them)
-    // why?? is it needed? because it's my code and it has to shine :-) 
-    // (and to be less performant as possible)
-    if(insert_query.find_first_of(";") != insert_query.find_last_of(";"))
-        return false;
+    sqlite3_reset(insert_successors_stmt_);
+    return inserted;
+}
+
+/*
+    Retrieve stored plans having exactly the same target and preconditions of @md,
+    ordered by ascending deadline (plan lib id of each one already set)
+*/
+vector<ManagedPlan> BDIPlanLibrary::retrievePlans(const ManagedDesire& md)
+{
+    vector<ManagedPlan> stored_plans;
+    if(select_plans_stmt_ == nullptr)
+        return stored_plans;
+
+    string precondition = md.getPrecondition().toString();
+    string target = targetString(md.getValue());
 
-    int insert_res = sqlite3_exec(DB, insert_query.c_str(), NULL, 0, NULL);
-    // Close connection to DB
-    sqlite3_close(DB);
+    sqlite3_bind_text(select_plans_stmt_, 1, target.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(select_plans_stmt_, 2, precondition.c_str(), -1, SQLITE_TRANSIENT);
+
+    while(sqlite3_step(select_plans_stmt_) == SQLITE_ROW)
+    {
+        int plan_id = sqlite3_column_int(select_plans_stmt_, 0);
+        const unsigned char* plan_text = sqlite3_column_text(select_plans_stmt_, 1);
+        if(plan_text == NULL)
+            continue;
 
-    return insert_res == SQLITE_OK;
-}
\ No newline at end of file
+        auto plan_items = ManagedPlan::parsePsys2PlanMsg(string(reinterpret_cast<const char*>(plan_text)));
+        if(!plan_items.has_value() || plan_items.value().size() == 0)
+            continue;
+
+        ManagedPlan mp = ManagedPlan{0, md, plan_items.value(), md.getPrecondition(), md.getContext()};
+        mp.setPlanLibID(plan_id);
+        stored_plans.push_back(mp);
+    }
+
+    sqlite3_reset(select_plans_stmt_);
+    sqlite3_clear_bindings(select_plans_stmt_);
+    return stored_plans;
+}
@@ -172,7 +172,7 @@ namespace BDIYAMLParser
             type = yaml_belief["type"].IsDefined()? 
                         yaml_belief["type"].as<string>() 
                     : 
-                        belief_params.size() == 1? belief_params[0].name : "";
+                        belief_params.size() == 1? belief_params[0].name.str() : "";
 
         if(belief_pddl_type == Belief().INSTANCE_TYPE)
             return ManagedBelief::buildMBInstance(belief_name, type);
@@ -0,0 +1,89 @@
+#include "ros2_bdi_utils/BeliefSetMirror.hpp"
+
+using std::vector;
+
+using ros2_bdi_interfaces::msg::Belief;
+using ros2_bdi_interfaces::msg::BeliefSet;
+using ros2_bdi_interfaces::msg::BeliefSetDelta;
+
+using BDIManaged::ManagedBelief;
+using BDIManaged::BeliefStore;
+using BDIManaged::BeliefSetMirror;
+
+BeliefSetMirror::BeliefSetMirror():
+    version_(0),
+    synced_(false)
+    {}
+
+/*
+    Replace the mirror content with a full snapshot, which is always considered authoritative
+    (snapshots stamped with the same digest of the mirrored belief set are not even parsed)
+    Returns UPDATED if the mirrored belief set has changed, UNCHANGED otherwise
+*/
+BeliefSetMirror::UpdateResult BeliefSetMirror::applySnapshot(const BeliefSet& msg)
+{
+    //digest of the snapshot matching the mirrored one: same content, no need to parse it
+    //(size checked too, since snapshots not stamped with a digest carry all zeros, as an empty mirror does)
+    if(msg.value.size() == belief_set_.size() && msg.digest == belief_set_.digest())
+    {
+        version_ = msg.version;
+        synced_ = true;
+        return UNCHANGED;
+    }
+
+    vector<ManagedBelief> snapshot;
+    snapshot.reserve(msg.value.size());
+    for(const Belief& b : msg.value)
+        snapshot.push_back(ManagedBelief{b});
+
+    //same beliefs (and same values for functions) already mirrored
+    bool changed = snapshot.size() != belief_set_.size();
+    for(int i = 0; !changed && i < snapshot.size(); i++)
+    {
+        BeliefStore::const_iterator it = belief_set_.find(snapshot[i]);
+        changed = it == belief_set_.end() || !(*it == snapshot[i]) || it->getValue() != snapshot[i].getValue();
+    }
+
+    if(changed)
+        belief_set_ = BeliefStore{snapshot};
+    version_ = msg.version;
+    synced_ = true;
+
+    return changed? UPDATED : UNCHANGED;
+}
+
+/*
+    Apply an incremental update to the mirror
+    Returns UPDATED/UNCHANGED if applied, STALE if already covered by the mirror version (ignored)
+    GAP if some previous delta has been missed (ignored): a new snapshot is needed to resync the mirror
+*/
+BeliefSetMirror::UpdateResult BeliefSetMirror::applyDelta(const BeliefSetDelta& msg)
+{
+    if(synced_ && msg.version <= version_)
+        return STALE;
+
+    if(!synced_ || msg.version != version_ + 1)
+    {
+        synced_ = false;
+        return GAP;
+    }
+
+    bool changed = false;
+    for(const Belief& b : msg.removed)
+        changed = belief_set_.erase(ManagedBelief{b}) > 0 || changed;
+
+    for(const Belief& b : msg.added)
+        changed = belief_set_.insert(ManagedBelief{b}).second || changed;
+
+    for(const Belief& b : msg.modified)
+    {
+        //erase + insert, since functions with diff. values are considered the same element
+        ManagedBelief mb = ManagedBelief{b};
+        belief_set_.erase(mb);
+        belief_set_.insert(mb);
+        changed = true;
+    }
+
+    version_ = msg.version;
+    return changed? UPDATED : UNCHANGED;
+}
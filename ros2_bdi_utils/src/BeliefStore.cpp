@@ -0,0 +1,377 @@
+#include "ros2_bdi_utils/BeliefStore.hpp"
+
+#include <cstring>
+
+#include "ros2_bdi_interfaces/msg/belief.hpp"
+
+#define EMPTY_SLOT -1
+#define TOMBSTONE_SLOT -2
+#define MIN_TABLE_CAPACITY 16
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+#define DIGEST_LANE2_BASIS 0x6a09e667f3bcc909ULL
+#define DIGEST_LANE2_PRIME 0x9e3779b97f4a7c15ULL
+
+using std::string;
+using std::vector;
+using std::set;
+using std::pair;
+using std::optional;
+
+using ros2_bdi_interfaces::msg::Belief;
+
+using BDIManaged::Symbol;
+using BDIManaged::ManagedBelief;
+using BDIManaged::ManagedParam;
+using BDIManaged::BeliefStore;
+
+/* FNV-1a step over a symbol id */
+static uint64_t fnvSymbol(const uint64_t& h, const Symbol& s)
+{
+    return (h ^ s.id()) * FNV_PRIME;
+}
+
+/* feed the bytes of @s (plus a separator) to both the lanes of a belief digest */
+static void digestBytes(BeliefStore::Digest& d, const char* s, const size_t& len)
+{
+    for(size_t i = 0; i <= len; i++)
+    {
+        uint64_t b = (i < len)? (unsigned char) s[i] : 0xffULL;
+        d[0] = (d[0] ^ b) * FNV_PRIME;
+        d[1] = (d[1] ^ b) * DIGEST_LANE2_PRIME;
+    }
+}
+
+/* final avalanche of a digest lane, so that summing the lanes of different beliefs doesn't cancel out */
+static uint64_t mixLane(uint64_t h)
+{
+    h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+    return h ^ (h >> 33);
+}
+
+/* apply an index op for position @pos (and @new_pos for moves) on the bucket of @key within @index */
+template<typename Index, typename Key>
+static void applyIndexOp(Index& index, const Key& key, const int& op, const uint32_t& pos, const uint32_t& new_pos)
+{
+    if(op == 0)//INDEX_ADD
+    {
+        index[key].insert(pos);
+        return;
+    }
+
+    auto it = index.find(key);
+    if(it == index.end())
+        return;
+
+    it->second.erase(pos);
+    if(op == 2)//INDEX_MOVE
+        it->second.insert(new_pos);
+    else if(it->second.empty())
+        index.erase(it);
+}
+
+BeliefStore::BeliefStore():
+    table_used_(0),
+    digest_({0, 0})
+    {}
+
+BeliefStore::BeliefStore(const set<ManagedBelief>& beliefs):
+    table_used_(0),
+    digest_({0, 0})
+{
+    rehash(MIN_TABLE_CAPACITY);
+    for(const ManagedBelief& mb : beliefs)
+        insert(mb);
+}
+
+BeliefStore::BeliefStore(const vector<ManagedBelief>& beliefs):
+    table_used_(0),
+    digest_({0, 0})
+{
+    rehash(MIN_TABLE_CAPACITY);
+    for(const ManagedBelief& mb : beliefs)
+        insert(mb);
+}
+
+/*
+    64-bit hash of a belief (over symbol ids), consistent with operator< (value of functions is not considered)
+*/
+uint64_t BeliefStore::hash(const ManagedBelief& mb)
+{
+    uint64_t h = (FNV_OFFSET_BASIS ^ (uint64_t) mb.pddlType()) * FNV_PRIME;
+    h = fnvSymbol(h, mb.getSymbol());
+    for(const ManagedParam& mp : mb.getParams())
+        h = fnvSymbol(h, mp.name);
+    return h;
+}
+
+/*
+    128-bit digest of a belief over its strings (so it does not depend on the process interning them),
+    value of functions and type of instances included
+*/
+BeliefStore::Digest BeliefStore::beliefDigest(const ManagedBelief& mb)
+{
+    Digest d = {FNV_OFFSET_BASIS ^ (uint64_t) mb.pddlType(), DIGEST_LANE2_BASIS ^ (uint64_t) mb.pddlType()};
+    digestBytes(d, mb.getName().data(), mb.getName().size());
+    for(const ManagedParam& mp : mb.getParams())
+        digestBytes(d, mp.name.str().data(), mp.name.str().size());
+
+    if(mb.pddlType() == Belief().FUNCTION_TYPE)
+    {
+        float value = mb.getValue();
+        char value_bytes[sizeof(float)];
+        std::memcpy(value_bytes, &value, sizeof(float));
+        digestBytes(d, value_bytes, sizeof(float));
+    }
+    else if(mb.pddlType() == Belief().INSTANCE_TYPE)
+        digestBytes(d, mb.type().name.str().data(), mb.type().name.str().size());
+
+    return {mixLane(d[0]), mixLane(d[1])};
+}
+
+/*
+    add (or subtract, if !add) the digest of @mb to the digest of the store
+*/
+void BeliefStore::accumulateDigest(const ManagedBelief& mb, const bool& add)
+{
+    Digest d = beliefDigest(mb);
+    for(int i = 0; i < 2; i++)
+        digest_[i] = add? digest_[i] + d[i] : digest_[i] - d[i];
+}
+
+size_t BeliefStore::ArgKeyHash::operator()(const ArgKey& k) const
+{
+    uint64_t h = (FNV_OFFSET_BASIS ^ (uint64_t) k.pddl_type) * FNV_PRIME;
+    h = (h ^ k.name) * FNV_PRIME;
+    h = (h ^ k.pos) * FNV_PRIME;
+    h = (h ^ k.value) * FNV_PRIME;
+    return (size_t) h;
+}
+
+/*
+    same element within the store (i.e. neither mb1 < mb2 nor mb2 < mb1)
+*/
+bool BeliefStore::sameBelief(const ManagedBelief& mb1, const ManagedBelief& mb2)
+{
+    if(mb1.pddlType() != mb2.pddlType() || mb1.getSymbol() != mb2.getSymbol())
+        return false;
+
+    const vector<ManagedParam>& mb1_params = mb1.getParams();
+    const vector<ManagedParam>& mb2_params = mb2.getParams();
+    if(mb1_params.size() != mb2_params.size())
+        return false;
+
+    for(int i=0; i<mb1_params.size(); i++)
+        if(mb1_params[i].name != mb2_params[i].name)
+            return false;
+
+    return true;
+}
+
+/*
+    slot of the table containing @mb (if any) or -1
+*/
+int64_t BeliefStore::findSlot(const ManagedBelief& mb, const uint64_t& h) const
+{
+    if(table_.empty())
+        return -1;
+
+    size_t mask = table_.size() - 1;
+    for(size_t i = h & mask; ; i = (i+1) & mask)
+    {
+        int32_t pos = table_[i];
+        if(pos == EMPTY_SLOT)
+            return -1;
+        if(pos >= 0 && hashes_[pos] == h && sameBelief(beliefs_[pos], mb))
+            return i;
+    }
+}
+
+/*
+    rebuild the lookup table with the given capacity (power of two)
+*/
+void BeliefStore::rehash(const size_t& capacity)
+{
+    table_.assign(capacity, EMPTY_SLOT);
+    table_used_ = beliefs_.size();
+
+    size_t mask = capacity - 1;
+    for(uint32_t pos = 0; pos < beliefs_.size(); pos++)
+    {
+        size_t i = hashes_[pos] & mask;
+        while(table_[i] != EMPTY_SLOT)
+            i = (i+1) & mask;
+        table_[i] = pos;
+    }
+}
+
+std::pair<BeliefStore::const_iterator, bool> BeliefStore::insert(const ManagedBelief& mb)
+{
+    uint64_t h = hash(mb);
+    int64_t slot = findSlot(mb, h);
+    if(slot >= 0)
+        return std::make_pair(begin() + table_[slot], false);//already there (as in std::set, it's not replaced)
+
+    // keep load factor (tombstones included) below 0.7, table at least twice the num of stored beliefs after rehash
+    if((table_used_ + 1) * 10 > table_.size() * 7)
+    {
+        size_t capacity = MIN_TABLE_CAPACITY;
+        while(capacity < (beliefs_.size() + 1) * 2)
+            capacity <<= 1;
+        rehash(capacity);
+    }
+
+    uint32_t pos = beliefs_.size();
+    beliefs_.push_back(mb);
+    hashes_.push_back(h);
+
+    size_t mask = table_.size() - 1;
+    size_t i = h & mask;
+    while(table_[i] >= 0)
+        i = (i+1) & mask;
+    if(table_[i] == EMPTY_SLOT)
+        table_used_++;
+    table_[i] = pos;
+
+    updateIndexes(pos, INDEX_ADD);
+    accumulateDigest(mb, true);
+    return std::make_pair(begin() + pos, true);
+}
+
+size_t BeliefStore::erase(const ManagedBelief& mb)
+{
+    int64_t slot = findSlot(mb, hash(mb));
+    if(slot < 0)
+        return 0;
+
+    uint32_t pos = table_[slot];
+    table_[slot] = TOMBSTONE_SLOT;
+    updateIndexes(pos, INDEX_DEL);
+    accumulateDigest(beliefs_[pos], false);//stored one: it might differ from @mb for the value of functions
+
+    // keep beliefs_ dense: move the last one in the freed position
+    uint32_t last = beliefs_.size() - 1;
+    if(pos != last)
+    {
+        beliefs_[pos] = std::move(beliefs_[last]);
+        hashes_[pos] = hashes_[last];
+
+        size_t mask = table_.size() - 1;
+        size_t i = hashes_[pos] & mask;
+        while(table_[i] != (int32_t) last)
+            i = (i+1) & mask;
+        table_[i] = pos;
+
+        updateIndexes(last, INDEX_MOVE, pos);
+    }
+    beliefs_.pop_back();
+    hashes_.pop_back();
+    return 1;
+}
+
+BeliefStore::const_iterator BeliefStore::find(const ManagedBelief& mb) const
+{
+    int64_t slot = findSlot(mb, hash(mb));
+    return slot >= 0? begin() + table_[slot] : end();
+}
+
+void BeliefStore::clear()
+{
+    beliefs_.clear();
+    hashes_.clear();
+    table_.clear();
+    table_used_ = 0;
+    by_pddl_type_.clear();
+    by_name_.clear();
+    by_arg_.clear();
+    by_instance_type_.clear();
+    digest_ = {0, 0};
+}
+
+/*
+    add/remove/move (to @new_pos) the belief in position @pos wrt. the secondary indexes
+    (n.b. in case of a move, the belief has been already moved to @new_pos within beliefs_)
+*/
+void BeliefStore::updateIndexes(const uint32_t& pos, const IndexOp& op, const uint32_t& new_pos)
+{
+    const ManagedBelief& mb = beliefs_[op == INDEX_MOVE? new_pos : pos];
+    uint32_t name = mb.getSymbol().id();
+
+    applyIndexOp(by_pddl_type_, mb.pddlType(), op, pos, new_pos);
+    applyIndexOp(by_name_, nameKey(mb.pddlType(), name), op, pos, new_pos);
+
+    const vector<ManagedParam>& params = mb.getParams();
+    for(uint32_t i = 0; i < params.size(); i++)
+        applyIndexOp(by_arg_, ArgKey{mb.pddlType(), name, i, params[i].name.id()}, op, pos, new_pos);
+
+    if(mb.pddlType() == Belief().INSTANCE_TYPE)
+        applyIndexOp(by_instance_type_, mb.type().name.id(), op, pos, new_pos);
+}
+
+/*
+    resolve a bucket of positions into pointers to the stored beliefs
+*/
+vector<const ManagedBelief*> BeliefStore::resolve(const Bucket* bucket) const
+{
+    vector<const ManagedBelief*> result;
+    if(bucket == NULL)
+        return result;
+
+    result.reserve(bucket->size());
+    for(const uint32_t& pos : *bucket)
+        result.push_back(&beliefs_[pos]);
+    return result;
+}
+
+/* beliefs of the given pddl type (INSTANCE/PREDICATE/FUNCTION) */
+vector<const ManagedBelief*> BeliefStore::getByPDDLType(const int& pddl_type) const
+{
+    auto it = by_pddl_type_.find(pddl_type);
+    return resolve(it != by_pddl_type_.end()? &it->second : NULL);
+}
+
+/* beliefs of the given pddl type with the given name (e.g. all the "robot_at" predicates) */
+vector<const ManagedBelief*> BeliefStore::getByName(const int& pddl_type, const string& name) const
+{
+    optional<Symbol> name_sym = Symbol::lookup(name);
+    if(!name_sym.has_value())
+        return vector<const ManagedBelief*>();
+
+    return getByName(pddl_type, name_sym.value());
+}
+
+vector<const ManagedBelief*> BeliefStore::getByName(const int& pddl_type, const Symbol& name) const
+{
+    auto it = by_name_.find(nameKey(pddl_type, name.id()));
+    return resolve(it != by_name_.end()? &it->second : NULL);
+}
+
+/* beliefs of the given pddl type and name having @value as argument in position @pos (e.g. ("robot_at", 0, "r1")) */
+vector<const ManagedBelief*> BeliefStore::getByArg(const int& pddl_type, const string& name, const size_t& pos, const string& value) const
+{
+    optional<Symbol> name_sym = Symbol::lookup(name);
+    optional<Symbol> value_sym = Symbol::lookup(value);
+    if(!name_sym.has_value() || !value_sym.has_value())
+        return vector<const ManagedBelief*>();
+
+    return getByArg(pddl_type, name_sym.value(), pos, value_sym.value());
+}
+
+vector<const ManagedBelief*> BeliefStore::getByArg(const int& pddl_type, const Symbol& name, const size_t& pos, const Symbol& value) const
+{
+    auto it = by_arg_.find(ArgKey{pddl_type, name.id(), (uint32_t) pos, value.id()});
+    return resolve(it != by_arg_.end()? &it->second : NULL);
+}
+
+/* instances of the given type (subtypes are not considered) */
+vector<const ManagedBelief*> BeliefStore::getInstancesByType(const string& type) const
+{
+    optional<Symbol> type_sym = Symbol::lookup(type);
+    if(!type_sym.has_value())
+        return vector<const ManagedBelief*>();
+
+    auto it = by_instance_type_.find(type_sym.value().id());
+    return resolve(it != by_instance_type_.end()? &it->second : NULL);
+}
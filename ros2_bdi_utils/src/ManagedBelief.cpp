@@ -18,26 +18,38 @@ using ros2_bdi_interfaces::msg::Belief;
 using BDIManaged::ManagedBelief;
 
 ManagedBelief::ManagedBelief():
-    name_(""),
+    name_(),
     pddl_type_(-1)
     {}
 
 ManagedBelief::ManagedBelief(const std::string& name,const int& pddl_type, const ManagedType& type):
+    ManagedBelief(Symbol{name}, pddl_type, type)
+{}
+
+ManagedBelief::ManagedBelief(const Symbol& name,const int& pddl_type, const ManagedType& type):
     name_(name),
     pddl_type_(pddl_type),
     type_(type)
 {}
     
 ManagedBelief::ManagedBelief(const std::string& name,const int& pddl_type,const std::vector<ManagedParam>& params, const float& value):
+    ManagedBelief(Symbol{name}, pddl_type, params, value)
+{}
+
+ManagedBelief::ManagedBelief(const Symbol& name,const int& pddl_type,const std::vector<ManagedParam>& params, const float& value):
     name_(name),
     pddl_type_(pddl_type),
     params_(params),
     value_ (value)
     {
+        // interned once, then just copied
+        static const ManagedType predicate_type = ManagedType{PDDLBDIConstants::PREDICATE_TYPE, std::nullopt};
+        static const ManagedType function_type = ManagedType{PDDLBDIConstants::FUNCTION_TYPE, std::nullopt};
+
         if(pddl_type == Belief().PREDICATE_TYPE)
-            type_ = ManagedType{PDDLBDIConstants::PREDICATE_TYPE, std::nullopt};
+            type_ = predicate_type;
         else if(pddl_type == Belief().FUNCTION_TYPE)
-            type_ = ManagedType{PDDLBDIConstants::FUNCTION_TYPE, std::nullopt};
+            type_ = function_type;
     }
 
 ManagedBelief::ManagedBelief(const Belief& belief):
@@ -46,14 +58,15 @@ ManagedBelief::ManagedBelief(const Belief& belief):
     type_(ManagedType{belief.type, std::nullopt}),//TODO deal with subtypes here in later versions
     value_ (belief.value)
     {
-        for(string p : belief.params)
-            params_.push_back(ManagedParam{p,""});//TODO deal with subtypes here in later versions
+        params_.reserve(belief.params.size());
+        for(const string& p : belief.params)
+            params_.push_back(ManagedParam{Symbol{p}});//TODO deal with subtypes here in later versions
     }
 
 // Clone a MG Belief DNF
 ManagedBelief ManagedBelief::clone()
 {
-    string name = string{name_};
+    Symbol name = name_;
     if(pddl_type_ == Belief().INSTANCE_TYPE)
     {
         ManagedType instance_type = type_;
@@ -63,7 +76,7 @@ ManagedBelief ManagedBelief::clone()
     {
         vector<ManagedParam> params;
         for(auto p : params_)
-            params.push_back(ManagedParam{string{p.name}, p.type}); 
+            params.push_back(ManagedParam{p.name, p.type}); 
         
         float value = 0.0f;
         if(pddl_type_ == Belief().FUNCTION_TYPE)
@@ -107,11 +120,12 @@ ManagedBelief ManagedBelief::buildMBFunction(const string& name, const vector<Ma
 Belief ManagedBelief::toBelief() const
 {
     Belief b = Belief();
-    b.name = name_;
+    b.name = name_.str();
     b.pddl_type = pddl_type_;
-    b.type = type_.name;
-    for(ManagedParam mp : params_)
-        b.params.push_back(mp.name);
+    b.type = type_.name.str();
+    b.params.reserve(params_.size());
+    for(const ManagedParam& mp : params_)
+        b.params.push_back(mp.name.str());
     b.value = value_;
     return b;
 }
@@ -132,18 +146,19 @@ ManagedBelief ManagedBelief::applySubstitution(const map<string, string> assignm
     if(pddl_type_ == Belief().FUNCTION_TYPE || pddl_type_ == Belief().PREDICATE_TYPE)
     {
         vector<ManagedParam> params_subs;
-        for(ManagedParam mp : params_)
-            if(mp.isPlaceholder() && assignments.count(mp.name) == 1)
-                params_subs.push_back(ManagedParam{assignments.find(mp.name)->second, mp.type});//replace param's name placeholder with assigned one
+        params_subs.reserve(params_.size());
+        for(const ManagedParam& mp : params_)
+            if(mp.isPlaceholder() && assignments.count(mp.name.str()) == 1)
+                params_subs.push_back(ManagedParam{assignments.find(mp.name.str())->second, mp.type});//replace param's name placeholder with assigned one
             else
-                params_subs.push_back(ManagedParam{mp.name, mp.type});//no placeholder returns as is
+                params_subs.push_back(mp);//no placeholder returns as is
                 
         return ManagedBelief{name_, pddl_type_, params_subs, value_};
     }
     else if(pddl_type_ == Belief().INSTANCE_TYPE)
     {
-        if(assignments.count(name_) == 1)
-            return ManagedBelief{assignments.find(name_)->second, Belief().INSTANCE_TYPE, type_};//replace name placeholder with assigned one
+        if(assignments.count(name_.str()) == 1)
+            return ManagedBelief{assignments.find(name_.str())->second, Belief().INSTANCE_TYPE, type_};//replace name placeholder with assigned one
         else
             return ManagedBelief{name_, Belief().INSTANCE_TYPE, type_};//no placeholder returns as is
     }
@@ -157,7 +172,7 @@ ManagedBelief ManagedBelief::applySubstitution(const map<string, string> assignm
 string ManagedBelief::getParamsJoined(const char separator) const
 {
     string params_string = "";
-    vector<ManagedParam> mb_params = this->getParams();
+    const vector<ManagedParam>& mb_params = this->getParams();
     for(int i=0; i<mb_params.size(); i++)
         params_string += (i==mb_params.size()-1)? mb_params[i].name : mb_params[i].name + separator;
     return params_string;
@@ -248,7 +263,7 @@ std::ostream& BDIManaged::operator<<(std::ostream& os, const ManagedBelief& mb)
     if(mb.pddlType() == Belief().INSTANCE_TYPE)
         param_or_type_string = " " + mb.type().name;
     else
-        for(ManagedParam p : mb.getParams())
+        for(const ManagedParam& p : mb.getParams())
             param_or_type_string += " " + p.name;
 
     os << mb.pddlType() << ":(" << mb.getName() << param_or_type_string + ")";
@@ -270,11 +285,11 @@ bool BDIManaged::operator<(ManagedBelief const &mb1, ManagedBelief const &mb2)
             return false;   
     }
 
-    if(mb1.getName() != mb2.getName())
-        return mb1.getName() < mb2.getName();
+    if(mb1.getSymbol() != mb2.getSymbol())
+        return mb1.getSymbol() < mb2.getSymbol();
     
-    vector<ManagedParam> mb1_params = mb1.getParams();
-    vector<ManagedParam> mb2_params = mb2.getParams();
+    const vector<ManagedParam>& mb1_params = mb1.getParams();
+    const vector<ManagedParam>& mb2_params = mb2.getParams();
 
     if(mb1_params.size() != mb2_params.size())
         return mb1_params.size() < mb2_params.size();
@@ -298,11 +313,11 @@ bool BDIManaged::operator==(ManagedBelief const &mb1, ManagedBelief const &mb2){
     if(mb1.pddlType() == Belief().INSTANCE_TYPE && mb1.type().name != mb2.type().name)
         return false;
 
-    vector<ManagedParam> mb1_params = mb1.getParams();
-    vector<ManagedParam> mb2_params = mb2.getParams();
+    const vector<ManagedParam>& mb1_params = mb1.getParams();
+    const vector<ManagedParam>& mb2_params = mb2.getParams();
 
     //check for different name or different num of params
-    if(mb1.getName() != mb2.getName() || mb1_params.size() != mb2_params.size()) // names OR sizes differ
+    if(mb1.getSymbol() != mb2.getSymbol() || mb1_params.size() != mb2_params.size()) // names OR sizes differ
         return false;
 
 
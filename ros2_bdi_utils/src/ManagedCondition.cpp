@@ -14,86 +14,60 @@ using ros2_bdi_interfaces::msg::Condition;
 using BDIManaged::ManagedParam;
 using BDIManaged::ManagedBelief;
 using BDIManaged::ManagedCondition;
+using BDIManaged::BeliefStore;
+using BDIManaged::WildPattern;
 
-/*
-    returns true if the wild_string potentially containing wild characters that are meant to be replaced by a single char (wild_single_char) or multiple ones (wild_multi_char)
-    mathes the text_string
-    Krauss algorithm https://en.wikipedia.org/wiki/Krauss_wildcard-matching_algorithm 
-*/
-bool krauss_wild_pattern_match(string wild_string, string text_string, 
-    const char& wild_single_char = '?', const char& wild_multi_char = '*')
-{
-    if(wild_string == text_string || wild_string == std::to_string(wild_multi_char))//trivial case
-        return true;
-
-    bool TRUE=true,FALSE=false;
-    bool check[wild_string.length()+1][text_string.length()+1];
-    check[0][0]=TRUE;
-    
-    for(int i=1;i<=text_string.length();i++)
-       check[0][i]=FALSE;
-    for(int i=1;i<=wild_string.length();i++)
-        if(wild_string[i-1] == wild_multi_char)//Checking for wild characters.
-            check[i][0]=check[i-1][0];
-    else
-        check[i][0]=FALSE;
-        
-    for(int i=1;i<=wild_string.length();i++)
+ManagedCondition::ManagedCondition(const ManagedBelief& managedBelief, const string& check):
+    condition_to_check_(managedBelief),
+    check_(check)
     {
-        for(int j=1;j<=text_string.length();j++)
-        {
-            if(wild_string[i-1] == text_string[j-1])
-                check[i][j]=check[i-1][j-1];
-            else if(wild_string[i-1] == wild_single_char)//Checking for wild character '?'.
-                check[i][j]=check[i-1][j-1];
-            else if(wild_string[i-1] == wild_multi_char)//Checking for wild character '*'.
-                check[i][j]=check[i-1][j]||check[i][j-1];
-                
-            else
-               check[i][j] =FALSE;
-        }
+        compile();
     }
 
-    return check[wild_string.length()][text_string.length()];
-}
+ManagedCondition::ManagedCondition(const Condition& condition):
+    condition_to_check_(ManagedBelief{condition.condition_to_check}),
+    check_(condition.check)
+    {
+        compile();
+    }
 
 /*
-    Returns true if the two mg beliefs are equivalent, taking into consideration wild pattern in the first
-    (e.g. params={"box_*"} will be considered equivalent to params={"box_a1"} ) when comparing names and params
-    (does not apply to value which are not a factor in order to consider the equivalence of two managed belief)
+    compile name and params into wild patterns, compute lookup mode (and arg position for ARG_LOOKUP) and cache check validity
 */
-bool wild_pattern_equal(const ManagedBelief& mgBeliefWildPattern, const ManagedBelief& mgBeliefToCheckAgainst)
+void ManagedCondition::compile()
 {
-    if(mgBeliefWildPattern.pddlType() != mgBeliefToCheckAgainst.pddlType()) // different pddl type... no reason to go further in the comparison
-        return false;
-        
-    if(!krauss_wild_pattern_match(mgBeliefWildPattern.getName(), mgBeliefToCheckAgainst.getName())) // names do not match (considering wild pattern chars)
-        return false;
+    valid_check_ = validCheckRequest();
+    lookup_arg_pos_ = 0;
 
-    vector<ManagedParam> wild_params = mgBeliefWildPattern.getParams();
-    vector<ManagedParam> text_params = mgBeliefToCheckAgainst.getParams();
-    if(wild_params.size() != mgBeliefToCheckAgainst.getParams().size())// params size differ
-        return false;
-    
-    //check equals param by param (at this point you know the two arrays are the same size)
-    for(uint8_t i = 0; i < wild_params.size(); i++)
-    {   
-        if(!krauss_wild_pattern_match(wild_params[i].name,text_params[i].name)) //params in pos i do not match
-            return false;
+    name_pattern_ = WildPattern{condition_to_check_.getName()};
+    param_patterns_.clear();
+    const vector<ManagedParam>& params = condition_to_check_.getParams();
+    for(const ManagedParam& mp : params)
+        param_patterns_.push_back(WildPattern{mp.name});
+
+    if(!name_pattern_.isLiteral())
+    {
+        lookup_mode_ = PDDL_TYPE_SCAN;
+        return;
     }
-    //otherwise equals
-    return true;
-}
 
-ManagedCondition::ManagedCondition(const ManagedBelief& managedBelief, const string& check):
-    condition_to_check_(managedBelief),
-    check_(check)
-    {}
+    lookup_mode_ = EXACT_LOOKUP;
+    bool literal_arg_found = false;
+    for(uint32_t i = 0; i < params.size(); i++)
+    {
+        if(param_patterns_[i].isLiteral())
+        {
+            if(!literal_arg_found)
+                lookup_arg_pos_ = i;
+            literal_arg_found = true;
+        }
+        else
+            lookup_mode_ = NAME_LOOKUP;
+    }
 
-ManagedCondition::ManagedCondition(const Condition& condition):
-    condition_to_check_(ManagedBelief{condition.condition_to_check}),
-    check_(condition.check)
-    {}
+    if(lookup_mode_ == NAME_LOOKUP && literal_arg_found)
+        lookup_mode_ = ARG_LOOKUP;
+}
 
 // Clone a MG Conditions DNF
 ManagedCondition ManagedCondition::clone()
@@ -123,21 +97,47 @@ bool ManagedCondition::containsPlaceholders(){
     return false;// no placeholder found
 }
 
-bool ManagedCondition::performCheckAgainstBelief(const ManagedBelief& mb)
+/*
+    Returns true if mb is equivalent to the belief to be checked, taking into consideration its (compiled) wild patterns
+    (e.g. params={"box_*"} will be considered equivalent to params={"box_a1"} ) when comparing names and params
+    (does not apply to value which are not a factor in order to consider the equivalence of two managed belief)
+*/
+bool ManagedCondition::wildPatternEqual(const ManagedBelief& mb) const
 {
-    if(!validCheckRequest())//check request not valid
+    if(condition_to_check_.pddlType() != mb.pddlType()) // different pddl type... no reason to go further in the comparison
+        return false;
+
+    if(!name_pattern_.matches(mb.getSymbol())) // names do not match (considering wild pattern chars)
+        return false;
+
+    const vector<ManagedParam>& text_params = mb.getParams();
+    if(param_patterns_.size() != text_params.size())// params size differ
+        return false;
+
+    //check equals param by param (at this point you know the two arrays are the same size)
+    for(size_t i = 0; i < param_patterns_.size(); i++)
+        if(!param_patterns_[i].matches(text_params[i].name)) //params in pos i do not match
+            return false;
+
+    //otherwise equals
+    return true;
+}
+
+bool ManagedCondition::performCheckAgainstBelief(const ManagedBelief& mb) const
+{
+    if(!valid_check_)//check request not valid
         return false;
     
     Condition c = Condition();
 
     if(condition_to_check_.pddlType() == Belief().INSTANCE_TYPE)
-        return wild_pattern_equal(condition_to_check_, mb);
+        return wildPatternEqual(mb);
 
     else if (condition_to_check_.pddlType() == Belief().PREDICATE_TYPE)
         //true if (same predicate and TRUE CHECK requested) or (diff predicate and FALSE CHECK requested)
-        return (check_ == c.TRUE_CHECK)? wild_pattern_equal(condition_to_check_, mb) : !(wild_pattern_equal(condition_to_check_, mb));
+        return (check_ == c.TRUE_CHECK)? wildPatternEqual(mb) : !(wildPatternEqual(mb));
 
-    else if (condition_to_check_.pddlType() == Belief().FUNCTION_TYPE && wild_pattern_equal(condition_to_check_, mb))//has to be the same fluent
+    else if (condition_to_check_.pddlType() == Belief().FUNCTION_TYPE && wildPatternEqual(mb))//has to be the same fluent
     {
         //now check the value wrt the given check request
         if(check_ == c.SMALLER_CHECK)
@@ -154,15 +154,15 @@ bool ManagedCondition::performCheckAgainstBelief(const ManagedBelief& mb)
 
     return false;//different fluent or some other error(s), hence give false
 }
-bool ManagedCondition::performCheckAgainstBeliefs(const vector<ManagedBelief>& mbArray)
+bool ManagedCondition::performCheckAgainstBeliefs(const vector<ManagedBelief>& mbArray) const
 {
     Condition c = Condition();
     uint8_t false_verified_count = 0;//to be used in case we need to check whether a predicate is false
 
-    if(!validCheckRequest())
+    if(!valid_check_)
         return false;
     
-    for(ManagedBelief mb : mbArray)
+    for(const ManagedBelief& mb : mbArray)
     {
         bool check_res = performCheckAgainstBelief(mb);
         if(check_res)
@@ -183,43 +183,45 @@ bool ManagedCondition::performCheckAgainstBeliefs(const vector<ManagedBelief>& m
     return false;
 }
 
-bool ManagedCondition::performCheckAgainstBeliefs(const set<ManagedBelief>& mbSet)
+bool ManagedCondition::performCheckAgainstBeliefs(const BeliefStore& mbSet) const
 {
     Condition c = Condition();
-    uint32_t false_verified_count = 0;//to be used in case we need to check whether a predicate is false
 
-    if(!validCheckRequest())
+    if(!valid_check_)
         return false;
-    
-    // int counter = 0;
-    for(ManagedBelief mb : mbSet)
+
+    if(lookup_mode_ == EXACT_LOOKUP)
     {
-        // counter++;
-        if(check_ == c.FALSE_CHECK && mb.pddlType() != Belief().PREDICATE_TYPE)
-        {    
-            false_verified_count++;
-            continue;
-        }
+        // at most one belief can match: FALSE_CHECK holds iff it is absent
+        BeliefStore::const_iterator it = mbSet.find(condition_to_check_);
+        if(it == mbSet.end())
+            return check_ == c.FALSE_CHECK;
+        return performCheckAgainstBelief(*it);
+    }
 
-        bool check_res = performCheckAgainstBelief(mb);
+    // beliefs not among the candidates can neither match nor deny the condition
+    vector<const ManagedBelief*> candidates = 
+        (lookup_mode_ == ARG_LOOKUP)? 
+            mbSet.getByArg(condition_to_check_.pddlType(), condition_to_check_.getSymbol(), 
+                lookup_arg_pos_, condition_to_check_.getParams()[lookup_arg_pos_].name)
+        : (lookup_mode_ == NAME_LOOKUP)?
+            mbSet.getByName(condition_to_check_.pddlType(), condition_to_check_.getSymbol())
+        :
+            mbSet.getByPDDLType(condition_to_check_.pddlType());
+
+    for(const ManagedBelief* mb : candidates)
+    {
+        bool check_res = performCheckAgainstBelief(*mb);
 
-        if(check_res)
-        {
-            if(check_ != c.FALSE_CHECK)
-                return true;
-            else
-                false_verified_count++; // false needs to be tested against all current kb
-        }
+        if(check_res && check_ != c.FALSE_CHECK)
+            return true;
 
         if(check_ == c.FALSE_CHECK && !check_res)
             return false; // check false where found to be true
     }
 
-    if (check_ == c.FALSE_CHECK && false_verified_count == mbSet.size())
-            return true; // check false has been successfully verified against all kb
+    return check_ == c.FALSE_CHECK; // check false has been successfully verified against all kb
 
-    // std::cout << std::to_string(counter) << "(" << std::to_string(false_verified_count) << "/" << std::to_string(mbSet.size()) << ")A" << std::flush << std::endl;
-    return false;
 }
 
 
@@ -261,9 +263,9 @@ bool ManagedCondition::isCheckStringForFluent() const
 }
 
 bool ManagedCondition::verifyAllManagedConditions(
-        const vector<ManagedCondition>& mcArray, const set<ManagedBelief>& mbSet)
+        const vector<ManagedCondition>& mcArray, const BeliefStore& mbSet)
 {
-    for(ManagedCondition mc : mcArray)
+    for(const ManagedCondition& mc : mcArray)
         if(!mc.performCheckAgainstBeliefs(mbSet))//one condition not valid and/or not verified
             return false;
             
@@ -13,6 +13,7 @@ using ros2_bdi_interfaces::msg::ConditionsConjunction;
 using BDIManaged::ManagedBelief;
 using BDIManaged::ManagedCondition;
 using BDIManaged::ManagedConditionsConjunction;
+using BDIManaged::BeliefStore;
 
 ManagedConditionsConjunction::ManagedConditionsConjunction():
     literals_(vector<ManagedCondition>()){}
@@ -73,7 +74,7 @@ ManagedConditionsConjunction ManagedConditionsConjunction::applySubstitution(con
 ManagedConditionsConjunction::ManagedConditionsConjunction(const vector<ManagedCondition>& literals):
     literals_(literals){}
 
-bool ManagedConditionsConjunction::isSatisfied(const set<ManagedBelief>& mbSet){
+bool ManagedConditionsConjunction::isSatisfied(const BeliefStore& mbSet) const{
     return ManagedCondition::verifyAllManagedConditions(literals_, mbSet);//note: returns true if empty
 }
 
@@ -1,8 +1,11 @@
 #include "ros2_bdi_utils/ManagedConditionsDNF.hpp"
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 
 #include "ros2_bdi_utils/BDIFilter.hpp"
+#include "ros2_bdi_utils/ReactiveRuleMatcher.hpp"
 
 using std::string;
 using std::vector;
@@ -19,6 +22,8 @@ using BDIManaged::ManagedBelief;
 using BDIManaged::ManagedCondition;
 using BDIManaged::ManagedConditionsConjunction;
 using BDIManaged::ManagedConditionsDNF;
+using BDIManaged::BeliefStore;
+using BDIManaged::ReactiveRuleMatcher;
 
 ManagedConditionsDNF::ManagedConditionsDNF():
     clauses_(vector<ManagedConditionsConjunction>()){}
@@ -53,8 +58,8 @@ ManagedConditionsDNF ManagedConditionsDNF::clone()
 ManagedConditionsDNF::ManagedConditionsDNF(const vector<ManagedConditionsConjunction>& clauses):
     clauses_(clauses){}
 
-bool ManagedConditionsDNF::isSatisfied(const set<ManagedBelief>& mbSet){
-    for(ManagedConditionsConjunction mcc : clauses_)
+bool ManagedConditionsDNF::isSatisfied(const BeliefStore& mbSet) const{
+    for(const ManagedConditionsConjunction& mcc : clauses_)
         if(mcc.isSatisfied(mbSet))
             return true;
     
@@ -134,15 +139,15 @@ ManagedConditionsDNF ManagedConditionsDNF::mergeMGConditionsDNF(const BDIManaged
 string ManagedConditionsDNF::toString() const
 {
     int clause_num=0;
-    int literal_num=0;
     string result = "";
     for(ManagedConditionsConjunction clause : clauses_)
     {
+        int literal_num=0;
         result += mgcond_clause_default_delimiters[0];
         for(ManagedCondition literal : clause.getLiterals())
         {
             string belief_to_check = literal.getMGBelief().toString(mgcond_belief_default_delimiters);
-            result += belief_to_check;
+            result += literal.getCheck() + "/" + belief_to_check;
             if(literal_num < clause.getLiterals().size()-1)//avoid to put & after last literal in clause
                 result += "&";
             literal_num++;
@@ -181,83 +186,15 @@ ManagedConditionsDNF ManagedConditionsDNF::applySubstitution(const map<string, s
     return ManagedConditionsDNF{new_clauses};
 }
 
-map<string, vector<ManagedBelief>> ManagedConditionsDNF::extractAssignmentsMap(const set<ManagedBelief>& belief_set)
-{
-    map<string, set<ManagedBelief>> assignments;
-    set<ManagedBelief> placeholder_beliefs = getBeliefsWithPlaceholders();
-    if (placeholder_beliefs.size() > 0)
-    {
-        for(ManagedBelief mb : placeholder_beliefs)
-        {
-            if(mb.pddlType() == Belief().PREDICATE_TYPE || mb.pddlType() == Belief().FUNCTION_TYPE)
-            {
-                for(ManagedParam mp : mb.getParams())
-                {
-                    if(mp.isPlaceholder())
-                    {   
-                        //filter belief instances by type of the plaholder param
-                        set<ManagedBelief> filteredInstances = BDIFilter::filterMGBeliefInstances(belief_set, mp.type);
-                        
-                        // std::cout << "filteredInstances for ph " << mp.name << " in " << mb.getName();
-                        // for(auto mbbb : filteredInstances)
-                        //     std::cout << mbbb << ", ";
-                        // std::cout << std::flush << std::endl;
-
-                        if(assignments.count(mp.name) == 0)// no matching instances found for now for placeholder mp.name
-                            assignments[mp.name] = filteredInstances;
-                        else// already found matching instances for mp.name -> intersection with filteredInstances found now
-                        {   
-                            for(ManagedBelief mb : filteredInstances)
-                                if(assignments[mp.name].count(mb) == 0) // mb in filteredInstances is not in map for mp.name placeholder
-                                    assignments[mp.name].erase(mb);
-                            for(ManagedBelief mb : assignments[mp.name]) // mb in assignments[mp.name] map is not in filteredInstances mp.name placeholder
-                                if(filteredInstances.count(mb) == 0)
-                                    assignments[mp.name].erase(mb);
-                        }
-                    }
-                            
-                }
-            }
-            else if(mb.pddlType() == Belief().INSTANCE_TYPE)
-            {
-                string instance_name = mb.getName();
-                if(instance_name.find("{") == 0 && instance_name.find("}") == instance_name.length()-1)
-                {
-                    //filter belief instances by type of the plaholder param
-                    set<ManagedBelief> filteredInstances = BDIFilter::filterMGBeliefInstances(belief_set, mb.type());
-                    // std::cout << "filteredInstances for ph " << instance_name << " in " << mb.getName();
-                    // for(auto mbbb : filteredInstances)
-                    //     std::cout << mbbb << ", ";
-                    // std::cout << std::flush << std::endl;
-
-                    if(assignments.count(instance_name) == 0)// no matching instances found for now for placeholder instance_name
-                        assignments[instance_name] = filteredInstances;
-                    else// already found matching instances for instance_name -> intersection with filteredInstances found now
-                    {   
-                        for(ManagedBelief mb : filteredInstances)
-                            if(assignments[instance_name].count(mb) == 0) // mb in filteredInstances is not in map for instance_name placeholder
-                                assignments[instance_name].erase(mb);
-                        for(ManagedBelief mb : assignments[instance_name]) // mb in assignments[instance_name] map is not in filteredInstances mp.name placeholder
-                            if(filteredInstances.count(mb) == 0)
-                                assignments[instance_name].erase(mb);
-                    }
-                }   
-            }
-        }
-    }
-
-    map<string, vector<ManagedBelief>> assignments_result;//marshalling to result format
-    if(assignments.size() > 0)
-    {
-        for(auto assignments_it = assignments.begin(); assignments_it != assignments.end(); assignments_it++)
-        {
-            assignments_result[assignments_it->first] = vector<ManagedBelief>();
-            for(ManagedBelief mb : assignments_it->second)
-                assignments_result[assignments_it->first].push_back(mb);
-        }
-    }
+/*
+    extract the assignments for all the placeholders in the mgconditions dnf which satisfy it against the belief set
+    (each one mapping every placeholder to an instance of the type(s) it is used with)
 
-    return assignments_result;
+    The dnf is joined over the belief set by the same engine matching the reactive rules (see ReactiveRuleMatcher)
+*/
+vector<map<string, string>> ManagedConditionsDNF::extractAssignmentsMap(const BeliefStore& belief_set) const
+{
+    return ReactiveRuleMatcher::satisfyingAssignments(*this, belief_set);
 }
 
 std::ostream& BDIManaged::operator<<(std::ostream& os, const ManagedConditionsDNF& mcdnf)
@@ -14,6 +14,7 @@ using ros2_bdi_interfaces::msg::Desire;
 
 using BDIManaged::ManagedBelief;
 using BDIManaged::ManagedDesire;
+using BDIManaged::BeliefStore;
 
 ManagedDesire::ManagedDesire():
     name_(""),
@@ -205,7 +206,7 @@ ManagedDesire ManagedDesire::applySubstitution(const map<string, string> assignm
                 new_rollback_beliefs_add, new_rollback_beliefs_del};
 }
 
-bool ManagedDesire::isFulfilled(const set<ManagedBelief>& bset)
+bool ManagedDesire::isFulfilled(const BeliefStore& bset)
 {
     for(ManagedBelief targetb : value_)
         if(bset.count(targetb) == 0)
@@ -4,6 +4,8 @@
 
 #include "ros2_bdi_interfaces/msg/desire.hpp"
 
+#include <set>
+
 #include <boost/algorithm/string.hpp>
 
 using plansys2_msgs::msg::Plan;
@@ -164,7 +166,7 @@ float ManagedPlan::computeUpdatedEndTime(const BDIActionExecutionInfo& bdi_ai)
         float max_end_time = 0.0f;
         for(int i = 0; i < bdi_ai.wait_action_indexes.size(); i++)
         {
-            BDIActionExecutionInfo bdi_ai_to_be_waited = actions_exec_info_[bdi_ai.wait_action_indexes[i]];
+            const BDIActionExecutionInfo& bdi_ai_to_be_waited = actions_exec_info_[bdi_ai.wait_action_indexes[i]];
             max_end_time = std::max(max_end_time, computeUpdatedEndTime(bdi_ai_to_be_waited) + bdi_ai.duration); 
         }
         return max_end_time;
@@ -178,7 +180,7 @@ float ManagedPlan::getUpdatedEstimatedDeadline()
     // you cannot compute the sum of all duration, because not all plans are 
     // linear sequence of actions (i.e. actions can start in group and/or actions
     // can start when other actions during plan exec. has not finished yet)
-    for(BDIActionExecutionInfo bdi_ai : actions_exec_info_)
+    for(const BDIActionExecutionInfo& bdi_ai : actions_exec_info_)
         deadline = std::max(deadline, computeUpdatedEndTime(bdi_ai)); 
 
     return deadline;
@@ -201,11 +203,13 @@ std::optional<vector<PlanItem>> ManagedPlan::parsePsys2PlanMsg(string plan_msg)
         boost::split(s_pitems, plan_msg, [](char c){return c == '\n';});//split string
         for(string s_pitem : s_pitems)
         {   
+            if(s_pitem.length() == 0)
+                continue;//e.g. after last line break
+
             //init values for parsing pitem
             int i = 0;
 
             float start_time = -1.0f;
-            string action = "";
             float duration = -1.0f;
 
             //retrieve start time
@@ -230,7 +234,7 @@ std::optional<vector<PlanItem>> ManagedPlan::parsePsys2PlanMsg(string plan_msg)
             
             PlanItem p_item = PlanItem();
             p_item.time = start_time;
-            p_item.action = action;
+            p_item.action = s_action;
             p_item.duration = duration;
             p_items.push_back(p_item);
         }
@@ -250,12 +254,36 @@ string ManagedPlan::toPsys2PlanString() const
     for(PlanItem item : pitems)
     {
         result += "[" + std::to_string(item.time) + "]";
-        result += "(" + item.action + ")";
+        result += item.action;//already within parenthesis
         result += "[" + std::to_string(item.duration) + "]\n";
     }
     return result;
 }
 
+/*
+    Return true if @mp1 and @mp2 cannot be executed concurrently, 
+    i.e. they share a (grounded) action or an instance among the args of their actions
+*/
+bool ManagedPlan::conflicting(const ManagedPlan& mp1, const ManagedPlan& mp2)
+{
+    std::set<string> mp1_actions, mp1_instances;
+    for(const BDIActionExecutionInfo& bdi_ai : mp1.actions_exec_info_)
+    {
+        mp1_actions.insert(computeActionFullName(bdi_ai));
+        mp1_instances.insert(bdi_ai.args.begin(), bdi_ai.args.end());
+    }
+
+    for(const BDIActionExecutionInfo& bdi_ai : mp2.actions_exec_info_)
+    {
+        if(mp1_actions.count(computeActionFullName(bdi_ai)) > 0)
+            return true;
+        for(const string& arg : bdi_ai.args)
+            if(mp1_instances.count(arg) > 0)
+                return true;
+    }
+    return false;
+}
+
 // overload `==` operator 
 bool BDIManaged::operator==(ManagedPlan const &mp1, ManagedPlan const &mp2){
      // first check based on target desires
@@ -111,6 +111,59 @@ namespace PDDLBDIConverter
     return beliefs;
   }
 
+  /*
+    Convert a PDDL problem fact and its value, as extracted by PDDLUtils::extractPDDLProblemFacts, to ROS2-BDI Belief
+    E.g. "r1 - robot" -> instance, "(robot_at r1 wp1)" -> predicate, "(battery r1)" with value "80" -> function
+    Returns std::nullopt if the fact cannot be parsed
+  */
+  std::optional<Belief> convertPDDLProblemFact(const string& fact, const string& value)
+  {
+    if(fact.length() == 0)
+      return std::nullopt;
+
+    Belief b = Belief();
+    vector<string> items;
+
+    if(fact[0] != '(')
+    {
+      //instance: "name - type"
+      boost::split(items, fact, [](char c){return c == ' ';});
+      if(items.size() != 3 || items[1] != "-")
+        return std::nullopt;
+      b.name = items[0];
+      b.pddl_type = Belief().INSTANCE_TYPE;
+      b.type = items[2];
+      b.value = 0.0f;// has NO meaning in Instance type
+      return b;
+    }
+
+    string fact_no_par = boost::replace_all_copy(boost::replace_all_copy(fact, "(", " "), ")", " ");
+    boost::trim(fact_no_par);
+    boost::split(items, fact_no_par, boost::is_any_of(" "), boost::token_compress_on);
+    if(fact_no_par.length() == 0 || items.size() == 0)
+      return std::nullopt;
+
+    b.name = items[0];
+    b.params = vector<string>(items.begin() + 1, items.end());
+    if(value.length() > 0)
+    {
+      //function: "(name p1 p2)" with its value
+      b.pddl_type = Belief().FUNCTION_TYPE;
+      try{
+        b.value = std::stof(value);
+      }catch(const std::exception& e){
+        return std::nullopt;
+      }
+    }
+    else
+    {
+      //predicate: "(name p1 p2)"
+      b.pddl_type = Belief().PREDICATE_TYPE;
+      b.value = 0.0f;// has NO meaning in Predicate type
+    }
+    return b;
+  }
+
   typedef enum {ADD_NANO_SEC, DEL_NANO_SEC} OpSign;
 
   /*
@@ -275,4 +328,53 @@ namespace PDDLBDIConverter
     return bdiActionExecutionInfo;
   }
 
+  /*
+    Get the full name of a plan item as reported in PlanSys2 executor feedback, i.e. "(a1 p1 p2 p3):timex1000"
+  */
+  string getActionFullName(const PlanItem& plan_item)
+  {
+    return plan_item.action + ":" + std::to_string(static_cast<int>(plan_item.time * 1000));
+  }
+
+  /*
+    Update in place status, timing, progress and waited actions of a BDIActionExecutionInfo 
+    from the corresponding PlanSys2 ActionExecutionInfo (fields depending just on the plan body are left untouched)
+    Waited actions are indexed through action_plan_index (action full name -> index within the plan body)
+
+    Timestamps of corresponding plan start are passed too 
+  */
+  void updateBDIActionExecutionInfo(
+    BDIActionExecutionInfo& bdi_action_exec_info,
+    const ActionExecutionInfo& psys2_action_feed, 
+    const std::map<string, int>& action_plan_index,
+    const int& first_ts_plan_sec, const unsigned int& first_ts_plan_nanosec)
+  {
+    bdi_action_exec_info.wait_action_indexes.resize(psys2_action_feed.waiting_actions.size());
+    for(int i = 0; i < psys2_action_feed.waiting_actions.size(); i++)
+    {
+      auto waitAction = action_plan_index.find(psys2_action_feed.waiting_actions[i]);
+      bdi_action_exec_info.wait_action_indexes[i] = (waitAction != action_plan_index.end())? waitAction->second : -1;
+    }
+
+    if(first_ts_plan_sec >= 0 && psys2_action_feed.status != psys2_action_feed.NOT_EXECUTED)
+    {
+      // start time of this action with respect first timestamp of first action start timestamp
+      bdi_action_exec_info.actual_start = computeRelativeTime(psys2_action_feed.start_stamp.sec, psys2_action_feed.start_stamp.nanosec,
+                              first_ts_plan_sec, first_ts_plan_nanosec);
+      
+      // retrieve execution time as (status_timestamp - start_timestamp)
+      bdi_action_exec_info.exec_time = computeRelativeTime(psys2_action_feed.status_stamp.sec, psys2_action_feed.status_stamp.nanosec,
+                                first_ts_plan_sec, first_ts_plan_nanosec) - bdi_action_exec_info.actual_start; 
+    }
+    else
+    { 
+      // still having no info
+      bdi_action_exec_info.actual_start = 0.0f;
+      bdi_action_exec_info.exec_time = 0.0f;
+    }
+
+    bdi_action_exec_info.progress = psys2_action_feed.completion;
+    bdi_action_exec_info.status = getBDIActionExecutionStatus(psys2_action_feed);
+  }
+
 }
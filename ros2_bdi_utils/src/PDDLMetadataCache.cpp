@@ -0,0 +1,201 @@
+#include "ros2_bdi_utils/PDDLMetadataCache.hpp"
+#include "ros2_bdi_utils/PDDLUtils.hpp"
+
+#include <algorithm>
+
+using std::string;
+using std::vector;
+using std::optional;
+using std::shared_ptr;
+
+using ros2_bdi_interfaces::msg::Belief;
+
+using BDIManaged::ManagedBelief;
+using BDIManaged::BeliefStore;
+using BDIManaged::PDDLTypeLattice;
+using BDIManaged::PDDLMetadataCache;
+
+PDDLMetadataCache::PDDLMetadataCache():
+    domain_expert_(nullptr),
+    domain_loaded_(false)
+    {}
+
+PDDLMetadataCache::PDDLMetadataCache(const shared_ptr<plansys2::DomainExpertClient>& domain_expert):
+    domain_expert_(domain_expert),
+    domain_loaded_(false)
+    {}
+
+/*
+    Retrieve the names of the predicates, functions and durative actions defined in the domain and its type hierarchy,
+    returns false if the domain expert has not answered with a domain yet
+*/
+bool PDDLMetadataCache::loadDomain()
+{
+    if(domain_expert_ == nullptr)
+        return false;
+
+    predicate_names_.clear();
+    for(const plansys2::Predicate& pred : domain_expert_->getPredicates())
+        predicate_names_.insert(pred.name);
+
+    function_names_.clear();
+    for(const plansys2::Function& function : domain_expert_->getFunctions())
+        function_names_.insert(function.name);
+
+    durative_action_names_.clear();
+    for(const string& action : domain_expert_->getDurativeActions())
+        durative_action_names_.insert(action);
+
+    // an empty domain means the domain expert is not ready yet: try again at the next lookup
+    domain_loaded_ = predicate_names_.size() > 0 || function_names_.size() > 0 || durative_action_names_.size() > 0;
+    if(domain_loaded_)
+        type_lattice_ = PDDLTypeLattice{PDDLUtils::extractPDDLDomainTypes(domain_expert_->getDomain())};
+    return domain_loaded_;
+}
+
+/*
+    Drop the schemas retrieved so far, so that they're retrieved again at the next lookup (e.g. domain expert restarted)
+*/
+void PDDLMetadataCache::invalidateDomain()
+{
+    domain_loaded_ = false;
+    predicate_names_.clear();
+    function_names_.clear();
+    durative_action_names_.clear();
+    type_lattice_ = PDDLTypeLattice{};
+    predicates_.clear();
+    functions_.clear();
+    durative_actions_.clear();
+}
+
+/*
+    Schema of predicate @name as defined in the domain, std::nullopt if there is no such definition
+*/
+optional<plansys2::Predicate> PDDLMetadataCache::getPredicate(const string& name)
+{
+    auto cached = predicates_.find(name);
+    if(cached != predicates_.end())
+        return cached->second;
+
+    if(domain_expert_ == nullptr)
+        return std::nullopt;
+    if(!domain_loaded_ && !loadDomain())
+        return domain_expert_->getPredicate(name);//domain not available yet: nothing is cached
+    if(predicate_names_.count(name) == 0)
+        return std::nullopt;
+
+    optional<plansys2::Predicate> pred = domain_expert_->getPredicate(name);
+    if(pred.has_value())
+        predicates_[name] = pred.value();
+    return pred;
+}
+
+/*
+    Schema of function @name as defined in the domain, std::nullopt if there is no such definition
+*/
+optional<plansys2::Function> PDDLMetadataCache::getFunction(const string& name)
+{
+    auto cached = functions_.find(name);
+    if(cached != functions_.end())
+        return cached->second;
+
+    if(domain_expert_ == nullptr)
+        return std::nullopt;
+    if(!domain_loaded_ && !loadDomain())
+        return domain_expert_->getFunction(name);//domain not available yet: nothing is cached
+    if(function_names_.count(name) == 0)
+        return std::nullopt;
+
+    optional<plansys2::Function> function = domain_expert_->getFunction(name);
+    if(function.has_value())
+        functions_[name] = function.value();
+    return function;
+}
+
+/*
+    Schema of durative action @name as defined in the domain, nullptr if there is no such definition
+*/
+shared_ptr<plansys2::DurativeAction> PDDLMetadataCache::getDurativeAction(const string& name)
+{
+    auto cached = durative_actions_.find(name);
+    if(cached != durative_actions_.end())
+        return cached->second;
+
+    if(domain_expert_ == nullptr)
+        return nullptr;
+    if(!domain_loaded_ && !loadDomain())
+        return domain_expert_->getDurativeAction(name);//domain not available yet: nothing is cached
+    if(durative_action_names_.count(name) == 0)
+        return nullptr;
+
+    shared_ptr<plansys2::DurativeAction> action = domain_expert_->getDurativeAction(name);
+    if(action != nullptr)
+        durative_actions_[name] = action;
+    return action;
+}
+
+/*
+    Type of the instance @name, std::nullopt if it is not a known instance
+*/
+optional<string> PDDLMetadataCache::getInstanceType(const string& name) const
+{
+    auto instance = instances_.find(name);
+    if(instance == instances_.end())
+        return std::nullopt;
+    return instance->second;
+}
+
+/*
+    Replace the mirrored instances with the ones within @beliefSet (e.g. upon a belief set snapshot)
+*/
+void PDDLMetadataCache::syncInstances(const BeliefStore& beliefSet)
+{
+    instances_.clear();
+    for(const ManagedBelief* mb : beliefSet.getByPDDLType(Belief().INSTANCE_TYPE))
+        addInstance(*mb);
+}
+
+/*
+    Mirror the instances added/removed by a belief set update (beliefs of other pddl types are ignored)
+*/
+void PDDLMetadataCache::updateInstances(const vector<Belief>& added, const vector<Belief>& removed)
+{
+    for(const Belief& b : removed)
+        if(b.pddl_type == Belief().INSTANCE_TYPE)
+            instances_.erase(b.name);
+
+    for(const Belief& b : added)
+        if(b.pddl_type == Belief().INSTANCE_TYPE)
+            instances_[b.name] = b.type;
+}
+
+void PDDLMetadataCache::addInstance(const ManagedBelief& mb)
+{
+    if(mb.pddlType() == Belief().INSTANCE_TYPE)
+        instances_[mb.getName()] = mb.type().name.str();
+}
+
+void PDDLMetadataCache::removeInstance(const ManagedBelief& mb)
+{
+    if(mb.pddlType() == Belief().INSTANCE_TYPE)
+        instances_.erase(mb.getName());
+}
+
+/*
+    Return true if an instance of type @insType can be used for @param, i.e. same type or one of its sub types
+    (checked through the type lattice, or within the sub types of @param for types not declared in the domain)
+*/
+bool PDDLMetadataCache::typeMatches(const plansys2_msgs::msg::Param& param, const string& insType)
+{
+    if(param.type == insType)
+        return true;
+
+    if(!domain_loaded_)
+        loadDomain();//type lattice empty until the domain has been retrieved
+    optional<uint16_t> ins_type_id = type_lattice_.typeId(insType);
+    optional<uint16_t> param_type_id = type_lattice_.typeId(param.type);
+    if(ins_type_id.has_value() && param_type_id.has_value())
+        return type_lattice_.isSubtype(ins_type_id.value(), param_type_id.value());
+
+    return std::find(param.sub_types.begin(), param.sub_types.end(), insType) != param.sub_types.end();
+}
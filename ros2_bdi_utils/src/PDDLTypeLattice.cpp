@@ -0,0 +1,70 @@
+#include "ros2_bdi_utils/PDDLTypeLattice.hpp"
+
+using std::map;
+using std::string;
+using std::vector;
+using std::optional;
+
+using BDIManaged::PDDLTypeLattice;
+
+PDDLTypeLattice::PDDLTypeLattice():
+    words_(0)
+    {}
+
+/*
+    Build the lattice out of the parent of each type (e.g. as returned by PDDLUtils::extractPDDLDomainTypes),
+    types appearing just as parents are included too
+*/
+PDDLTypeLattice::PDDLTypeLattice(const map<string, string>& parents):
+    words_(0)
+{
+    auto addType = [this](const string& type)
+    {
+        if(ids_.count(type) == 0)
+        {
+            ids_[type] = names_.size();
+            names_.push_back(type);
+        }
+    };
+    for(const auto& type_parent : parents)
+    {
+        addType(type_parent.first);
+        addType(type_parent.second);
+    }
+
+    words_ = (names_.size() + 63) / 64;
+    ancestors_ = vector<uint64_t>(names_.size() * words_, 0);
+    for(uint16_t t = 0; t < names_.size(); t++)
+    {
+        // walk up the chain of parents (cycles in a malformed hierarchy stop at the first type met twice)
+        uint16_t ancestor = t;
+        while(!isSubtype(t, ancestor))
+        {
+            ancestors_[t * words_ + (ancestor >> 6)] |= uint64_t{1} << (ancestor & 63);
+
+            auto parent = parents.find(names_[ancestor]);
+            if(parent == parents.end())
+                break;//root type
+            ancestor = ids_[parent->second];
+        }
+    }
+}
+
+/* id of @type, std::nullopt if it is not a type of the domain */
+optional<uint16_t> PDDLTypeLattice::typeId(const string& type) const
+{
+    auto id = ids_.find(type);
+    if(id == ids_.end())
+        return std::nullopt;
+    return id->second;
+}
+
+/*
+    true if @sub is @super or one of its (direct or indirect) subtypes
+*/
+bool PDDLTypeLattice::isSubtype(const string& sub, const string& super) const
+{
+    auto sub_id = ids_.find(sub);
+    auto super_id = ids_.find(super);
+    return sub_id != ids_.end() && super_id != ids_.end() && isSubtype(sub_id->second, super_id->second);
+}
@@ -1,8 +1,11 @@
 #include "ros2_bdi_utils/PDDLUtils.hpp"
 
 #include <boost/algorithm/string.hpp>
+#include <cctype>
 
 using std::vector;
+using std::map;
+using std::set;
 using std::string;
 
 /*Remove ALL parenthesis from an expression*/
@@ -16,6 +19,151 @@ string removeParenthesis(const string& expression)
     return stringNoPar;
 }
 
+/*Remove ALL the comments from a PDDL text, i.e. from each ';' up to the end of its line*/
+string removeComments(const string& pddl)
+{
+    string pddlNoComments;
+    pddlNoComments.reserve(pddl.length());
+    size_t start = 0;
+    while(start < pddl.length())
+    {
+        size_t comment = pddl.find(';', start);
+        if(comment == string::npos)
+        {
+            pddlNoComments.append(pddl, start, string::npos);
+            break;
+        }
+        pddlNoComments.append(pddl, start, comment - start);
+        start = pddl.find('\n', comment);//line break kept as a separator
+    }
+    return pddlNoComments;
+}
+
+/*Split an expression in its tokens, treating parenthesis as tokens on their own*/
+vector<string> tokenizeExpression(const string& expression)
+{
+    vector<string> tokens;
+    string token = "";
+    for(char c : expression)
+    {
+        if(c == '(' || c == ')' || isspace(c))
+        {
+            if(token.length() > 0)
+                tokens.push_back(token);
+            token = "";
+            if(c == '(' || c == ')')
+                tokens.push_back(string(1, c));
+        }
+        else
+            token += c;
+    }
+    if(token.length() > 0)
+        tokens.push_back(token);
+    return tokens;
+}
+
+/*Rebuild an expression from its tokens, e.g. ["(", "=", "(", "f", "a", ")", "3", ")"] -> "(= (f a) 3)"*/
+string joinExpressionTokens(const vector<string>& tokens)
+{
+    string expression = "";
+    for(int i = 0; i < tokens.size(); i++)
+    {
+        if(i > 0 && tokens[i] != ")" && tokens[i-1] != "(")
+            expression += " ";
+        expression += tokens[i];
+    }
+    return expression;
+}
+
+/*
+    true if the token following an open parenthesis at position @i of @tokens is a predicate/function name
+    (i.e. not a logical/numeric operator, a time specifier, a variable or a number)
+*/
+bool isPDDLNameToken(const vector<string>& tokens, const int& i)
+{
+    static const set<string> operators = {"and", "or", "not", "imply", "forall", "exists", "when", 
+        "=", "<", ">", "<=", ">=", "+", "-", "*", "/", "increase", "decrease", "assign", "scale-up", "scale-down"};
+
+    const string& token = tokens[i];
+    if(token == "(" || token == ")" || token[0] == '?' || token[0] == ':' || isdigit(token[0]) || operators.count(token) > 0)
+        return false;
+    
+    //time specifiers "(at start ...)", "(at end ...)", "(over all ...)" vs. predicates named like them
+    bool followed_by = i+1 < tokens.size();
+    if(token == "at" && followed_by && (tokens[i+1] == "start" || tokens[i+1] == "end"))
+        return false;
+    if(token == "over" && followed_by && tokens[i+1] == "all")
+        return false;
+    return true;
+}
+
+/*
+    Returns the content of the :objects section of a PDDL problem string (empty if it has none)
+*/
+string pddlProblemObjects(const string& pddlProblem)
+{
+    size_t objects_start = pddlProblem.find(":objects");
+    if(objects_start == string::npos)
+        return "";
+
+    objects_start += string(":objects").length();
+    size_t objects_end = pddlProblem.find(")", objects_start);
+    return pddlProblem.substr(objects_start, objects_end - objects_start);
+}
+
+/*
+    Add to @facts the instances declared within the content of an :objects section: "name1 name2 - type1 name3 - type2 ..."
+*/
+void extractPDDLObjectsFacts(const string& objects, map<string, string>& facts)
+{
+    vector<string> tokens = tokenizeExpression(objects);
+    vector<string> names;
+    for(int i = 0; i < tokens.size(); i++)
+    {
+        if(tokens[i] == "-" && i+1 < tokens.size())
+        {
+            for(string name : names)
+                facts[name + " - " + tokens[i+1]] = "";
+            names.clear();
+            i++;//skip type token
+        }
+        else
+            names.push_back(tokens[i]);
+    }
+}
+
+/*
+    Add to @facts the facts stated within (part of) the content of an :init section: every top level parenthesized expression 
+    is a fact, up to the closing parenthesis of the section
+*/
+void extractPDDLInitFacts(const string& init, map<string, string>& facts)
+{
+    vector<string> tokens = tokenizeExpression(init);
+    vector<string> fact_tokens;
+    int depth = 0;
+    for(string token : tokens)
+    {
+        if(token == ")" && depth == 0)
+            break;//end of init section
+        
+        if(token == "(")
+            depth++;
+        else if(token == ")")
+            depth--;
+        
+        fact_tokens.push_back(token);
+        if(depth == 0)
+        {
+            //function fact: "( = ( name p1 p2 ) value )" -> "(name p1 p2)" mapped to "value"
+            if(fact_tokens.size() > 4 && fact_tokens[1] == "=" && fact_tokens[2] == "(")
+                facts[joinExpressionTokens(vector<string>(fact_tokens.begin() + 2, fact_tokens.end() - 2))] = fact_tokens[fact_tokens.size() - 2];
+            else
+                facts[joinExpressionTokens(fact_tokens)] = "";
+            fact_tokens.clear();
+        }
+    }
+}
+
 namespace PDDLUtils{
 
     /*
@@ -34,4 +182,280 @@ namespace PDDLUtils{
         return elems;
     }
 
+    /*
+        Returns the facts stated within the :objects and :init sections of a PDDL problem string,
+        each one normalized into a single-line key which does not depend on the problem whitespaces
+        and mapped to its value (non empty just for functions)
+        E.g. "r1 r2 - robot" -> {"r1 - robot": "", "r2 - robot": ""}, "( = ( battery r1 ) 80 )" -> {"(battery r1)": "80"}
+    */
+    map<string, string> extractPDDLProblemFacts(const string& pddlProblem)
+    {
+        map<string, string> facts;
+        extractPDDLObjectsFacts(pddlProblemObjects(pddlProblem), facts);
+
+        size_t init_start = pddlProblem.find(":init");
+        if(init_start != string::npos)
+            extractPDDLInitFacts(pddlProblem.substr(init_start + string(":init").length()), facts);
+
+        return facts;
+    }
+
+    /*
+        Diff the facts of two versions of a PDDL problem string (see extractPDDLProblemFacts), looking just at the part
+        of their :init sections which differs (i.e. the facts around the first and the last differing char)
+        and at their :objects sections, if they differ at all.
+        @added gets the facts of @pddlProblemAfter new or with a new value, @removed the facts of @pddlProblemBefore dropped
+        Returns false if the problems have no :init section (caller should extract all their facts)
+    */
+    bool diffPDDLProblemFacts(const string& pddlProblemBefore, const string& pddlProblemAfter,
+        map<string, string>& added, map<string, string>& removed)
+    {
+        size_t init_before = pddlProblemBefore.find(":init");
+        size_t init_after = pddlProblemAfter.find(":init");
+        if(init_before == string::npos || init_after == string::npos)
+            return false;
+
+        map<string, string> facts_before, facts_after;
+
+        string objects_before = pddlProblemObjects(pddlProblemBefore);
+        string objects_after = pddlProblemObjects(pddlProblemAfter);
+        if(objects_before != objects_after)
+        {
+            extractPDDLObjectsFacts(objects_before, facts_before);
+            extractPDDLObjectsFacts(objects_after, facts_after);
+        }
+
+        const string init_tag = ":init";
+        const char* before = pddlProblemBefore.c_str() + init_before + init_tag.length();
+        const char* after = pddlProblemAfter.c_str() + init_after + init_tag.length();
+        size_t len_before = pddlProblemBefore.length() - init_before - init_tag.length();
+        size_t len_after = pddlProblemAfter.length() - init_after - init_tag.length();
+
+        // common prefix and suffix (not overlapping) of the two :init sections
+        size_t prefix = 0;
+        while(prefix < len_before && prefix < len_after && before[prefix] == after[prefix])
+            prefix++;
+        size_t suffix = 0;
+        while(suffix < len_before - prefix && suffix < len_after - prefix && 
+                before[len_before - 1 - suffix] == after[len_after - 1 - suffix])
+            suffix++;
+
+        if(prefix < len_before || prefix < len_after)
+        {
+            // move back the start of the window to the start of the top level fact containing the first differing char
+            // (nothing to do if the :init section is closed before it)
+            size_t window_start = prefix, fact_start = 0;
+            int depth = 0;
+            bool init_closed = false;
+            for(size_t i = 0; i < prefix && !init_closed; i++)
+            {
+                if(before[i] == '(' && depth++ == 0)
+                    fact_start = i;
+                else if(before[i] == ')')
+                    init_closed = --depth < 0;
+            }
+            if(!init_closed && depth > 0)
+                window_start = fact_start;
+
+            // move forward the end of the window to the end of the top level fact containing the last differing char
+            // (same offset within the common suffix for both the problems, as their depth there is the same)
+            auto windowEnd = [&window_start](const char* section, const size_t& len, const size_t& end)
+            {
+                int depth = 0;
+                size_t i = window_start;
+                for(; i < len && (i < end || depth > 0); i++)
+                {
+                    if(section[i] == '(')
+                        depth++;
+                    else if(section[i] == ')' && --depth < 0)
+                        break;//end of :init section
+                }
+                return i;
+            };
+
+            if(!init_closed)
+            {
+                size_t end_before = windowEnd(before, len_before, len_before - suffix);
+                size_t end_after = windowEnd(after, len_after, len_after - suffix);
+                extractPDDLInitFacts(string(before + window_start, end_before - window_start), facts_before);
+                extractPDDLInitFacts(string(after + window_start, end_after - window_start), facts_after);
+            }
+        }
+
+        for(const auto& fact : facts_after)
+        {
+            auto fact_before = facts_before.find(fact.first);
+            if(fact_before == facts_before.end() || fact_before->second != fact.second)
+                added.insert(fact);
+        }
+        for(const auto& fact : facts_before)
+            if(facts_after.count(fact.first) == 0)
+                removed.insert(fact);
+
+        return true;
+    }
+
+    /*
+        Returns a copy of the PDDL problem string with its :goal section replaced by @pddlGoal
+        (appended as last section if the problem has no goal yet)
+        E.g. "(define ... (:goal (and (p a))))", "(and (q b))" -> "(define ... ( :goal (and (q b)) ))"
+    */
+    string replacePDDLProblemGoal(const string& pddlProblem, const string& pddlGoal)
+    {
+        string goal_section = "( :goal " + pddlGoal + " )";
+
+        size_t goal_start = pddlProblem.find(":goal");
+        if(goal_start != string::npos)
+            goal_start = pddlProblem.rfind("(", goal_start);
+        
+        if(goal_start == string::npos)
+        {
+            //no goal section: put it before the parenthesis closing the problem definition
+            size_t problem_end = pddlProblem.rfind(")");
+            if(problem_end == string::npos)
+                return pddlProblem;
+            return pddlProblem.substr(0, problem_end) + goal_section + "\n" + pddlProblem.substr(problem_end);
+        }
+
+        //look for the parenthesis closing the goal section
+        int depth = 0;
+        size_t goal_end = goal_start;
+        for(; goal_end < pddlProblem.length(); goal_end++)
+        {
+            if(pddlProblem[goal_end] == '(')
+                depth++;
+            else if(pddlProblem[goal_end] == ')' && --depth == 0)
+                break;
+        }
+        if(goal_end == pddlProblem.length())
+            return pddlProblem;//unbalanced goal section
+
+        return pddlProblem.substr(0, goal_start) + goal_section + pddlProblem.substr(goal_end + 1);
+    }
+
+    /*
+        Returns the predicates/functions read and written by each action (durative or not) of a PDDL domain string
+        E.g. "(:action move :parameters (?r ?a ?b) :precondition (and (at ?r ?a) (> (battery ?r) 10)) :effect (at ?r ?b))"
+            -> {name: "move", conditions: {"at", "battery"}, effects: {"at"}}
+    */
+    vector<PDDLActionDependencies> extractPDDLDomainActionsDependencies(const string& pddlDomain)
+    {
+        vector<PDDLActionDependencies> actions;
+        vector<string> tokens = tokenizeExpression(removeComments(pddlDomain));
+
+        int depth = 0;
+        int action_depth = -1;// depth of the action being scanned (-1 if not within an action)
+        set<string>* section = NULL;// names collected in the current section of the action, if relevant
+        for(int i = 0; i < tokens.size(); i++)
+        {
+            const string& token = tokens[i];
+            if(token == "(")
+            {
+                depth++;
+                if(action_depth < 0 && i+2 < tokens.size() && (tokens[i+1] == ":action" || tokens[i+1] == ":durative-action"))
+                {
+                    actions.push_back(PDDLActionDependencies{tokens[i+2], set<string>(), set<string>()});
+                    action_depth = depth;
+                    section = NULL;
+                    i += 2;
+                }
+                else if(section != NULL && i+1 < tokens.size() && isPDDLNameToken(tokens, i+1))
+                    section->insert(tokens[i+1]);
+            }
+            else if(token == ")")
+            {
+                if(depth-- == action_depth)
+                    action_depth = -1;
+            }
+            else if(action_depth >= 0 && depth == action_depth)
+            {
+                if(token == ":precondition" || token == ":condition" || token == ":duration")
+                    section = &actions.back().conditions;
+                else if(token == ":effect")
+                    section = &actions.back().effects;
+                else if(token[0] == ':')
+                    section = NULL;
+            }
+        }
+        return actions;
+    }
+
+    /*
+        Returns the names of the predicates/functions which can affect reaching a goal made of @goalNames:
+        the goal ones plus, transitively, the ones read by any action writing a relevant one
+    */
+    set<string> computeRelevantPDDLNames(const vector<PDDLActionDependencies>& actions, const set<string>& goalNames)
+    {
+        set<string> relevant = goalNames;
+        vector<bool> expanded(actions.size(), false);
+        bool changed = true;
+        while(changed)
+        {
+            changed = false;
+            for(int a = 0; a < actions.size(); a++)
+            {
+                if(expanded[a])
+                    continue;
+                
+                bool writes_relevant = false;
+                for(const string& effect : actions[a].effects)
+                    writes_relevant = writes_relevant || relevant.count(effect) > 0;
+                
+                if(writes_relevant)
+                {
+                    relevant.insert(actions[a].conditions.begin(), actions[a].conditions.end());
+                    expanded[a] = true;
+                    changed = true;
+                }
+            }
+        }
+        return relevant;
+    }
+
+    /*
+        Returns the types declared within the :types section of a PDDL domain string, each one mapped to its parent type
+        (types declared without a parent, or just used as parent, are mapped to "object")
+        E.g. "(:types robot drone - vehicle vehicle dock)" -> {"robot": "vehicle", "drone": "vehicle", "vehicle": "object", "dock": "object"}
+    */
+    map<string, string> extractPDDLDomainTypes(const string& pddlDomain)
+    {
+        map<string, string> types;
+
+        //types section: "type1 type2 - parent1 type3 - parent2 type4 ..." up to the closing parenthesis
+        //(comments stripped first, as they might contain parenthesis)
+        const string pddlDomainNoComments = removeComments(pddlDomain);
+        size_t types_start = pddlDomainNoComments.find(":types");
+        if(types_start == string::npos)
+            return types;
+        
+        types_start += string(":types").length();
+        size_t types_end = pddlDomainNoComments.find(")", types_start);
+        vector<string> tokens = tokenizeExpression(pddlDomainNoComments.substr(types_start, types_end - types_start));
+        vector<string> names;
+        for(int i = 0; i < tokens.size(); i++)
+        {
+            if(tokens[i] == "-" && i+1 < tokens.size())
+            {
+                for(string name : names)
+                    types[name] = tokens[i+1];
+                names.clear();
+                i++;//skip parent type token
+            }
+            else
+                names.push_back(tokens[i]);
+        }
+        for(string name : names)
+            types[name] = "object";//no parent type stated
+        
+        //parent types not declared on their own are direct subtypes of object too
+        vector<string> parents;
+        for(const auto& type : types)
+            parents.push_back(type.second);
+        for(const string& parent : parents)
+            if(parent != "object" && types.count(parent) == 0)
+                types[parent] = "object";
+        
+        return types;
+    }
+
 };
\ No newline at end of file
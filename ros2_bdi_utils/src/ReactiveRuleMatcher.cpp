@@ -0,0 +1,549 @@
+#include "ros2_bdi_utils/ReactiveRuleMatcher.hpp"
+
+#include <algorithm>
+
+#include "ros2_bdi_interfaces/msg/belief.hpp"
+#include "ros2_bdi_interfaces/msg/condition.hpp"
+
+using std::string;
+using std::vector;
+using std::set;
+using std::map;
+using std::pair;
+using std::optional;
+using std::unordered_set;
+
+using ros2_bdi_interfaces::msg::Belief;
+using ros2_bdi_interfaces::msg::Condition;
+
+using BDIManaged::Symbol;
+using BDIManaged::WildPattern;
+using BDIManaged::ManagedType;
+using BDIManaged::ManagedParam;
+using BDIManaged::ManagedBelief;
+using BDIManaged::ManagedCondition;
+using BDIManaged::ManagedConditionsConjunction;
+using BDIManaged::ManagedConditionsDNF;
+using BDIManaged::ManagedReactiveRule;
+using BDIManaged::BeliefStore;
+using BDIManaged::ReactiveRuleMatcher;
+
+/* true if @s is a placeholder, e.g. {x} */
+static bool isPlaceholderName(const string& s)
+{
+    return s.find("{") == 0 && s.find("}") == s.length()-1;
+}
+
+/* key of the literals by name index */
+static uint64_t literalKey(const int& pddl_type, const Symbol& name)
+{
+    return (((uint64_t) pddl_type) << 32) | name.id();
+}
+
+size_t ReactiveRuleMatcher::BindingHash::operator()(const Binding& b) const
+{
+    uint64_t h = 14695981039346656037ULL;
+    for(const Symbol& v : b)
+        h = (h ^ v.id()) * 1099511628211ULL;
+    return (size_t) h;
+}
+
+ReactiveRuleMatcher::ReactiveRuleMatcher() {}
+
+ReactiveRuleMatcher::ReactiveRuleMatcher(const set<ManagedReactiveRule>& rules)
+{
+    rules_.reserve(rules.size());
+    for(const ManagedReactiveRule& rule : rules)
+        compileRule(rule);
+}
+
+/*
+    compile a rule into placeholders and literals
+*/
+void ReactiveRuleMatcher::compileRule(const ManagedReactiveRule& rule)
+{
+    Condition c = Condition();
+    size_t rule_index = rules_.size();
+    rules_.push_back(CompiledRule{rule, {}, {}, {}, {}, true});
+    CompiledRule& cr = rules_.back();
+
+    for(const ManagedConditionsConjunction& clause : rule.getMGCondition().getClauses())
+    {
+        vector<int> clause_literals;
+        bool valid_clause = true;
+        for(const ManagedCondition& mc : clause.getLiterals())
+        {
+            if(!mc.isValid())
+            {
+                valid_clause = false;// performing the check would always give false
+                continue;
+            }
+
+            const ManagedBelief& mb = mc.getMGBelief();
+            Literal lit;
+            lit.pddl_type = mb.pddlType();
+            lit.check = mc.getCheck();
+            lit.value = mb.getValue();
+            lit.negated = lit.check == c.FALSE_CHECK;
+            lit.name_var = -1;
+
+            if(mb.pddlType() == Belief().INSTANCE_TYPE && isPlaceholderName(mb.getName()))
+                lit.name_var = placeholderVar(cr, mb.getName(), mb.type());
+            else
+                lit.name_pattern = WildPattern{mb.getName()};
+            if(lit.name_var >= 0)
+                lit.vars.push_back(lit.name_var);
+
+            for(const ManagedParam& mp : mb.getParams())
+            {
+                int var = mp.isPlaceholder()? placeholderVar(cr, mp.name, mp.type) : -1;
+                lit.param_vars.push_back(var);
+                lit.param_patterns.push_back(var >= 0? WildPattern{} : WildPattern{mp.name});
+                if(var >= 0 && std::find(lit.vars.begin(), lit.vars.end(), var) == lit.vars.end())
+                    lit.vars.push_back(var);
+            }
+
+            size_t literal_index = cr.literals.size();
+            if(lit.name_var < 0 && lit.name_pattern.isLiteral())
+                literals_by_name_[literalKey(lit.pddl_type, mb.getSymbol())].push_back(std::make_pair(rule_index, literal_index));
+            else
+                wild_literals_.push_back(std::make_pair(rule_index, literal_index));
+
+            cr.literals.push_back(lit);
+            clause_literals.push_back(literal_index);
+        }
+        cr.clauses.push_back(valid_clause? clause_literals : vector<int>{-1});
+    }
+}
+
+/*
+    var index of the placeholder (added with @type among its constraints)
+*/
+int ReactiveRuleMatcher::placeholderVar(CompiledRule& cr, const string& name, const ManagedType& type)
+{
+    int var = 0;
+    while(var < cr.placeholders.size() && cr.placeholders[var].name != name)
+        var++;
+
+    if(var == cr.placeholders.size())
+        cr.placeholders.push_back(Placeholder{name, {}, {}});
+
+    Placeholder& ph = cr.placeholders[var];
+    bool known_type = false;
+    for(const ManagedType& t : ph.types)
+        known_type = known_type || (t.name == type.name && t.sub_types == type.sub_types);
+    if(!known_type)
+    {
+        ph.types.push_back(type);
+        ph.domains.push_back(std::unordered_set<Symbol>());
+    }
+    return var;
+}
+
+/*
+    rebuild all the alpha memories from a belief set snapshot (conflict sets are kept)
+*/
+void ReactiveRuleMatcher::reset(const BeliefStore& belief_set)
+{
+    for(CompiledRule& cr : rules_)
+    {
+        for(Literal& lit : cr.literals)
+        {
+            lit.matched.clear();
+            lit.tokens.clear();
+        }
+        for(Placeholder& ph : cr.placeholders)
+            for(auto& domain : ph.domains)
+                domain.clear();
+        cr.dirty = true;
+    }
+
+    instances_.clear();
+    for(const ManagedBelief& mb : belief_set)
+        updateMemories(mb, true);
+}
+
+void ReactiveRuleMatcher::addBelief(const ManagedBelief& mb)
+{
+    updateMemories(mb, true);
+}
+
+void ReactiveRuleMatcher::removeBelief(const ManagedBelief& mb)
+{
+    updateMemories(mb, false);
+}
+
+/*
+    true if the instance @mb satisfies the type constraint @type
+*/
+bool ReactiveRuleMatcher::instanceOfType(const ManagedBelief& mb, const ManagedType& type)
+{
+    if(type.name.empty() || mb.type().name == type.name)
+        return true;
+
+    return type.sub_types.has_value() &&
+        std::find(type.sub_types.value().begin(), type.sub_types.value().end(), mb.type().name.str()) != type.sub_types.value().end();
+}
+
+/*
+    values bound by @mb to the literal placeholders, nullopt if it does not match the literal
+*/
+optional<ReactiveRuleMatcher::Binding> ReactiveRuleMatcher::matchLiteral(const Literal& lit, const ManagedBelief& mb)
+{
+    if(mb.pddlType() != lit.pddl_type)
+        return std::nullopt;
+    if(lit.name_var < 0 && !lit.name_pattern.matches(mb.getSymbol()))
+        return std::nullopt;
+
+    const vector<ManagedParam>& params = mb.getParams();
+    if(params.size() != lit.param_vars.size())
+        return std::nullopt;
+
+    Binding token(lit.vars.size());
+    auto bind = [&](const int& var, const Symbol& value)
+    {
+        size_t i = std::find(lit.vars.begin(), lit.vars.end(), var) - lit.vars.begin();
+        if(!token[i].empty() && token[i] != value)
+            return false;//same placeholder bound to different values
+        token[i] = value;
+        return true;
+    };
+
+    if(lit.name_var >= 0 && !bind(lit.name_var, mb.getSymbol()))
+        return std::nullopt;
+
+    for(size_t i = 0; i < params.size(); i++)
+    {
+        if(lit.param_vars[i] >= 0)
+        {
+            if(!bind(lit.param_vars[i], params[i].name))
+                return std::nullopt;
+        }
+        else if(!lit.param_patterns[i].matches(params[i].name))
+            return std::nullopt;
+    }
+
+    if(lit.pddl_type == Belief().FUNCTION_TYPE)
+    {
+        Condition c = Condition();
+        bool value_check =
+            (lit.check == c.SMALLER_CHECK)? mb.getValue() < lit.value :
+            (lit.check == c.SMALLER_OR_EQUALS_CHECK)? mb.getValue() <= lit.value :
+            (lit.check == c.EQUALS_CHECK)? mb.getValue() == lit.value :
+            (lit.check == c.GREATER_OR_EQUALS_CHECK)? mb.getValue() >= lit.value :
+            (lit.check == c.GREATER_CHECK)? mb.getValue() > lit.value : false;
+        if(!value_check)
+            return std::nullopt;
+    }
+
+    return token;
+}
+
+/*
+    add/remove the instance @mb wrt. the domains of the placeholders
+*/
+void ReactiveRuleMatcher::updateDomains(const ManagedBelief& mb, const bool& add)
+{
+    for(CompiledRule& cr : rules_)
+        for(Placeholder& ph : cr.placeholders)
+            for(size_t t = 0; t < ph.types.size(); t++)
+                if(instanceOfType(mb, ph.types[t]))
+                {
+                    if(add)
+                        ph.domains[t].insert(mb.getSymbol());
+                    else
+                        ph.domains[t].erase(mb.getSymbol());
+                    cr.dirty = true;
+                }
+}
+
+/*
+    add/remove @mb wrt. every alpha memory
+*/
+void ReactiveRuleMatcher::updateMemories(const ManagedBelief& mb, const bool& add)
+{
+    // placeholder domains (the instance previously known with the same name is the one to be removed, whatever its type)
+    if(mb.pddlType() == Belief().INSTANCE_TYPE)
+    {
+        auto known = instances_.find(mb.getSymbol());
+        if(known != instances_.end())
+        {
+            updateDomains(known->second, false);
+            instances_.erase(known);
+        }
+        if(add)
+        {
+            updateDomains(mb, true);
+            instances_.emplace(mb.getSymbol(), mb);
+        }
+    }
+
+    // literals
+    auto update = [&](const pair<size_t, size_t>& ref)
+    {
+        CompiledRule& cr = rules_[ref.first];
+        Literal& lit = cr.literals[ref.second];
+
+        auto it = lit.matched.find(mb);
+        if(it != lit.matched.end())
+        {
+            // (also when adding: functions with a new value might not match anymore)
+            auto token_it = lit.tokens.find(it->second);
+            if(token_it != lit.tokens.end() && --(token_it->second) == 0)
+                lit.tokens.erase(token_it);
+            lit.matched.erase(it);
+            cr.dirty = true;
+        }
+
+        if(!add)
+            return;
+
+        optional<Binding> token = matchLiteral(lit, mb);
+        if(token.has_value())
+        {
+            lit.matched.emplace(mb, token.value());
+            lit.tokens[token.value()]++;
+            cr.dirty = true;
+        }
+    };
+
+    auto it = literals_by_name_.find(literalKey(mb.pddlType(), mb.getSymbol()));
+    if(it != literals_by_name_.end())
+        for(const pair<size_t, size_t>& ref : it->second)
+            update(ref);
+    for(const pair<size_t, size_t>& ref : wild_literals_)
+        update(ref);
+}
+
+/*
+    true if @value belongs to the domain of the placeholder
+*/
+bool ReactiveRuleMatcher::inDomain(const Placeholder& ph, const Symbol& value)
+{
+    for(const auto& domain : ph.domains)
+        if(domain.count(value) == 0)
+            return false;
+    return true;
+}
+
+/*
+    values in the domain of the placeholder
+*/
+vector<Symbol> ReactiveRuleMatcher::domainValues(const Placeholder& ph)
+{
+    vector<Symbol> values;
+    if(ph.domains.empty())
+        return values;
+
+    // go through the smallest one, checking the others
+    size_t smallest = 0;
+    for(size_t t = 1; t < ph.domains.size(); t++)
+        if(ph.domains[t].size() < ph.domains[smallest].size())
+            smallest = t;
+
+    for(const Symbol& value : ph.domains[smallest])
+        if(inDomain(ph, value))
+            values.push_back(value);
+    return values;
+}
+
+/*
+    extend partial bindings assigning every value in its domain to the placeholder @var
+*/
+vector<ReactiveRuleMatcher::Binding> ReactiveRuleMatcher::extendByDomain(const vector<Binding>& partial, const Placeholder& ph, const int& var)
+{
+    vector<Symbol> values = domainValues(ph);
+    vector<Binding> extended;
+    extended.reserve(partial.size() * values.size());
+    for(const Binding& b : partial)
+        for(const Symbol& v : values)
+        {
+            extended.push_back(b);
+            extended.back()[var] = v;
+        }
+    return extended;
+}
+
+/*
+    all the instantiations of the rule currently satisfied
+*/
+unordered_set<ReactiveRuleMatcher::Binding, ReactiveRuleMatcher::BindingHash> ReactiveRuleMatcher::computeInstantiations(const CompiledRule& cr) const
+{
+    unordered_set<Binding, BindingHash> instantiations;
+    size_t num_vars = cr.placeholders.size();
+
+    if(cr.clauses.empty())
+    {
+        instantiations.insert(Binding());// empty DNF is always satisfied
+        return instantiations;
+    }
+
+    for(const vector<int>& clause : cr.clauses)
+    {
+        if(clause.size() == 1 && clause[0] < 0)
+            continue;// invalid clause
+
+        vector<const Literal*> positives, negatives;
+        for(const int& l : clause)
+            (cr.literals[l].negated? negatives : positives).push_back(&cr.literals[l]);
+
+        // join positive literals, smallest alpha memories first
+        std::sort(positives.begin(), positives.end(),
+            [](const Literal* l1, const Literal* l2){return l1->tokens.size() < l2->tokens.size();});
+
+        vector<Binding> partial = {Binding(num_vars)};
+        vector<bool> bound(num_vars, false);
+        for(const Literal* lit : positives)
+        {
+            if(lit->tokens.empty())
+            {
+                partial.clear();
+                break;
+            }
+
+            // token positions whose placeholder is already bound: join on them
+            vector<size_t> shared;
+            for(size_t i = 0; i < lit->vars.size(); i++)
+                if(bound[lit->vars[i]])
+                    shared.push_back(i);
+
+            std::unordered_map<Binding, vector<const Binding*>, BindingHash> index;
+            for(const auto& token : lit->tokens)
+            {
+                Binding key;
+                for(const size_t& i : shared)
+                    key.push_back(token.first[i]);
+                index[key].push_back(&token.first);
+            }
+
+            vector<Binding> joined;
+            for(const Binding& b : partial)
+            {
+                Binding key;
+                for(const size_t& i : shared)
+                    key.push_back(b[lit->vars[i]]);
+
+                auto bucket = index.find(key);
+                if(bucket == index.end())
+                    continue;
+
+                for(const Binding* token : bucket->second)
+                {
+                    joined.push_back(b);
+                    for(size_t i = 0; i < lit->vars.size(); i++)
+                        joined.back()[lit->vars[i]] = (*token)[i];
+                }
+            }
+            partial = std::move(joined);
+
+            for(const int& var : lit->vars)
+                bound[var] = true;
+            if(partial.empty())
+                break;
+        }
+
+        // values bound through the literals need to be instances of the right type
+        vector<Binding> typed;
+        for(const Binding& b : partial)
+        {
+            bool ok = true;
+            for(size_t var = 0; ok && var < num_vars; var++)
+                ok = !bound[var] || inDomain(cr.placeholders[var], b[var]);
+            if(ok)
+                typed.push_back(b);
+        }
+        partial = std::move(typed);
+
+        // placeholders appearing just in negated literals range over their domain, then negated literals are checked
+        for(const Literal* lit : negatives)
+            for(const int& var : lit->vars)
+                if(!bound[var])
+                {
+                    partial = extendByDomain(partial, cr.placeholders[var], var);
+                    bound[var] = true;
+                }
+
+        vector<Binding> satisfied;
+        for(const Binding& b : partial)
+        {
+            bool ok = true;
+            for(size_t n = 0; ok && n < negatives.size(); n++)
+            {
+                Binding key;
+                for(const int& var : negatives[n]->vars)
+                    key.push_back(b[var]);
+                ok = negatives[n]->tokens.count(key) == 0;
+            }
+            if(ok)
+                satisfied.push_back(b);
+        }
+        partial = std::move(satisfied);
+
+        // placeholders not appearing in the clause range over their domain as well
+        for(size_t var = 0; var < num_vars; var++)
+            if(!bound[var])
+                partial = extendByDomain(partial, cr.placeholders[var], var);
+
+        for(Binding& b : partial)
+            instantiations.insert(std::move(b));
+    }
+
+    return instantiations;
+}
+
+/*
+    rule instantiations (with placeholders already substituted) which have become satisfied
+    since the last call, in rule order
+*/
+vector<ManagedReactiveRule> ReactiveRuleMatcher::newActivations()
+{
+    vector<ManagedReactiveRule> activations;
+    for(CompiledRule& cr : rules_)
+    {
+        if(!cr.dirty)
+            continue;
+        cr.dirty = false;
+
+        unordered_set<Binding, BindingHash> instantiations = computeInstantiations(cr);
+        for(const Binding& b : instantiations)
+        {
+            if(cr.conflict_set.count(b) > 0)
+                continue;//already satisfied at last check
+
+            if(cr.placeholders.empty())
+            {
+                activations.push_back(cr.rule);
+                continue;
+            }
+
+            map<string, string> assignments;
+            for(size_t var = 0; var < cr.placeholders.size(); var++)
+                assignments[cr.placeholders[var].name] = b[var].str();
+            activations.push_back(ManagedReactiveRule::applySubstitution(cr.rule, assignments));
+        }
+        cr.conflict_set = std::move(instantiations);
+    }
+    return activations;
+}
+
+/*
+    one shot join: assignments of the placeholders of @condition which satisfy it against the belief set
+    (see ManagedConditionsDNF::extractAssignmentsMap)
+*/
+vector<map<string, string>> ReactiveRuleMatcher::satisfyingAssignments(const ManagedConditionsDNF& condition, const BeliefStore& belief_set)
+{
+    ReactiveRuleMatcher matcher;
+    matcher.compileRule(ManagedReactiveRule{0, condition, {}, {}});
+    matcher.reset(belief_set);
+
+    const CompiledRule& cr = matcher.rules_.front();
+    vector<map<string, string>> assignments;
+    for(const Binding& b : matcher.computeInstantiations(cr))
+    {
+        map<string, string> assignment;
+        for(size_t var = 0; var < cr.placeholders.size(); var++)
+            assignment[cr.placeholders[var].name] = b[var].str();
+        assignments.push_back(assignment);
+    }
+    return assignments;
+}
@@ -0,0 +1,119 @@
+#include "ros2_bdi_utils/Symbol.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <stdexcept>
+#include <unordered_map>
+
+// strings are resolved through fixed size chunks of pointers to the keys of the id map (stable across rehashes),
+// so that resolving an id never needs to lock the table
+#define SYMBOL_CHUNK_BITS 12
+#define SYMBOL_CHUNK_SIZE (1u << SYMBOL_CHUNK_BITS)
+#define SYMBOL_MAX_CHUNKS 4096
+
+using std::string;
+using std::optional;
+
+using BDIManaged::Symbol;
+
+namespace
+{
+    typedef struct{
+        std::mutex mutex;
+        std::unordered_map<string, uint32_t> ids;
+        std::atomic<const string**> chunks[SYMBOL_MAX_CHUNKS];
+        uint32_t next_id;
+    }SymbolTable;
+
+    /*
+        process-wide table, initialized at first use with the empty string as symbol 0
+        (never destroyed, since symbols might still be resolved during static destruction)
+    */
+    SymbolTable& symbolTable()
+    {
+        static SymbolTable* table = []()
+        {
+            SymbolTable* t = new SymbolTable();
+            for(auto& chunk : t->chunks)
+                chunk.store(NULL, std::memory_order_relaxed);
+
+            const string** first_chunk = new const string*[SYMBOL_CHUNK_SIZE];
+            first_chunk[0] = &(t->ids.emplace(string{""}, 0).first->first);
+            t->chunks[0].store(first_chunk, std::memory_order_release);
+            t->next_id = 1;
+            return t;
+        }();
+        return *table;
+    }
+}
+
+/*
+    id of @s within the table (created if not present yet)
+*/
+uint32_t Symbol::intern(const string& s)
+{
+    if(s.empty())
+        return 0;
+
+    SymbolTable& table = symbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto it = table.ids.find(s);
+    if(it != table.ids.end())
+        return it->second;
+
+    uint32_t id = table.next_id;
+    uint32_t chunk_index = id >> SYMBOL_CHUNK_BITS;
+    if(chunk_index >= SYMBOL_MAX_CHUNKS)
+        throw std::length_error("Symbol table is full");
+
+    const string** chunk = table.chunks[chunk_index].load(std::memory_order_relaxed);
+    bool new_chunk = chunk == NULL;
+    if(new_chunk)
+        chunk = new const string*[SYMBOL_CHUNK_SIZE];
+
+    chunk[id & (SYMBOL_CHUNK_SIZE - 1)] = &(table.ids.emplace(s, id).first->first);
+    if(new_chunk)
+        table.chunks[chunk_index].store(chunk, std::memory_order_release);
+    table.next_id++;
+    return id;
+}
+
+/*
+    string corresponding to an id returned by intern
+*/
+const string& Symbol::resolve(const uint32_t& id)
+{
+    const string** chunk = symbolTable().chunks[id >> SYMBOL_CHUNK_BITS].load(std::memory_order_acquire);
+    return *chunk[id & (SYMBOL_CHUNK_SIZE - 1)];
+}
+
+/*
+    symbol for @s, nullopt if @s has never been interned (the table is not modified)
+*/
+optional<Symbol> Symbol::lookup(const string& s)
+{
+    if(s.empty())
+        return Symbol{};
+
+    SymbolTable& table = symbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto it = table.ids.find(s);
+    if(it == table.ids.end())
+        return std::nullopt;
+
+    Symbol sym;
+    sym.id_ = it->second;
+    return sym;
+}
+
+/*
+    number of symbols interned so far (empty string included)
+*/
+size_t Symbol::tableSize()
+{
+    SymbolTable& table = symbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.next_id;
+}
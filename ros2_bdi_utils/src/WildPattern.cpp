@@ -0,0 +1,109 @@
+#include "ros2_bdi_utils/WildPattern.hpp"
+
+using std::string;
+
+using BDIManaged::Symbol;
+using BDIManaged::WildPattern;
+
+WildPattern::WildPattern():
+    kind_(LITERAL),
+    wild_single_char_('?'),
+    wild_multi_char_('*')
+    {}
+
+WildPattern::WildPattern(const string& pattern, const char& wild_single_char, const char& wild_multi_char):
+    text_(pattern),
+    wild_single_char_(wild_single_char),
+    wild_multi_char_(wild_multi_char)
+{
+    size_t first_wild = pattern.find_first_of(string{wild_single_char, wild_multi_char});
+    if(first_wild == string::npos)
+    {
+        kind_ = LITERAL;
+        literal_ = Symbol{pattern};
+        return;
+    }
+
+    bool has_single = pattern.find(wild_single_char) != string::npos;
+    size_t first_multi = pattern.find_first_of(wild_multi_char);
+    size_t last_multi = pattern.find_last_of(wild_multi_char);
+    size_t first_not_multi = pattern.find_first_not_of(wild_multi_char);
+    size_t last_not_multi = pattern.find_last_not_of(wild_multi_char);
+
+    if(first_not_multi == string::npos)
+        kind_ = ANY;//just multi chars
+
+    else if(!has_single && first_multi > last_not_multi)
+    {
+        kind_ = PREFIX;//e.g. "box_*"
+        text_ = pattern.substr(0, first_multi);
+    }
+    else if(!has_single && last_multi < first_not_multi)
+    {
+        kind_ = SUFFIX;//e.g. "*_box"
+        text_ = pattern.substr(last_multi + 1);
+    }
+    else
+        kind_ = GLOB;
+}
+
+/*
+    true if @text matches the pattern
+*/
+bool WildPattern::matches(const string& text) const
+{
+    switch(kind_)
+    {
+        case ANY:
+            return true;
+        case LITERAL:
+            return text == text_;
+        case PREFIX:
+            return text.compare(0, text_.length(), text_) == 0;
+        case SUFFIX:
+            return text.length() >= text_.length() && text.compare(text.length() - text_.length(), text_.length(), text_) == 0;
+        default:
+            return globMatch(text);
+    }
+}
+
+bool WildPattern::matches(const Symbol& text) const
+{
+    if(kind_ == LITERAL)
+        return text == literal_;
+    return matches(text.str());
+}
+
+/*
+    general case: greedy scan, backtracking only to the last multi char met
+    (each text char is consumed at most once per multi char, linear for the usual identifiers)
+*/
+bool WildPattern::globMatch(const string& text) const
+{
+    size_t p = 0, t = 0;
+    size_t star = string::npos, star_t = 0;
+    while(t < text.length())
+    {
+        if(p < text_.length() && text_[p] == wild_multi_char_)
+        {
+            star = p++;//remember where to resume from and first try to match an empty sequence
+            star_t = t;
+        }
+        else if(p < text_.length() && (text_[p] == wild_single_char_ || text_[p] == text[t]))
+        {
+            p++;
+            t++;
+        }
+        else if(star != string::npos)
+        {
+            p = star + 1;//let the last multi char absorb one more text char
+            t = ++star_t;
+        }
+        else
+            return false;
+    }
+
+    while(p < text_.length() && text_[p] == wild_multi_char_)
+        p++;
+    return p == text_.length();
+}